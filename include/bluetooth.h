@@ -32,6 +32,12 @@ extern "C"
  * @file        bluetooth.h
  * @brief       API to control the Bluetooth adapter and devices and communications.
  * @ingroup     CAPI_NETWORK_BLUETOOTH_MODULE
+ *
+ * @remarks     Thread safety: all functions can be called from any thread once bt_initialize() has returned. \n
+ *              Requests of the same profile (RFCOMM socket, OPP, HDP and audio) are serialized by a lock of that
+ *              profile, so requests of different profiles do not wait for each other. \n
+ *              Registering and unregistering callbacks never blocks event delivery. Callbacks are invoked on the
+ *              thread which delivers the Bluetooth F/W events.
  */
 
 
@@ -77,6 +83,67 @@ typedef enum
 	BT_ERROR_REMOTE_DEVICE_NOT_CONNECTED = TIZEN_ERROR_NETWORK_CLASS|0x010B, /**< Remote device is not connected */
 } bt_error_e;
 
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_MODULE
+ * @brief  Enumerations of the Bluetooth events which can be subscribed to.
+ * @see bt_event_subscribe()
+ */
+typedef enum
+{
+	BT_EVENT_STATE_CHANGED = 0x00, /**< Adapter state is changed (#bt_adapter_state_changed_cb) */
+	BT_EVENT_NAME_CHANGED, /**< Adapter name is changed (#bt_adapter_name_changed_cb) */
+	BT_EVENT_VISIBILITY_MODE_CHANGED, /**< Adapter visibility mode is changed (#bt_adapter_visibility_mode_changed_cb) */
+	BT_EVENT_DEVICE_DISCOVERY_STATE_CHANGED, /**< Device discovery state is changed (#bt_adapter_device_discovery_state_changed_cb) */
+	BT_EVENT_BOND_CREATED, /**< A bond is created (#bt_device_bond_created_cb) */
+	BT_EVENT_BOND_DESTROYED, /**< A bond is destroyed (#bt_device_bond_destroyed_cb) */
+	BT_EVENT_AUTHORIZATION_CHANGED, /**< Authorization is changed (#bt_device_authorization_changed_cb) */
+	BT_EVENT_SERVICE_SEARCHED, /**< Service search finish (#bt_device_service_searched_cb) */
+	BT_EVENT_DATA_RECEIVED, /**< Data is received (#bt_socket_data_received_cb) */
+	BT_EVENT_CONNECTION_STATE_CHANGED, /**< Connection state is changed (#bt_socket_connection_state_changed_cb) */
+	BT_EVENT_RFCOMM_CONNECTION_REQUESTED, /**< RFCOMM connection is requested (#bt_socket_connection_requested_cb) */
+	BT_EVENT_OPP_CONNECTION_REQUESTED, /**< OPP connection is requested (#bt_opp_server_connection_requested_cb) */
+	BT_EVENT_OPP_PUSH_REQUESTED, /**< OPP push is requested (#bt_opp_server_push_requested_cb) */
+	BT_EVENT_OPP_SERVER_TRANSFER_PROGRESS, /**< OPP transfer progress (#bt_opp_server_transfer_progress_cb) */
+	BT_EVENT_OPP_SERVER_TRANSFER_FINISHED, /**< OPP transfer is completed (#bt_opp_server_transfer_finished_cb) */
+	BT_EVENT_OPP_CLIENT_PUSH_RESPONSED, /**< OPP client connection is reponsed (#bt_opp_client_push_responded_cb) */
+	BT_EVENT_OPP_CLIENT_PUSH_PROGRESS, /**< OPP client push progress (#bt_opp_client_push_progress_cb) */
+	BT_EVENT_OPP_CLIENT_PUSH_FINISHED, /**< OPP client push is finished (#bt_opp_client_push_finished_cb) */
+	BT_EVENT_PAN_CONNECTION_STATE_CHANGED, /**< PAN connection change (#bt_panu_connection_state_changed_cb) */
+	BT_EVENT_NAP_CONNECTION_STATE_CHANGED, /**< NAP connection change (#bt_nap_connection_state_changed_cb) */
+	BT_EVENT_HDP_CONNECTED, /**< HDP connection change (#bt_hdp_connected_cb) */
+	BT_EVENT_HDP_DISCONNECTED, /**< HDP disconnection change (#bt_hdp_disconnected_cb) */
+	BT_EVENT_HDP_DATA_RECIEVED, /**< HDP Data recieve Callabck (#bt_hdp_data_received_cb) */
+	BT_EVENT_AUDIO_CONNECTION_STATUS, /**< Audio Connection change callback (#bt_audio_connection_state_changed_cb) */
+	BT_EVENT_AG_MICROPHONE_GAIN_CHANGE, /**< Audio Microphone change callback (#bt_ag_microphone_gain_changed_cb) */
+	BT_EVENT_AG_SPEAKER_GAIN_CHANGE, /**< Audio Speaker gain change callback (#bt_ag_speaker_gain_changed_cb) */
+	BT_EVENT_AVRCP_CONNECTION_STATUS, /**< AVRCP connection change callback (#bt_avrcp_target_connection_state_changed_cb) */
+	BT_EVENT_HID_CONNECTION_STATUS, /**< HID connection status callback (#bt_hid_host_connection_state_changed_cb) */
+	BT_EVENT_MAX /**< Number of events */
+} bt_event_e;
+
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_MODULE
+ * @brief  Enumerations of the delivery modes of the Bluetooth events.
+ * @see bt_event_set_delivery_mode()
+ */
+typedef enum
+{
+	BT_EVENT_DELIVERY_INLINE = 0x00, /**< Callbacks are invoked on the thread which receives the Bluetooth F/W events */
+	BT_EVENT_DELIVERY_THREAD_POOL, /**< Callbacks are invoked on a pool of dispatch threads */
+} bt_event_delivery_mode_e;
+
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_MODULE
+ * @brief  Enumerations of the policies applied when the event queue is full.
+ * @see bt_event_set_queue_policy()
+ */
+typedef enum
+{
+	BT_EVENT_QUEUE_POLICY_BLOCK = 0x00, /**< Wait until an event is delivered */
+	BT_EVENT_QUEUE_POLICY_DROP_OLDEST, /**< Drop the oldest queued event of the same #bt_event_e */
+	BT_EVENT_QUEUE_POLICY_COALESCE_BY_DEVICE, /**< Replace the queued event of the same remote device, or drop the oldest one. Events without a remote device are never replaced */
+} bt_event_queue_policy_e;
+
 /**
  * @ingroup CAPI_NETWORK_BLUETOOTH_ADAPTER_MODULE
  * @brief  Enumerations of the Bluetooth adapter state.
@@ -121,6 +188,28 @@ typedef enum
 	BT_DEVICE_UNAUTHORIZED, /**< The remote Bluetooth device is unauthorized */
 } bt_device_authorization_e;
 
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_DEVICE_MODULE
+ * @brief Enumerations of the modes of a queued service search.
+ * @see bt_device_queue_service_search_with_mode()
+ */
+typedef enum
+{
+	BT_DEVICE_SERVICE_SEARCH_ALWAYS, /**< Search the services of the remote device */
+	BT_DEVICE_SERVICE_SEARCH_IF_STALE, /**< Search only if the cached services are missing or stale */
+} bt_device_service_search_mode_e;
+
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_ADAPTER_MODULE
+ * @brief Enumerations of the smoothing of the RSSI samples of a device.
+ * @see bt_proximity_start()
+ */
+typedef enum
+{
+	BT_PROXIMITY_SMOOTHING_EWMA, /**< Exponentially weighted moving average */
+	BT_PROXIMITY_SMOOTHING_KALMAN, /**< Kalman filter, which trusts a sample more as the time since the previous one grows */
+} bt_proximity_smoothing_e;
+
 /**
  * @ingroup CAPI_NETWORK_BLUETOOTH_SOCKET_MODULE
  * @brief  Enumerations of Bluetooth socket connection state.
@@ -341,6 +430,82 @@ typedef enum {
     BT_HDP_CHANNEL_TYPE_STREAMING,  /**< Streaming Data Channel */
 } bt_hdp_channel_type_e;
 
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_MODULE
+ * @brief Statistics of the event queue used by #BT_EVENT_DELIVERY_THREAD_POOL mode.
+ *
+ * @see bt_event_get_queue_stats()
+ */
+typedef struct
+{
+	unsigned long long enqueued; /**< Number of events accepted by the queue, including coalesced events */
+	unsigned long long dropped; /**< Number of events dropped because the queue was full */
+	unsigned long long coalesced; /**< Number of events which replaced a queued event */
+	int queued; /**< Number of events in the queue */
+	int high_water; /**< Highest number of events in the queue */
+	int capacity; /**< Maximum number of events in the queue */
+} bt_event_queue_stats_s;
+
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_MODULE
+ * @brief  Enumerations of the latencies measured for each event.
+ * @see bt_diag_get_latency_stats()
+ */
+typedef enum
+{
+	BT_DIAG_LATENCY_QUEUE = 0x00, /**< From receiving the Bluetooth F/W event to invoking the first callback */
+	BT_DIAG_LATENCY_CALLBACK, /**< From invoking the first callback to the return of the last callback */
+	BT_DIAG_LATENCY_TOTAL, /**< From receiving the Bluetooth F/W event to the return of the last callback */
+} bt_diag_latency_e;
+
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_MODULE
+ * @brief Latency distribution of an event, in nanoseconds.
+ *
+ * @remarks The values are the upper bounds of histogram buckets, which are about 6% wide.
+ *
+ * @see bt_diag_get_latency_stats()
+ */
+typedef struct
+{
+	unsigned long long count; /**< Number of delivered events */
+	unsigned long long min; /**< Minimum latency */
+	unsigned long long p50; /**< Median latency */
+	unsigned long long p90; /**< 90th percentile latency */
+	unsigned long long p99; /**< 99th percentile latency */
+	unsigned long long p999; /**< 99.9th percentile latency */
+	unsigned long long max; /**< Maximum latency */
+} bt_diag_latency_stats_s;
+
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_MODULE
+ * @brief Trace record of a delivered event.
+ *
+ * @see bt_diag_get_trace()
+ */
+typedef struct
+{
+	bt_event_e event; /**< The event */
+	unsigned long long received; /**< Monotonic time when the Bluetooth F/W event was received, in nanoseconds */
+	unsigned int converted; /**< Nanoseconds from @a received until the event was converted */
+	unsigned int callback_started; /**< Nanoseconds from @a received until the first callback was invoked */
+	unsigned int callback_ended; /**< Nanoseconds from @a received until the last callback returned */
+} bt_diag_trace_record_s;
+
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_MODULE
+ * @brief Binary address of a Bluetooth device.
+ *
+ * @details @a addr holds the address in the order it is written, so "00:1B:66:01:23:45"
+ * is { 0x00, 0x1B, 0x66, 0x01, 0x23, 0x45 }.
+ *
+ * @see bt_event_subscribe_addr()
+ */
+typedef struct
+{
+	unsigned char addr[6]; /**< The address bytes */
+} bt_addr_t;
+
 /**
  * @ingroup CAPI_NETWORK_BLUETOOTH_DEVICE_MODULE
  * @brief Class structure of device and service.
@@ -358,6 +523,44 @@ typedef struct
 	This value can be a combination of #bt_major_service_class_e like #BT_MAJOR_SERVICE_CLASS_RENDERING | #BT_MAJOR_SERVICE_CLASS_AUDIO */
 } bt_class_s;
 
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_DEVICE_MODULE
+ * @brief Enumerations of the well-known services, which have a 16 bit UUID on the Bluetooth base UUID.
+ *
+ * @see bt_device_info_has_service()
+ * @see bt_adapter_device_discovery_info_has_service()
+ * @see bt_device_view_has_service()
+ */
+typedef enum
+{
+	BT_SERVICE_SPP = 0, /**< Serial Port (0x1101) */
+	BT_SERVICE_DUN, /**< Dial-up Networking (0x1103) */
+	BT_SERVICE_OPP, /**< Object Push (0x1105) */
+	BT_SERVICE_FTP, /**< File Transfer (0x1106) */
+	BT_SERVICE_HSP, /**< Headset (0x1108) */
+	BT_SERVICE_A2DP_SOURCE, /**< Audio Source (0x110A) */
+	BT_SERVICE_A2DP_SINK, /**< Audio Sink (0x110B) */
+	BT_SERVICE_AVRCP_TARGET, /**< A/V Remote Control Target (0x110C) */
+	BT_SERVICE_AVRCP, /**< A/V Remote Control (0x110E) */
+	BT_SERVICE_AVRCP_CONTROLLER, /**< A/V Remote Control Controller (0x110F) */
+	BT_SERVICE_HSP_AG, /**< Headset Audio Gateway (0x1112) */
+	BT_SERVICE_PANU, /**< PAN User (0x1115) */
+	BT_SERVICE_NAP, /**< Network Access Point (0x1116) */
+	BT_SERVICE_GN, /**< Group Ad-hoc Network (0x1117) */
+	BT_SERVICE_HFP, /**< Handsfree (0x111E) */
+	BT_SERVICE_HFP_AG, /**< Handsfree Audio Gateway (0x111F) */
+	BT_SERVICE_HID, /**< Human Interface Device (0x1124) */
+	BT_SERVICE_SAP, /**< SIM Access (0x112D) */
+	BT_SERVICE_PBAP_PCE, /**< Phonebook Access Client (0x112E) */
+	BT_SERVICE_PBAP_PSE, /**< Phonebook Access Server (0x112F) */
+	BT_SERVICE_MAP_MSE, /**< Message Access Server (0x1132) */
+	BT_SERVICE_MAP_MCE, /**< Message Notification Server (0x1133) */
+	BT_SERVICE_PNP, /**< PnP Information (0x1200) */
+	BT_SERVICE_HDP_SOURCE, /**< Health Device Source (0x1401) */
+	BT_SERVICE_HDP_SINK, /**< Health Device Sink (0x1402) */
+	BT_SERVICE_MAX, /**< Number of services, not a service */
+} bt_service_e;
+
 /**
  * @ingroup CAPI_NETWORK_BLUETOOTH_ADAPTER_MODULE
  * @brief Structure of device discovery information.
@@ -367,15 +570,135 @@ typedef struct
  */
 typedef struct
 {
-	char *remote_address;	/**< The address of remote device */
+	char *remote_address;	/**< The address of remote device, interned (see bt_address_intern()) */
 	char *remote_name;	/**< The name of remote device */
 	bt_class_s bt_class;	/**< The Bluetooth classes */
 	int rssi;	/**< The strength indicator of received signal  */
 	bool is_bonded;	/**< The bonding state */
-	char **service_uuid;  /**< The UUID list of service */
+	char **service_uuid;  /**< The UUID list of service, in uppercase and in the form the remote device reported */
 	int service_count;	/**< The number of services */
 } bt_adapter_device_discovery_info_s;
 
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_ADAPTER_MODULE
+ * @brief Structure of a device discovery filter. A device is found only if it passes every condition.
+ *
+ * @remarks A zero-filled filter accepts every device.
+ *
+ * @see bt_adapter_start_device_discovery_with_filter()
+ */
+typedef struct
+{
+	unsigned int major_device_class_mask; /**< Bits (1 << #bt_major_device_class_e) of the accepted major device classes, 0 for any */
+	unsigned long long minor_device_class_mask; /**< Bits (1 << (#bt_minor_device_class_e >> 2)) of the accepted minor device classes, 0 for any */
+	const char **service_uuids; /**< The UUIDs of the services which a device must all have */
+	int service_count; /**< The number of UUIDs in @a service_uuids, 0 for any */
+	int min_rssi; /**< The lowest accepted RSSI in dBm, a negative value, or 0 for any */
+	const char *name_prefix; /**< The beginning of the accepted device names, NULL for any */
+} bt_adapter_device_discovery_filter_s;
+
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_ADAPTER_MODULE
+ * @brief Structure of a periodic device discovery schedule. The times are in milliseconds.
+ *
+ * @details A discovery of @a window runs every interval. The interval starts at @a interval, doubles
+ * after each cycle in which no device was found or lost, up to @a max_interval, and comes back
+ * toward @a interval as devices come and go.
+ *
+ * @see bt_adapter_start_discovery_schedule()
+ */
+typedef struct
+{
+	int window; /**< The duration of a discovery */
+	int interval; /**< The shortest time from the start of a discovery to the start of the next one, at least @a window */
+	int max_interval; /**< The longest interval, at least @a interval. Equal to @a interval for a fixed period */
+} bt_adapter_discovery_schedule_s;
+
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_ADAPTER_MODULE
+ * @brief Structure of the statistics of a cycle of a periodic device discovery.
+ *
+ * @see bt_adapter_discovery_cycle_cb()
+ */
+typedef struct
+{
+	int cycle; /**< The number of the cycle, from 1 */
+	int result; /**< #BT_ERROR_NONE, or the error which prevented or ended the discovery early */
+	bool yielded; /**< Whether the discovery was skipped or stopped early because a device was connected */
+	int found; /**< The number of devices found in the cycle */
+	int new_devices; /**< The number of devices found which were not known */
+	int lost; /**< The number of known devices which were not found in the last 2 complete discoveries */
+	int known; /**< The number of devices known after the cycle */
+	int interval; /**< The time from the start of this cycle to the start of the next one */
+} bt_adapter_discovery_cycle_s;
+
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_ADAPTER_MODULE
+ * @brief The handle of a device discovery session.
+ *
+ * @see bt_adapter_open_discovery_session()
+ */
+typedef struct bt_adapter_discovery_session_s *bt_adapter_discovery_session_h;
+
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_ADAPTER_MODULE
+ * @brief Structure of the criteria of a device lookup. A device must meet all the given criteria.
+ *
+ * @see bt_adapter_find_device()
+ */
+typedef struct
+{
+	const char *remote_address; /**< The address of the device, NULL for any */
+	const char *name_pattern; /**< The pattern of the device name, where '*' matches any string and '?' any character, NULL for any */
+	const char *service_uuid; /**< The UUID of a service of the device, NULL for any */
+	int max_age; /**< The longest time since a device was last found for it to be taken from the discovered devices, in milliseconds. 0 to always discover */
+} bt_adapter_find_device_criteria_s;
+
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_ADAPTER_MODULE
+ * @brief Structure of the configuration of the proximity tracking.
+ *
+ * @see bt_proximity_start()
+ */
+typedef struct
+{
+	bt_proximity_smoothing_e smoothing; /**< The smoothing of the RSSI samples */
+	double alpha; /**< The weight of a new sample for #BT_PROXIMITY_SMOOTHING_EWMA, greater than 0 and at most 1 */
+	double process_noise; /**< The variance added to the estimate per second for #BT_PROXIMITY_SMOOTHING_KALMAN, in dB^2 */
+	double measurement_noise; /**< The variance of a sample for #BT_PROXIMITY_SMOOTHING_KALMAN, in dB^2 */
+	int max_age; /**< The time after which a device not found anymore is forgotten, in milliseconds */
+} bt_proximity_config_s;
+
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_ADAPTER_MODULE
+ * @brief Structure of a device tracked by the proximity tracking.
+ *
+ * @see bt_proximity_get_top_n()
+ * @see bt_proximity_get_device()
+ */
+typedef struct
+{
+	const char *remote_address; /**< The address of the device, interned so it stays valid */
+	int rssi; /**< The smoothed RSSI, in dBm */
+	int last_rssi; /**< The last RSSI sample, in dBm */
+	int sample_count; /**< The number of samples kept, up to 16 */
+	int age; /**< The time since the last sample, in milliseconds */
+} bt_proximity_device_s;
+
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_ADAPTER_MODULE
+ * @brief Statistics of the bonded device cache.
+ *
+ * @see bt_adapter_get_bonded_device_cache_stats()
+ */
+typedef struct
+{
+	unsigned long long hits; /**< Number of queries answered from the cache */
+	unsigned long long misses; /**< Number of queries which read the bonded devices from the Bluetooth F/W */
+	unsigned long long refreshes; /**< Number of times the bonded devices were read from the Bluetooth F/W */
+	int count; /**< Number of cached bonded devices, -1 if they are not read yet */
+} bt_adapter_bonded_device_cache_stats_s;
+
 /**
  * @ingroup CAPI_NETWORK_BLUETOOTH_DEVICE_MODULE
  * @brief Device information structure used for identifying pear device.
@@ -388,13 +711,26 @@ typedef struct
 	char *remote_address;	/**< The address of remote device */
 	char *remote_name;	/**< The name of remote device */
 	bt_class_s bt_class;	/**< The Bluetooth classes */
-	char **service_uuid;  /**< The UUID list of service */
+	char **service_uuid;  /**< The UUID list of service, in uppercase and in the form the remote device reported */
 	int service_count;	/**< The number of services */
 	bool is_bonded;	/**< The bonding state */
 	bool is_connected;	/**< The connection state */
 	bool is_authorized;	/**< The authorization state */
 } bt_device_info_s;
 
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_DEVICE_MODULE
+ * @brief The handle of a borrowed view over the information of a remote device.
+ *
+ * @details Unlike #bt_device_info_s, nothing is copied when the event occurs.
+ * The bt_device_view_*() functions convert only the requested member.
+ *
+ * @remarks The view is only valid in the callback which receives it.
+ *
+ * @see bt_event_subscribe_device_view()
+ */
+typedef struct bt_device_view_s *bt_device_view_h;
+
 /**
  * @ingroup CAPI_NETWORK_BLUETOOTH_DEVICE_MODULE
  * @brief Service Discovery Protocol (SDP) data structure.
@@ -406,11 +742,32 @@ typedef struct
  */
 typedef struct
 {
-	char *remote_address;   /**< The address of remote device */
+	char *remote_address;   /**< The address of remote device, interned (see bt_address_intern()) */
 	char **service_uuid;  /**< The UUID list of service */
 	int service_count;    /**< The number of services. */
 } bt_device_sdp_info_s;
 
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_DEVICE_MODULE
+ * @brief Statistics of the service search queue.
+ *
+ * @remarks The wait times are from the request to the start of its search, in milliseconds.
+ *
+ * @see bt_device_get_service_search_queue_stats()
+ */
+typedef struct
+{
+	int depth; /**< Number of searches waiting, not counting the running search */
+	int max_depth; /**< Highest number of searches waiting */
+	bool running; /**< Whether a search of the queue is running */
+	unsigned long long requests; /**< Number of accepted requests */
+	unsigned long long deduplicated; /**< Number of requests which joined a search already queued or running */
+	unsigned long long searches; /**< Number of searches started */
+	unsigned long long cached; /**< Number of requests answered from the service cache */
+	int wait_avg; /**< Average wait time of the searches, in milliseconds */
+	int wait_max; /**< Longest wait time of a search, in milliseconds */
+} bt_device_service_search_queue_stats_s;
+
 /**
  * @ingroup CAPI_NETWORK_BLUETOOTH_SOCKET_MODULE
  *
@@ -422,7 +779,7 @@ typedef struct
 {
 	int socket_fd;	/**< The file descriptor of connected socket */
 	bt_socket_role_e local_role;	/**< The local device role in this connection */
-	char *remote_address;	/**< The remote device address */
+	char *remote_address;	/**< The remote device address, interned (see bt_address_intern()) */
 	char *service_uuid;	/**< The service UUId */
 } bt_socket_connection_s;
 
@@ -528,6 +885,74 @@ typedef void (*bt_adapter_device_discovery_state_changed_cb)
  */
 typedef bool (*bt_adapter_bonded_device_cb)(bt_device_info_s *device_info, void *user_data);
 
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_ADAPTER_MODULE
+ * @brief  Called when you get discovered devices repeatedly.
+ *
+ * @remarks The @a discovery_info is valid only in this function.
+ *
+ * @param[in] discovery_info The information of the discovered device, as it was last found
+ * @param[in] age The time since the device was last found, in milliseconds
+ * @param[in] user_data The user data passed from the foreach function
+ * @return @c true to continue with the next iteration of the loop,
+ * \n @c false to break out of the loop.
+ * @pre bt_adapter_foreach_discovered_device() will invoke this function.
+ *
+ * @see bt_adapter_foreach_discovered_device()
+ *
+ */
+typedef bool (*bt_adapter_discovered_device_cb)(bt_adapter_device_discovery_info_s *discovery_info, int age, void *user_data);
+
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_ADAPTER_MODULE
+ * @brief  Called at the end of each cycle of a periodic device discovery.
+ *
+ * @remarks The @a cycle is valid only in this function.
+ *
+ * @param[in] cycle The statistics of the cycle
+ * @param[in] user_data The user data passed from the start function
+ * @pre bt_adapter_start_discovery_schedule() will invoke this function.
+ *
+ * @see bt_adapter_start_discovery_schedule()
+ */
+typedef void (*bt_adapter_discovery_cycle_cb)(const bt_adapter_discovery_cycle_s *cycle, void *user_data);
+
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_ADAPTER_MODULE
+ * @brief  Called once when a device lookup completes.
+ *
+ * @remarks The @a discovery_info is valid only in this function.
+ *
+ * @param[in] result The result of the lookup: #BT_ERROR_NONE if a device was found, #BT_ERROR_TIMED_OUT
+ * if its timeout passed first, #BT_ERROR_CANCELLED if it was cancelled, or #BT_ERROR_NOT_ENABLED if the
+ * adapter was disabled
+ * @param[in] discovery_info The information of the device found, NULL if none was found
+ * @param[in] age The time since the device was found, in milliseconds, 0 if it was found by the lookup
+ * @param[in] user_data The user data passed from the lookup function
+ * @pre bt_adapter_find_device() will invoke this function.
+ *
+ * @see bt_adapter_find_device()
+ * @see bt_adapter_cancel_find_device()
+ */
+typedef void (*bt_adapter_device_found_cb)(int result, bt_adapter_device_discovery_info_s *discovery_info, int age,
+		void *user_data);
+
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_ADAPTER_MODULE
+ * @brief  Called when the smoothed RSSI of a device crosses a proximity threshold.
+ *
+ * @param[in] threshold_id The identifier of the threshold
+ * @param[in] remote_address The interned address of the device
+ * @param[in] rssi The smoothed RSSI of the device, in dBm
+ * @param[in] is_near @c true if the device came near, @c false if it went away or was forgotten
+ * @param[in] user_data The user data passed from the function which added the threshold
+ * @pre bt_proximity_add_threshold() registers this function.
+ *
+ * @see bt_proximity_add_threshold()
+ */
+typedef void (*bt_proximity_threshold_crossed_cb)(int threshold_id, const char *remote_address, int rssi,
+		bool is_near, void *user_data);
+
 /**
  * @ingroup CAPI_NETWORK_BLUETOOTH_DEVICE_MODULE
  * @brief Called when the process of creating bond finishes.
@@ -551,6 +976,36 @@ typedef bool (*bt_adapter_bonded_device_cb)(bt_device_info_s *device_info, void
  */
 typedef void (*bt_device_bond_created_cb)(int result, bt_device_info_s *device_info, void *user_data);
 
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_ADAPTER_MODULE
+ * @brief  Called when the state of device discovery changes, with a borrowed view of the found device.
+ *
+ * @param[in] result The result of the device discovery
+ * @param[in] discovery_state The discovery state to be changed
+ * @param[in] device The view of the discovered device \n
+ *					If \a discovery_state is #BT_ADAPTER_DEVICE_DISCOVERY_STARTED or
+ * #BT_ADAPTER_DEVICE_DISCOVERY_FINISHED, then \a device is NULL.
+ * @param[in] user_data The user data passed from the callback registration function
+ *
+ * @see bt_event_subscribe_device_view()
+ * @see bt_adapter_device_discovery_state_changed_cb()
+ */
+typedef void (*bt_adapter_device_discovery_state_changed_view_cb)
+	(int result, bt_adapter_device_discovery_state_e discovery_state, bt_device_view_h device, void *user_data);
+
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_DEVICE_MODULE
+ * @brief Called when the process of creating bond finishes, with a borrowed view of the device.
+ *
+ * @param[in] result The result of the bonding device
+ * @param[in] device The view of the device which you creates bond with
+ * @param[in] user_data The user data passed from the callback registration function
+ *
+ * @see bt_event_subscribe_device_view()
+ * @see bt_device_bond_created_cb()
+ */
+typedef void (*bt_device_bond_created_view_cb)(int result, bt_device_view_h device, void *user_data);
+
 /**
  * @ingroup CAPI_NETWORK_BLUETOOTH_DEVICE_MODULE
  * @brief  Called when the bond destroys.
@@ -638,13 +1093,42 @@ typedef void (*bt_socket_data_received_cb)(bt_socket_received_data_s *data, void
 typedef void (*bt_socket_connection_state_changed_cb)
 	(int result, bt_socket_connection_state_e connection_state, bt_socket_connection_s *connection, void *user_data);
 
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_MODULE
+ * @brief  Called when an event which reports a remote device occurs, with the binary address of the device.
+ * @param[in] event  The event
+ * @param[in] result  The result of the event, as passed to the callback documented for @a event
+ * @param[in] state  The state passed to the callback documented for @a event (connection state,
+ * connected flag, discovery state or authorization), 0 if it has none
+ * @param[in] remote_addr  The address of the remote device, NULL if the Bluetooth F/W did not report it
+ * @param[in] user_data  The user data passed from the subscription function
+ * @remarks @a remote_addr is only valid in the callback.
+ * @see bt_event_subscribe_addr()
+ */
+typedef void (*bt_event_addr_cb)(bt_event_e event, int result, int state, const bt_addr_t *remote_addr, void *user_data);
+
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_MODULE
+ * @brief  Called once when an asynchronous operation completes.
+ * @param[in] operation_id  The identifier given by the function which started the operation
+ * @param[in] result  The result of the operation: the result of its Bluetooth event, #BT_ERROR_TIMED_OUT
+ * if its deadline passed first, or #BT_ERROR_CANCELLED if it was cancelled
+ * @param[in] remote_address  The interned address of the remote device, NULL for the operations of the adapter
+ * @param[in] user_data  The user data passed from the function which started the operation
+ * @remarks The callback documented for the Bluetooth event of the operation is invoked as well, after this one.
+ * @see bt_operation_cancel()
+ */
+typedef void (*bt_operation_completed_cb)(int operation_id, int result, const char *remote_address, void *user_data);
+
 
 /**
  * @ingroup CAPI_NETWORK_BLUETOOTH_MODULE
  * @brief Initializes the Bluetooth API.
  *
  * @remarks This function must be called before Bluetooth API starts. \n
- * You must free all resources of the Bluetooth service by calling bt_deinitialize() if Bluetooth service is no longer needed.
+ * You must free all resources of the Bluetooth service by calling bt_deinitialize() if Bluetooth service is no longer needed. \n
+ * Initialization is reference counted: each call must be balanced by a call to bt_deinitialize(), and
+ * the resources are released by the last one.
  *
  * @return 0 on success, otherwise a negative error value.
  * @retval #BT_ERROR_NONE  Successful
@@ -659,7 +1143,8 @@ int bt_initialize(void);
  * @ingroup CAPI_NETWORK_BLUETOOTH_MODULE
  * @brief Releases all resources of the Bluetooth API.
  *
- * @remarks This function must be called if Bluetooth API is no longer needed.
+ * @remarks This function must be called if Bluetooth API is no longer needed. \n
+ * The resources are released when the number of calls matches the number of calls to bt_initialize().
  *
  * @return 0 on success, otherwise a negative error value.
  * @retval #BT_ERROR_NONE  Successful
@@ -674,66 +1159,519 @@ int bt_deinitialize(void);
 
 
 /**
- * @ingroup CAPI_NETWORK_BLUETOOTH_ADAPTER_MODULE
- * @brief Enables the local Bluetooth adapter, asynchronously.
+ * @ingroup CAPI_NETWORK_BLUETOOTH_MODULE
+ * @brief Subscribes to a Bluetooth event.
  *
- * @details This function enables Bluetooth protocol stack and hardware.
+ * @details Unlike the bt_*_set_*_cb() functions, which keep a single callback per event,
+ * any number of subscribers can be registered for the same event. Each of them is invoked
+ * in the order of subscription whenever the event occurs.
+ *
+ * @remarks The type of @a callback must match the callback type documented for @a event in #bt_event_e. \n
+ * Subscribing and unsubscribing never block event delivery. A subscriber removed while an event is
+ * being delivered can still be invoked for that event.
+ *
+ * @param[in] event  The event to subscribe to
+ * @param[in] callback  The callback function to invoke
+ * @param[in] user_data  The user data to be passed to the callback function
+ * @param[out] subscription_id  The id of the subscription, used to unsubscribe
  *
  * @return 0 on success, otherwise a negative error value.
  * @retval #BT_ERROR_NONE  Successful
  * @retval #BT_ERROR_NOT_INITIALIZED  Not initialized
- * @retval #BT_ERROR_ALREADY_DONE  Already enabled
- * @retval #BT_ERROR_NOW_IN_PROGRESS  Operation now in progress
- *
- * @pre Bluetooth service must be initialized with bt_initialize().
- * @post This function invokes bt_adapter_state_changed_cb().
+ * @retval #BT_ERROR_INVALID_PARAMETER  Invalid parameter
+ * @retval #BT_ERROR_OUT_OF_MEMORY  Out of memory
  *
- * @see bt_initialize()
- * @see bt_adapter_get_state()
- * @see bt_adapter_disable()
- * @see bt_adapter_set_state_changed_cb()
- * @see bt_adapter_unset_state_changed_cb()
- * @see bt_adapter_state_changed_cb()
+ * @pre Bluetooth API must be initialized with bt_initialize().
  *
+ * @see bt_event_unsubscribe()
  */
-int bt_adapter_enable(void);
+int bt_event_subscribe(bt_event_e event, void *callback, void *user_data, int *subscription_id);
+
 
 /**
- * @ingroup CAPI_NETWORK_BLUETOOTH_ADAPTER_MODULE
- * @brief Disables the local Bluetooth adapter, asynchronously.
+ * @ingroup CAPI_NETWORK_BLUETOOTH_MODULE
+ * @brief Subscribes to a Bluetooth event of some remote devices only.
  *
- * @details This function disables Bluetooth protocol stack and hardware.
+ * @details The remote address of the event is matched before the event is converted, so the events of
+ * other devices cost no allocation when no subscriber wants them.
  *
- * @remarks You should disable Bluetooth adapter to switch off Bluetooth chip, which is helpful for saving power.
+ * @remarks The type of @a callback must match the callback type documented for @a event in #bt_event_e. \n
+ * Events which do not carry a remote device address, such as #BT_EVENT_DATA_RECEIVED or #BT_EVENT_STATE_CHANGED,
+ * are never delivered to this subscription.
+ *
+ * @param[in] event  The event to subscribe to
+ * @param[in] remote_addresses  The addresses of the remote devices, in the form "XX:XX:XX:XX:XX:XX"
+ * @param[in] address_count  The number of addresses in @a remote_addresses
+ * @param[in] callback  The callback function to invoke
+ * @param[in] user_data  The user data to be passed to the callback function
+ * @param[out] subscription_id  The id of the subscription, used to unsubscribe
  *
  * @return 0 on success, otherwise a negative error value.
  * @retval #BT_ERROR_NONE  Successful
  * @retval #BT_ERROR_NOT_INITIALIZED  Not initialized
- * @retval #BT_ERROR_NOT_ENABLED  Not enabled
- * @retval #BT_ERROR_NOW_IN_PROGRESS  Operation now in progress
- *
- * @pre Bluetooth API must be enabled with bt_adapter_enable().
- * @post This function invokes bt_adapter_state_changed_cb().
+ * @retval #BT_ERROR_INVALID_PARAMETER  Invalid parameter
+ * @retval #BT_ERROR_OUT_OF_MEMORY  Out of memory
  *
- * @see bt_adapter_get_state()
- * @see bt_adapter_enable()
- * @see bt_adapter_state_changed_cb()
- * @see bt_adapter_set_state_changed_cb()
- * @see bt_adapter_unset_state_changed_cb ()
+ * @pre Bluetooth API must be initialized with bt_initialize().
  *
+ * @see bt_event_subscribe()
+ * @see bt_event_unsubscribe()
  */
-int bt_adapter_disable(void);
+int bt_event_subscribe_with_filter(bt_event_e event, const char *remote_addresses[], int address_count,
+		void *callback, void *user_data, int *subscription_id);
+
 
 /**
- * @ingroup CAPI_NETWORK_BLUETOOTH_ADAPTER_MODULE
- * @brief Gets the current state of local Bluetooth adapter.
+ * @ingroup CAPI_NETWORK_BLUETOOTH_MODULE
+ * @brief Subscribes to a Bluetooth event which reports a remote device, with a borrowed view of the device.
  *
- * @param[out] adapter_state The current adapter state
+ * @details The device information is not converted when the event occurs. The callback reads the members
+ * it needs with the bt_device_view_*() functions, which convert them on demand.
+ *
+ * @remarks Only #BT_EVENT_DEVICE_DISCOVERY_STATE_CHANGED (#bt_adapter_device_discovery_state_changed_view_cb)
+ * and #BT_EVENT_BOND_CREATED (#bt_device_bond_created_view_cb) are supported.
+ *
+ * @param[in] event  The event to subscribe to
+ * @param[in] callback  The callback function to invoke
+ * @param[in] user_data  The user data to be passed to the callback function
+ * @param[out] subscription_id  The id of the subscription, used to unsubscribe
+ *
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #BT_ERROR_NONE  Successful
+ * @retval #BT_ERROR_NOT_INITIALIZED  Not initialized
+ * @retval #BT_ERROR_INVALID_PARAMETER  Invalid parameter
+ * @retval #BT_ERROR_OUT_OF_MEMORY  Out of memory
+ *
+ * @pre Bluetooth API must be initialized with bt_initialize().
+ *
+ * @see bt_event_unsubscribe()
+ */
+int bt_event_subscribe_device_view(bt_event_e event, void *callback, void *user_data, int *subscription_id);
+
+
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_MODULE
+ * @brief Subscribes to a Bluetooth event which reports a remote device, with the binary address of the device.
+ *
+ * @details The address is read from the Bluetooth F/W event, so the callback never parses a string.
+ *
+ * @remarks Only the events which report a remote device are supported, such as the connection,
+ * bonding, authorization and discovery events.
+ *
+ * @param[in] event  The event to subscribe to
+ * @param[in] callback  The callback function to invoke
+ * @param[in] user_data  The user data to be passed to the callback function
+ * @param[out] subscription_id  The id of the subscription, used to unsubscribe
+ *
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #BT_ERROR_NONE  Successful
+ * @retval #BT_ERROR_NOT_INITIALIZED  Not initialized
+ * @retval #BT_ERROR_INVALID_PARAMETER  Invalid parameter
+ * @retval #BT_ERROR_OUT_OF_MEMORY  Out of memory
+ *
+ * @pre Bluetooth API must be initialized with bt_initialize().
+ *
+ * @see bt_event_addr_cb()
+ * @see bt_event_unsubscribe()
+ */
+int bt_event_subscribe_addr(bt_event_e event, bt_event_addr_cb callback, void *user_data, int *subscription_id);
+
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_MODULE
+ * @brief Gets the interned string of an address.
+ *
+ * @details The remote addresses passed to the event callbacks are interned: there is one
+ * string per device, owned by the library, so two addresses are the same device if and only
+ * if the pointers are equal. This function gives the interned string of an address which the
+ * application already has, to compare it with the addresses of the events or to use it as the
+ * key of a pointer keyed table.
+ *
+ * @remarks @a interned_address is uppercase, must not be modified nor freed, and stays valid
+ * until the process exits. \n
+ * An interned string is kept for each device which has ever been reported.
+ *
+ * @param[in] remote_address  The address of the remote Bluetooth device, "XX:XX:XX:XX:XX:XX" in either case
+ * @param[out] interned_address  The interned string of @a remote_address
+ *
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #BT_ERROR_NONE  Successful
+ * @retval #BT_ERROR_INVALID_PARAMETER  Invalid parameter
+ * @retval #BT_ERROR_OUT_OF_MEMORY  Out of memory
+ */
+int bt_address_intern(const char *remote_address, const char **interned_address);
+
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_MODULE
+ * @brief Cancels an asynchronous operation.
+ *
+ * @details The request is stopped in the Bluetooth F/W if it can be (bonding and service search),
+ * and the completion callback of the operation is invoked with #BT_ERROR_CANCELLED before this
+ * function returns. The operations still pending are cancelled by the last bt_deinitialize().
+ *
+ * @param[in] operation_id  The identifier of the operation
+ *
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #BT_ERROR_NONE  Successful
+ * @retval #BT_ERROR_NOT_INITIALIZED  Not initialized
+ * @retval #BT_ERROR_NOT_IN_PROGRESS  The operation has already completed
+ *
+ * @see bt_operation_completed_cb()
+ */
+int bt_operation_cancel(int operation_id);
+
+
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_MODULE
+ * @brief Unsubscribes from a Bluetooth event.
+ *
+ * @param[in] subscription_id  The id of the subscription returned by bt_event_subscribe()
+ *
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #BT_ERROR_NONE  Successful
+ * @retval #BT_ERROR_NOT_INITIALIZED  Not initialized
+ * @retval #BT_ERROR_INVALID_PARAMETER  Invalid parameter
+ * @retval #BT_ERROR_OUT_OF_MEMORY  Out of memory
+ *
+ * @pre Bluetooth API must be initialized with bt_initialize().
+ *
+ * @see bt_event_subscribe()
+ */
+int bt_event_unsubscribe(int subscription_id);
+
+
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_MODULE
+ * @brief Sets the delivery mode of the Bluetooth events.
+ *
+ * @details In #BT_EVENT_DELIVERY_THREAD_POOL mode, events are queued per remote device and
+ * delivered by @a worker_count dispatch threads, so a slow callback of one device does not delay
+ * the events of another. Events of the same remote device are delivered in order, the data received
+ * on a socket or HDP channel included. An event without a remote address, such as the end of the
+ * device discovery, is delivered after the events of the same #bt_event_e queued before it.
+ *
+ * @remarks Switching back to #BT_EVENT_DELIVERY_INLINE waits until the queued events are delivered,
+ * so it must not be called from a callback. The last bt_deinitialize() switches back to #BT_EVENT_DELIVERY_INLINE. \n
+ * Data passed to the callbacks is only valid until the callback returns, in both modes.
+ *
+ * @param[in] mode  The delivery mode
+ * @param[in] worker_count  The number of dispatch threads, ignored in #BT_EVENT_DELIVERY_INLINE mode
+ *
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #BT_ERROR_NONE  Successful
+ * @retval #BT_ERROR_NOT_INITIALIZED  Not initialized
+ * @retval #BT_ERROR_INVALID_PARAMETER  Invalid parameter
+ * @retval #BT_ERROR_OUT_OF_MEMORY  Out of memory
+ * @retval #BT_ERROR_OPERATION_FAILED  Operation failed
+ *
+ * @pre Bluetooth API must be initialized with bt_initialize().
+ *
+ * @see bt_event_get_delivery_mode()
+ */
+int bt_event_set_delivery_mode(bt_event_delivery_mode_e mode, int worker_count);
+
+
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_MODULE
+ * @brief Gets the delivery mode of the Bluetooth events.
+ *
+ * @param[out] mode  The delivery mode
+ *
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #BT_ERROR_NONE  Successful
+ * @retval #BT_ERROR_NOT_INITIALIZED  Not initialized
+ * @retval #BT_ERROR_INVALID_PARAMETER  Invalid parameter
+ *
+ * @pre Bluetooth API must be initialized with bt_initialize().
+ *
+ * @see bt_event_set_delivery_mode()
+ */
+int bt_event_get_delivery_mode(bt_event_delivery_mode_e *mode);
+
+
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_MODULE
+ * @brief Sets the maximum number of events queued in #BT_EVENT_DELIVERY_THREAD_POOL mode.
+ *
+ * @remarks The queue is allocated when the thread pool mode starts, so the capacity can only be changed
+ * in #BT_EVENT_DELIVERY_INLINE mode. The default capacity is 256 events.
+ *
+ * @param[in] capacity  The maximum number of queued events
+ *
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #BT_ERROR_NONE  Successful
+ * @retval #BT_ERROR_NOT_INITIALIZED  Not initialized
+ * @retval #BT_ERROR_INVALID_PARAMETER  Invalid parameter
+ * @retval #BT_ERROR_RESOURCE_BUSY  Events are delivered by the thread pool
+ *
+ * @pre Bluetooth API must be initialized with bt_initialize().
+ *
+ * @see bt_event_set_delivery_mode()
+ * @see bt_event_set_queue_policy()
+ */
+int bt_event_set_queue_capacity(int capacity);
+
+
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_MODULE
+ * @brief Sets the policy applied to an event when the event queue is full.
+ *
+ * @details #BT_EVENT_QUEUE_POLICY_COALESCE_BY_DEVICE also replaces a queued event of the same remote device
+ * when the queue is not full, so only the latest state of each device is delivered. Events without a remote
+ * device, like the start and the end of the device discovery, are never replaced. \n
+ * By default, device discovery events are coalesced, OPP progress events drop the oldest one and the other
+ * events block.
+ *
+ * @remarks #BT_EVENT_QUEUE_POLICY_BLOCK blocks the thread receiving the Bluetooth F/W events until a
+ * dispatch thread takes an event from the queue.
+ *
+ * @param[in] event  The event
+ * @param[in] policy  The policy
+ *
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #BT_ERROR_NONE  Successful
+ * @retval #BT_ERROR_NOT_INITIALIZED  Not initialized
+ * @retval #BT_ERROR_INVALID_PARAMETER  Invalid parameter
+ *
+ * @pre Bluetooth API must be initialized with bt_initialize().
+ *
+ * @see bt_event_get_queue_policy()
+ */
+int bt_event_set_queue_policy(bt_event_e event, bt_event_queue_policy_e policy);
+
+
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_MODULE
+ * @brief Gets the policy applied to an event when the event queue is full.
+ *
+ * @param[in] event  The event
+ * @param[out] policy  The policy
+ *
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #BT_ERROR_NONE  Successful
+ * @retval #BT_ERROR_NOT_INITIALIZED  Not initialized
+ * @retval #BT_ERROR_INVALID_PARAMETER  Invalid parameter
+ *
+ * @pre Bluetooth API must be initialized with bt_initialize().
+ *
+ * @see bt_event_set_queue_policy()
+ */
+int bt_event_get_queue_policy(bt_event_e event, bt_event_queue_policy_e *policy);
+
+
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_MODULE
+ * @brief Gets the statistics of the event queue.
+ *
+ * @param[out] stats  The statistics
+ *
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #BT_ERROR_NONE  Successful
+ * @retval #BT_ERROR_NOT_INITIALIZED  Not initialized
+ * @retval #BT_ERROR_INVALID_PARAMETER  Invalid parameter
+ *
+ * @pre Bluetooth API must be initialized with bt_initialize().
+ *
+ * @see bt_event_set_queue_capacity()
+ */
+int bt_event_get_queue_stats(bt_event_queue_stats_s *stats);
+
+
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_MODULE
+ * @brief Gets the latency distribution of an event.
+ *
+ * @details Every event delivered to at least one callback is measured, so the statistics can be read
+ * at any time without enabling them first.
+ *
+ * @param[in] event  The event
+ * @param[in] type  The measured latency
+ * @param[out] stats  The latency distribution
+ *
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #BT_ERROR_NONE  Successful
+ * @retval #BT_ERROR_NOT_INITIALIZED  Not initialized
+ * @retval #BT_ERROR_INVALID_PARAMETER  Invalid parameter
+ *
+ * @pre Bluetooth API must be initialized with bt_initialize().
+ *
+ * @see bt_diag_reset()
+ * @see bt_diag_dump()
+ */
+int bt_diag_get_latency_stats(bt_event_e event, bt_diag_latency_e type, bt_diag_latency_stats_s *stats);
+
+
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_MODULE
+ * @brief Gets the latest delivered events, oldest first.
+ *
+ * @remarks Only the last 1024 events are kept.
+ *
+ * @param[out] records  The array which receives the trace records
+ * @param[in] max_count  The number of records @a records can hold
+ * @param[out] count  The number of copied records
+ *
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #BT_ERROR_NONE  Successful
+ * @retval #BT_ERROR_NOT_INITIALIZED  Not initialized
+ * @retval #BT_ERROR_INVALID_PARAMETER  Invalid parameter
+ *
+ * @pre Bluetooth API must be initialized with bt_initialize().
+ *
+ * @see bt_diag_dump()
+ */
+int bt_diag_get_trace(bt_diag_trace_record_s *records, int max_count, int *count);
+
+
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_MODULE
+ * @brief Clears the latency distributions and the trace records.
+ *
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #BT_ERROR_NONE  Successful
+ * @retval #BT_ERROR_NOT_INITIALIZED  Not initialized
+ *
+ * @pre Bluetooth API must be initialized with bt_initialize().
+ *
+ * @see bt_diag_get_latency_stats()
+ */
+int bt_diag_reset(void);
+
+
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_MODULE
+ * @brief Writes the latency distributions and the trace records to a text file.
+ *
+ * @param[in] path  The path of the file, which is overwritten
+ *
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #BT_ERROR_NONE  Successful
+ * @retval #BT_ERROR_NOT_INITIALIZED  Not initialized
+ * @retval #BT_ERROR_INVALID_PARAMETER  Invalid parameter or the file cannot be opened
+ * @retval #BT_ERROR_OUT_OF_MEMORY  Out of memory
+ * @retval #BT_ERROR_OPERATION_FAILED  Writing the file failed
+ *
+ * @pre Bluetooth API must be initialized with bt_initialize().
+ *
+ * @see bt_diag_get_latency_stats()
+ * @see bt_diag_get_trace()
+ */
+int bt_diag_dump(const char *path);
+
+
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_ADAPTER_MODULE
+ * @brief Enables the local Bluetooth adapter, asynchronously.
+ *
+ * @details This function enables Bluetooth protocol stack and hardware.
+ *
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #BT_ERROR_NONE  Successful
+ * @retval #BT_ERROR_NOT_INITIALIZED  Not initialized
+ * @retval #BT_ERROR_ALREADY_DONE  Already enabled
+ * @retval #BT_ERROR_NOW_IN_PROGRESS  Operation now in progress
+ *
+ * @pre Bluetooth service must be initialized with bt_initialize().
+ * @post This function invokes bt_adapter_state_changed_cb().
+ *
+ * @see bt_initialize()
+ * @see bt_adapter_get_state()
+ * @see bt_adapter_disable()
+ * @see bt_adapter_set_state_changed_cb()
+ * @see bt_adapter_unset_state_changed_cb()
+ * @see bt_adapter_state_changed_cb()
+ *
+ */
+int bt_adapter_enable(void);
+
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_ADAPTER_MODULE
+ * @brief Disables the local Bluetooth adapter, asynchronously.
+ *
+ * @details This function disables Bluetooth protocol stack and hardware.
+ *
+ * @remarks You should disable Bluetooth adapter to switch off Bluetooth chip, which is helpful for saving power.
+ *
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #BT_ERROR_NONE  Successful
+ * @retval #BT_ERROR_NOT_INITIALIZED  Not initialized
+ * @retval #BT_ERROR_NOT_ENABLED  Not enabled
+ * @retval #BT_ERROR_NOW_IN_PROGRESS  Operation now in progress
+ *
+ * @pre Bluetooth API must be enabled with bt_adapter_enable().
+ * @post This function invokes bt_adapter_state_changed_cb().
+ *
+ * @see bt_adapter_get_state()
+ * @see bt_adapter_enable()
+ * @see bt_adapter_state_changed_cb()
+ * @see bt_adapter_set_state_changed_cb()
+ * @see bt_adapter_unset_state_changed_cb ()
+ *
+ */
+int bt_adapter_disable(void);
+
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_ADAPTER_MODULE
+ * @brief Enables the local Bluetooth adapter, and reports the result to its own callback.
+ *
+ * @details Same as bt_adapter_enable(), completed by the next change of the adapter state to enabled.
+ *
+ * @param[in] timeout_ms  The deadline in milliseconds, after which @a callback is invoked with #BT_ERROR_TIMED_OUT, or 0 for none
+ * @param[in] callback  The callback function invoked when the operation completes
+ * @param[in] user_data  The user data passed to the callback function
+ * @param[out] operation_id  The identifier of the operation, for bt_operation_cancel()
+ *
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #BT_ERROR_NONE  Successful
+ * @retval #BT_ERROR_NOT_INITIALIZED  Not initialized
+ * @retval #BT_ERROR_INVALID_PARAMETER  Invalid parameter
+ * @retval #BT_ERROR_OUT_OF_MEMORY  Out of memory
+ * @retval #BT_ERROR_ALREADY_DONE  Already enabled
+ * @retval #BT_ERROR_NOW_IN_PROGRESS  Operation now in progress
+ *
+ * @post This function invokes bt_operation_completed_cb().
+ *
+ * @see bt_adapter_enable()
+ * @see bt_operation_cancel()
+ */
+int bt_adapter_enable_async(int timeout_ms, bt_operation_completed_cb callback, void *user_data, int *operation_id);
+
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_ADAPTER_MODULE
+ * @brief Disables the local Bluetooth adapter, and reports the result to its own callback.
+ *
+ * @details Same as bt_adapter_disable(), completed by the next change of the adapter state to disabled.
+ *
+ * @param[in] timeout_ms  The deadline in milliseconds, after which @a callback is invoked with #BT_ERROR_TIMED_OUT, or 0 for none
+ * @param[in] callback  The callback function invoked when the operation completes
+ * @param[in] user_data  The user data passed to the callback function
+ * @param[out] operation_id  The identifier of the operation, for bt_operation_cancel()
  *
  * @return 0 on success, otherwise a negative error value.
  * @retval #BT_ERROR_NONE  Successful
  * @retval #BT_ERROR_NOT_INITIALIZED  Not initialized
  * @retval #BT_ERROR_INVALID_PARAMETER  Invalid parameter
+ * @retval #BT_ERROR_OUT_OF_MEMORY  Out of memory
+ * @retval #BT_ERROR_NOT_ENABLED  Not enabled
+ * @retval #BT_ERROR_NOW_IN_PROGRESS  Operation now in progress
+ *
+ * @post This function invokes bt_operation_completed_cb().
+ *
+ * @see bt_adapter_disable()
+ * @see bt_operation_cancel()
+ */
+int bt_adapter_disable_async(int timeout_ms, bt_operation_completed_cb callback, void *user_data, int *operation_id);
+
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_ADAPTER_MODULE
+ * @brief Gets the current state of local Bluetooth adapter.
+ *
+ * @param[out] adapter_state The current adapter state
+ *
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #BT_ERROR_NONE  Successful
+ * @retval #BT_ERROR_NOT_INITIALIZED  Not initialized
+ * @retval #BT_ERROR_INVALID_PARAMETER  Invalid parameter
+ * @retval #BT_ERROR_OPERATION_FAILED  Operation failed
  *
  * @pre Bluetooth service must be initialized with bt_initialize().
  *
@@ -773,126 +1711,445 @@ int bt_adapter_get_address(char **local_address);
  *
  * @remarks The @a local_name must be released with free() by you.
  *
- * @param[out] local_name  The local device name
+ * @param[out] local_name  The local device name
+ *
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #BT_ERROR_NONE  Successful
+ * @retval #BT_ERROR_NOT_INITIALIZED  Not initialized
+ * @retval #BT_ERROR_INVALID_PARAMETER  Invalid parameter
+ * @retval #BT_ERROR_NOT_ENABLED  Not enabled
+ * @retval #BT_ERROR_OUT_OF_MEMORY  Out of memory
+ * @retval #BT_ERROR_OPERATION_FAILED  Operation failed
+ *
+ * @pre The state of local Bluetooth must be #BT_ADAPTER_ENABLED with bt_adapter_enable().
+ *
+ * @see bt_adapter_enable()
+ * @see bt_adapter_set_name()
+ */
+int bt_adapter_get_name(char **local_name);
+
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_ADAPTER_MODULE
+ * @brief Sets the name of local Bluetooth adapter.
+ *
+ * @param[in] local_name The name of the Bluetooth device. \n
+ *				The maximum length is 248 characters.
+ *
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #BT_ERROR_NONE  Successful
+ * @retval #BT_ERROR_NOT_INITIALIZED  Not initialized
+ * @retval #BT_ERROR_INVALID_PARAMETER  Invalid parameter
+ * @retval #BT_ERROR_NOT_ENABLED  Not enabled
+ * @retval #BT_ERROR_OPERATION_FAILED Operation failed
+ *
+ * @pre The state of local Bluetooth must be #BT_ADAPTER_ENABLED with bt_adapter_enable().
+ * @post bt_adapter_name_changed_cb() will be invoked if this function returns #BT_ERROR_NONE.
+ *
+ * @see bt_adapter_enable()
+ * @see bt_adapter_get_name()
+ * @see bt_adapter_name_changed_cb()
+ * @see bt_adapter_set_name_changed_cb()
+ * @see bt_adapter_unset_name_changed_cb()
+ */
+int bt_adapter_set_name(const char *local_name);
+
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_ADAPTER_MODULE
+ * @brief Gets the visibility mode of local Bluetooth adapter.
+ *
+ * @param[out] mode	The visibility mode of the Bluetooth device
+ *
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #BT_ERROR_NONE  Successful
+ * @retval #BT_ERROR_NOT_INITIALIZED  Not initialized
+ * @retval #BT_ERROR_INVALID_PARAMETER  Invalid parameter
+ * @retval #BT_ERROR_NOT_ENABLED  Not enabled
+ * @retval #BT_ERROR_OPERATION_FAILED  Operation failed
+ *
+ * @pre The state of local Bluetooth must be #BT_ADAPTER_ENABLED with bt_adapter_enable().
+ *
+ * @see bt_adapter_enable()
+ * @see bt_adapter_set_visibility()
+ */
+int bt_adapter_get_visibility(bt_adapter_visibility_mode_e *mode);
+
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_ADAPTER_MODULE
+ * @brief Sets the visibility mode.
+ *
+ * @remarks #BT_ADAPTER_VISIBILITY_MODE_LIMITED_DISCOVERABLE will change to #BT_ADAPTER_VISIBILITY_MODE_NON_DISCOVERABLE
+ * after the given @a timeout_sec goes.
+ *
+ * @param[in] discoverable_mode The Bluetooth discoverable mode to set
+ * @param[in] timeout_sec The discoverable time duration (in seconds)
+ *					@a timeout_sec is used only for #BT_ADAPTER_VISIBILITY_MODE_LIMITED_DISCOVERABLE mode.
+ *
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #BT_ERROR_NONE  Successful
+ * @retval #BT_ERROR_NOT_INITIALIZED  Not initialized
+ * @retval #BT_ERROR_NOT_ENABLED  Not enabled
+ * @retval #BT_ERROR_INVALID_PARAMETER  Invalid parameter
+ * @retval #BT_ERROR_OPERATION_FAILED  Operation failed
+ *
+ * @pre The state of local Bluetooth must be #BT_ADAPTER_ENABLED with bt_adapter_enable().
+ * @post bt_adapter_visibility_mode_changed_cb() will be invoked if this function returns #BT_ERROR_NONE.
+ *
+ * @see bt_adapter_enable()
+ * @see bt_adapter_get_visibility()
+ * @see bt_adapter_visibility_mode_changed_cb()
+ * @see bt_adapter_set_visibility_mode_changed_cb()
+ * @see bt_adapter_unset_visibility_mode_changed_cb()
+ */
+int bt_adapter_set_visibility(bt_adapter_visibility_mode_e discoverable_mode, int timeout_sec);
+
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_ADAPTER_MODULE
+ * @brief Starts the device discovery, asynchronously.
+ *
+ * @details If a device is discovered, bt_adapter_device_discovery_state_changed_cb() will be invoked
+ * with #BT_ADAPTER_DEVICE_DISCOVERY_FOUND, and then bt_adapter_device_discovery_state_changed_cb()
+ * will be called with #BT_ADAPTER_DEVICE_DISCOVERY_FINISHED in case of the completion or cancellation of the discovery.
+ *
+ * @remarks To connect to peer Bluetooth device, you need to know its Bluetooth address. \n
+ * The device discovery can be stopped by bt_adapter_stop_device_discovery().
+ *
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #BT_ERROR_NONE  Successful
+ * @retval #BT_ERROR_NOT_INITIALIZED  Not initialized
+ * @retval #BT_ERROR_NOT_ENABLED  Not enabled
+ * @retval #BT_ERROR_NOW_IN_PROGRESS  Operation is now in progress
+ * @retval #BT_ERROR_OPERATION_FAILED  Operation failed
+ *
+ * @pre The state of local Bluetooth must be #BT_ADAPTER_ENABLED with bt_adapter_enable().
+ * @post This function invokes bt_adapter_device_discovery_state_changed_cb().
+ *
+ * @see bt_adapter_enable()
+ * @see bt_adapter_is_discovering()
+ * @see bt_adapter_stop_device_discovery()
+ * @see bt_adapter_device_discovery_state_changed_cb()
+ * @see bt_adapter_set_device_discovery_state_changed_cb()
+ * @see bt_adapter_unset_device_discovery_state_changed_cb()
+ */
+int bt_adapter_start_device_discovery(void);
+
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_ADAPTER_MODULE
+ * @brief Starts the device discovery of the devices which pass a filter, asynchronously.
+ *
+ * @details The devices which do not pass the filter are dropped as they are reported by the
+ * Bluetooth F/W, before their information is converted or cached, so
+ * bt_adapter_device_discovery_state_changed_cb() is not invoked for them.
+ * The major device classes are passed to the F/W as well, when it can filter them.
+ *
+ * @remarks The filter is copied, and stays in effect until bt_adapter_start_device_discovery() or
+ * this function is called again. \n
+ * Every other behavior is the same as bt_adapter_start_device_discovery().
+ *
+ * @param[in] filter The filter of the devices
+ *
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #BT_ERROR_NONE  Successful
+ * @retval #BT_ERROR_NOT_INITIALIZED  Not initialized
+ * @retval #BT_ERROR_INVALID_PARAMETER  Invalid parameter
+ * @retval #BT_ERROR_OUT_OF_MEMORY  Out of memory
+ * @retval #BT_ERROR_NOT_ENABLED  Not enabled
+ * @retval #BT_ERROR_NOW_IN_PROGRESS  Operation is now in progress
+ * @retval #BT_ERROR_OPERATION_FAILED  Operation failed
+ *
+ * @pre The state of local Bluetooth must be #BT_ADAPTER_ENABLED with bt_adapter_enable().
+ * @post This function invokes bt_adapter_device_discovery_state_changed_cb().
+ *
+ * @see bt_adapter_start_device_discovery()
+ * @see bt_adapter_stop_device_discovery()
+ * @see bt_adapter_device_discovery_state_changed_cb()
+ */
+int bt_adapter_start_device_discovery_with_filter(const bt_adapter_device_discovery_filter_s *filter);
+
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_ADAPTER_MODULE
+ * @brief Starts a periodic device discovery, which keeps an inventory of the nearby devices.
+ *
+ * @details The first discovery starts from the main loop, then one starts every interval of the
+ * @a schedule. While a remote device is connected, the discoveries are skipped, and a running
+ * discovery is stopped when a device connects, so the connections keep the radio. At the end of
+ * each cycle, @a callback is invoked with the devices found, new and lost.
+ *
+ * @remarks The devices found are reported to bt_adapter_device_discovery_state_changed_cb() as well.
+ * A filter set by bt_adapter_start_device_discovery_with_filter() applies to these discoveries. \n
+ * The schedule runs until bt_adapter_stop_discovery_schedule() or the last bt_deinitialize().
+ * The timers run in the default main context.
+ *
+ * @param[in] schedule The window and the intervals of the discovery
+ * @param[in] callback The callback function invoked at the end of each cycle
+ * @param[in] user_data The user data passed to the callback function
+ *
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #BT_ERROR_NONE  Successful
+ * @retval #BT_ERROR_NOT_INITIALIZED  Not initialized
+ * @retval #BT_ERROR_INVALID_PARAMETER  Invalid parameter
+ * @retval #BT_ERROR_OUT_OF_MEMORY  Out of memory
+ * @retval #BT_ERROR_NOW_IN_PROGRESS  A schedule is already running
+ *
+ * @post This function invokes bt_adapter_discovery_cycle_cb().
+ *
+ * @see bt_adapter_stop_discovery_schedule()
+ * @see bt_adapter_discovery_cycle_cb()
+ */
+int bt_adapter_start_discovery_schedule(const bt_adapter_discovery_schedule_s *schedule,
+		bt_adapter_discovery_cycle_cb callback, void *user_data);
+
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_ADAPTER_MODULE
+ * @brief Stops the periodic device discovery, and its running discovery if any.
+ *
+ * @remarks The inventory of the devices is forgotten.
+ *
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #BT_ERROR_NONE  Successful
+ * @retval #BT_ERROR_NOT_INITIALIZED  Not initialized
+ * @retval #BT_ERROR_NOT_IN_PROGRESS  No schedule is running
+ *
+ * @see bt_adapter_start_discovery_schedule()
+ */
+int bt_adapter_stop_discovery_schedule(void);
+
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_ADAPTER_MODULE
+ * @brief Opens a device discovery session, which shares one discovery with the other sessions.
+ *
+ * @details The device discovery runs while any session is open. It is started again whenever it
+ * finishes, including when bt_adapter_stop_device_discovery() stops it, and stopped when the last
+ * session is closed. A discovery started by another component is neither restarted nor stopped by the
+ * sessions, which start theirs when it finishes. Each device found is reported to the sessions whose
+ * filter it passes.
+ *
+ * @remarks @a callback is invoked with #BT_ADAPTER_DEVICE_DISCOVERY_FOUND for each device found, and
+ * with #BT_ADAPTER_DEVICE_DISCOVERY_FINISHED and #BT_ERROR_NOT_ENABLED when the adapter is disabled.
+ * The session stays open, and the discovery starts again when the adapter is enabled. \n
+ * The filter is copied, and the filter of bt_adapter_start_device_discovery_with_filter() does not apply
+ * to the sessions. The devices found are reported to bt_adapter_device_discovery_state_changed_cb() as well. \n
+ * The sessions are closed by the last bt_deinitialize().
+ *
+ * @param[in] filter The filter of the devices, NULL for every device
+ * @param[in] callback The callback function invoked for the devices of the session
+ * @param[in] user_data The user data passed to the callback function
+ * @param[out] session The handle of the session
+ *
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #BT_ERROR_NONE  Successful
+ * @retval #BT_ERROR_NOT_INITIALIZED  Not initialized
+ * @retval #BT_ERROR_INVALID_PARAMETER  Invalid parameter
+ * @retval #BT_ERROR_OUT_OF_MEMORY  Out of memory
+ * @retval #BT_ERROR_NOT_ENABLED  Not enabled
+ * @retval #BT_ERROR_OPERATION_FAILED  Operation failed
+ *
+ * @pre The state of local Bluetooth must be #BT_ADAPTER_ENABLED with bt_adapter_enable().
+ * @post This function invokes bt_adapter_device_discovery_state_changed_cb().
+ *
+ * @see bt_adapter_close_discovery_session()
+ */
+int bt_adapter_open_discovery_session(const bt_adapter_device_discovery_filter_s *filter,
+		bt_adapter_device_discovery_state_changed_cb callback, void *user_data,
+		bt_adapter_discovery_session_h *session);
+
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_ADAPTER_MODULE
+ * @brief Closes a device discovery session, and stops the discovery of the sessions if it was the last one.
+ *
+ * @remarks The callback of the session may be running in another thread when this function returns,
+ * but it is not invoked for the events which occur afterwards.
+ *
+ * @param[in] session The handle of the session
+ *
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #BT_ERROR_NONE  Successful
+ * @retval #BT_ERROR_NOT_INITIALIZED  Not initialized
+ * @retval #BT_ERROR_INVALID_PARAMETER  The session is not open
+ *
+ * @see bt_adapter_open_discovery_session()
+ */
+int bt_adapter_close_discovery_session(bt_adapter_discovery_session_h session);
+
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_ADAPTER_MODULE
+ * @brief Looks up a device, and stops as soon as it is found.
+ *
+ * @details If a device which meets the @a criteria was found within @a max_age of the criteria,
+ * @a callback is invoked with it before this function returns. Otherwise a discovery session is
+ * opened, and closed by the first device which meets the criteria, so the discovery stops at once
+ * unless another session uses it.
+ *
+ * @remarks At least one of the address, the name pattern and the service UUID must be given. \n
+ * The lookups still pending are cancelled by the last bt_deinitialize().
+ * The timer runs in the default main context.
+ *
+ * @param[in] criteria The criteria of the device
+ * @param[in] timeout_ms The longest time to discover the device, in milliseconds
+ * @param[in] callback The callback function invoked when the lookup completes
+ * @param[in] user_data The user data passed to the callback function
+ * @param[out] find_id The identifier of the lookup, used to cancel it
+ *
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #BT_ERROR_NONE  Successful
+ * @retval #BT_ERROR_NOT_INITIALIZED  Not initialized
+ * @retval #BT_ERROR_INVALID_PARAMETER  Invalid parameter
+ * @retval #BT_ERROR_OUT_OF_MEMORY  Out of memory
+ * @retval #BT_ERROR_NOT_ENABLED  Not enabled
+ * @retval #BT_ERROR_OPERATION_FAILED  Operation failed
+ *
+ * @post This function invokes bt_adapter_device_found_cb().
+ *
+ * @see bt_adapter_cancel_find_device()
+ * @see bt_adapter_open_discovery_session()
+ */
+int bt_adapter_find_device(const bt_adapter_find_device_criteria_s *criteria, int timeout_ms,
+		bt_adapter_device_found_cb callback, void *user_data, int *find_id);
+
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_ADAPTER_MODULE
+ * @brief Cancels a device lookup.
+ *
+ * @details The callback of the lookup is invoked with #BT_ERROR_CANCELLED before this function returns.
+ *
+ * @param[in] find_id The identifier of the lookup
+ *
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #BT_ERROR_NONE  Successful
+ * @retval #BT_ERROR_NOT_INITIALIZED  Not initialized
+ * @retval #BT_ERROR_NOT_IN_PROGRESS  The lookup has already completed
+ *
+ * @see bt_adapter_find_device()
+ */
+int bt_adapter_cancel_find_device(int find_id);
+
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_ADAPTER_MODULE
+ * @brief Starts tracking the RSSI of the devices found, and ranking them by proximity.
+ *
+ * @details Each device found keeps its last 16 RSSI samples and a smoothed RSSI. The devices are
+ * kept ranked by their smoothed RSSI as the samples arrive, so bt_proximity_get_top_n() does not sort.
+ *
+ * @remarks The devices are found by any discovery: this function does not start one. \n
+ * The tracking runs until bt_proximity_stop() or the last bt_deinitialize().
+ *
+ * @param[in] config The configuration, NULL for a Kalman filter with a measurement noise of 16 dB^2,
+ * a process noise of 1 dB^2 per second, and devices forgotten after 30 seconds
+ *
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #BT_ERROR_NONE  Successful
+ * @retval #BT_ERROR_NOT_INITIALIZED  Not initialized
+ * @retval #BT_ERROR_INVALID_PARAMETER  Invalid parameter
+ * @retval #BT_ERROR_NOW_IN_PROGRESS  The tracking is already running
+ *
+ * @see bt_proximity_stop()
+ * @see bt_proximity_get_top_n()
+ */
+int bt_proximity_start(const bt_proximity_config_s *config);
+
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_ADAPTER_MODULE
+ * @brief Stops the proximity tracking, and forgets the tracked devices.
+ *
+ * @remarks The thresholds stay registered.
  *
  * @return 0 on success, otherwise a negative error value.
  * @retval #BT_ERROR_NONE  Successful
  * @retval #BT_ERROR_NOT_INITIALIZED  Not initialized
- * @retval #BT_ERROR_INVALID_PARAMETER  Invalid parameter
- * @retval #BT_ERROR_NOT_ENABLED  Not enabled
- * @retval #BT_ERROR_OUT_OF_MEMORY  Out of memory
- * @retval #BT_ERROR_OPERATION_FAILED  Operation failed
+ * @retval #BT_ERROR_NOT_IN_PROGRESS  The tracking is not running
  *
- * @pre The state of local Bluetooth must be #BT_ADAPTER_ENABLED with bt_adapter_enable().
- *
- * @see bt_adapter_enable()
- * @see bt_adapter_set_name()
+ * @see bt_proximity_start()
  */
-int bt_adapter_get_name(char **local_name);
+int bt_proximity_stop(void);
 
 /**
  * @ingroup CAPI_NETWORK_BLUETOOTH_ADAPTER_MODULE
- * @brief Sets the name of local Bluetooth adapter.
+ * @brief Gets the nearest devices, by smoothed RSSI.
  *
- * @param[in] local_name The name of the Bluetooth device. \n
- *				The maximum length is 248 characters.
+ * @details The devices are copied from the head of the ranking, nearest first, without sorting.
+ *
+ * @param[in] n The largest number of devices to get
+ * @param[out] devices The array of at least @a n devices to fill
+ * @param[out] count The number of devices filled, less than @a n if fewer devices are tracked
  *
  * @return 0 on success, otherwise a negative error value.
  * @retval #BT_ERROR_NONE  Successful
  * @retval #BT_ERROR_NOT_INITIALIZED  Not initialized
  * @retval #BT_ERROR_INVALID_PARAMETER  Invalid parameter
- * @retval #BT_ERROR_NOT_ENABLED  Not enabled
- * @retval #BT_ERROR_OPERATION_FAILED Operation failed
+ * @retval #BT_ERROR_NOT_IN_PROGRESS  The tracking is not running
  *
- * @pre The state of local Bluetooth must be #BT_ADAPTER_ENABLED with bt_adapter_enable().
- * @post bt_adapter_name_changed_cb() will be invoked if this function returns #BT_ERROR_NONE.
+ * @pre The tracking must be started with bt_proximity_start().
  *
- * @see bt_adapter_enable()
- * @see bt_adapter_get_name()
- * @see bt_adapter_name_changed_cb()
- * @see bt_adapter_set_name_changed_cb()
- * @see bt_adapter_unset_name_changed_cb()
+ * @see bt_proximity_get_device()
  */
-int bt_adapter_set_name(const char *local_name);
+int bt_proximity_get_top_n(int n, bt_proximity_device_s *devices, int *count);
 
 /**
  * @ingroup CAPI_NETWORK_BLUETOOTH_ADAPTER_MODULE
- * @brief Gets the visibility mode of local Bluetooth adapter.
+ * @brief Gets a tracked device, and optionally its last RSSI samples.
  *
- * @param[out] mode	The visibility mode of the Bluetooth device
+ * @param[in] remote_address The address of the device
+ * @param[out] device The device
+ * @param[out] history The array of the RSSI samples to fill, oldest first, NULL if @a history_size is 0
+ * @param[in] history_size The largest number of samples to get
+ * @param[out] history_count The number of samples filled, NULL if @a history_size is 0
  *
  * @return 0 on success, otherwise a negative error value.
  * @retval #BT_ERROR_NONE  Successful
  * @retval #BT_ERROR_NOT_INITIALIZED  Not initialized
  * @retval #BT_ERROR_INVALID_PARAMETER  Invalid parameter
- * @retval #BT_ERROR_NOT_ENABLED  Not enabled
- * @retval #BT_ERROR_OPERATION_FAILED  Operation failed
+ * @retval #BT_ERROR_OUT_OF_MEMORY  Out of memory
+ * @retval #BT_ERROR_NOT_IN_PROGRESS  The tracking is not running
+ * @retval #BT_ERROR_REMOTE_DEVICE_NOT_FOUND  The device is not tracked
  *
- * @pre The state of local Bluetooth must be #BT_ADAPTER_ENABLED with bt_adapter_enable().
+ * @pre The tracking must be started with bt_proximity_start().
  *
- * @see bt_adapter_enable()
- * @see bt_adapter_set_visibility()
+ * @see bt_proximity_get_top_n()
  */
-int bt_adapter_get_visibility(bt_adapter_visibility_mode_e *mode);
+int bt_proximity_get_device(const char *remote_address, bt_proximity_device_s *device,
+		int *history, int history_size, int *history_count);
 
 /**
  * @ingroup CAPI_NETWORK_BLUETOOTH_ADAPTER_MODULE
- * @brief Sets the visibility mode.
+ * @brief Adds a proximity threshold, whose crossings by the tracked devices are reported.
  *
- * @remarks #BT_ADAPTER_VISIBILITY_MODE_LIMITED_DISCOVERABLE will change to #BT_ADAPTER_VISIBILITY_MODE_NON_DISCOVERABLE
- * after the given @a timeout_sec goes.
+ * @details A device comes near when its smoothed RSSI reaches @a rssi, and goes away when it falls
+ * below @a rssi minus @a hysteresis, or when it is forgotten.
  *
- * @param[in] discoverable_mode The Bluetooth discoverable mode to set
- * @param[in] timeout_sec The discoverable time duration (in seconds)
- *					@a timeout_sec is used only for #BT_ADAPTER_VISIBILITY_MODE_LIMITED_DISCOVERABLE mode.
+ * @remarks At most 32 thresholds can be added. The callback is invoked in the thread which
+ * delivers the Bluetooth events, or in the thread of bt_proximity_get_top_n() for a forgotten device.
+ *
+ * @param[in] rssi The RSSI of the threshold, in dBm
+ * @param[in] hysteresis The margin below @a rssi before a near device goes away, in dB
+ * @param[in] callback The callback function invoked for the crossings
+ * @param[in] user_data The user data passed to the callback function
+ * @param[out] threshold_id The identifier of the threshold, used to remove it
  *
  * @return 0 on success, otherwise a negative error value.
  * @retval #BT_ERROR_NONE  Successful
  * @retval #BT_ERROR_NOT_INITIALIZED  Not initialized
- * @retval #BT_ERROR_NOT_ENABLED  Not enabled
  * @retval #BT_ERROR_INVALID_PARAMETER  Invalid parameter
- * @retval #BT_ERROR_OPERATION_FAILED  Operation failed
- *
- * @pre The state of local Bluetooth must be #BT_ADAPTER_ENABLED with bt_adapter_enable().
- * @post bt_adapter_visibility_mode_changed_cb() will be invoked if this function returns #BT_ERROR_NONE.
+ * @retval #BT_ERROR_RESOURCE_BUSY  No more threshold can be added
  *
- * @see bt_adapter_enable()
- * @see bt_adapter_get_visibility()
- * @see bt_adapter_visibility_mode_changed_cb()
- * @see bt_adapter_set_visibility_mode_changed_cb()
- * @see bt_adapter_unset_visibility_mode_changed_cb()
+ * @see bt_proximity_remove_threshold()
+ * @see bt_proximity_threshold_crossed_cb()
  */
-int bt_adapter_set_visibility(bt_adapter_visibility_mode_e discoverable_mode, int timeout_sec);
+int bt_proximity_add_threshold(int rssi, int hysteresis, bt_proximity_threshold_crossed_cb callback,
+		void *user_data, int *threshold_id);
 
 /**
  * @ingroup CAPI_NETWORK_BLUETOOTH_ADAPTER_MODULE
- * @brief Starts the device discovery, asynchronously.
- *
- * @details If a device is discovered, bt_adapter_device_discovery_state_changed_cb() will be invoked
- * with #BT_ADAPTER_DEVICE_DISCOVERY_FOUND, and then bt_adapter_device_discovery_state_changed_cb()
- * will be called with #BT_ADAPTER_DEVICE_DISCOVERY_FINISHED in case of the completion or cancellation of the discovery.
+ * @brief Removes a proximity threshold.
  *
- * @remarks To connect to peer Bluetooth device, you need to know its Bluetooth address. \n
- * The device discovery can be stopped by bt_adapter_stop_device_discovery().
+ * @param[in] threshold_id The identifier of the threshold
  *
  * @return 0 on success, otherwise a negative error value.
  * @retval #BT_ERROR_NONE  Successful
  * @retval #BT_ERROR_NOT_INITIALIZED  Not initialized
- * @retval #BT_ERROR_NOT_ENABLED  Not enabled
- * @retval #BT_ERROR_NOW_IN_PROGRESS  Operation is now in progress
- * @retval #BT_ERROR_OPERATION_FAILED  Operation failed
+ * @retval #BT_ERROR_INVALID_PARAMETER  The threshold does not exist
  *
- * @pre The state of local Bluetooth must be #BT_ADAPTER_ENABLED with bt_adapter_enable().
- * @post This function invokes bt_adapter_device_discovery_state_changed_cb().
- *
- * @see bt_adapter_enable()
- * @see bt_adapter_is_discovering()
- * @see bt_adapter_stop_device_discovery()
- * @see bt_adapter_device_discovery_state_changed_cb()
- * @see bt_adapter_set_device_discovery_state_changed_cb()
- * @see bt_adapter_unset_device_discovery_state_changed_cb()
+ * @see bt_proximity_add_threshold()
  */
-int bt_adapter_start_device_discovery(void);
+int bt_proximity_remove_threshold(int threshold_id);
 
 /**
  * @ingroup CAPI_NETWORK_BLUETOOTH_ADAPTER_MODULE
@@ -946,6 +2203,9 @@ int bt_adapter_is_discovering(bool *is_discovering);
  * @ingroup CAPI_NETWORK_BLUETOOTH_ADAPTER_MODULE
  * @brief Retrieves the device information of all bonded devices.
  *
+ * @details The bonded devices are read from the Bluetooth F/W by the first call only,
+ * then kept current by the Bluetooth events. See bt_adapter_refresh_bonded_device_cache().
+ *
  * @param [in] callback The callback function to invoke
  * @param [in] user_data The user data passed from the foreach function
  *
@@ -968,7 +2228,8 @@ int bt_adapter_foreach_bonded_device(bt_adapter_bonded_device_cb callback, void
 /**
  * @ingroup CAPI_NETWORK_BLUETOOTH_ADAPTER_MODULE
  * @brief Gets the device information of a bonded device.
- * @remarks The @a device_info must be released with bt_adapter_free_device_info() by you .
+ * @remarks The @a device_info must be released with bt_adapter_free_device_info() by you . \n
+ * Its members are stored in the same memory block, so they must not be freed separately.
  *
  * @param [in] remote_address The address of remote device
  * @param [out] device_info The bonded device information
@@ -1004,6 +2265,160 @@ int bt_adapter_get_bonded_device_info(const char *remote_address, bt_device_info
  */
 int bt_adapter_free_device_info(bt_device_info_s *device_info);
 
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_ADAPTER_MODULE
+ * @brief Reads the bonded devices from the Bluetooth F/W again.
+ *
+ * @details bt_adapter_foreach_bonded_device() and bt_adapter_get_bonded_device_info() are answered
+ * from a cache kept current by the Bluetooth events. This function is needed only if the bonded
+ * devices were changed without an event, for example by another process while it was not running.
+ *
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #BT_ERROR_NONE  Successful
+ * @retval #BT_ERROR_NOT_INITIALIZED  Not initialized
+ * @retval #BT_ERROR_OUT_OF_MEMORY  Out of memory
+ * @retval #BT_ERROR_NOT_ENABLED  Not enabled
+ * @retval #BT_ERROR_OPERATION_FAILED  Operation failed
+ *
+ * @pre The state of local Bluetooth must be #BT_ADAPTER_ENABLED with bt_adapter_enable().
+ *
+ * @see bt_adapter_foreach_bonded_device()
+ * @see bt_adapter_get_bonded_device_cache_stats()
+ */
+int bt_adapter_refresh_bonded_device_cache(void);
+
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_ADAPTER_MODULE
+ * @brief Gets the statistics of the bonded device cache.
+ *
+ * @param[out] stats  The statistics, reset by the last bt_deinitialize()
+ *
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #BT_ERROR_NONE  Successful
+ * @retval #BT_ERROR_NOT_INITIALIZED  Not initialized
+ * @retval #BT_ERROR_INVALID_PARAMETER  Invalid parameter
+ *
+ * @see bt_adapter_refresh_bonded_device_cache()
+ */
+int bt_adapter_get_bonded_device_cache_stats(bt_adapter_bonded_device_cache_stats_s *stats);
+
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_ADAPTER_MODULE
+ * @brief Checks whether a discovered device has a well-known service.
+ *
+ * @details The services are kept as a bitmask when the device is discovered, so no UUID string is compared.
+ *
+ * @param[in] discovery_info  The device discovery information passed to bt_adapter_device_discovery_state_changed_cb()
+ * @param[in] service  The service
+ * @param[out] has_service  true if the device has the service
+ *
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #BT_ERROR_NONE  Successful
+ * @retval #BT_ERROR_INVALID_PARAMETER  Invalid parameter
+ *
+ * @pre @a discovery_info must be given by the Bluetooth API, not built by the application.
+ *
+ * @see bt_adapter_device_discovery_state_changed_cb()
+ */
+int bt_adapter_device_discovery_info_has_service(const bt_adapter_device_discovery_info_s *discovery_info,
+		bt_service_e service, bool *has_service);
+
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_ADAPTER_MODULE
+ * @brief Retrieves the devices found by the device discoveries, which were found within the time to live.
+ *
+ * @details Each device found by a discovery is cached with the time it was last found,
+ * so the devices around can be queried without starting a new discovery.
+ *
+ * @param[in] foreach_cb The callback function to invoke
+ * @param[in] user_data The user data passed from the foreach function
+ *
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #BT_ERROR_NONE  Successful
+ * @retval #BT_ERROR_NOT_INITIALIZED  Not initialized
+ * @retval #BT_ERROR_INVALID_PARAMETER  Invalid parameter
+ * @retval #BT_ERROR_OUT_OF_MEMORY  Out of memory
+ *
+ * @post This function invokes bt_adapter_discovered_device_cb().
+ *
+ * @see bt_adapter_discovered_device_cb()
+ * @see bt_adapter_set_discovered_device_ttl()
+ * @see bt_adapter_start_device_discovery()
+ */
+int bt_adapter_foreach_discovered_device(bt_adapter_discovered_device_cb foreach_cb, void *user_data);
+
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_ADAPTER_MODULE
+ * @brief Gets the information of a discovered device, as it was last found.
+ * @remarks The @a discovery_info must be released with bt_adapter_free_discovered_device_info() by you. \n
+ * Its members are stored in the same memory block, so they must not be freed separately.
+ *
+ * @param[in] remote_address The address of remote device
+ * @param[out] discovery_info The information of the discovered device
+ * @param[out] age The time since the device was last found, in milliseconds. It can be NULL.
+ *
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #BT_ERROR_NONE  Successful
+ * @retval #BT_ERROR_NOT_INITIALIZED  Not initialized
+ * @retval #BT_ERROR_INVALID_PARAMETER  Invalid parameter
+ * @retval #BT_ERROR_OUT_OF_MEMORY  Out of memory
+ * @retval #BT_ERROR_REMOTE_DEVICE_NOT_FOUND  Remote device not found within the time to live
+ *
+ * @see bt_adapter_free_discovered_device_info()
+ * @see bt_adapter_foreach_discovered_device()
+ */
+int bt_adapter_get_discovered_device_info(const char *remote_address,
+		bt_adapter_device_discovery_info_s **discovery_info, int *age);
+
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_ADAPTER_MODULE
+ * @brief Frees the information of a discovered device.
+ *
+ * @param[in] discovery_info The information given by bt_adapter_get_discovered_device_info()
+ *
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #BT_ERROR_NONE  Successful
+ * @retval #BT_ERROR_NOT_INITIALIZED  Not initialized
+ * @retval #BT_ERROR_INVALID_PARAMETER  Invalid parameter
+ *
+ * @see bt_adapter_get_discovered_device_info()
+ */
+int bt_adapter_free_discovered_device_info(bt_adapter_device_discovery_info_s *discovery_info);
+
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_ADAPTER_MODULE
+ * @brief Sets the time to live of the discovered devices.
+ *
+ * @details A device which has not been found again within the time to live is removed from the cache.
+ * The default is 60 seconds.
+ *
+ * @param[in] ttl The time to live in seconds, or 0 to disable the cache and remove its devices
+ *
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #BT_ERROR_NONE  Successful
+ * @retval #BT_ERROR_NOT_INITIALIZED  Not initialized
+ * @retval #BT_ERROR_INVALID_PARAMETER  Invalid parameter
+ *
+ * @see bt_adapter_get_discovered_device_ttl()
+ * @see bt_adapter_foreach_discovered_device()
+ */
+int bt_adapter_set_discovered_device_ttl(int ttl);
+
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_ADAPTER_MODULE
+ * @brief Gets the time to live of the discovered devices.
+ *
+ * @param[out] ttl The time to live in seconds, 0 if the cache is disabled
+ *
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #BT_ERROR_NONE  Successful
+ * @retval #BT_ERROR_NOT_INITIALIZED  Not initialized
+ * @retval #BT_ERROR_INVALID_PARAMETER  Invalid parameter
+ *
+ * @see bt_adapter_set_discovered_device_ttl()
+ */
+int bt_adapter_get_discovered_device_ttl(int *ttl);
+
 /**
  * @ingroup CAPI_NETWORK_BLUETOOTH_ADAPTER_MODULE
  * @brief Checks whether the UUID of service is used or not
@@ -1198,6 +2613,56 @@ int bt_adapter_unset_device_discovery_state_changed_cb(void);
  */
 int bt_device_create_bond(const char *remote_address);
 
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_DEVICE_MODULE
+ * @brief Creates a bond with a remote Bluetooth device given by its binary address, asynchronously.
+ *
+ * @details Same as bt_device_create_bond(), without formatting and parsing the address.
+ *
+ * @param[in] remote_addr The binary address of the remote Bluetooth device
+ *
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #BT_ERROR_NONE  Successful
+ * @retval #BT_ERROR_NOT_INITIALIZED  Not initialized
+ * @retval #BT_ERROR_INVALID_PARAMETER  Invalid parameter
+ * @retval #BT_ERROR_NOT_ENABLED  Not enabled
+ * @retval #BT_ERROR_RESOURCE_BUSY  Device or resource busy
+ * @retval #BT_ERROR_OPERATION_FAILED  Operation failed
+ *
+ * @see bt_device_create_bond()
+ */
+int bt_device_create_bond_by_addr(const bt_addr_t *remote_addr);
+
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_DEVICE_MODULE
+ * @brief Creates a bond with a remote Bluetooth device, and reports the result to its own callback.
+ *
+ * @details Same as bt_device_create_bond(), completed by the bonding result of @a remote_address.
+ * Cancelling the operation cancels the bonding, like bt_device_cancel_bonding().
+ *
+ * @param[in] remote_address The address of the remote Bluetooth device
+ * @param[in] timeout_ms  The deadline in milliseconds, after which @a callback is invoked with #BT_ERROR_TIMED_OUT, or 0 for none
+ * @param[in] callback  The callback function invoked when the operation completes
+ * @param[in] user_data  The user data passed to the callback function
+ * @param[out] operation_id  The identifier of the operation, for bt_operation_cancel()
+ *
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #BT_ERROR_NONE  Successful
+ * @retval #BT_ERROR_NOT_INITIALIZED  Not initialized
+ * @retval #BT_ERROR_INVALID_PARAMETER  Invalid parameter
+ * @retval #BT_ERROR_OUT_OF_MEMORY  Out of memory
+ * @retval #BT_ERROR_NOT_ENABLED  Not enabled
+ * @retval #BT_ERROR_RESOURCE_BUSY  Device or resource busy
+ * @retval #BT_ERROR_OPERATION_FAILED  Operation failed
+ *
+ * @post This function invokes bt_operation_completed_cb().
+ *
+ * @see bt_device_create_bond()
+ * @see bt_operation_cancel()
+ */
+int bt_device_create_bond_async(const char *remote_address, int timeout_ms,
+		bt_operation_completed_cb callback, void *user_data, int *operation_id);
+
 /**
  * @ingroup CAPI_NETWORK_BLUETOOTH_DEVICE_MODULE
  * @brief Cancels the bonding process.
@@ -1217,40 +2682,86 @@ int bt_device_create_bond(const char *remote_address);
  * @see bt_device_set_bond_created_cb()
  * @see bt_device_unset_bond_created_cb()
  */
-int bt_device_cancel_bonding(void);
+int bt_device_cancel_bonding(void);
+
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_DEVICE_MODULE
+ * @brief Destroys the bond, asynchronously.
+ *
+ * @param[in] remote_address The address of the remote Bluetooth device to remove bonding
+ *
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #BT_ERROR_NONE  Successful
+ * @retval #BT_ERROR_NOT_INITIALIZED  Not initialized
+ * @retval #BT_ERROR_INVALID_PARAMETER  Invalid parameter
+ * @retval #BT_ERROR_NOT_ENABLED  Not enabled
+ * @retval #BT_ERROR_RESOURCE_BUSY  Device or resource busy
+ * @retval #BT_ERROR_REMOTE_DEVICE_NOT_BONDED  Remote device not bonded
+ * @retval #BT_ERROR_OPERATION_FAILED  Operation failed
+ *
+ * @pre The state of local Bluetooth must be #BT_ADAPTER_ENABLED with bt_adapter_enable().
+ * @pre The bond with the remote device must be created with bt_device_create_bond().
+ * @post This function invokes bt_device_bond_destroyed_cb().
+ *
+ * @see bt_adapter_enable()
+ * @see bt_device_create_bond()
+ * @see bt_device_bond_destroyed_cb()
+ * @see bt_device_set_bond_destroyed_cb()
+ * @see bt_device_unset_bond_destroyed_cb()
+ */
+int bt_device_destroy_bond(const char *remote_address);
+
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_DEVICE_MODULE
+ * @brief Destroys the bond with a remote device given by its binary address, asynchronously.
+ *
+ * @details Same as bt_device_destroy_bond(), without formatting and parsing the address.
+ *
+ * @param[in] remote_addr The binary address of the remote Bluetooth device
+ *
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #BT_ERROR_NONE  Successful
+ * @retval #BT_ERROR_NOT_INITIALIZED  Not initialized
+ * @retval #BT_ERROR_INVALID_PARAMETER  Invalid parameter
+ * @retval #BT_ERROR_NOT_ENABLED  Not enabled
+ * @retval #BT_ERROR_RESOURCE_BUSY  Device or resource busy
+ * @retval #BT_ERROR_REMOTE_DEVICE_NOT_BONDED  Remote device not bonded
+ * @retval #BT_ERROR_OPERATION_FAILED  Operation failed
+ *
+ * @see bt_device_destroy_bond()
+ */
+int bt_device_destroy_bond_by_addr(const bt_addr_t *remote_addr);
 
 /**
  * @ingroup CAPI_NETWORK_BLUETOOTH_DEVICE_MODULE
- * @brief Destroys the bond, asynchronously.
+ * @brief Sets an alias for the bonded device.
  *
- * @param[in] remote_address The address of the remote Bluetooth device to remove bonding
+ * @param[in] remote_address The address of the remote Bluetooth device
+ * @param[in] alias The alias of the remote Bluetooth device
  *
  * @return 0 on success, otherwise a negative error value.
  * @retval #BT_ERROR_NONE  Successful
  * @retval #BT_ERROR_NOT_INITIALIZED  Not initialized
  * @retval #BT_ERROR_INVALID_PARAMETER  Invalid parameter
  * @retval #BT_ERROR_NOT_ENABLED  Not enabled
- * @retval #BT_ERROR_RESOURCE_BUSY  Device or resource busy
  * @retval #BT_ERROR_REMOTE_DEVICE_NOT_BONDED  Remote device not bonded
  * @retval #BT_ERROR_OPERATION_FAILED  Operation failed
  *
  * @pre The state of local Bluetooth must be #BT_ADAPTER_ENABLED with bt_adapter_enable().
  * @pre The bond with the remote device must be created with bt_device_create_bond().
- * @post This function invokes bt_device_bond_destroyed_cb().
  *
  * @see bt_adapter_enable()
  * @see bt_device_create_bond()
- * @see bt_device_bond_destroyed_cb()
- * @see bt_device_set_bond_destroyed_cb()
- * @see bt_device_unset_bond_destroyed_cb()
  */
-int bt_device_destroy_bond(const char *remote_address);
+int bt_device_set_alias(const char *remote_address, const char *alias);
 
 /**
  * @ingroup CAPI_NETWORK_BLUETOOTH_DEVICE_MODULE
- * @brief Sets an alias for the bonded device.
+ * @brief Sets an alias for a bonded device given by its binary address.
  *
- * @param[in] remote_address The address of the remote Bluetooth device
+ * @details Same as bt_device_set_alias(), without formatting and parsing the address.
+ *
+ * @param[in] remote_addr The binary address of the remote Bluetooth device
  * @param[in] alias The alias of the remote Bluetooth device
  *
  * @return 0 on success, otherwise a negative error value.
@@ -1261,13 +2772,9 @@ int bt_device_destroy_bond(const char *remote_address);
  * @retval #BT_ERROR_REMOTE_DEVICE_NOT_BONDED  Remote device not bonded
  * @retval #BT_ERROR_OPERATION_FAILED  Operation failed
  *
- * @pre The state of local Bluetooth must be #BT_ADAPTER_ENABLED with bt_adapter_enable().
- * @pre The bond with the remote device must be created with bt_device_create_bond().
- *
- * @see bt_adapter_enable()
- * @see bt_device_create_bond()
+ * @see bt_device_set_alias()
  */
-int bt_device_set_alias(const char *remote_address, const char *alias);
+int bt_device_set_alias_by_addr(const bt_addr_t *remote_addr, const char *alias);
 
 /**
  * @ingroup CAPI_NETWORK_BLUETOOTH_DEVICE_MODULE
@@ -1298,6 +2805,27 @@ int bt_device_set_alias(const char *remote_address, const char *alias);
  */
 int bt_device_set_authorization(const char *remote_address, bt_device_authorization_e authorization_state);
 
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_DEVICE_MODULE
+ * @brief Sets the authorization of a bonded device given by its binary address, asynchronously.
+ *
+ * @details Same as bt_device_set_authorization(), without formatting and parsing the address.
+ *
+ * @param[in] remote_addr The binary address of the remote Bluetooth device
+ * @param[in] authorization The Bluetooth authorization state
+ *
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #BT_ERROR_NONE  Successful
+ * @retval #BT_ERROR_NOT_INITIALIZED  Not initialized
+ * @retval #BT_ERROR_INVALID_PARAMETER  Invalid parameter
+ * @retval #BT_ERROR_NOT_ENABLED  Not enabled
+ * @retval #BT_ERROR_REMOTE_DEVICE_NOT_BONDED  Remote device not bonded
+ * @retval #BT_ERROR_OPERATION_FAILED  Operation failed
+ *
+ * @see bt_device_set_authorization()
+ */
+int bt_device_set_authorization_by_addr(const bt_addr_t *remote_addr, bt_device_authorization_e authorization_state);
+
 /**
  * @ingroup CAPI_NETWORK_BLUETOOTH_DEVICE_MODULE
  * @brief Starts the search for services supported by the specified device, asynchronously.
@@ -1333,6 +2861,56 @@ int bt_device_set_authorization(const char *remote_address, bt_device_authorizat
  */
 int bt_device_start_service_search(const char *remote_address);
 
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_DEVICE_MODULE
+ * @brief Starts the search for services supported by a device given by its binary address, asynchronously.
+ *
+ * @details Same as bt_device_start_service_search(), without formatting and parsing the address.
+ *
+ * @param[in] remote_addr The binary address of the remote Bluetooth device
+ *
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #BT_ERROR_NONE  Successful
+ * @retval #BT_ERROR_NOT_INITIALIZED  Not initialized
+ * @retval #BT_ERROR_INVALID_PARAMETER  Invalid parameter
+ * @retval #BT_ERROR_NOT_ENABLED  Not enabled
+ * @retval #BT_ERROR_REMOTE_DEVICE_NOT_BONDED  Remote device not bonded
+ * @retval #BT_ERROR_SERVICE_SEARCH_FAILED  Service search failed
+ *
+ * @see bt_device_start_service_search()
+ */
+int bt_device_start_service_search_by_addr(const bt_addr_t *remote_addr);
+
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_DEVICE_MODULE
+ * @brief Starts the search for services of a remote device, and reports the result to its own callback.
+ *
+ * @details Same as bt_device_start_service_search(), completed by the search result of @a remote_address.
+ * Cancelling the operation cancels the search, like bt_device_cancel_service_search().
+ *
+ * @param[in] remote_address The address of the remote Bluetooth device
+ * @param[in] timeout_ms  The deadline in milliseconds, after which @a callback is invoked with #BT_ERROR_TIMED_OUT, or 0 for none
+ * @param[in] callback  The callback function invoked when the operation completes
+ * @param[in] user_data  The user data passed to the callback function
+ * @param[out] operation_id  The identifier of the operation, for bt_operation_cancel()
+ *
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #BT_ERROR_NONE  Successful
+ * @retval #BT_ERROR_NOT_INITIALIZED  Not initialized
+ * @retval #BT_ERROR_INVALID_PARAMETER  Invalid parameter
+ * @retval #BT_ERROR_OUT_OF_MEMORY  Out of memory
+ * @retval #BT_ERROR_NOT_ENABLED  Not enabled
+ * @retval #BT_ERROR_REMOTE_DEVICE_NOT_BONDED  Remote device not bonded
+ * @retval #BT_ERROR_SERVICE_SEARCH_FAILED  Service search failed
+ *
+ * @post This function invokes bt_operation_completed_cb().
+ *
+ * @see bt_device_start_service_search()
+ * @see bt_operation_cancel()
+ */
+int bt_device_start_service_search_async(const char *remote_address, int timeout_ms,
+		bt_operation_completed_cb callback, void *user_data, int *operation_id);
+
 /**
  * @ingroup CAPI_NETWORK_BLUETOOTH_DEVICE_MODULE
  * @brief Cancels service search process.
@@ -1354,6 +2932,162 @@ int bt_device_start_service_search(const char *remote_address);
  */
 int bt_device_cancel_service_search(void);
 
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_DEVICE_MODULE
+ * @brief Queues a search for services of a remote device.
+ *
+ * @details The Bluetooth F/W runs one service search at a time. The queued searches are started
+ * one after the other, each as soon as the result of the previous one arrives, instead of failing
+ * with #BT_ERROR_NOW_IN_PROGRESS. A request for a device which is already queued or being searched
+ * joins that search, and its callback is invoked with the same result.
+ *
+ * @remarks The callback is invoked once, with @a sdp_info holding at least the address of the device,
+ * even on failure. The callback of bt_device_set_service_searched_cb() is invoked as well. \n
+ * The requests still queued are cancelled by the last bt_deinitialize(), and fail with
+ * #BT_ERROR_NOT_ENABLED when the adapter is disabled. bt_device_cancel_service_search() cancels the
+ * running search only.
+ *
+ * @param[in] remote_address The address of the remote Bluetooth device
+ * @param[in] callback The callback function invoked with the result of the search
+ * @param[in] user_data The user data passed to the callback function
+ *
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #BT_ERROR_NONE  Successful
+ * @retval #BT_ERROR_NOT_INITIALIZED  Not initialized
+ * @retval #BT_ERROR_INVALID_PARAMETER  Invalid parameter
+ * @retval #BT_ERROR_OUT_OF_MEMORY  Out of memory
+ *
+ * @post This function invokes bt_device_service_searched_cb().
+ *
+ * @see bt_device_start_service_search()
+ * @see bt_device_get_service_search_queue_stats()
+ * @see bt_device_queue_service_search_with_mode()
+ */
+int bt_device_queue_service_search(const char *remote_address, bt_device_service_searched_cb callback, void *user_data);
+
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_DEVICE_MODULE
+ * @brief Gets the statistics of the service search queue.
+ *
+ * @param[out] stats  The statistics, reset by the last bt_deinitialize()
+ *
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #BT_ERROR_NONE  Successful
+ * @retval #BT_ERROR_NOT_INITIALIZED  Not initialized
+ * @retval #BT_ERROR_INVALID_PARAMETER  Invalid parameter
+ *
+ * @see bt_device_queue_service_search()
+ */
+int bt_device_get_service_search_queue_stats(bt_device_service_search_queue_stats_s *stats);
+
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_DEVICE_MODULE
+ * @brief Queues a search for services of a remote device, unless its cached services are valid.
+ *
+ * @details With #BT_DEVICE_SERVICE_SEARCH_IF_STALE, the services found by the last search of the
+ * device are used if they are younger than the maximum age, so a reconnection does not repeat the
+ * search. Otherwise, it is the same as bt_device_queue_service_search().
+ *
+ * @remarks When the cached services are used, the callback is invoked before this function returns,
+ * and the callback of bt_device_set_service_searched_cb() is not invoked.
+ *
+ * @param[in] remote_address The address of the remote Bluetooth device
+ * @param[in] mode The search mode
+ * @param[in] callback The callback function invoked with the result of the search
+ * @param[in] user_data The user data passed to the callback function
+ *
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #BT_ERROR_NONE  Successful
+ * @retval #BT_ERROR_NOT_INITIALIZED  Not initialized
+ * @retval #BT_ERROR_INVALID_PARAMETER  Invalid parameter
+ * @retval #BT_ERROR_OUT_OF_MEMORY  Out of memory
+ *
+ * @post This function invokes bt_device_service_searched_cb().
+ *
+ * @see bt_device_queue_service_search()
+ * @see bt_device_get_cached_services()
+ * @see bt_device_set_cached_services_max_age()
+ */
+int bt_device_queue_service_search_with_mode(const char *remote_address, bt_device_service_search_mode_e mode,
+		bt_device_service_searched_cb callback, void *user_data);
+
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_DEVICE_MODULE
+ * @brief Gets the services found by the last successful search of a remote device.
+ *
+ * @details The results of the service searches are kept in a file of the user cache directory, which
+ * is mapped by bt_initialize(), so they are still available after a restart. The services of a device
+ * are forgotten when its bond is removed.
+ *
+ * @remarks The @a sdp_info must be released with bt_device_free_cached_services() by you. \n
+ * Its members are stored in the same memory block, so they must not be freed separately.
+ * The UUIDs which the F/W reported malformed are not cached.
+ *
+ * @param[in] remote_address The address of the remote Bluetooth device
+ * @param[out] sdp_info The cached services of the device
+ * @param[out] age The time since the services were searched, in seconds. It can be NULL.
+ *
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #BT_ERROR_NONE  Successful
+ * @retval #BT_ERROR_NOT_INITIALIZED  Not initialized
+ * @retval #BT_ERROR_INVALID_PARAMETER  Invalid parameter
+ * @retval #BT_ERROR_OUT_OF_MEMORY  Out of memory
+ * @retval #BT_ERROR_REMOTE_DEVICE_NOT_FOUND  No services cached, or older than the maximum age
+ *
+ * @see bt_device_free_cached_services()
+ * @see bt_device_set_cached_services_max_age()
+ */
+int bt_device_get_cached_services(const char *remote_address, bt_device_sdp_info_s **sdp_info, int *age);
+
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_DEVICE_MODULE
+ * @brief Frees the cached services of a remote device.
+ *
+ * @param[in] sdp_info The services given by bt_device_get_cached_services()
+ *
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #BT_ERROR_NONE  Successful
+ * @retval #BT_ERROR_NOT_INITIALIZED  Not initialized
+ * @retval #BT_ERROR_INVALID_PARAMETER  Invalid parameter
+ *
+ * @see bt_device_get_cached_services()
+ */
+int bt_device_free_cached_services(bt_device_sdp_info_s *sdp_info);
+
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_DEVICE_MODULE
+ * @brief Sets the maximum age of the cached services.
+ *
+ * @details The cached services older than the maximum age are stale: bt_device_get_cached_services()
+ * does not return them, and #BT_DEVICE_SERVICE_SEARCH_IF_STALE searches again. The default is 7 days.
+ *
+ * @param[in] max_age The maximum age in seconds, or 0 to never use the cached services
+ *
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #BT_ERROR_NONE  Successful
+ * @retval #BT_ERROR_NOT_INITIALIZED  Not initialized
+ * @retval #BT_ERROR_INVALID_PARAMETER  Invalid parameter
+ *
+ * @see bt_device_get_cached_services_max_age()
+ * @see bt_device_get_cached_services()
+ */
+int bt_device_set_cached_services_max_age(int max_age);
+
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_DEVICE_MODULE
+ * @brief Gets the maximum age of the cached services.
+ *
+ * @param[out] max_age The maximum age in seconds, 0 if the cached services are never used
+ *
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #BT_ERROR_NONE  Successful
+ * @retval #BT_ERROR_NOT_INITIALIZED  Not initialized
+ * @retval #BT_ERROR_INVALID_PARAMETER  Invalid parameter
+ *
+ * @see bt_device_set_cached_services_max_age()
+ */
+int bt_device_get_cached_services_max_age(int *max_age);
+
 /**
  * @ingroup CAPI_NETWORK_BLUETOOTH_DEVICE_MODULE
  * @brief  Registers a callback function to be invoked when the bond creates.
@@ -1440,36 +3174,173 @@ int bt_device_set_authorization_changed_cb(bt_device_authorization_changed_cb ca
  * @see bt_initialize()
  * @see bt_device_set_authorization_changed_cb()
  */
-int bt_device_unset_authorization_changed_cb(void);
+int bt_device_unset_authorization_changed_cb(void);
+
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_DEVICE_MODULE
+ * @brief  Registers a callback function to be invoked when the process of service search finishes.
+ * @param[in] callback The callback function to register
+ * @param[in] user_data The user data to be passed to the callback function
+ * @return   0 on success, otherwise a negative error value.
+ * @retval #BT_ERROR_NONE  Successful
+ * @retval #BT_ERROR_NOT_INITIALIZED  Not initialized
+ * @retval #BT_ERROR_INVALID_PARAMETER  Invalid parameter
+ * @pre The Bluetooth service must be initialized with bt_initialize().
+ * @post  bt_device_service_searched_cb() will be invoked.
+ * @see bt_initialize()
+ * @see bt_device_service_searched_cb()
+ * @see bt_device_unset_service_searched_cb()
+ */
+int bt_device_set_service_searched_cb(bt_device_service_searched_cb callback, void *user_data);
+
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_DEVICE_MODULE
+ * @brief	Unregisters the callback function.
+ * @return	0 on success, otherwise a negative error value.
+ * @retval #BT_ERROR_NONE  Successful
+ * @retval #BT_ERROR_NOT_INITIALIZED  Not initialized
+ * @pre The Bluetooth service must be initialized with bt_initialize().
+ * @see bt_initialize()
+ * @see bt_device_set_service_searched_cb()
+ */
+int bt_device_unset_service_searched_cb(void);
+
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_DEVICE_MODULE
+ * @brief Gets the address of the remote device.
+ * @remarks @a remote_address is valid until the callback which received @a device returns.
+ * @param[in] device  The view of the remote device
+ * @param[out] remote_address  The address of the remote device
+ * @return	0 on success, otherwise a negative error value.
+ * @retval #BT_ERROR_NONE  Successful
+ * @retval #BT_ERROR_INVALID_PARAMETER  Invalid parameter
+ * @see bt_event_subscribe_device_view()
+ */
+int bt_device_view_get_address(bt_device_view_h device, const char **remote_address);
+
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_DEVICE_MODULE
+ * @brief Gets the name of the remote device.
+ * @remarks @a remote_name is NULL if the name is unknown. It is valid until the callback which received @a device returns.
+ * @param[in] device  The view of the remote device
+ * @param[out] remote_name  The name of the remote device
+ * @return	0 on success, otherwise a negative error value.
+ * @retval #BT_ERROR_NONE  Successful
+ * @retval #BT_ERROR_INVALID_PARAMETER  Invalid parameter
+ * @see bt_event_subscribe_device_view()
+ */
+int bt_device_view_get_name(bt_device_view_h device, const char **remote_name);
+
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_DEVICE_MODULE
+ * @brief Gets the Bluetooth classes of the remote device.
+ * @param[in] device  The view of the remote device
+ * @param[out] bt_class  The Bluetooth classes
+ * @return	0 on success, otherwise a negative error value.
+ * @retval #BT_ERROR_NONE  Successful
+ * @retval #BT_ERROR_INVALID_PARAMETER  Invalid parameter
+ * @see bt_event_subscribe_device_view()
+ */
+int bt_device_view_get_class(bt_device_view_h device, bt_class_s *bt_class);
+
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_DEVICE_MODULE
+ * @brief Gets the strength indicator of the received signal of the remote device.
+ * @param[in] device  The view of the remote device
+ * @param[out] rssi  The strength indicator of the received signal
+ * @return	0 on success, otherwise a negative error value.
+ * @retval #BT_ERROR_NONE  Successful
+ * @retval #BT_ERROR_INVALID_PARAMETER  Invalid parameter
+ * @see bt_event_subscribe_device_view()
+ */
+int bt_device_view_get_rssi(bt_device_view_h device, int *rssi);
+
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_DEVICE_MODULE
+ * @brief Checks whether the remote device is bonded.
+ * @param[in] device  The view of the remote device
+ * @param[out] is_bonded  The bonding state
+ * @return	0 on success, otherwise a negative error value.
+ * @retval #BT_ERROR_NONE  Successful
+ * @retval #BT_ERROR_INVALID_PARAMETER  Invalid parameter
+ * @see bt_event_subscribe_device_view()
+ */
+int bt_device_view_is_bonded(bt_device_view_h device, bool *is_bonded);
+
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_DEVICE_MODULE
+ * @brief Gets the number of services of the remote device.
+ * @param[in] device  The view of the remote device
+ * @param[out] count  The number of services
+ * @return	0 on success, otherwise a negative error value.
+ * @retval #BT_ERROR_NONE  Successful
+ * @retval #BT_ERROR_INVALID_PARAMETER  Invalid parameter
+ * @see bt_device_view_get_service_uuid()
+ */
+int bt_device_view_get_service_count(bt_device_view_h device, int *count);
+
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_DEVICE_MODULE
+ * @brief Gets the UUID of a service of the remote device, in upper case.
+ * @remarks @a uuid is valid until this function is called again with @a device, or the callback which
+ * received @a device returns.
+ * @param[in] device  The view of the remote device
+ * @param[in] index  The index of the service, from 0 to the number of services - 1
+ * @param[out] uuid  The UUID of the service
+ * @return	0 on success, otherwise a negative error value.
+ * @retval #BT_ERROR_NONE  Successful
+ * @retval #BT_ERROR_INVALID_PARAMETER  Invalid parameter
+ * @see bt_device_view_get_service_count()
+ */
+int bt_device_view_get_service_uuid(bt_device_view_h device, int index, const char **uuid);
+
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_DEVICE_MODULE
+ * @brief Checks whether the remote device has a service, without converting its UUIDs.
+ * @param[in] device  The view of the remote device
+ * @param[in] uuid  The UUID of the service, in upper or lower case
+ * @param[out] has_uuid  true if the remote device has the service
+ * @return	0 on success, otherwise a negative error value.
+ * @retval #BT_ERROR_NONE  Successful
+ * @retval #BT_ERROR_INVALID_PARAMETER  Invalid parameter
+ * @see bt_device_view_get_service_uuid()
+ */
+int bt_device_view_has_service_uuid(bt_device_view_h device, const char *uuid, bool *has_uuid);
 
 /**
  * @ingroup CAPI_NETWORK_BLUETOOTH_DEVICE_MODULE
- * @brief  Registers a callback function to be invoked when the process of service search finishes.
- * @param[in] callback The callback function to register
- * @param[in] user_data The user data to be passed to the callback function
- * @return   0 on success, otherwise a negative error value.
+ * @brief Checks whether the remote device has a well-known service.
+ * @remarks The UUIDs are parsed once, on the first request.
+ * @param[in] device  The view of the remote device
+ * @param[in] service  The service
+ * @param[out] has_service  true if the remote device has the service
+ * @return	0 on success, otherwise a negative error value.
  * @retval #BT_ERROR_NONE  Successful
- * @retval #BT_ERROR_NOT_INITIALIZED  Not initialized
  * @retval #BT_ERROR_INVALID_PARAMETER  Invalid parameter
- * @pre The Bluetooth service must be initialized with bt_initialize().
- * @post  bt_device_service_searched_cb() will be invoked.
- * @see bt_initialize()
- * @see bt_device_service_searched_cb()
- * @see bt_device_unset_service_searched_cb()
+ * @see bt_device_view_has_service_uuid()
  */
-int bt_device_set_service_searched_cb(bt_device_service_searched_cb callback, void *user_data);
+int bt_device_view_has_service(bt_device_view_h device, bt_service_e service, bool *has_service);
 
 /**
  * @ingroup CAPI_NETWORK_BLUETOOTH_DEVICE_MODULE
- * @brief	Unregisters the callback function.
- * @return	0 on success, otherwise a negative error value.
+ * @brief Checks whether a device has a well-known service.
+ *
+ * @details The services are kept as a bitmask when the information is built, so no UUID string is compared.
+ *
+ * @param[in] device_info  The device information, from bt_adapter_get_bonded_device_info(),
+ * bt_adapter_bonded_device_cb() or bt_device_bond_created_cb()
+ * @param[in] service  The service
+ * @param[out] has_service  true if the device has the service
+ *
+ * @return 0 on success, otherwise a negative error value.
  * @retval #BT_ERROR_NONE  Successful
- * @retval #BT_ERROR_NOT_INITIALIZED  Not initialized
- * @pre The Bluetooth service must be initialized with bt_initialize().
- * @see bt_initialize()
- * @see bt_device_set_service_searched_cb()
+ * @retval #BT_ERROR_INVALID_PARAMETER  Invalid parameter
+ *
+ * @pre @a device_info must be given by the Bluetooth API, not built by the application.
+ *
+ * @see bt_adapter_get_bonded_device_info()
  */
-int bt_device_unset_service_searched_cb(void);
+int bt_device_info_has_service(const bt_device_info_s *device_info, bt_service_e service, bool *has_service);
 
 /**
  * @ingroup CAPI_NETWORK_BLUETOOTH_SOCKET_MODULE
@@ -1654,6 +3525,57 @@ int bt_socket_reject(int socket_fd);
  */
 int bt_socket_connect_rfcomm(const char *remote_address, const char *service_uuid);
 
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_SOCKET_MODULE
+ * @brief Connects to a specific RFCOMM based service on a remote device given by its binary address, asynchronously.
+ *
+ * @details Same as bt_socket_connect_rfcomm(), without formatting and parsing the address.
+ *
+ * @param[in] remote_addr The binary address of the remote Bluetooth device
+ * @param[in] service_uuid The UUID of service provided by the remote Bluetooth device
+ *
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #BT_ERROR_NONE  Successful
+ * @retval #BT_ERROR_NOT_INITIALIZED  Not initialized
+ * @retval #BT_ERROR_INVALID_PARAMETER  Invalid parameter
+ * @retval #BT_ERROR_NOT_ENABLED  Not enabled
+ * @retval #BT_ERROR_REMOTE_DEVICE_NOT_BONDED  Remote device not bonded
+ * @retval #BT_ERROR_OPERATION_FAILED  Operation failed
+ *
+ * @see bt_socket_connect_rfcomm()
+ */
+int bt_socket_connect_rfcomm_by_addr(const bt_addr_t *remote_addr, const char *service_uuid);
+
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_SOCKET_MODULE
+ * @brief Connects to a specific RFCOMM based service on a remote Bluetooth device, and reports
+ * the result to its own callback.
+ *
+ * @details Same as bt_socket_connect_rfcomm(), completed by the next connection result of @a remote_address.
+ *
+ * @param[in] remote_address The address of the remote Bluetooth device
+ * @param[in] service_uuid The UUID of service provided by the remote Bluetooth device
+ * @param[in] timeout_ms  The deadline in milliseconds, after which @a callback is invoked with #BT_ERROR_TIMED_OUT, or 0 for none
+ * @param[in] callback  The callback function invoked when the operation completes
+ * @param[in] user_data  The user data passed to the callback function
+ * @param[out] operation_id  The identifier of the operation, for bt_operation_cancel()
+ *
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #BT_ERROR_NONE  Successful
+ * @retval #BT_ERROR_NOT_INITIALIZED  Not initialized
+ * @retval #BT_ERROR_INVALID_PARAMETER  Invalid parameter
+ * @retval #BT_ERROR_OUT_OF_MEMORY  Out of memory
+ * @retval #BT_ERROR_NOT_ENABLED  Not enabled
+ * @retval #BT_ERROR_OPERATION_FAILED  Operation failed
+ *
+ * @post This function invokes bt_operation_completed_cb().
+ *
+ * @see bt_socket_connect_rfcomm()
+ * @see bt_operation_cancel()
+ */
+int bt_socket_connect_rfcomm_async(const char *remote_address, const char *service_uuid, int timeout_ms,
+		bt_operation_completed_cb callback, void *user_data, int *operation_id);
+
 /**
  * @ingroup CAPI_NETWORK_BLUETOOTH_SOCKET_MODULE
  * @brief Disconnects the RFCOMM connection with the given file descriptor of conneted socket.
@@ -2067,6 +3989,31 @@ typedef void (*bt_opp_client_push_finished_cb)(int result, const char *remote_ad
 int bt_opp_client_push_files(const char *remote_address, bt_opp_client_push_responded_cb responded_cb,
  bt_opp_client_push_progress_cb progress_cb, bt_opp_client_push_finished_cb finished_cb, void *user_data);
 
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_OPP_CLIENT_MODULE
+ * @brief Pushes the files to a remote device given by its binary address, asynchronously.
+ *
+ * @details Same as bt_opp_client_push_files(), without formatting and parsing the address.
+ *
+ * @param[in] remote_addr The binary address of the remote Bluetooth device
+ * @param[in] responded_cb  The callback called when OPP server responds to the push request
+ * @param[in] progress_cb  The callback called when each file is being transfered
+ * @param[in] finished_cb  The callback called when the push request is finished
+ * @param[in] user_data The user data to be passed to the callback function
+ *
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #BT_ERROR_NONE  Successful
+ * @retval #BT_ERROR_NOT_INITIALIZED  Not initialized
+ * @retval #BT_ERROR_NOT_ENABLED  Not enabled
+ * @retval #BT_ERROR_INVALID_PARAMETER  Invalid parameter
+ * @retval #BT_ERROR_OPERATION_FAILED  Operation failed
+ * @retval #BT_ERROR_NOW_IN_PROGRESS  Operation now in progress
+ *
+ * @see bt_opp_client_push_files()
+ */
+int bt_opp_client_push_files_by_addr(const bt_addr_t *remote_addr, bt_opp_client_push_responded_cb responded_cb,
+ bt_opp_client_push_progress_cb progress_cb, bt_opp_client_push_finished_cb finished_cb, void *user_data);
+
 /**
  * @ingroup CAPI_NETWORK_BLUETOOTH_OPP_CLIENT_MODULE
  * @brief Cancels the push request in progress, asynchronously.
@@ -2219,6 +4166,28 @@ int bt_panu_unset_connection_state_changed_cb(void);
  */
 int bt_panu_connect(const char *remote_address, bt_panu_service_type_e type);
 
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_PAN_PANU_MODULE
+ * @brief Connects a remote device given by its binary address with the PAN(Personal Area Networking) service, asynchronously.
+ *
+ * @details Same as bt_panu_connect(), without formatting and parsing the address.
+ *
+ * @param[in] remote_addr The binary address of the remote Bluetooth device
+ * @param[in] type  The type of PAN service
+ *
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #BT_ERROR_NONE  Successful
+ * @retval #BT_ERROR_NOT_INITIALIZED  Not initialized
+ * @retval #BT_ERROR_INVALID_PARAMETER  Invalid parameter
+ * @retval #BT_ERROR_NOT_ENABLED  Not enabled
+ * @retval #BT_ERROR_REMOTE_DEVICE_NOT_BONDED  Remote device is not bonded
+ * @retval #BT_ERROR_OUT_OF_MEMORY  Out of memory
+ * @retval #BT_ERROR_OPERATION_FAILED  Operation failed
+ *
+ * @see bt_panu_connect()
+ */
+int bt_panu_connect_by_addr(const bt_addr_t *remote_addr, bt_panu_service_type_e type);
+
 /**
  * @ingroup CAPI_NETWORK_BLUETOOTH_PAN_PANU_MODULE
  * @brief Disconnects the remote device with the PAN(Personal Area Networking) service, asynchronously.
@@ -2238,6 +4207,27 @@ int bt_panu_connect(const char *remote_address, bt_panu_service_type_e type);
  */
 int bt_panu_disconnect(const char *remote_address);
 
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_PAN_PANU_MODULE
+ * @brief Disconnects a remote device given by its binary address from the PAN(Personal Area Networking) service, asynchronously.
+ *
+ * @details Same as bt_panu_disconnect(), without formatting and parsing the address.
+ *
+ * @param[in] remote_addr The binary address of the remote Bluetooth device
+ *
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #BT_ERROR_NONE  Successful
+ * @retval #BT_ERROR_NOT_INITIALIZED  Not initialized
+ * @retval #BT_ERROR_INVALID_PARAMETER  Invalid parameter
+ * @retval #BT_ERROR_NOT_ENABLED  Not enabled
+ * @retval #BT_ERROR_REMOTE_DEVICE_NOT_CONNECTED  Remote device is not connected
+ * @retval #BT_ERROR_OUT_OF_MEMORY  Out of memory
+ * @retval #BT_ERROR_OPERATION_FAILED  Operation failed
+ *
+ * @see bt_panu_disconnect()
+ */
+int bt_panu_disconnect_by_addr(const bt_addr_t *remote_addr);
+
 /**
  * @ingroup CAPI_NETWORK_BLUETOOTH_HID_MODULE
  * @brief  Called when the connection state is changed.
@@ -2302,6 +4292,54 @@ int bt_hid_host_deinitialize(void);
  */
 int bt_hid_host_connect(const char *remote_address);
 
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_HID_MODULE
+ * @brief Connects a remote device given by its binary address with the HID(Human Interface Device) service, asynchronously.
+ *
+ * @details Same as bt_hid_host_connect(), without formatting and parsing the address.
+ *
+ * @param[in] remote_addr The binary address of the remote Bluetooth device
+ *
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #BT_ERROR_NONE  Successful
+ * @retval #BT_ERROR_NOT_INITIALIZED  Not initialized
+ * @retval #BT_ERROR_INVALID_PARAMETER  Invalid parameter
+ * @retval #BT_ERROR_NOT_ENABLED  Not enabled
+ * @retval #BT_ERROR_REMOTE_DEVICE_NOT_BONDED  Remote device is not bonded
+ * @retval #BT_ERROR_OPERATION_FAILED  Operation failed
+ *
+ * @see bt_hid_host_connect()
+ */
+int bt_hid_host_connect_by_addr(const bt_addr_t *remote_addr);
+
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_HID_MODULE
+ * @brief Connects the remote device with the HID service, and reports the result to its own callback.
+ *
+ * @details Same as bt_hid_host_connect(), completed by the next HID connection of @a remote_address.
+ *
+ * @param[in] remote_address The MAC address of the remote Bluetooth device
+ * @param[in] timeout_ms  The deadline in milliseconds, after which @a callback is invoked with #BT_ERROR_TIMED_OUT, or 0 for none
+ * @param[in] callback  The callback function invoked when the operation completes
+ * @param[in] user_data  The user data passed to the callback function
+ * @param[out] operation_id  The identifier of the operation, for bt_operation_cancel()
+ *
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #BT_ERROR_NONE  Successful
+ * @retval #BT_ERROR_NOT_INITIALIZED  Not initialized
+ * @retval #BT_ERROR_INVALID_PARAMETER  Invalid parameter
+ * @retval #BT_ERROR_OUT_OF_MEMORY  Out of memory
+ * @retval #BT_ERROR_NOT_ENABLED  Not enabled
+ * @retval #BT_ERROR_OPERATION_FAILED  Operation failed
+ *
+ * @post This function invokes bt_operation_completed_cb().
+ *
+ * @see bt_hid_host_connect()
+ * @see bt_operation_cancel()
+ */
+int bt_hid_host_connect_async(const char *remote_address, int timeout_ms,
+		bt_operation_completed_cb callback, void *user_data, int *operation_id);
+
 /**
  * @ingroup CAPI_NETWORK_BLUETOOTH_HID_MODULE
  * @brief Disconnects the remote device with the HID(Human Interface Device) service, asynchronously.
@@ -2320,6 +4358,26 @@ int bt_hid_host_connect(const char *remote_address);
  */
 int bt_hid_host_disconnect(const char *remote_address);
 
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_HID_MODULE
+ * @brief Disconnects a remote device given by its binary address from the HID(Human Interface Device) service, asynchronously.
+ *
+ * @details Same as bt_hid_host_disconnect(), without formatting and parsing the address.
+ *
+ * @param[in] remote_addr The binary address of the remote Bluetooth device
+ *
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #BT_ERROR_NONE  Successful
+ * @retval #BT_ERROR_NOT_INITIALIZED  Not initialized
+ * @retval #BT_ERROR_INVALID_PARAMETER  Invalid parameter
+ * @retval #BT_ERROR_NOT_ENABLED  Not enabled
+ * @retval #BT_ERROR_REMOTE_DEVICE_NOT_CONNECTED  Remote device is not connected
+ * @retval #BT_ERROR_OPERATION_FAILED  Operation failed
+ *
+ * @see bt_hid_host_disconnect()
+ */
+int bt_hid_host_disconnect_by_addr(const bt_addr_t *remote_addr);
+
 /**
  * @ingroup CAPI_NETWORK_BLUETOOTH_AUDIO_MODULE
  * @brief Initializes the Bluetooth profiles related with audio.
@@ -2370,6 +4428,59 @@ int bt_audio_deinitialize(void);
  */
 int bt_audio_connect(const char *remote_address, bt_audio_profile_type_e type);
 
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_AUDIO_MODULE
+ * @brief Connects a remote device given by its binary address with the given audio profile, asynchronously.
+ *
+ * @details Same as bt_audio_connect(), without formatting and parsing the address.
+ *
+ * @param[in] remote_addr The binary address of the remote Bluetooth device
+ * @param[in] type  The type of audio profile
+ *
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #BT_ERROR_NONE  Successful
+ * @retval #BT_ERROR_NOT_INITIALIZED  Not initialized
+ * @retval #BT_ERROR_INVALID_PARAMETER  Invalid parameter
+ * @retval #BT_ERROR_NOT_ENABLED  Not enabled
+ * @retval #BT_ERROR_REMOTE_DEVICE_NOT_BONDED  Remote device is not bonded
+ * @retval #BT_ERROR_OPERATION_FAILED  Operation failed
+ *
+ * @see bt_audio_connect()
+ */
+int bt_audio_connect_by_addr(const bt_addr_t *remote_addr, bt_audio_profile_type_e type);
+
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_AUDIO_MODULE
+ * @brief Connects the remote device with the given audio profile, and reports the result to its own callback.
+ *
+ * @details Same as bt_audio_connect(), completed by the connection of @a remote_address. With
+ * #BT_AUDIO_PROFILE_TYPE_ALL, the operation completes once both profiles are connected, or as
+ * soon as either fails.
+ *
+ * @param[in] remote_address The address of the remote Bluetooth device
+ * @param[in] type The type of audio profile
+ * @param[in] timeout_ms  The deadline in milliseconds, after which @a callback is invoked with #BT_ERROR_TIMED_OUT, or 0 for none
+ * @param[in] callback  The callback function invoked when the operation completes
+ * @param[in] user_data  The user data passed to the callback function
+ * @param[out] operation_id  The identifier of the operation, for bt_operation_cancel()
+ *
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #BT_ERROR_NONE  Successful
+ * @retval #BT_ERROR_NOT_INITIALIZED  Not initialized
+ * @retval #BT_ERROR_INVALID_PARAMETER  Invalid parameter
+ * @retval #BT_ERROR_OUT_OF_MEMORY  Out of memory
+ * @retval #BT_ERROR_NOT_ENABLED  Not enabled
+ * @retval #BT_ERROR_OPERATION_FAILED  Operation failed
+ *
+ * @pre The audio service must be initialized with bt_audio_initialize().
+ * @post This function invokes bt_operation_completed_cb().
+ *
+ * @see bt_audio_connect()
+ * @see bt_operation_cancel()
+ */
+int bt_audio_connect_async(const char *remote_address, bt_audio_profile_type_e type, int timeout_ms,
+		bt_operation_completed_cb callback, void *user_data, int *operation_id);
+
 /**
  * @ingroup CAPI_NETWORK_BLUETOOTH_AUDIO_MODULE
  * @brief Disconnects the remote device with the given audio profile, asynchronously.
@@ -2391,6 +4502,27 @@ int bt_audio_connect(const char *remote_address, bt_audio_profile_type_e type);
  */
 int bt_audio_disconnect(const char *remote_address, bt_audio_profile_type_e type);
 
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_AUDIO_MODULE
+ * @brief Disconnects a remote device given by its binary address from the given audio profile, asynchronously.
+ *
+ * @details Same as bt_audio_disconnect(), without formatting and parsing the address.
+ *
+ * @param[in] remote_addr The binary address of the remote Bluetooth device
+ * @param[in] type  The type of audio profile
+ *
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #BT_ERROR_NONE  Successful
+ * @retval #BT_ERROR_NOT_INITIALIZED  Not initialized
+ * @retval #BT_ERROR_INVALID_PARAMETER  Invalid parameter
+ * @retval #BT_ERROR_NOT_ENABLED  Not enabled
+ * @retval #BT_ERROR_REMOTE_DEVICE_NOT_CONNECTED  Remote device is not connected
+ * @retval #BT_ERROR_OPERATION_FAILED  Operation failed
+ *
+ * @see bt_audio_disconnect()
+ */
+int bt_audio_disconnect_by_addr(const bt_addr_t *remote_addr, bt_audio_profile_type_e type);
+
 /**
  * @ingroup CAPI_NETWORK_BLUETOOTH_AUDIO_MODULE
  * @brief  Called when the connection state is changed.
@@ -2774,6 +4906,28 @@ int bt_hdp_unregister_sink_app(const char *app_id);
  */
 int bt_hdp_connect_to_source(const char *remote_address, const char *app_id);
 
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_HDP_MODULE
+ * @brief Connects a remote device given by its binary address, which acts as @a Source role, asynchronously.
+ *
+ * @details Same as bt_hdp_connect_to_source(), without formatting and parsing the address.
+ *
+ * @param[in] remote_addr The binary address of the remote Bluetooth device
+ * @param[in] app_id  The ID of application
+ *
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #BT_ERROR_NONE  Successful
+ * @retval #BT_ERROR_NOT_INITIALIZED  Not initialized
+ * @retval #BT_ERROR_INVALID_PARAMETER  Invalid parameter
+ * @retval #BT_ERROR_NOT_ENABLED  Not enabled
+ * @retval #BT_ERROR_REMOTE_DEVICE_NOT_BONDED  Remote device is not bonded
+ * @retval #BT_ERROR_OUT_OF_MEMORY  Out of memory
+ * @retval #BT_ERROR_OPERATION_FAILED  Operation failed
+ *
+ * @see bt_hdp_connect_to_source()
+ */
+int bt_hdp_connect_to_source_by_addr(const bt_addr_t *remote_addr, const char *app_id);
+
 /**
  * @ingroup CAPI_NETWORK_BLUETOOTH_HDP_MODULE
  * @brief Disconnects the remote device, asynchronously.
@@ -2794,6 +4948,28 @@ int bt_hdp_connect_to_source(const char *remote_address, const char *app_id);
  */
 int bt_hdp_disconnect(const char *remote_address, unsigned int channel);
 
+/**
+ * @ingroup CAPI_NETWORK_BLUETOOTH_HDP_MODULE
+ * @brief Disconnects a remote device given by its binary address, asynchronously.
+ *
+ * @details Same as bt_hdp_disconnect(), without formatting and parsing the address.
+ *
+ * @param[in] remote_addr The binary address of the remote Bluetooth device
+ * @param[in] channel  The connected data channel
+ *
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #BT_ERROR_NONE  Successful
+ * @retval #BT_ERROR_NOT_INITIALIZED  Not initialized
+ * @retval #BT_ERROR_INVALID_PARAMETER  Invalid parameter
+ * @retval #BT_ERROR_NOT_ENABLED  Not enabled
+ * @retval #BT_ERROR_REMOTE_DEVICE_NOT_CONNECTED  Remote device is not connected
+ * @retval #BT_ERROR_OUT_OF_MEMORY  Out of memory
+ * @retval #BT_ERROR_OPERATION_FAILED  Operation failed
+ *
+ * @see bt_hdp_disconnect()
+ */
+int bt_hdp_disconnect_by_addr(const bt_addr_t *remote_addr, unsigned int channel);
+
 /**
  * @ingroup CAPI_NETWORK_BLUETOOTH_HDP_MODULE
  * @brief Sends the data to the remote device.
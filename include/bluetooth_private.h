@@ -20,6 +20,7 @@
 
 #include <dlog.h>
 #include <stdbool.h>
+#include <stddef.h>
 #include <bluetooth-api.h>
 #include <bluetooth-audio-api.h>
 #include <bluetooth-media-control.h>
@@ -33,41 +34,109 @@ extern "C" {
 
 #define OPP_UUID "00001105-0000-1000-8000-00805f9b34fb"
 
+#define BT_ADDRESS_STR_LEN 18 /* "XX:XX:XX:XX:XX:XX" with the terminating null */
+#define BT_UUID_STR_LEN 37 /* "XXXXXXXX-XXXX-XXXX-XXXX-XXXXXXXXXXXX" with the terminating null */
+
+#define BT_SERVICE_BIT(service) (1ULL << (service))
+
 /**
  * @internal
- * @brief Bluetooth callback.
+ * @brief Binary 128 bit UUID, in the order it is written.
  */
-typedef enum
+typedef struct
+{
+	unsigned char uuid[16];
+} bt_uuid_s;
+
+/**
+ * @internal
+ * @brief #bt_device_info_s built by _bt_get_bt_device_info_s(), with its services as #BT_SERVICE_BIT() flags.
+ */
+typedef struct
+{
+	guint64 service_mask;
+	bt_device_info_s info;
+} bt_device_info_ext_s;
+
+/**
+ * @internal
+ * @brief #bt_adapter_device_discovery_info_s built for an event, with its services as #BT_SERVICE_BIT() flags.
+ */
+typedef struct
+{
+	guint64 service_mask;
+	bt_adapter_device_discovery_info_s info;
+} bt_discovery_info_ext_s;
+
+#define BT_INFO_EXT(ptr, type) ((type *)((char *)(ptr) - offsetof(type, info)))
+
+/**
+ * @internal
+ * @brief Slots of a #bt_intern_table_s.
+ */
+typedef struct bt_intern_slots_s bt_intern_slots_s;
+
+/**
+ * @internal
+ * @brief Table of interned values, each formatted once from a binary key of up to 16 bytes.
+ * @remarks Define it statically with #BT_INTERN_TABLE_INIT.
+ */
+typedef struct
+{
+	size_t key_len;
+	size_t value_len;
+	void (*format)(char *value, const void *key); /**< Formats the value of a new key */
+	GMutex lock;
+	bt_intern_slots_s *slots; /**< Published slots, probed without the lock */
+	bt_intern_slots_s *retired; /**< Replaced slots, which readers may still probe */
+	guint count;
+	char *chunk;
+	int chunk_used;
+} bt_intern_table_s;
+
+#define BT_INTERN_TABLE_INIT(key_len, value_len, format) { (key_len), (value_len), (format), }
+
+/**
+ * @internal
+ * @brief Bump allocator holding the converted members of events.
+ */
+typedef struct bt_arena_s bt_arena_s;
+
+/**
+ * @internal
+ * @brief Position in a #bt_arena_s, from _bt_arena_get_mark().
+ */
+typedef struct
+{
+	struct bt_arena_chunk_s *chunk;
+	char *cursor;
+} bt_arena_mark_s;
+
+#define BT_OPERATION_MAX_EVENTS 2
+
+#define BT_PROXIMITY_HISTORY_SIZE 16 /* RSSI samples kept per device */
+
+/**
+ * @internal
+ * @brief Kind of asynchronous operation, see _bt_operation_begin().
+ */
+typedef struct
 {
-	BT_EVENT_STATE_CHANGED = 0x00, /**< Adapter state is changed */
-	BT_EVENT_NAME_CHANGED, /**< Adapter name is changed */
-	BT_EVENT_VISIBILITY_MODE_CHANGED, /**< Adapter visibility mode is changed */
-	BT_EVENT_DEVICE_DISCOVERY_STATE_CHANGED, /**< Device discovery state is changed */
-	BT_EVENT_BOND_CREATED, /**< A bond is created */
-	BT_EVENT_BOND_DESTROYED, /**< A bond is destroyed */
-	BT_EVENT_AUTHORIZATION_CHANGED, /**< Authorization is changed */
-	BT_EVENT_SERVICE_SEARCHED, /**< Service search finish */
-	BT_EVENT_DATA_RECEIVED, /**< Data is received */
-	BT_EVENT_CONNECTION_STATE_CHANGED, /**< Connection state is changed */
-	BT_EVENT_RFCOMM_CONNECTION_REQUESTED, /**< RFCOMM connection is requested */
-	BT_EVENT_OPP_CONNECTION_REQUESTED, /**< OPP connection is requested */
-	BT_EVENT_OPP_PUSH_REQUESTED, /**< OPP push is requested */
-	BT_EVENT_OPP_SERVER_TRANSFER_PROGRESS, /**< OPP transfer progress */
-	BT_EVENT_OPP_SERVER_TRANSFER_FINISHED, /**< OPP transfer is completed */
-	BT_EVENT_OPP_CLIENT_PUSH_RESPONSED, /**< OPP client connection is reponsed */
-	BT_EVENT_OPP_CLIENT_PUSH_PROGRESS, /**< OPP client push progress */
-	BT_EVENT_OPP_CLIENT_PUSH_FINISHED, /**< OPP client push is finished */
-	BT_EVENT_PAN_CONNECTION_STATE_CHANGED, /**< PAN connection change */
-	BT_EVENT_NAP_CONNECTION_STATE_CHANGED, /**< NAP connection change */
-	BT_EVENT_HDP_CONNECTED, /**< HDP connection change */
-	BT_EVENT_HDP_DISCONNECTED, /**< HDP disconnection change */
-	BT_EVENT_HDP_DATA_RECIEVED, /**< HDP Data recieve Callabck */
-	BT_EVENT_AUDIO_CONNECTION_STATUS, /**< Audio Connection change callback */
-	BT_EVENT_AG_MICROPHONE_GAIN_CHANGE, /**< Audio Microphone change callback */
-	BT_EVENT_AG_SPEAKER_GAIN_CHANGE, /**< Audio Speaker gain change callback */
-	BT_EVENT_AVRCP_CONNECTION_STATUS, /**< AVRCP connection change callback */
-	BT_EVENT_HID_CONNECTION_STATUS /**< HID connection status callback */
-} bt_event_e;
+	int events[BT_OPERATION_MAX_EVENTS]; /**< F/W events which all complete the operation, 0 terminated if fewer */
+	int (*cancel)(void); /**< Stops the request in the F/W, NULL if it cannot be stopped */
+} bt_operation_type_s;
+
+/**
+ * @internal
+ * @brief Set of remote device addresses accepted by a subscription.
+ */
+typedef struct bt_event_address_filter_s bt_event_address_filter_s;
+
+/**
+ * @internal
+ * @brief Compiled #bt_adapter_device_discovery_filter_s, from _bt_discovery_filter_compile().
+ */
+typedef struct bt_discovery_filter_s bt_discovery_filter_s;
 
 /**
  * @internal
@@ -75,10 +144,71 @@ typedef enum
 typedef struct bt_event_sig_event_slot_s
 {
     int event_type;
+    int id;
     const void *callback;
     void *user_data;
+    const bt_event_address_filter_s *filter;
+    bool view; /**< The callback takes a #bt_device_view_h */
+    bool binary; /**< The callback is a #bt_event_addr_cb */
 } bt_event_sig_event_slot_s;
 
+/**
+ * @internal
+ * @brief Borrowed view over the F/W device information, with the members converted on demand.
+ */
+struct bt_device_view_s
+{
+	const bluetooth_device_info_t *info;
+	char address[BT_ADDRESS_STR_LEN]; /**< Empty until bt_device_view_get_address() */
+	char uuid[BLUETOOTH_UUID_STRING_MAX]; /**< Last malformed UUID from bt_device_view_get_service_uuid() */
+	guint64 service_mask; /**< #BT_SERVICE_BIT() flags, valid if @a has_service_mask */
+	bool has_service_mask;
+};
+
+/**
+ * @internal
+ * @brief Bluetooth F/W event converted to the arguments of the CAPI callback.
+ * @remarks @a name, @a interface_name, @a data and @a device are borrowed from the F/W event until _bt_detach_event_data() copies them. \n
+ * Other pointer members are allocated in @a arena and released with it by _bt_release_event_data().
+ */
+typedef struct
+{
+	int event; /**< Bluetooth F/W event */
+	int index; /**< Event delivered to the listeners (#bt_event_e) */
+	int result; /**< Converted result of the event */
+	int state; /**< State reported by the callback */
+	const char *remote_address; /**< Address of the remote device, interned by _bt_intern_address() */
+	const char *name; /**< Name (file name, application handle, ...) */
+	const char *interface_name; /**< Network interface name */
+	const char *data; /**< Received data */
+	long long size; /**< Size of file or data */
+	int value; /**< Socket fd, channel id, percentage or gain */
+	int type; /**< Profile or channel type */
+	void *info; /**< Converted information structure */
+	bluetooth_device_info_t *device; /**< Device information, converted to @a info only for bt_*_cb() listeners */
+	bt_socket_connection_s connection; /**< RFCOMM connection information */
+	bool detached; /**< Borrowed members were copied by _bt_detach_event_data() */
+	bool has_device_address; /**< @a device_address is set, only when a subscription filters addresses or takes binary addresses */
+	bluetooth_device_address_t device_address; /**< Raw address of the remote device */
+	unsigned long long received; /**< Time the F/W event was received, from _bt_diag_now() */
+	unsigned long long converted; /**< Time the F/W event was converted, from _bt_diag_now() */
+	bt_arena_s *arena; /**< Arena of the converted members */
+	bt_arena_mark_s arena_mark; /**< Position of @a arena before the conversion */
+} bt_event_data_s;
+
+
+/**
+ * @internal
+ * @brief Locks serializing the F/W requests of each subsystem.
+ */
+typedef enum
+{
+	BT_LOCK_SOCKET = 0x00, /**< RFCOMM socket */
+	BT_LOCK_OPP, /**< OPP server and client */
+	BT_LOCK_HDP, /**< HDP */
+	BT_LOCK_AUDIO, /**< Audio (AG, A2DP) */
+	BT_LOCK_MAX /**< Number of locks */
+} bt_lock_e;
 
 #define BT_CHECK_INPUT_PARAMETER(arg) \
 	if (arg == NULL) \
@@ -87,6 +217,13 @@ typedef struct bt_event_sig_event_slot_s
 		return BT_ERROR_INVALID_PARAMETER; \
 	}
 
+#define BT_CHECK_ADDRESS_TO_HEX(addr_hex, addr_str) \
+	if (_bt_convert_address_to_hex(addr_hex, addr_str) != BT_ERROR_NONE) \
+	{ \
+		LOGE("[%s] INVALID_PARAMETER(0x%08x)", __FUNCTION__, BT_ERROR_INVALID_PARAMETER); \
+		return BT_ERROR_INVALID_PARAMETER; \
+	}
+
 /**
  * @internal
  * @brief Check the initialzating status
@@ -100,6 +237,19 @@ int _bt_check_init_status(void);
 		return BT_ERROR_NOT_INITIALIZED; \
 	}
 
+/**
+ * @internal
+ * @brief Lock the subsystem.
+ * @remarks Subsystem locks are not recursive and must not be held while calling another public function of the same subsystem.
+ */
+void _bt_lock(bt_lock_e lock);
+
+/**
+ * @internal
+ * @brief Unlock the subsystem.
+ */
+void _bt_unlock(bt_lock_e lock);
+
 /**
  * @internal
  * @brief Set the event callback.
@@ -118,6 +268,117 @@ void _bt_unset_cb(int events);
  */
 bool _bt_check_cb(int events);
 
+/**
+ * @internal
+ * @brief Invoke the listeners of the converted event and release it.
+ */
+void _bt_deliver_event(bt_event_data_s *data);
+
+/**
+ * @internal
+ * @brief Copy the members borrowed from the F/W event, so the event can outlive the F/W callback.
+ */
+int _bt_detach_event_data(bt_event_data_s *data);
+
+/**
+ * @internal
+ * @brief Release the members of the converted event.
+ */
+void _bt_release_event_data(bt_event_data_s *data);
+
+/**
+ * @internal
+ * @brief Queue the converted event for delivery on the dispatch thread pool.
+ * @return true if the event was queued and is owned by the queue, false if it must be delivered inline.
+ */
+bool _bt_dispatch_event(bt_event_data_s *data);
+
+/**
+ * @internal
+ * @brief Stop the dispatch thread pool after delivering the queued events.
+ */
+void _bt_dispatch_stop(void);
+
+/**
+ * @internal
+ * @brief Check if events are delivered on the dispatch thread pool.
+ */
+bool _bt_dispatch_is_active(void);
+
+/**
+ * @internal
+ * @brief Track the remote device of the RFCOMM sockets and HDP channels, to queue their data events with it.
+ */
+void _bt_dispatch_update(int event, bluetooth_event_param_t *param);
+
+/**
+ * @internal
+ * @brief Create an arena owned by a single event.
+ */
+bt_arena_s *_bt_arena_create(void);
+
+/**
+ * @internal
+ * @brief Free the arena and all memory allocated from it.
+ */
+void _bt_arena_destroy(bt_arena_s *arena);
+
+/**
+ * @internal
+ * @brief Get the arena of the calling thread, reused by the events delivered inline.
+ */
+bt_arena_s *_bt_arena_get_thread_arena(void);
+
+/**
+ * @internal
+ * @brief Check if the arena is the one of a thread.
+ */
+bool _bt_arena_is_thread_arena(bt_arena_s *arena);
+
+/**
+ * @internal
+ * @brief Get the current position of the arena.
+ */
+void _bt_arena_get_mark(bt_arena_s *arena, bt_arena_mark_s *mark);
+
+/**
+ * @internal
+ * @brief Release all memory allocated from the arena after the mark.
+ * @remarks The largest chunk released is kept and reused by the next allocations which do not fit.
+ */
+void _bt_arena_rewind(bt_arena_s *arena, const bt_arena_mark_s *mark);
+
+/**
+ * @internal
+ * @brief Allocate memory from the arena, or from the heap if @a arena is NULL.
+ */
+void *_bt_arena_alloc(bt_arena_s *arena, size_t size);
+
+/**
+ * @internal
+ * @brief Copy the string into the arena, or into the heap if @a arena is NULL.
+ */
+char *_bt_arena_strdup(bt_arena_s *arena, const char *str);
+
+/**
+ * @internal
+ * @brief Copy the memory into the arena, or into the heap if @a arena is NULL.
+ */
+void *_bt_arena_memdup(bt_arena_s *arena, const void *memory, size_t size);
+
+/**
+ * @internal
+ * @brief Get the monotonic time in nanoseconds used by the event trace.
+ */
+unsigned long long _bt_diag_now(void);
+
+/**
+ * @internal
+ * @brief Record the delivery of the event in the trace ring and the latency histograms.
+ */
+void _bt_diag_record(bt_event_data_s *data, unsigned long long callback_started,
+		unsigned long long callback_ended);
+
 /**
  * @internal
  * @brief Convert Bluetooth F/W error codes to capi Bluetooth error codes.
@@ -128,8 +389,10 @@ int _bt_get_error_code(int origin_error);
 /**
  * @internal
  * @brief Convert Bluetooth F/W bluetooth_device_info_t to capi bt_device_info_s.
+ * @remarks The structure, its UUID table and its strings are a single block allocated in @a arena,
+ * or in the heap and freed by _bt_free_bt_device_info_s() if @a arena is NULL.
  */
-int _bt_get_bt_device_info_s(bt_device_info_s **dest_dev, bluetooth_device_info_t *source_dev);
+int _bt_get_bt_device_info_s(bt_device_info_s **dest_dev, bluetooth_device_info_t *source_dev, bt_arena_s *arena);
 
 
 /**
@@ -138,6 +401,19 @@ int _bt_get_bt_device_info_s(bt_device_info_s **dest_dev, bluetooth_device_info_
  */
 void _bt_free_bt_device_info_s(bt_device_info_s *device_info);
 
+/**
+ * @internal
+ * @brief Convert Bluetooth F/W bluetooth_device_info_t to capi bt_adapter_device_discovery_info_s, allocated in @a arena.
+ */
+int _bt_get_bt_adapter_device_discovery_info_s(bt_adapter_device_discovery_info_s **discovery_info,
+		bluetooth_device_info_t *source_info, bt_arena_s *arena);
+
+/**
+ * @internal
+ * @brief Convert Bluetooth F/W bt_sdp_info_t to capi bt_device_sdp_info_s, allocated in @a arena.
+ */
+int _bt_get_bt_device_sdp_info_s(bt_device_sdp_info_s **dest, bt_sdp_info_t *source, bt_arena_s *arena);
+
 /**
  * @internal
  * @brief Convert Bluetooth F/W bluetooth_device_address_t to string.
@@ -148,8 +424,335 @@ int _bt_convert_address_to_string(char **addr_str, bluetooth_device_address_t *a
 /**
  * @internal
  * @brief Convert string to Bluetooth F/W bluetooth_device_address_t.
+ * @return #BT_ERROR_INVALID_PARAMETER if @a addr_str is not "XX:XX:XX:XX:XX:XX", and @a addr_hex is cleared.
+ */
+int _bt_convert_address_to_hex(bluetooth_device_address_t *addr_hex, const char *addr_str);
+
+/**
+ * @internal
+ * @brief Format the address as "XX:XX:XX:XX:XX:XX" into a buffer of #BT_ADDRESS_STR_LEN bytes.
+ */
+void _bt_format_address(char *address_str, const bluetooth_device_address_t *address);
+
+/**
+ * @internal
+ * @brief Parse a "XX:XX:XX:XX:XX:XX" address, in either case.
+ * @return false if the string is not exactly an address.
+ */
+bool _bt_parse_address(const char *address_str, bluetooth_device_address_t *address);
+
+/**
+ * @internal
+ * @brief Get the interned value of the key, formatted by the table on the first request.
+ * @remarks The value is owned by the table and valid for the life of the process,
+ * so two keys are equal if and only if their values are the same pointer.
+ * @return NULL if out of memory.
+ */
+const char *_bt_intern(bt_intern_table_s *table, const void *key);
+
+/**
+ * @internal
+ * @brief Get the interned "XX:XX:XX:XX:XX:XX" string of the address.
+ * @remarks The string is owned by the library and valid for the life of the process,
+ * so two interned addresses are equal if and only if the pointers are equal.
+ * @return NULL if out of memory.
+ */
+const char *_bt_intern_address(const bluetooth_device_address_t *address);
+
+/**
+ * @internal
+ * @brief Get the interned string of a "XX:XX:XX:XX:XX:XX" address, in either case.
+ * @return NULL if @a address_str is not an address, or if out of memory.
+ */
+const char *_bt_intern_address_string(const char *address_str);
+
+/**
+ * @internal
+ * @brief Value of each hexadecimal digit, 0xFF for any other character.
+ */
+extern const unsigned char _bt_hex_value[256];
+
+/**
+ * @internal
+ * @brief Both uppercase hexadecimal digits of each byte.
+ */
+extern const char _bt_hex_pairs[256][2];
+
+/**
+ * @internal
+ * @brief Parse a UUID, in either case: "XXXXXXXX-XXXX-XXXX-XXXX-XXXXXXXXXXXX", or the 16 bit "XXXX"
+ * and 32 bit "XXXXXXXX" forms on the Bluetooth base UUID.
+ * @return false if the string is not a UUID.
+ */
+bool _bt_parse_uuid(const char *uuid_str, bt_uuid_s *uuid);
+
+/**
+ * @internal
+ * @brief Format the UUID in uppercase into a buffer of #BT_UUID_STR_LEN bytes.
+ */
+void _bt_format_uuid(char *uuid_str, const bt_uuid_s *uuid);
+
+/**
+ * @internal
+ * @brief Get the interned uppercase string of the UUID, in the form of @a length digits.
+ * @remarks The string is owned by the library and valid for the life of the process. \n
+ * @a length is 4 or 8 for the short forms, which only UUIDs on the Bluetooth base UUID have, and
+ * BT_UUID_STR_LEN - 1 otherwise.
+ * @return NULL if out of memory.
+ */
+const char *_bt_intern_uuid(const bt_uuid_s *uuid, int length);
+
+/**
+ * @internal
+ * @brief Get the well-known service of the UUID.
+ * @return The #bt_service_e, or -1 if the UUID is not a well-known service.
+ */
+int _bt_get_uuid_service(const bt_uuid_s *uuid);
+
+/**
+ * @internal
+ * @brief Intern a UUID string of the F/W in uppercase and in its own form, and add its service to @a service_mask.
+ * @return NULL if @a uuid_str is not a UUID, or if out of memory.
+ */
+const char *_bt_convert_uuid(const char *uuid_str, guint64 *service_mask);
+
+/**
+ * @internal
+ * @brief Get the #BT_SERVICE_BIT() flags of the UUID strings of the F/W.
+ */
+guint64 _bt_get_service_mask(const char (*uuids)[BLUETOOTH_UUID_STRING_MAX], int count);
+
+/**
+ * @internal
+ * @brief Update the adapter property cache from an adapter event of the F/W.
+ */
+void _bt_adapter_cache_update(int event, bluetooth_event_param_t *param);
+
+/**
+ * @internal
+ * @brief Forget the cached adapter properties, so the getters read the F/W again.
+ */
+void _bt_adapter_cache_clear(void);
+
+/**
+ * @internal
+ * @brief Check a device reported by the discovery against the filter of bt_adapter_start_device_discovery_with_filter().
+ * @remarks Allocates nothing. Without a filter, every device passes.
+ */
+bool _bt_discovery_filter_match(const bluetooth_device_info_t *source_info);
+
+/**
+ * @internal
+ * @brief Remove the discovery filter.
+ */
+void _bt_discovery_filter_clear(void);
+
+/**
+ * @internal
+ * @brief Start the device discovery with the compiled filter, or NULL for every device, which the filter then owns.
+ * @remarks If the discovery cannot start, the filter is freed and the filter of a discovery in progress is kept.
+ */
+int _bt_discovery_filter_start(bt_discovery_filter_s *filter);
+
+/**
+ * @internal
+ * @brief Compile a discovery filter, in a single block released with free().
+ */
+int _bt_discovery_filter_compile(const bt_adapter_device_discovery_filter_s *source, bt_discovery_filter_s **filter);
+
+/**
+ * @internal
+ * @brief Check a device reported by the discovery against a compiled filter.
+ */
+bool _bt_discovery_filter_match_device(const bt_discovery_filter_s *filter, const bluetooth_device_info_t *source_info);
+
+/**
+ * @internal
+ * @brief The mask of the major device classes passed to the F/W for a compiled filter.
+ * @remarks #BLUETOOTH_DEVICE_MAJOR_MASK_MISC, which reports every device, if the F/W cannot filter them all.
+ */
+unsigned int _bt_discovery_filter_get_fw_mask(const bt_discovery_filter_s *filter);
+
+/**
+ * @internal
+ * @brief Follow the discovery and adapter events for the discovery sessions, and deliver the devices found.
+ * @remarks Called for every event, before the filter of bt_adapter_start_device_discovery_with_filter() applies.
+ */
+void _bt_discovery_session_update(int event, bluetooth_event_param_t *param);
+
+/**
+ * @internal
+ * @brief Close a discovery session, as bt_adapter_close_discovery_session() does.
+ * @remarks #BT_ERROR_INVALID_PARAMETER, without logging, if the session is already closed.
+ */
+int _bt_discovery_session_close(bt_adapter_discovery_session_h session);
+
+/**
+ * @internal
+ * @brief Close every discovery session without invoking their callbacks.
+ */
+void _bt_discovery_session_close_all(void);
+
+/**
+ * @internal
+ * @brief Cancel the device lookups of bt_adapter_find_device(), invoking their callbacks.
+ */
+void _bt_device_finder_cancel_all(void);
+
+/**
+ * @internal
+ * @brief Add an RSSI sample of a device found to the proximity tracking, if it runs.
+ */
+void _bt_proximity_update(const bluetooth_device_info_t *source_info);
+
+/**
+ * @internal
+ * @brief Stop the proximity tracking and remove the thresholds, without invoking their callbacks.
+ */
+void _bt_proximity_clear(void);
+
+/**
+ * @internal
+ * @brief Follow the discovery, device and connection events for the periodic device discovery.
+ * @remarks Called for every event, before the devices out of the discovery filter are dropped. Only
+ * #BLUETOOTH_EVENT_REMOTE_DEVICE_NAME_UPDATED, #BLUETOOTH_EVENT_DISCOVERY_STARTED,
+ * #BLUETOOTH_EVENT_DISCOVERY_FINISHED, #BLUETOOTH_EVENT_DEVICE_CONNECTED, #BLUETOOTH_EVENT_DEVICE_DISCONNECTED
+ * and #BLUETOOTH_EVENT_DISABLED are followed.
+ */
+void _bt_discovery_schedule_update(int event, bluetooth_event_param_t *param);
+
+/**
+ * @internal
+ * @brief Stop the periodic device discovery, if running, without invoking its callback.
+ */
+void _bt_discovery_schedule_stop(void);
+
+/**
+ * @internal
+ * @brief Register an asynchronous operation, before its request is sent to the F/W.
+ * @remarks @a address is NULL for the operations of the adapter, whose events have no address.
+ * @see _bt_operation_abort()
+ */
+int _bt_operation_begin(const bt_operation_type_s *type, const bluetooth_device_address_t *address,
+		int timeout_ms, bt_operation_completed_cb callback, void *user_data, int *operation_id);
+
+/**
+ * @internal
+ * @brief Remove an operation whose request was refused by the F/W, without invoking its callback.
+ */
+void _bt_operation_abort(int operation_id);
+
+/**
+ * @internal
+ * @brief Check if an operation waits for an event.
+ */
+bool _bt_operation_is_pending(void);
+
+/**
+ * @internal
+ * @brief Match a F/W event to the oldest pending operation waiting for it.
+ * @param[in] result  The result, as a #bt_error_e
+ * @param[in] address  The remote address of the event, NULL if it has none
+ */
+void _bt_operation_complete(int event, int result, const bluetooth_device_address_t *address);
+
+/**
+ * @internal
+ * @brief Complete all the pending operations with #BT_ERROR_CANCELLED.
+ */
+void _bt_operation_cancel_all(void);
+
+/**
+ * @internal
+ * @brief Complete the queued service search of a search result, and start the next one.
+ * @remarks Called for #BLUETOOTH_EVENT_SERVICE_SEARCHED, #BLUETOOTH_EVENT_SERVICE_SEARCH_CANCELLED
+ * and #BLUETOOTH_EVENT_DISABLED.
+ */
+void _bt_sdp_queue_update(int event, bluetooth_event_param_t *param);
+
+/**
+ * @internal
+ * @brief Complete all the queued service searches with #BT_ERROR_CANCELLED.
+ */
+void _bt_sdp_queue_cancel_all(void);
+
+/**
+ * @internal
+ * @brief Map the service cache file, creating it if needed.
+ * @remarks Without the file, the services are not cached, and nothing fails.
+ */
+void _bt_sdp_cache_open(void);
+
+/**
+ * @internal
+ * @brief Unmap the service cache file.
+ */
+void _bt_sdp_cache_close(void);
+
+/**
+ * @internal
+ * @brief Store the services of a search result, or forget those of a device whose bond is removed.
+ * @remarks Called for #BLUETOOTH_EVENT_SERVICE_SEARCHED and #BLUETOOTH_EVENT_BONDED_DEVICE_REMOVED.
+ */
+void _bt_sdp_cache_update(int event, bluetooth_event_param_t *param);
+
+/**
+ * @internal
+ * @brief Get the cached services of a device, if they are not stale.
+ * @remarks The @a sdp_info is one memory block to release with free(). The age is in seconds.
+ * @return #BT_ERROR_REMOTE_DEVICE_NOT_FOUND if no services are cached or they are stale.
+ */
+int _bt_sdp_cache_get(const bluetooth_device_address_t *address, bt_device_sdp_info_s **sdp_info, int *age);
+
+/**
+ * @internal
+ * @brief Add or refresh a discovered device in the discovered device cache.
+ */
+void _bt_device_cache_update(const bluetooth_device_info_t *source_info);
+
+/**
+ * @internal
+ * @brief Remove all the devices of the discovered device cache.
+ */
+void _bt_device_cache_clear(void);
+
+/**
+ * @internal
+ * @brief Invoke the callback for each bonded device, read from the F/W only if not cached.
+ */
+int _bt_bonded_cache_foreach(bt_adapter_bonded_device_cb foreach_cb, void *user_data);
+
+/**
+ * @internal
+ * @brief Get the device information of a bonded device, read from the F/W only if not cached.
+ * @return #BT_ERROR_REMOTE_DEVICE_NOT_BONDED if the device is not bonded.
+ */
+int _bt_bonded_cache_get(const bluetooth_device_address_t *address, bt_device_info_s **device_info);
+
+/**
+ * @internal
+ * @brief Update the bonded device cache from a bonding, authorization, connection, service search
+ * or adapter event of the F/W.
+ */
+void _bt_bonded_cache_update(int event, bluetooth_event_param_t *param);
+
+/**
+ * @internal
+ * @brief Remove the bonded devices of the cache, and reset its statistics.
+ */
+void _bt_bonded_cache_clear(void);
+
+/**
+ * @internal
+ * @brief Convert a CAPI #bt_addr_t to Bluetooth F/W bluetooth_device_address_t.
+ */
+void _bt_convert_addr_to_hex(bluetooth_device_address_t *addr_hex, const bt_addr_t *addr);
+
+/**
+ * @internal
+ * @brief Convert Bluetooth F/W bluetooth_device_address_t to a CAPI #bt_addr_t.
  */
-void _bt_convert_address_to_hex(bluetooth_device_address_t *addr_hex, const char *addr_str);
+void _bt_convert_hex_to_addr(bt_addr_t *addr, const bluetooth_device_address_t *addr_hex);
 
 
 /**
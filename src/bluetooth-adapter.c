@@ -31,6 +31,88 @@
 #endif
 #define LOG_TAG "TIZEN_N_BLUETOOTH"
 
+/*
+ *  Adapter property cache
+ *
+ *  The getters read the F/W once, then the adapter events keep the properties current while
+ *  the library is initialized, so polling them needs no IPC. An event received while a
+ *  getter reads the F/W changes the generation, and the value read is then not cached.
+ */
+typedef struct {
+	GMutex lock;
+	guint generation;
+	bool has_state;
+	bool has_address;
+	bool has_name;
+	bool has_visibility;
+	bt_adapter_state_e state;
+	bluetooth_device_address_t address;
+	char name[BLUETOOTH_DEVICE_NAME_LENGTH_MAX + 1];
+	bt_adapter_visibility_mode_e visibility;
+} bt_adapter_cache_s;
+
+static bt_adapter_cache_s bt_adapter_cache;
+
+static const bt_operation_type_s bt_operation_enable = {
+	{ BLUETOOTH_EVENT_ENABLED, 0 }, NULL,
+};
+
+static const bt_operation_type_s bt_operation_disable = {
+	{ BLUETOOTH_EVENT_DISABLED, 0 }, NULL,
+};
+
+void _bt_adapter_cache_update(int event, bluetooth_event_param_t *param)
+{
+	g_mutex_lock(&bt_adapter_cache.lock);
+	bt_adapter_cache.generation++;
+
+	switch (event) {
+	case BLUETOOTH_EVENT_ENABLED:
+	case BLUETOOTH_EVENT_DISABLED:
+		/* The name and the visibility are read again in the new state */
+		bt_adapter_cache.has_name = false;
+		bt_adapter_cache.has_visibility = false;
+		bt_adapter_cache.has_state = false;
+		if (param->result != BLUETOOTH_ERROR_NONE)
+			break;
+		bt_adapter_cache.state = (event == BLUETOOTH_EVENT_ENABLED) ? BT_ADAPTER_ENABLED : BT_ADAPTER_DISABLED;
+		bt_adapter_cache.has_state = true;
+		break;
+	case BLUETOOTH_EVENT_LOCAL_NAME_CHANGED:
+		bt_adapter_cache.has_name = false;
+		if (param->param_data == NULL)
+			break;
+		strncpy(bt_adapter_cache.name, (char *)(param->param_data), BLUETOOTH_DEVICE_NAME_LENGTH_MAX);
+		bt_adapter_cache.name[BLUETOOTH_DEVICE_NAME_LENGTH_MAX] = '\0';
+		bt_adapter_cache.has_name = true;
+		break;
+	case BLUETOOTH_EVENT_DISCOVERABLE_MODE_CHANGED:
+		bt_adapter_cache.has_visibility = false;
+		if (param->result != BLUETOOTH_ERROR_NONE || param->param_data == NULL)
+			break;
+		bt_adapter_cache.visibility = _bt_get_bt_visibility_mode_e(*(bluetooth_discoverable_mode_t *)(param->param_data));
+		bt_adapter_cache.has_visibility = true;
+		break;
+	case BLUETOOTH_EVENT_DISCOVERABLE_TIMEOUT:
+		bt_adapter_cache.has_visibility = false;
+		break;
+	default:
+		break;
+	}
+
+	g_mutex_unlock(&bt_adapter_cache.lock);
+}
+
+void _bt_adapter_cache_clear(void)
+{
+	g_mutex_lock(&bt_adapter_cache.lock);
+	bt_adapter_cache.generation++;
+	bt_adapter_cache.has_state = false;
+	bt_adapter_cache.has_address = false;
+	bt_adapter_cache.has_name = false;
+	bt_adapter_cache.has_visibility = false;
+	g_mutex_unlock(&bt_adapter_cache.lock);
+}
 
 int bt_adapter_enable(void)
 {
@@ -56,12 +138,75 @@ int bt_adapter_disable(void)
 	return error_code;
 }
 
+int bt_adapter_enable_async(int timeout_ms, bt_operation_completed_cb callback, void *user_data, int *operation_id)
+{
+	int error_code = BT_ERROR_NONE;
+
+	BT_CHECK_INIT_STATUS();
+
+	error_code = _bt_operation_begin(&bt_operation_enable, NULL, timeout_ms, callback, user_data, operation_id);
+	if (error_code != BT_ERROR_NONE)
+		return error_code;
+
+	error_code = bt_adapter_enable();
+	if (error_code != BT_ERROR_NONE)
+		_bt_operation_abort(*operation_id);
+
+	return error_code;
+}
+
+int bt_adapter_disable_async(int timeout_ms, bt_operation_completed_cb callback, void *user_data, int *operation_id)
+{
+	int error_code = BT_ERROR_NONE;
+
+	BT_CHECK_INIT_STATUS();
+
+	error_code = _bt_operation_begin(&bt_operation_disable, NULL, timeout_ms, callback, user_data, operation_id);
+	if (error_code != BT_ERROR_NONE)
+		return error_code;
+
+	error_code = bt_adapter_disable();
+	if (error_code != BT_ERROR_NONE)
+		_bt_operation_abort(*operation_id);
+
+	return error_code;
+}
+
 int bt_adapter_get_state(bt_adapter_state_e *adapter_state)
 {
+	int state = BLUETOOTH_ADAPTER_DISABLED;
+	int error_code = BT_ERROR_NONE;
+	guint generation = 0;
+
 	BT_CHECK_INIT_STATUS();
 	BT_CHECK_INPUT_PARAMETER(adapter_state);
 
-	*adapter_state = bluetooth_check_adapter();
+	g_mutex_lock(&bt_adapter_cache.lock);
+	if (bt_adapter_cache.has_state == true) {
+		*adapter_state = bt_adapter_cache.state;
+		g_mutex_unlock(&bt_adapter_cache.lock);
+		return BT_ERROR_NONE;
+	}
+	generation = bt_adapter_cache.generation;
+	g_mutex_unlock(&bt_adapter_cache.lock);
+
+	state = bluetooth_check_adapter();
+
+	/* An error is not a state, so it is not cached */
+	if (state != BLUETOOTH_ADAPTER_ENABLED && state != BLUETOOTH_ADAPTER_DISABLED) {
+		error_code = _bt_get_error_code(state);
+		LOGE("[%s] %s(0x%08x)", __FUNCTION__, _bt_convert_error_to_string(error_code), error_code);
+		return error_code;
+	}
+
+	g_mutex_lock(&bt_adapter_cache.lock);
+	if (generation == bt_adapter_cache.generation) {
+		bt_adapter_cache.state = state;
+		bt_adapter_cache.has_state = true;
+	}
+	g_mutex_unlock(&bt_adapter_cache.lock);
+
+	*adapter_state = state;
 	return BT_ERROR_NONE;
 }
 
@@ -69,14 +214,29 @@ int bt_adapter_get_address(char **address)
 {
 	bluetooth_device_address_t loc_address = { {0} };
 	int error_code = BT_ERROR_NONE;
+	bool cached = false;
 
 	BT_CHECK_INIT_STATUS();
 	BT_CHECK_INPUT_PARAMETER(address);
 
-	error_code = _bt_get_error_code(bluetooth_get_local_address(&loc_address));
-	if (error_code != BT_ERROR_NONE) {
-		LOGE("[%s] %s(0x%08x)", __FUNCTION__, _bt_convert_error_to_string(error_code), error_code);
-		return error_code;
+	/* The local address never changes, so no event invalidates it */
+	g_mutex_lock(&bt_adapter_cache.lock);
+	cached = bt_adapter_cache.has_address;
+	if (cached == true)
+		loc_address = bt_adapter_cache.address;
+	g_mutex_unlock(&bt_adapter_cache.lock);
+
+	if (cached == false) {
+		error_code = _bt_get_error_code(bluetooth_get_local_address(&loc_address));
+		if (error_code != BT_ERROR_NONE) {
+			LOGE("[%s] %s(0x%08x)", __FUNCTION__, _bt_convert_error_to_string(error_code), error_code);
+			return error_code;
+		}
+
+		g_mutex_lock(&bt_adapter_cache.lock);
+		bt_adapter_cache.address = loc_address;
+		bt_adapter_cache.has_address = true;
+		g_mutex_unlock(&bt_adapter_cache.lock);
 	}
 
 	error_code = _bt_convert_address_to_string(address, &loc_address);
@@ -92,15 +252,37 @@ int bt_adapter_get_name(char **name)
 {
 	int ret = BT_ERROR_NONE;
 	bluetooth_device_name_t loc_name = { {0} };
+	guint generation = 0;
 
 	BT_CHECK_INIT_STATUS();
 	BT_CHECK_INPUT_PARAMETER(name);
 
+	g_mutex_lock(&bt_adapter_cache.lock);
+	if (bt_adapter_cache.has_name == true) {
+		*name = strdup(bt_adapter_cache.name);
+		g_mutex_unlock(&bt_adapter_cache.lock);
+		if (*name == NULL) {
+			LOGE("[%s] OUT_OF_MEMORY(0x%08x)", __FUNCTION__, BT_ERROR_OUT_OF_MEMORY);
+			return BT_ERROR_OUT_OF_MEMORY;
+		}
+		return BT_ERROR_NONE;
+	}
+	generation = bt_adapter_cache.generation;
+	g_mutex_unlock(&bt_adapter_cache.lock);
+
 	ret = _bt_get_error_code(bluetooth_get_local_name(&loc_name));
 	if (ret != BT_ERROR_NONE) {
 		LOGE("[%s] %s(0x%08x)", __FUNCTION__, _bt_convert_error_to_string(ret), ret);
 		return ret;
 	}
+	loc_name.name[BLUETOOTH_DEVICE_NAME_LENGTH_MAX] = '\0';
+
+	g_mutex_lock(&bt_adapter_cache.lock);
+	if (generation == bt_adapter_cache.generation) {
+		memcpy(bt_adapter_cache.name, loc_name.name, sizeof(bt_adapter_cache.name));
+		bt_adapter_cache.has_name = true;
+	}
+	g_mutex_unlock(&bt_adapter_cache.lock);
 
 	*name = strdup(loc_name.name);
 	if (*name == NULL) {
@@ -134,10 +316,20 @@ int bt_adapter_get_visibility(bt_adapter_visibility_mode_e *mode)
 {
 	bluetooth_discoverable_mode_t discoverable_mode = BLUETOOTH_DISCOVERABLE_MODE_CONNECTABLE;
 	int ret = BT_ERROR_NONE;
+	guint generation = 0;
 
 	BT_CHECK_INIT_STATUS();
 	BT_CHECK_INPUT_PARAMETER(mode);
 
+	g_mutex_lock(&bt_adapter_cache.lock);
+	if (bt_adapter_cache.has_visibility == true) {
+		*mode = bt_adapter_cache.visibility;
+		g_mutex_unlock(&bt_adapter_cache.lock);
+		return BT_ERROR_NONE;
+	}
+	generation = bt_adapter_cache.generation;
+	g_mutex_unlock(&bt_adapter_cache.lock);
+
 	ret = _bt_get_error_code(bluetooth_get_discoverable_mode(&discoverable_mode));
 	if (ret != BT_ERROR_NONE) {
 		LOGE("[%s] %s(0x%08x)", __FUNCTION__, _bt_convert_error_to_string(ret), ret);
@@ -145,6 +337,14 @@ int bt_adapter_get_visibility(bt_adapter_visibility_mode_e *mode)
 	}
 
 	*mode = _bt_get_bt_visibility_mode_e(discoverable_mode);
+
+	g_mutex_lock(&bt_adapter_cache.lock);
+	if (generation == bt_adapter_cache.generation) {
+		bt_adapter_cache.visibility = *mode;
+		bt_adapter_cache.has_visibility = true;
+	}
+	g_mutex_unlock(&bt_adapter_cache.lock);
+
 	return BT_ERROR_NONE;
 }
 
@@ -181,50 +381,14 @@ int bt_adapter_set_visibility(bt_adapter_visibility_mode_e visibility_mode, int
 
 int bt_adapter_foreach_bonded_device(bt_adapter_bonded_device_cb foreach_cb, void *user_data)
 {
-	GPtrArray *dev_list = NULL;
-	bt_device_info_s *dev_info = NULL;
-	bluetooth_device_info_t *ptr = NULL;
 	int ret = BT_ERROR_NONE;
-	int i = 0;
 
 	BT_CHECK_INIT_STATUS();
 	BT_CHECK_INPUT_PARAMETER(foreach_cb);
 
-	dev_list = g_ptr_array_new();
-	if (dev_list == NULL) {
-		LOGE("[%s] OUT_OF_MEMORY(0x%08x)", __FUNCTION__, BT_ERROR_OUT_OF_MEMORY);
-		return BT_ERROR_OUT_OF_MEMORY;
-	}
-
-	ret = _bt_get_error_code(bluetooth_get_bonded_device_list(&dev_list));
+	ret = _bt_bonded_cache_foreach(foreach_cb, user_data);
 	if (ret != BT_ERROR_NONE) {
 		LOGE("[%s] %s(0x%08x) : Failed to get bonded device list", __FUNCTION__, _bt_convert_error_to_string(ret), ret);
-		return ret;
-	}
-
-	for (i = 0; i < dev_list->len; i++) {
-		ptr = g_ptr_array_index(dev_list, i);
-		if (ptr != NULL) {
-			ret = _bt_get_bt_device_info_s(&dev_info, (bluetooth_device_info_t *)ptr);
-			if (ret != BT_ERROR_NONE) {
-				LOGE("[%s] %s(0x%08x) : Failed to get device info", __FUNCTION__, _bt_convert_error_to_string(ret), ret);
-				break;
-			}
-
-			if (!foreach_cb(dev_info, user_data)) {
-				_bt_free_bt_device_info_s(dev_info);
-				break;
-			}
-			_bt_free_bt_device_info_s(dev_info);
-		} else {
-			LOGE("[%s] OPERATION_FAILED(0x%08x)", __FUNCTION__, BT_ERROR_OPERATION_FAILED);
-			ret = BT_ERROR_OPERATION_FAILED;
-			break;
-		}
-	}
-
-	if (dev_list != NULL) {
-		g_ptr_array_free(dev_list, TRUE);
 	}
 
 	return ret;
@@ -234,33 +398,17 @@ int bt_adapter_get_bonded_device_info(const char *remote_address, bt_device_info
 {
 	int ret;
 	bluetooth_device_address_t addr_hex = { {0,} };
-	bluetooth_device_info_t *info;
 
 	BT_CHECK_INIT_STATUS();
 	BT_CHECK_INPUT_PARAMETER(remote_address);
+	BT_CHECK_ADDRESS_TO_HEX(&addr_hex, remote_address);
 
-	info = (bluetooth_device_info_t *)malloc(sizeof(bluetooth_device_info_t));
-	if (info == NULL)
-		return BT_ERROR_OUT_OF_MEMORY;
-
-	_bt_convert_address_to_hex(&addr_hex, remote_address);
-
-	ret = _bt_get_error_code(bluetooth_get_bonded_device(&addr_hex, info));
+	ret = _bt_bonded_cache_get(&addr_hex, device_info);
 	if (ret != BT_ERROR_NONE) {
 		LOGE("[%s] %s(0x%08x) : Failed to run function", __FUNCTION__,
 					_bt_convert_error_to_string(ret), ret);
-	} else {
-		ret = _bt_get_bt_device_info_s(device_info, info);
-		if (ret != BT_ERROR_NONE) {
-			LOGE("[%s] %s(0x%08x) : Failed to get device info",
-						__FUNCTION__,
-						_bt_convert_error_to_string(ret),
-						ret);
-		}
 	}
 
-	free(info);
-
 	return ret;
 }
 
@@ -274,6 +422,22 @@ int bt_adapter_free_device_info(bt_device_info_s *device_info)
 	return BT_ERROR_NONE;
 }
 
+int bt_adapter_device_discovery_info_has_service(const bt_adapter_device_discovery_info_s *discovery_info,
+		bt_service_e service, bool *has_service)
+{
+	BT_CHECK_INPUT_PARAMETER(discovery_info);
+	BT_CHECK_INPUT_PARAMETER(has_service);
+	if (service < 0 || service >= BT_SERVICE_MAX) {
+		LOGE("[%s] INVALID_PARAMETER(0x%08x)", __FUNCTION__, BT_ERROR_INVALID_PARAMETER);
+		return BT_ERROR_INVALID_PARAMETER;
+	}
+
+	*has_service = (BT_INFO_EXT(discovery_info, bt_discovery_info_ext_s)->service_mask &
+			BT_SERVICE_BIT(service)) ? true : false;
+
+	return BT_ERROR_NONE;
+}
+
 int bt_adapter_is_service_used(const char *service_uuid, bool *used)
 {
 	int ret = BT_ERROR_NONE;
@@ -385,7 +549,7 @@ int bt_adapter_start_device_discovery(void)
 	int error_code = BT_ERROR_NONE;
 
 	BT_CHECK_INIT_STATUS();
-	error_code = _bt_get_error_code(bluetooth_start_discovery(0, 0, BLUETOOTH_DEVICE_MAJOR_MASK_MISC));
+	error_code = _bt_discovery_filter_start(NULL);
 	if (error_code != BT_ERROR_NONE) {
 		LOGE("[%s] %s(0x%08x)", __FUNCTION__, _bt_convert_error_to_string(error_code), error_code);
 	}
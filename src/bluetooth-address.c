@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <glib.h>
+#include <dlog.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <bluetooth-api.h>
+
+#include "bluetooth.h"
+#include "bluetooth_private.h"
+
+#ifdef LOG_TAG
+#undef LOG_TAG
+#endif
+#define LOG_TAG "TIZEN_N_BLUETOOTH"
+
+/*
+ *  Address codec
+ *
+ *  Addresses are always "XX:XX:XX:XX:XX:XX" with uppercase digits when formatted, and
+ *  strictly this form (either case) when parsed. Both directions go through lookup
+ *  tables, so neither depends on the locale or on the stdio format parser.
+ */
+
+#define BT_HEX_INVALID 0xFF
+
+/* Value of a hexadecimal digit, BT_HEX_INVALID for any other character */
+const unsigned char _bt_hex_value[256] = {
+	[0 ... 255] = BT_HEX_INVALID,
+	['0'] = 0x0, ['1'] = 0x1, ['2'] = 0x2, ['3'] = 0x3, ['4'] = 0x4,
+	['5'] = 0x5, ['6'] = 0x6, ['7'] = 0x7, ['8'] = 0x8, ['9'] = 0x9,
+	['A'] = 0xA, ['B'] = 0xB, ['C'] = 0xC, ['D'] = 0xD, ['E'] = 0xE, ['F'] = 0xF,
+	['a'] = 0xA, ['b'] = 0xB, ['c'] = 0xC, ['d'] = 0xD, ['e'] = 0xE, ['f'] = 0xF,
+};
+
+#define BT_HEX_PAIRS(high) \
+	{ high, '0' }, { high, '1' }, { high, '2' }, { high, '3' }, \
+	{ high, '4' }, { high, '5' }, { high, '6' }, { high, '7' }, \
+	{ high, '8' }, { high, '9' }, { high, 'A' }, { high, 'B' }, \
+	{ high, 'C' }, { high, 'D' }, { high, 'E' }, { high, 'F' }
+
+/* Both digits of each byte */
+const char _bt_hex_pairs[256][2] = {
+	BT_HEX_PAIRS('0'), BT_HEX_PAIRS('1'), BT_HEX_PAIRS('2'), BT_HEX_PAIRS('3'),
+	BT_HEX_PAIRS('4'), BT_HEX_PAIRS('5'), BT_HEX_PAIRS('6'), BT_HEX_PAIRS('7'),
+	BT_HEX_PAIRS('8'), BT_HEX_PAIRS('9'), BT_HEX_PAIRS('A'), BT_HEX_PAIRS('B'),
+	BT_HEX_PAIRS('C'), BT_HEX_PAIRS('D'), BT_HEX_PAIRS('E'), BT_HEX_PAIRS('F'),
+};
+
+void _bt_format_address(char *address_str, const bluetooth_device_address_t *address)
+{
+	int i;
+
+	for (i = 0; i < BLUETOOTH_ADDRESS_LENGTH; i++) {
+		memcpy(address_str + i * 3, _bt_hex_pairs[address->addr[i]], 2);
+		address_str[i * 3 + 2] = ':';
+	}
+	address_str[BT_ADDRESS_STR_LEN - 1] = '\0';
+}
+
+bool _bt_parse_address(const char *address_str, bluetooth_device_address_t *address)
+{
+	const unsigned char *str = (const unsigned char *)address_str;
+	unsigned char high;
+	unsigned char low;
+	unsigned int invalid = 0;
+	int i;
+
+	if (address_str == NULL || strnlen(address_str, BT_ADDRESS_STR_LEN) != BT_ADDRESS_STR_LEN - 1)
+		return false;
+
+	/* Errors are accumulated, so a valid address takes no branch */
+	for (i = 0; i < BLUETOOTH_ADDRESS_LENGTH; i++) {
+		high = _bt_hex_value[str[i * 3]];
+		low = _bt_hex_value[str[i * 3 + 1]];
+		invalid |= (high | low) & 0xF0;
+		if (i < BLUETOOTH_ADDRESS_LENGTH - 1)
+			invalid |= str[i * 3 + 2] ^ ':';
+		address->addr[i] = (unsigned char)((high << 4) | (low & 0x0F));
+	}
+
+	return (invalid == 0) ? true : false;
+}
+
+int _bt_convert_address_to_string(char **addr_str, bluetooth_device_address_t *addr_hex)
+{
+	*addr_str = malloc(BT_ADDRESS_STR_LEN);
+
+	if (*addr_str != NULL) {
+		_bt_format_address(*addr_str, addr_hex);
+		return BT_ERROR_NONE;
+	} else {
+		return BT_ERROR_OUT_OF_MEMORY;
+	}
+}
+
+int _bt_convert_address_to_hex(bluetooth_device_address_t *addr_hex, const char *addr_str)
+{
+	if (_bt_parse_address(addr_str, addr_hex) == false) {
+		LOGE("[%s] Invalid format string - %s", __FUNCTION__, (addr_str != NULL) ? addr_str : "(null)");
+		memset(addr_hex, 0x00, sizeof(bluetooth_device_address_t));
+		return BT_ERROR_INVALID_PARAMETER;
+	}
+
+	return BT_ERROR_NONE;
+}
+
+static void __bt_address_intern_format(char *value, const void *key)
+{
+	_bt_format_address(value, (const bluetooth_device_address_t *)key);
+}
+
+static bt_intern_table_s bt_address_intern_table = BT_INTERN_TABLE_INIT(sizeof(bluetooth_device_address_t),
+		BT_ADDRESS_STR_LEN, __bt_address_intern_format);
+
+const char *_bt_intern_address(const bluetooth_device_address_t *address)
+{
+	return _bt_intern(&bt_address_intern_table, address);
+}
+
+const char *_bt_intern_address_string(const char *address_str)
+{
+	bluetooth_device_address_t address;
+
+	if (_bt_parse_address(address_str, &address) == false)
+		return NULL;
+
+	return _bt_intern_address(&address);
+}
+
+int bt_address_intern(const char *remote_address, const char **interned_address)
+{
+	bluetooth_device_address_t addr_hex = { {0,} };
+
+	BT_CHECK_INPUT_PARAMETER(remote_address);
+	BT_CHECK_INPUT_PARAMETER(interned_address);
+	BT_CHECK_ADDRESS_TO_HEX(&addr_hex, remote_address);
+
+	*interned_address = _bt_intern_address(&addr_hex);
+	if (*interned_address == NULL) {
+		LOGE("[%s] OUT_OF_MEMORY(0x%08x)", __FUNCTION__, BT_ERROR_OUT_OF_MEMORY);
+		return BT_ERROR_OUT_OF_MEMORY;
+	}
+
+	return BT_ERROR_NONE;
+}
+
+void _bt_convert_addr_to_hex(bluetooth_device_address_t *addr_hex, const bt_addr_t *addr)
+{
+	memcpy(addr_hex->addr, addr->addr, BLUETOOTH_ADDRESS_LENGTH);
+}
+
+void _bt_convert_hex_to_addr(bt_addr_t *addr, const bluetooth_device_address_t *addr_hex)
+{
+	memcpy(addr->addr, addr_hex->addr, BLUETOOTH_ADDRESS_LENGTH);
+}
@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <glib.h>
+#include <dlog.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <bluetooth-api.h>
+
+#include "bluetooth.h"
+#include "bluetooth_private.h"
+
+#ifdef LOG_TAG
+#undef LOG_TAG
+#endif
+#define LOG_TAG "TIZEN_N_BLUETOOTH"
+
+/* First chunk, allocated with the arena. It holds a discovered device with a few services. */
+#define BT_ARENA_FIRST_CHUNK_SIZE 1024
+#define BT_ARENA_ALIGN 8
+
+/*
+ *  Chunk of the arena. Chunks are chained from the newest to the first one.
+ */
+typedef struct bt_arena_chunk_s {
+	struct bt_arena_chunk_s *previous;
+	size_t size;
+	char *cursor;
+	char data[];
+} bt_arena_chunk_s;
+
+struct bt_arena_s {
+	bt_arena_chunk_s *current;
+	bt_arena_chunk_s *spare; /* Largest chunk released by a rewind, NULL if none */
+	bool thread_arena;
+	bt_arena_chunk_s first;
+};
+
+static void __bt_arena_free_thread_arena(gpointer data);
+
+static GPrivate bt_thread_arena = G_PRIVATE_INIT(__bt_arena_free_thread_arena);
+
+static bt_arena_s *__bt_arena_create(bool thread_arena)
+{
+	bt_arena_s *arena = malloc(sizeof(bt_arena_s) + BT_ARENA_FIRST_CHUNK_SIZE);
+
+	if (arena == NULL)
+		return NULL;
+
+	arena->current = &arena->first;
+	arena->spare = NULL;
+	arena->thread_arena = thread_arena;
+	arena->first.previous = NULL;
+	arena->first.size = BT_ARENA_FIRST_CHUNK_SIZE;
+	arena->first.cursor = arena->first.data;
+
+	return arena;
+}
+
+/*
+ *  Release the chunks after @a last. The largest one is kept as the spare chunk, so the arena of a
+ *  thread stops allocating once its spare chunk holds the largest event.
+ */
+static void __bt_arena_free_chunks(bt_arena_s *arena, bt_arena_chunk_s *last)
+{
+	bt_arena_chunk_s *chunk = arena->current;
+	bt_arena_chunk_s *previous = NULL;
+
+	while (chunk != last) {
+		previous = chunk->previous;
+		if (arena->spare == NULL || arena->spare->size < chunk->size) {
+			free(arena->spare);
+			arena->spare = chunk;
+		} else {
+			free(chunk);
+		}
+		chunk = previous;
+	}
+
+	arena->current = last;
+}
+
+static void __bt_arena_free_thread_arena(gpointer data)
+{
+	_bt_arena_destroy(data);
+}
+
+bt_arena_s *_bt_arena_create(void)
+{
+	return __bt_arena_create(false);
+}
+
+void _bt_arena_destroy(bt_arena_s *arena)
+{
+	if (arena == NULL)
+		return;
+
+	__bt_arena_free_chunks(arena, &arena->first);
+	free(arena->spare);
+	free(arena);
+}
+
+bt_arena_s *_bt_arena_get_thread_arena(void)
+{
+	bt_arena_s *arena = g_private_get(&bt_thread_arena);
+
+	if (arena == NULL) {
+		arena = __bt_arena_create(true);
+		if (arena != NULL)
+			g_private_set(&bt_thread_arena, arena);
+	}
+
+	return arena;
+}
+
+bool _bt_arena_is_thread_arena(bt_arena_s *arena)
+{
+	return (arena != NULL && arena->thread_arena == true) ? true : false;
+}
+
+void _bt_arena_get_mark(bt_arena_s *arena, bt_arena_mark_s *mark)
+{
+	mark->chunk = arena->current;
+	mark->cursor = arena->current->cursor;
+}
+
+void _bt_arena_rewind(bt_arena_s *arena, const bt_arena_mark_s *mark)
+{
+	__bt_arena_free_chunks(arena, mark->chunk);
+	arena->current->cursor = mark->cursor;
+}
+
+void *_bt_arena_alloc(bt_arena_s *arena, size_t size)
+{
+	bt_arena_chunk_s *chunk = NULL;
+	size_t chunk_size;
+	void *memory = NULL;
+
+	if (arena == NULL)
+		return malloc(size);
+
+	size = (size + BT_ARENA_ALIGN - 1) & ~(size_t)(BT_ARENA_ALIGN - 1);
+
+	chunk = arena->current;
+	if ((size_t)(chunk->data + chunk->size - chunk->cursor) < size) {
+		if (arena->spare != NULL && arena->spare->size >= size) {
+			chunk = arena->spare;
+			arena->spare = NULL;
+		} else {
+			chunk_size = chunk->size * 2;
+			while (chunk_size < size)
+				chunk_size *= 2;
+
+			chunk = malloc(sizeof(bt_arena_chunk_s) + chunk_size);
+			if (chunk == NULL)
+				return NULL;
+			chunk->size = chunk_size;
+		}
+
+		chunk->previous = arena->current;
+		chunk->cursor = chunk->data;
+		arena->current = chunk;
+	}
+
+	memory = chunk->cursor;
+	chunk->cursor += size;
+
+	return memory;
+}
+
+char *_bt_arena_strdup(bt_arena_s *arena, const char *str)
+{
+	size_t size = strlen(str) + 1;
+	char *copy = _bt_arena_alloc(arena, size);
+
+	if (copy != NULL)
+		memcpy(copy, str, size);
+
+	return copy;
+}
+
+void *_bt_arena_memdup(bt_arena_s *arena, const void *memory, size_t size)
+{
+	void *copy = _bt_arena_alloc(arena, size);
+
+	if (copy != NULL)
+		memcpy(copy, memory, size);
+
+	return copy;
+}
@@ -52,7 +52,9 @@ int bt_audio_initialize(void)
 	int error = BT_ERROR_NONE;
 
 	BT_CHECK_INIT_STATUS();
+	_bt_lock(BT_LOCK_AUDIO);
 	error = bluetooth_audio_init(_bt_audio_event_proxy, NULL);
+	_bt_unlock(BT_LOCK_AUDIO);
 	error = _bt_convert_media_error_code(error);
 	error = _bt_get_error_code(error);
 	if (BT_ERROR_NONE != error) {
@@ -68,7 +70,9 @@ int bt_audio_deinitialize(void)
 
 	BT_CHECK_INIT_STATUS();
 
+	_bt_lock(BT_LOCK_AUDIO);
 	error = bluetooth_audio_deinit();
+	_bt_unlock(BT_LOCK_AUDIO);
 	error = _bt_convert_media_error_code(error);
 	error = _bt_get_error_code(error);
 	if (BT_ERROR_NONE != error) {
@@ -78,25 +82,24 @@ int bt_audio_deinitialize(void)
 	return error;
 }
 
-int bt_audio_connect(const char *remote_address, bt_audio_profile_type_e type)
+static int __bt_audio_connect(bluetooth_device_address_t *addr_hex, bt_audio_profile_type_e type)
 {
 	int error = BT_ERROR_NONE;
-	bluetooth_device_address_t addr_hex = { {0,} };
-	BT_CHECK_INIT_STATUS();
-	BT_CHECK_INPUT_PARAMETER(remote_address);
-	_bt_convert_address_to_hex(&addr_hex, remote_address);
+
+	_bt_lock(BT_LOCK_AUDIO);
 	switch(type) {
 	case BT_AUDIO_PROFILE_TYPE_HSP_HFP:
-		error = bluetooth_ag_connect(&addr_hex);
+		error = bluetooth_ag_connect(addr_hex);
 		break;
 	case BT_AUDIO_PROFILE_TYPE_A2DP:
-		error = bluetooth_av_connect(&addr_hex);
+		error = bluetooth_av_connect(addr_hex);
 		break;
 	case BT_AUDIO_PROFILE_TYPE_ALL:
 	default:
-		error = bluetooth_audio_connect(&addr_hex);
+		error = bluetooth_audio_connect(addr_hex);
 		break;
 	}
+	_bt_unlock(BT_LOCK_AUDIO);
 	error = _bt_convert_media_error_code(error);
 	error = _bt_get_error_code(error);
 	if (error != BT_ERROR_NONE) {
@@ -106,25 +109,76 @@ int bt_audio_connect(const char *remote_address, bt_audio_profile_type_e type)
 	return error;
 }
 
-int bt_audio_disconnect(const char *remote_address, bt_audio_profile_type_e type)
+int bt_audio_connect(const char *remote_address, bt_audio_profile_type_e type)
+{
+	bluetooth_device_address_t addr_hex = { {0,} };
+
+	BT_CHECK_INIT_STATUS();
+	BT_CHECK_INPUT_PARAMETER(remote_address);
+	BT_CHECK_ADDRESS_TO_HEX(&addr_hex, remote_address);
+	return __bt_audio_connect(&addr_hex, type);
+}
+
+int bt_audio_connect_by_addr(const bt_addr_t *remote_addr, bt_audio_profile_type_e type)
+{
+	bluetooth_device_address_t addr_hex = { {0,} };
+
+	BT_CHECK_INIT_STATUS();
+	BT_CHECK_INPUT_PARAMETER(remote_addr);
+	_bt_convert_addr_to_hex(&addr_hex, remote_addr);
+	return __bt_audio_connect(&addr_hex, type);
+}
+
+/* Indexed by bt_audio_profile_type_e */
+static const bt_operation_type_s bt_operation_audio_connect[] = {
+	{ { BLUETOOTH_EVENT_AG_CONNECTED, BLUETOOTH_EVENT_AV_CONNECTED }, NULL },
+	{ { BLUETOOTH_EVENT_AG_CONNECTED, 0 }, NULL },
+	{ { BLUETOOTH_EVENT_AV_CONNECTED, 0 }, NULL },
+};
+
+int bt_audio_connect_async(const char *remote_address, bt_audio_profile_type_e type, int timeout_ms,
+		bt_operation_completed_cb callback, void *user_data, int *operation_id)
 {
-	int error = BT_ERROR_NONE;
 	bluetooth_device_address_t addr_hex = { {0,} };
+	int error_code = BT_ERROR_NONE;
+
 	BT_CHECK_INIT_STATUS();
 	BT_CHECK_INPUT_PARAMETER(remote_address);
-	_bt_convert_address_to_hex(&addr_hex, remote_address);
+	BT_CHECK_ADDRESS_TO_HEX(&addr_hex, remote_address);
+	if (type < BT_AUDIO_PROFILE_TYPE_ALL || type > BT_AUDIO_PROFILE_TYPE_A2DP) {
+		LOGE("[%s] INVALID_PARAMETER(0x%08x)", __FUNCTION__, BT_ERROR_INVALID_PARAMETER);
+		return BT_ERROR_INVALID_PARAMETER;
+	}
+
+	error_code = _bt_operation_begin(&bt_operation_audio_connect[type], &addr_hex, timeout_ms, callback, user_data, operation_id);
+	if (error_code != BT_ERROR_NONE)
+		return error_code;
+
+	error_code = __bt_audio_connect(&addr_hex, type);
+	if (error_code != BT_ERROR_NONE)
+		_bt_operation_abort(*operation_id);
+
+	return error_code;
+}
+
+static int __bt_audio_disconnect(bluetooth_device_address_t *addr_hex, bt_audio_profile_type_e type)
+{
+	int error = BT_ERROR_NONE;
+
+	_bt_lock(BT_LOCK_AUDIO);
 	switch(type) {
 	case BT_AUDIO_PROFILE_TYPE_HSP_HFP:
-		error = bluetooth_ag_disconnect(&addr_hex);
+		error = bluetooth_ag_disconnect(addr_hex);
 		break;
 	case BT_AUDIO_PROFILE_TYPE_A2DP:
-		error = bluetooth_av_disconnect(&addr_hex);
+		error = bluetooth_av_disconnect(addr_hex);
 		break;
 	case BT_AUDIO_PROFILE_TYPE_ALL:
 	default:
-		error = bluetooth_audio_disconnect(&addr_hex);
+		error = bluetooth_audio_disconnect(addr_hex);
 		break;
 	}
+	_bt_unlock(BT_LOCK_AUDIO);
 	error = _bt_convert_media_error_code(error);
 	error = _bt_get_error_code(error);
 	if (error != BT_ERROR_NONE) {
@@ -134,6 +188,26 @@ int bt_audio_disconnect(const char *remote_address, bt_audio_profile_type_e type
 	return error;
 }
 
+int bt_audio_disconnect(const char *remote_address, bt_audio_profile_type_e type)
+{
+	bluetooth_device_address_t addr_hex = { {0,} };
+
+	BT_CHECK_INIT_STATUS();
+	BT_CHECK_INPUT_PARAMETER(remote_address);
+	BT_CHECK_ADDRESS_TO_HEX(&addr_hex, remote_address);
+	return __bt_audio_disconnect(&addr_hex, type);
+}
+
+int bt_audio_disconnect_by_addr(const bt_addr_t *remote_addr, bt_audio_profile_type_e type)
+{
+	bluetooth_device_address_t addr_hex = { {0,} };
+
+	BT_CHECK_INIT_STATUS();
+	BT_CHECK_INPUT_PARAMETER(remote_addr);
+	_bt_convert_addr_to_hex(&addr_hex, remote_addr);
+	return __bt_audio_disconnect(&addr_hex, type);
+}
+
 int bt_audio_set_connection_state_changed_cb(bt_audio_connection_state_changed_cb callback, void *user_data)
 {
 	BT_CHECK_INIT_STATUS();
@@ -156,7 +230,9 @@ int bt_ag_notify_speaker_gain(const char *remote_address, int gain)
 
 	BT_CHECK_INIT_STATUS();
 	BT_CHECK_INPUT_PARAMETER(remote_address);
+	_bt_lock(BT_LOCK_AUDIO);
 	error = bluetooth_ag_set_speaker_gain((unsigned short)gain);
+	_bt_unlock(BT_LOCK_AUDIO);
 	error = _bt_convert_media_error_code(error);
 	error = _bt_get_error_code(error);
 	if (BT_ERROR_NONE != error) {
@@ -173,7 +249,9 @@ int bt_ag_get_speaker_gain(const char *remote_address, int *gain)
 	BT_CHECK_INIT_STATUS();
 	BT_CHECK_INPUT_PARAMETER(gain);
 	BT_CHECK_INPUT_PARAMETER(remote_address);
+	_bt_lock(BT_LOCK_AUDIO);
 	error = bluetooth_ag_get_headset_volume((unsigned int *)gain);
+	_bt_unlock(BT_LOCK_AUDIO);
 	error = _bt_convert_media_error_code(error);
 	error = _bt_get_error_code(error);
 	if (BT_ERROR_NONE != error) {
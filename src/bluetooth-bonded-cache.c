@@ -0,0 +1,355 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <glib.h>
+#include <dlog.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <bluetooth-api.h>
+
+#include "bluetooth.h"
+#include "bluetooth_private.h"
+
+#ifdef LOG_TAG
+#undef LOG_TAG
+#endif
+#define LOG_TAG "TIZEN_N_BLUETOOTH"
+
+/*
+ *  Bonded device cache
+ *
+ *  The bonded devices are read from the F/W once, then kept current by the bonding,
+ *  authorization, connection and service search events, so the queries need no IPC.
+ *  The records of the F/W are kept as they are, keyed by their interned address.
+ *
+ *  The list is read without the lock. An event received meanwhile may not be part of
+ *  the list, so the list is then used for that query only, and read again by the next.
+ */
+
+static GMutex bt_bonded_cache_lock;
+static GHashTable *bt_bonded_cache = NULL; /* NULL until read from the F/W */
+static guint bt_bonded_cache_generation = 0;
+static bt_adapter_bonded_device_cache_stats_s bt_bonded_cache_stats;
+
+static GHashTable *__bt_bonded_cache_read(int *result)
+{
+	GPtrArray *dev_list = NULL;
+	GHashTable *table = NULL;
+	bluetooth_device_info_t *ptr = NULL;
+	bluetooth_device_info_t *info = NULL;
+	const char *address = NULL;
+	int i;
+
+	dev_list = g_ptr_array_new();
+	if (dev_list == NULL) {
+		*result = BT_ERROR_OUT_OF_MEMORY;
+		return NULL;
+	}
+
+	*result = _bt_get_error_code(bluetooth_get_bonded_device_list(&dev_list));
+	if (*result != BT_ERROR_NONE) {
+		g_ptr_array_free(dev_list, TRUE);
+		return NULL;
+	}
+
+	table = g_hash_table_new_full(g_direct_hash, g_direct_equal, NULL, free);
+	for (i = 0; i < dev_list->len; i++) {
+		ptr = g_ptr_array_index(dev_list, i);
+		if (ptr == NULL) {
+			*result = BT_ERROR_OPERATION_FAILED;
+			break;
+		}
+
+		address = _bt_intern_address(&ptr->device_address);
+		info = malloc(sizeof(bluetooth_device_info_t));
+		if (address == NULL || info == NULL) {
+			free(info);
+			*result = BT_ERROR_OUT_OF_MEMORY;
+			break;
+		}
+		memcpy(info, ptr, sizeof(bluetooth_device_info_t));
+		g_hash_table_replace(table, (gpointer)address, info);
+	}
+
+	g_ptr_array_free(dev_list, TRUE);
+
+	if (*result != BT_ERROR_NONE) {
+		g_hash_table_destroy(table);
+		return NULL;
+	}
+
+	return table;
+}
+
+/*
+ *  Get the bonded devices with bt_bonded_cache_lock held, reading them from the F/W if needed.
+ *  The returned table must be released with __bt_bonded_cache_release().
+ */
+static GHashTable *__bt_bonded_cache_acquire(bool force, int *result)
+{
+	GHashTable *table = NULL;
+	guint generation = 0;
+
+	*result = BT_ERROR_NONE;
+
+	g_mutex_lock(&bt_bonded_cache_lock);
+	if (force == false && bt_bonded_cache != NULL) {
+		bt_bonded_cache_stats.hits++;
+		return bt_bonded_cache;
+	}
+	if (force == false)
+		bt_bonded_cache_stats.misses++;
+	generation = bt_bonded_cache_generation;
+	g_mutex_unlock(&bt_bonded_cache_lock);
+
+	table = __bt_bonded_cache_read(result);
+	if (table == NULL)
+		return NULL;
+
+	g_mutex_lock(&bt_bonded_cache_lock);
+	bt_bonded_cache_stats.refreshes++;
+	if (generation == bt_bonded_cache_generation) {
+		if (bt_bonded_cache != NULL)
+			g_hash_table_destroy(bt_bonded_cache);
+		bt_bonded_cache = table;
+	}
+
+	return table;
+}
+
+static void __bt_bonded_cache_release(GHashTable *table)
+{
+	bool owned = (table != bt_bonded_cache) ? true : false;
+
+	g_mutex_unlock(&bt_bonded_cache_lock);
+
+	/* Not published, because an event was received while it was read */
+	if (owned == true)
+		g_hash_table_destroy(table);
+}
+
+int _bt_bonded_cache_foreach(bt_adapter_bonded_device_cb foreach_cb, void *user_data)
+{
+	GHashTable *table = NULL;
+	GHashTableIter iter;
+	gpointer value = NULL;
+	bt_device_info_s **dev_infos = NULL;
+	guint count = 0;
+	guint i;
+	int ret = BT_ERROR_NONE;
+
+	table = __bt_bonded_cache_acquire(false, &ret);
+	if (table == NULL)
+		return ret;
+
+	/* Converted under the lock, so the callback may call the Bluetooth API */
+	if (g_hash_table_size(table) > 0) {
+		dev_infos = malloc(sizeof(bt_device_info_s *) * g_hash_table_size(table));
+		if (dev_infos == NULL)
+			ret = BT_ERROR_OUT_OF_MEMORY;
+	}
+
+	g_hash_table_iter_init(&iter, table);
+	while (ret == BT_ERROR_NONE && g_hash_table_iter_next(&iter, NULL, &value)) {
+		ret = _bt_get_bt_device_info_s(&dev_infos[count], value, NULL);
+		if (ret == BT_ERROR_NONE)
+			count++;
+	}
+	__bt_bonded_cache_release(table);
+
+	if (ret != BT_ERROR_NONE)
+		LOGE("[%s] %s(0x%08x) : Failed to get device info", __FUNCTION__, _bt_convert_error_to_string(ret), ret);
+
+	for (i = 0; i < count && ret == BT_ERROR_NONE; i++) {
+		if (!foreach_cb(dev_infos[i], user_data))
+			break;
+	}
+
+	for (i = 0; i < count; i++)
+		_bt_free_bt_device_info_s(dev_infos[i]);
+	free(dev_infos);
+
+	return ret;
+}
+
+int _bt_bonded_cache_get(const bluetooth_device_address_t *address, bt_device_info_s **device_info)
+{
+	GHashTable *table = NULL;
+	bluetooth_device_info_t *info = NULL;
+	const char *interned = NULL;
+	int ret = BT_ERROR_NONE;
+
+	interned = _bt_intern_address(address);
+	if (interned == NULL)
+		return BT_ERROR_OUT_OF_MEMORY;
+
+	table = __bt_bonded_cache_acquire(false, &ret);
+	if (table == NULL)
+		return ret;
+
+	info = g_hash_table_lookup(table, interned);
+	if (info != NULL)
+		ret = _bt_get_bt_device_info_s(device_info, info, NULL);
+	else
+		ret = BT_ERROR_REMOTE_DEVICE_NOT_BONDED;
+	__bt_bonded_cache_release(table);
+
+	return ret;
+}
+
+static bluetooth_device_info_t *__bt_bonded_cache_lookup(const bluetooth_device_address_t *address)
+{
+	const char *interned = NULL;
+
+	if (bt_bonded_cache == NULL)
+		return NULL;
+
+	interned = _bt_intern_address(address);
+	if (interned == NULL)
+		return NULL;
+
+	return g_hash_table_lookup(bt_bonded_cache, interned);
+}
+
+void _bt_bonded_cache_update(int event, bluetooth_event_param_t *param)
+{
+	bluetooth_device_info_t *source_info = NULL;
+	bluetooth_device_info_t *info = NULL;
+	bt_sdp_info_t *sdp_info = NULL;
+	const char *interned = NULL;
+	int count;
+
+	g_mutex_lock(&bt_bonded_cache_lock);
+	bt_bonded_cache_generation++;
+
+	switch (event) {
+	case BLUETOOTH_EVENT_BONDING_FINISHED:
+		source_info = param->param_data;
+		if (bt_bonded_cache == NULL || param->result != BLUETOOTH_ERROR_NONE || source_info == NULL)
+			break;
+
+		interned = _bt_intern_address(&source_info->device_address);
+		info = malloc(sizeof(bluetooth_device_info_t));
+		if (interned == NULL || info == NULL) {
+			/* Read again by the next query */
+			free(info);
+			g_hash_table_destroy(bt_bonded_cache);
+			bt_bonded_cache = NULL;
+			break;
+		}
+		memcpy(info, source_info, sizeof(bluetooth_device_info_t));
+		info->paired = TRUE;
+		g_hash_table_replace(bt_bonded_cache, (gpointer)interned, info);
+		break;
+	case BLUETOOTH_EVENT_BONDED_DEVICE_REMOVED:
+		if (bt_bonded_cache == NULL || param->param_data == NULL)
+			break;
+
+		interned = _bt_intern_address(param->param_data);
+		if (interned != NULL)
+			g_hash_table_remove(bt_bonded_cache, interned);
+		break;
+	case BLUETOOTH_EVENT_DEVICE_AUTHORIZED:
+	case BLUETOOTH_EVENT_DEVICE_UNAUTHORIZED:
+		if (param->result != BLUETOOTH_ERROR_NONE || param->param_data == NULL)
+			break;
+
+		info = __bt_bonded_cache_lookup(param->param_data);
+		if (info != NULL)
+			info->trust = (event == BLUETOOTH_EVENT_DEVICE_AUTHORIZED) ? TRUE : FALSE;
+		break;
+	case BLUETOOTH_EVENT_DEVICE_CONNECTED:
+	case BLUETOOTH_EVENT_DEVICE_DISCONNECTED:
+		if (param->param_data == NULL)
+			break;
+
+		info = __bt_bonded_cache_lookup(param->param_data);
+		if (info != NULL)
+			info->connected = (event == BLUETOOTH_EVENT_DEVICE_CONNECTED) ? TRUE : FALSE;
+		break;
+	case BLUETOOTH_EVENT_SERVICE_SEARCHED:
+		sdp_info = param->param_data;
+		if (param->result != BLUETOOTH_ERROR_NONE || sdp_info == NULL)
+			break;
+
+		info = __bt_bonded_cache_lookup(&sdp_info->device_addr);
+		if (info == NULL)
+			break;
+
+		count = (sdp_info->service_index > 0) ? sdp_info->service_index : 0;
+		if (count > BLUETOOTH_MAX_SERVICES_FOR_DEVICE)
+			count = BLUETOOTH_MAX_SERVICES_FOR_DEVICE;
+		info->service_index = count;
+		memcpy(info->service_list_array, sdp_info->service_list_array, sizeof(info->service_list_array[0]) * count);
+		memcpy(info->uuids, sdp_info->uuids, sizeof(info->uuids[0]) * count);
+		break;
+	case BLUETOOTH_EVENT_DISABLED:
+		/* Read again once enabled */
+		if (bt_bonded_cache != NULL) {
+			g_hash_table_destroy(bt_bonded_cache);
+			bt_bonded_cache = NULL;
+		}
+		break;
+	default:
+		break;
+	}
+
+	g_mutex_unlock(&bt_bonded_cache_lock);
+}
+
+void _bt_bonded_cache_clear(void)
+{
+	g_mutex_lock(&bt_bonded_cache_lock);
+	bt_bonded_cache_generation++;
+	if (bt_bonded_cache != NULL) {
+		g_hash_table_destroy(bt_bonded_cache);
+		bt_bonded_cache = NULL;
+	}
+	memset(&bt_bonded_cache_stats, 0x00, sizeof(bt_bonded_cache_stats));
+	g_mutex_unlock(&bt_bonded_cache_lock);
+}
+
+int bt_adapter_refresh_bonded_device_cache(void)
+{
+	GHashTable *table = NULL;
+	int ret = BT_ERROR_NONE;
+
+	BT_CHECK_INIT_STATUS();
+
+	table = __bt_bonded_cache_acquire(true, &ret);
+	if (table == NULL) {
+		LOGE("[%s] %s(0x%08x) : Failed to get bonded device list", __FUNCTION__, _bt_convert_error_to_string(ret), ret);
+		return ret;
+	}
+	__bt_bonded_cache_release(table);
+
+	return BT_ERROR_NONE;
+}
+
+int bt_adapter_get_bonded_device_cache_stats(bt_adapter_bonded_device_cache_stats_s *stats)
+{
+	BT_CHECK_INIT_STATUS();
+	BT_CHECK_INPUT_PARAMETER(stats);
+
+	g_mutex_lock(&bt_bonded_cache_lock);
+	*stats = bt_bonded_cache_stats;
+	stats->count = (bt_bonded_cache != NULL) ? (int)g_hash_table_size(bt_bonded_cache) : -1;
+	g_mutex_unlock(&bt_bonded_cache_lock);
+
+	return BT_ERROR_NONE;
+}
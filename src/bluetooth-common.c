@@ -31,48 +31,75 @@
 #endif
 #define LOG_TAG "TIZEN_N_BLUETOOTH"
 
-static bool is_initialized = false;
-static bt_event_sig_event_slot_s bt_event_slot_container[] = {
-	{BT_EVENT_STATE_CHANGED, NULL, NULL},
-	{BT_EVENT_NAME_CHANGED, NULL, NULL},
-	{BT_EVENT_VISIBILITY_MODE_CHANGED, NULL, NULL},
-	{BT_EVENT_DEVICE_DISCOVERY_STATE_CHANGED, NULL, NULL},
-	{BT_EVENT_BOND_CREATED, NULL, NULL},
-	{BT_EVENT_BOND_DESTROYED, NULL, NULL},
-	{BT_EVENT_AUTHORIZATION_CHANGED, NULL, NULL},
-	{BT_EVENT_SERVICE_SEARCHED, NULL, NULL},
-	{BT_EVENT_DATA_RECEIVED, NULL, NULL},
-	{BT_EVENT_CONNECTION_STATE_CHANGED, NULL, NULL},
-	{BT_EVENT_RFCOMM_CONNECTION_REQUESTED, NULL, NULL},
-	{BT_EVENT_OPP_CONNECTION_REQUESTED, NULL, NULL},
-	{BT_EVENT_OPP_PUSH_REQUESTED, NULL, NULL},
-	{BT_EVENT_OPP_SERVER_TRANSFER_PROGRESS, NULL, NULL},
-	{BT_EVENT_OPP_SERVER_TRANSFER_FINISHED, NULL, NULL},
-	{BT_EVENT_OPP_CLIENT_PUSH_RESPONSED, NULL, NULL},
-	{BT_EVENT_OPP_CLIENT_PUSH_PROGRESS, NULL, NULL},
-	{BT_EVENT_OPP_CLIENT_PUSH_FINISHED, NULL, NULL},
-	{BT_EVENT_PAN_CONNECTION_STATE_CHANGED, NULL, NULL},
-	{BT_EVENT_NAP_CONNECTION_STATE_CHANGED, NULL, NULL},
-	{BT_EVENT_HDP_CONNECTED, NULL, NULL},
-	{BT_EVENT_HDP_DISCONNECTED, NULL, NULL},
-	{BT_EVENT_HDP_DATA_RECIEVED, NULL, NULL},
-	{BT_EVENT_AUDIO_CONNECTION_STATUS, NULL, NULL},
-	{BT_EVENT_AG_MICROPHONE_GAIN_CHANGE, NULL, NULL},
-	{BT_EVENT_AG_MICROPHONE_GAIN_CHANGE, NULL, NULL},
-	{BT_EVENT_AVRCP_CONNECTION_STATUS, NULL, NULL},
-	{BT_EVENT_HID_CONNECTION_STATUS, NULL, NULL}
+static volatile gint bt_init_count = 0; /* Number of bt_initialize() not yet deinitialized */
+static GMutex bt_init_lock;
+static GMutex bt_subsystem_locks[BT_LOCK_MAX];
+
+/*
+ *  Event listener registry
+ *
+ *  Listeners of each event are kept in an immutable array. The event proxy reads the
+ *  published array without taking a lock, while (un)subscriptions build a new copy under
+ *  bt_event_registry_lock and publish it atomically. Replaced arrays are retired and only
+ *  freed once no dispatch is in flight, so a reader never sees a freed array.
+ */
+typedef struct bt_event_listener_array_s {
+	struct bt_event_listener_array_s *retired_next;
+	bt_event_address_filter_s *retired_filter; /* Filter of a listener which the next array dropped */
+	bt_event_address_filter_s *any_filter; /* Union of the filters, NULL if a listener takes every device */
+	int filtered; /* Number of listeners with a filter */
+	int binary; /* Number of listeners taking the binary address */
+	int count;
+	bt_event_sig_event_slot_s listeners[];
+} bt_event_listener_array_s;
+
+/*
+ *  Set of remote device addresses, probed with the raw F/W address.
+ *  Open addressing over a power of two table; a key is the 48 bit address plus a used bit.
+ */
+struct bt_event_address_filter_s {
+	guint mask;
+	guint64 keys[];
 };
 
+#define BT_EVENT_ADDRESS_KEY_USED (1ULL << 48)
+
+static bt_event_listener_array_s *bt_event_listeners[BT_EVENT_MAX];
+static bt_event_listener_array_s *bt_event_retired_listeners = NULL;
+static volatile gint bt_event_legacy_id[BT_EVENT_MAX]; /* Subscription used by _bt_set_cb() */
+static int bt_event_last_id = 0;
+static volatile gint bt_event_readers = 0;
+static GMutex bt_event_registry_lock;
+
+/*
+ *  Dispatch entry of a Bluetooth F/W event
+ */
+typedef struct {
+	int index; /* Listeners in bt_event_listeners */
+	int arg; /* Constant argument handed to the converter (state, percentage, ...) */
+	bool (*convert)(int arg, bluetooth_event_param_t *param, bt_event_data_s *data);
+	bool (*address)(bluetooth_event_param_t *param, bluetooth_device_address_t *address); /* Raw remote address */
+	void (*invoke)(const void *callback, bt_event_data_s *data, void *user_data);
+} bt_event_dispatch_s;
+
 /*
  *  Internal Functions
  */
 static void __bt_event_proxy(int event, bluetooth_event_param_t * param, void *user_data);
-static int __bt_get_cb_index(int event);
+static int __bt_event_add_listener(int index, bt_event_sig_event_slot_s *listener, int *subscription_id);
+static int __bt_event_update_listener(int index, int id, const bt_event_sig_event_slot_s *listener);
+static guint64 __bt_event_address_key(const bluetooth_device_address_t *address);
+static bt_event_address_filter_s *__bt_event_create_filter(int count);
+static void __bt_event_filter_add(bt_event_address_filter_s *filter, guint64 key);
+static bool __bt_event_filter_contains(const bt_event_address_filter_s *filter, const bluetooth_device_address_t *address);
+static int __bt_event_find_listener(int id);
+static bool __bt_event_has_address(int index);
+static void __bt_event_reclaim_listeners(void);
+static void __bt_event_enter_readers(void);
+static void __bt_event_leave_readers(void);
 static void __bt_convert_lower_to_upper(char *origin);
-static int __bt_get_bt_device_sdp_info_s(bt_device_sdp_info_s **dest, bt_sdp_info_t *source);
-static void __bt_free_bt_device_sdp_info_s(bt_device_sdp_info_s *sdp_info);
-static int __bt_get_bt_adapter_device_discovery_info_s(bt_adapter_device_discovery_info_s **discovery_info, bluetooth_device_info_t *source_info);
-static void __bt_free_bt_adapter_device_discovery_info_s(bt_adapter_device_discovery_info_s *discovery_info);
+static const char *__bt_convert_address_string(bt_arena_s *arena, const char *address_str);
+static char *__bt_convert_uuid_in_arena(bt_arena_s *arena, const char *uuid, guint64 *service_mask);
 
 
 /*
@@ -81,36 +108,216 @@ static void __bt_free_bt_adapter_device_discovery_info_s(bt_adapter_device_disco
 
 int bt_initialize(void)
 {
-	if (is_initialized != true) {
+	g_mutex_lock(&bt_init_lock);
+	if (g_atomic_int_get(&bt_init_count) == 0) {
 		if (bluetooth_register_callback(&__bt_event_proxy, NULL) != BLUETOOTH_ERROR_NONE) {
+			g_mutex_unlock(&bt_init_lock);
 			LOGE("[%s] OPERATION_FAILED(0x%08x)", __FUNCTION__, BT_ERROR_OPERATION_FAILED);
 			return BT_ERROR_OPERATION_FAILED;
 		}
-		is_initialized = true;
+		_bt_sdp_cache_open();
 	}
+	g_atomic_int_inc(&bt_init_count);
+	g_mutex_unlock(&bt_init_lock);
 
 	return BT_ERROR_NONE;
 }
 
 int bt_deinitialize(void)
 {
+	bool last = false;
+
 	BT_CHECK_INIT_STATUS();
-	if (bluetooth_unregister_callback() != BLUETOOTH_ERROR_NONE) {
-		LOGE("[%s] OPERATION_FAILED(0x%08x)", __FUNCTION__, BT_ERROR_OPERATION_FAILED);
-		return BT_ERROR_OPERATION_FAILED;
+
+	g_mutex_lock(&bt_init_lock);
+	if (g_atomic_int_get(&bt_init_count) == 0) {
+		g_mutex_unlock(&bt_init_lock);
+		LOGE("[%s] NOT_INITIALIZED(0x%08x)", __FUNCTION__, BT_ERROR_NOT_INITIALIZED);
+		return BT_ERROR_NOT_INITIALIZED;
+	}
+
+	if (g_atomic_int_get(&bt_init_count) == 1) {
+		if (bluetooth_unregister_callback() != BLUETOOTH_ERROR_NONE) {
+			g_mutex_unlock(&bt_init_lock);
+			LOGE("[%s] OPERATION_FAILED(0x%08x)", __FUNCTION__, BT_ERROR_OPERATION_FAILED);
+			return BT_ERROR_OPERATION_FAILED;
+		}
+		_bt_dispatch_stop();
+		_bt_device_cache_clear();
+		_bt_bonded_cache_clear();
+		_bt_adapter_cache_clear();
+		_bt_sdp_cache_close();
+		_bt_discovery_filter_clear();
+		_bt_discovery_schedule_stop();
+		_bt_discovery_session_close_all();
+		_bt_proximity_clear();
+		last = true;
+	}
+	g_atomic_int_add(&bt_init_count, -1);
+	g_mutex_unlock(&bt_init_lock);
+
+	/* No event completes them anymore, and their callbacks may call the API */
+	if (last == true) {
+		_bt_operation_cancel_all();
+		_bt_sdp_queue_cancel_all();
+		_bt_device_finder_cancel_all();
 	}
-	is_initialized = false;
 
 	return BT_ERROR_NONE;
 }
 
+int bt_event_subscribe(bt_event_e event, void *callback, void *user_data, int *subscription_id)
+{
+	bt_event_sig_event_slot_s listener = { 0, };
+	int error_code = BT_ERROR_NONE;
+
+	BT_CHECK_INIT_STATUS();
+	BT_CHECK_INPUT_PARAMETER(callback);
+	BT_CHECK_INPUT_PARAMETER(subscription_id);
+	if (event < 0 || event >= BT_EVENT_MAX) {
+		LOGE("[%s] INVALID_PARAMETER(0x%08x)", __FUNCTION__, BT_ERROR_INVALID_PARAMETER);
+		return BT_ERROR_INVALID_PARAMETER;
+	}
+
+	listener.callback = callback;
+	listener.user_data = user_data;
+
+	error_code = __bt_event_add_listener(event, &listener, subscription_id);
+	if (error_code != BT_ERROR_NONE) {
+		LOGE("[%s] %s(0x%08x)", __FUNCTION__, _bt_convert_error_to_string(error_code), error_code);
+	}
+
+	return error_code;
+}
+
+int bt_event_subscribe_with_filter(bt_event_e event, const char *remote_addresses[], int address_count,
+		void *callback, void *user_data, int *subscription_id)
+{
+	bt_event_sig_event_slot_s listener = { 0, };
+	bt_event_address_filter_s *filter = NULL;
+	bluetooth_device_address_t address;
+	int error_code = BT_ERROR_NONE;
+	int i;
+
+	BT_CHECK_INIT_STATUS();
+	BT_CHECK_INPUT_PARAMETER(remote_addresses);
+	BT_CHECK_INPUT_PARAMETER(callback);
+	BT_CHECK_INPUT_PARAMETER(subscription_id);
+	if (event < 0 || event >= BT_EVENT_MAX || address_count <= 0) {
+		LOGE("[%s] INVALID_PARAMETER(0x%08x)", __FUNCTION__, BT_ERROR_INVALID_PARAMETER);
+		return BT_ERROR_INVALID_PARAMETER;
+	}
+
+	filter = __bt_event_create_filter(address_count);
+	if (filter == NULL) {
+		LOGE("[%s] OUT_OF_MEMORY(0x%08x)", __FUNCTION__, BT_ERROR_OUT_OF_MEMORY);
+		return BT_ERROR_OUT_OF_MEMORY;
+	}
+
+	for (i = 0; i < address_count; i++) {
+		if (remote_addresses[i] == NULL ||
+				_bt_parse_address(remote_addresses[i], &address) == false) {
+			free(filter);
+			LOGE("[%s] INVALID_PARAMETER(0x%08x)", __FUNCTION__, BT_ERROR_INVALID_PARAMETER);
+			return BT_ERROR_INVALID_PARAMETER;
+		}
+		__bt_event_filter_add(filter, __bt_event_address_key(&address));
+	}
+
+	listener.callback = callback;
+	listener.user_data = user_data;
+	listener.filter = filter;
+
+	error_code = __bt_event_add_listener(event, &listener, subscription_id);
+	if (error_code != BT_ERROR_NONE) {
+		free(filter);
+		LOGE("[%s] %s(0x%08x)", __FUNCTION__, _bt_convert_error_to_string(error_code), error_code);
+	}
+
+	return error_code;
+}
+
+int bt_event_subscribe_device_view(bt_event_e event, void *callback, void *user_data, int *subscription_id)
+{
+	bt_event_sig_event_slot_s listener = { 0, };
+	int error_code = BT_ERROR_NONE;
+
+	BT_CHECK_INIT_STATUS();
+	BT_CHECK_INPUT_PARAMETER(callback);
+	BT_CHECK_INPUT_PARAMETER(subscription_id);
+	if (event != BT_EVENT_DEVICE_DISCOVERY_STATE_CHANGED && event != BT_EVENT_BOND_CREATED) {
+		LOGE("[%s] INVALID_PARAMETER(0x%08x)", __FUNCTION__, BT_ERROR_INVALID_PARAMETER);
+		return BT_ERROR_INVALID_PARAMETER;
+	}
+
+	listener.callback = callback;
+	listener.user_data = user_data;
+	listener.view = true;
+
+	error_code = __bt_event_add_listener(event, &listener, subscription_id);
+	if (error_code != BT_ERROR_NONE) {
+		LOGE("[%s] %s(0x%08x)", __FUNCTION__, _bt_convert_error_to_string(error_code), error_code);
+	}
+
+	return error_code;
+}
+
+int bt_event_subscribe_addr(bt_event_e event, bt_event_addr_cb callback, void *user_data, int *subscription_id)
+{
+	bt_event_sig_event_slot_s listener = { 0, };
+	int error_code = BT_ERROR_NONE;
+
+	BT_CHECK_INIT_STATUS();
+	BT_CHECK_INPUT_PARAMETER(callback);
+	BT_CHECK_INPUT_PARAMETER(subscription_id);
+	if (event < 0 || event >= BT_EVENT_MAX || __bt_event_has_address(event) == false) {
+		LOGE("[%s] INVALID_PARAMETER(0x%08x)", __FUNCTION__, BT_ERROR_INVALID_PARAMETER);
+		return BT_ERROR_INVALID_PARAMETER;
+	}
+
+	listener.callback = callback;
+	listener.user_data = user_data;
+	listener.binary = true;
+
+	error_code = __bt_event_add_listener(event, &listener, subscription_id);
+	if (error_code != BT_ERROR_NONE) {
+		LOGE("[%s] %s(0x%08x)", __FUNCTION__, _bt_convert_error_to_string(error_code), error_code);
+	}
+
+	return error_code;
+}
+
+int bt_event_unsubscribe(int subscription_id)
+{
+	int error_code = BT_ERROR_NONE;
+	int index = -1;
+
+	BT_CHECK_INIT_STATUS();
+
+	g_mutex_lock(&bt_event_registry_lock);
+	if (subscription_id > 0)
+		index = __bt_event_find_listener(subscription_id);
+
+	if (index < 0)
+		error_code = BT_ERROR_INVALID_PARAMETER;
+	else
+		error_code = __bt_event_update_listener(index, subscription_id, NULL);
+	g_mutex_unlock(&bt_event_registry_lock);
+
+	if (error_code != BT_ERROR_NONE) {
+		LOGE("[%s] %s(0x%08x)", __FUNCTION__, _bt_convert_error_to_string(error_code), error_code);
+	}
+
+	return error_code;
+}
+
 
 /*
  *  Common Functions
  */
 int _bt_check_init_status(void)
 {
-	if (is_initialized != true)
+	if (g_atomic_int_get(&bt_init_count) <= 0)
 	{
 		LOGE("[%s] NOT_INITIALIZED(0x%08x)", __FUNCTION__, BT_ERROR_NOT_INITIALIZED);
 		return BT_ERROR_NOT_INITIALIZED;
@@ -119,23 +326,59 @@ int _bt_check_init_status(void)
 	return BT_ERROR_NONE;
 }
 
+void _bt_lock(bt_lock_e lock)
+{
+	g_mutex_lock(&bt_subsystem_locks[lock]);
+}
+
+void _bt_unlock(bt_lock_e lock)
+{
+	g_mutex_unlock(&bt_subsystem_locks[lock]);
+}
+
 void _bt_set_cb(int events, void *callback, void *user_data)
 {
-	bt_event_slot_container[events].callback = callback;
-	bt_event_slot_container[events].user_data = user_data;
+	bt_event_sig_event_slot_s listener = { 0, };
+	int id = 0;
+
+	if (events < 0 || events >= BT_EVENT_MAX)
+		return;
+
+	listener.callback = callback;
+	listener.user_data = user_data;
+
+	g_mutex_lock(&bt_event_registry_lock);
+	id = bt_event_legacy_id[events];
+	if (id == 0)
+		id = ++bt_event_last_id;
+
+	if (__bt_event_update_listener(events, id, (callback != NULL) ? &listener : NULL) != BT_ERROR_NONE) {
+		LOGE("[%s] OUT_OF_MEMORY(0x%08x)", __FUNCTION__, BT_ERROR_OUT_OF_MEMORY);
+	} else {
+		g_atomic_int_set(&bt_event_legacy_id[events], (callback != NULL) ? id : 0);
+	}
+	g_mutex_unlock(&bt_event_registry_lock);
 }
 
 void _bt_unset_cb(int events)
 {
-	if (bt_event_slot_container[events].callback != NULL) {
-		bt_event_slot_container[events].callback = NULL;
-		bt_event_slot_container[events].user_data = NULL;
+	if (events < 0 || events >= BT_EVENT_MAX)
+		return;
+
+	g_mutex_lock(&bt_event_registry_lock);
+	if (bt_event_legacy_id[events] != 0) {
+		__bt_event_update_listener(events, bt_event_legacy_id[events], NULL);
+		g_atomic_int_set(&bt_event_legacy_id[events], 0);
 	}
+	g_mutex_unlock(&bt_event_registry_lock);
 }
 
 bool _bt_check_cb(int events)
 {
-	return (bt_event_slot_container[events].callback != NULL) ? true : false;
+	if (events < 0 || events >= BT_EVENT_MAX)
+		return false;
+
+	return (g_atomic_int_get(&bt_event_legacy_id[events]) != 0) ? true : false;
 }
 
 int _bt_get_error_code(int origin_error)
@@ -193,42 +436,84 @@ int _bt_get_error_code(int origin_error)
 
 }
 
-int _bt_get_bt_device_info_s(bt_device_info_s **dest_dev, bluetooth_device_info_t *source_dev)
+/*
+ *  The device information is a single block, so it is freed at once:
+ *  bt_device_info_ext_s | service_uuid[] | remote_address | remote_name | malformed UUID strings
+ *  Well-formed UUIDs point to interned strings.
+ */
+int _bt_get_bt_device_info_s(bt_device_info_s **dest_dev, bluetooth_device_info_t *source_dev, bt_arena_s *arena)
 {
+	bt_device_info_ext_s *device_ext = NULL;
+	const char *uuids[BLUETOOTH_MAX_SERVICES_FOR_DEVICE];
+	guint64 service_mask = 0;
+	int service_count = 0;
+	size_t name_len = 0;
+	size_t uuid_len = 0;
+	size_t size = 0;
+	char *pool = NULL;
 	int i = 0;
 
 	BT_CHECK_INPUT_PARAMETER(source_dev);
 
-	*dest_dev = (bt_device_info_s *)malloc(sizeof(bt_device_info_s));
-	if (*dest_dev == NULL) {
+	service_count = (source_dev->service_index > 0) ? source_dev->service_index : 0;
+	if (service_count > BLUETOOTH_MAX_SERVICES_FOR_DEVICE)
+		service_count = BLUETOOTH_MAX_SERVICES_FOR_DEVICE;
+	name_len = strlen(source_dev->device_name.name);
+
+	size = sizeof(bt_device_info_ext_s) + sizeof(char *) * service_count + BT_ADDRESS_STR_LEN;
+	if (name_len > 0)
+		size += name_len + 1;
+	for (i = 0; i < service_count; i++) {
+		uuids[i] = _bt_convert_uuid(source_dev->uuids[i], &service_mask);
+		if (uuids[i] == NULL)
+			size += strlen(source_dev->uuids[i]) + 1;
+	}
+
+	device_ext = (bt_device_info_ext_s *)_bt_arena_alloc(arena, size);
+	if (device_ext == NULL) {
+		*dest_dev = NULL;
 		return BT_ERROR_OUT_OF_MEMORY;
 	}
+	device_ext->service_mask = service_mask;
+	*dest_dev = &device_ext->info;
+	pool = (char *)(device_ext + 1);
+
+	if (service_count > 0) {
+		(*dest_dev)->service_uuid = (char **)pool;
+		pool += sizeof(char *) * service_count;
+	} else {
+		(*dest_dev)->service_uuid = NULL;
+	}
+
+	(*dest_dev)->remote_address = pool;
+	_bt_format_address(pool, &(source_dev->device_address));
+	pool += BT_ADDRESS_STR_LEN;
 
-	if (strlen(source_dev->device_name.name) > 0) {
-		(*dest_dev)->remote_name = strdup(source_dev->device_name.name);
+	if (name_len > 0) {
+		(*dest_dev)->remote_name = pool;
+		memcpy(pool, source_dev->device_name.name, name_len + 1);
+		pool += name_len + 1;
 	} else {
 		(*dest_dev)->remote_name = NULL;
 	}
 
-	_bt_convert_address_to_string(&((*dest_dev)->remote_address), &(source_dev->device_address));
+	for (i = 0; i < service_count; i++) {
+		if (uuids[i] != NULL) {
+			(*dest_dev)->service_uuid[i] = (char *)uuids[i];
+			continue;
+		}
+
+		uuid_len = strlen(source_dev->uuids[i]);
+		(*dest_dev)->service_uuid[i] = pool;
+		memcpy(pool, source_dev->uuids[i], uuid_len + 1);
+		__bt_convert_lower_to_upper(pool);
+		pool += uuid_len + 1;
+	}
 
 	(*dest_dev)->bt_class.major_device_class = source_dev->device_class.major_class;
 	(*dest_dev)->bt_class.minor_device_class = source_dev->device_class.minor_class;
 	(*dest_dev)->bt_class.major_service_class_mask = source_dev->device_class.service_class;
-	if (source_dev->service_index > 0) {
-		(*dest_dev)->service_uuid = (char **)malloc(sizeof(char *) * source_dev->service_index);
-		if ((*dest_dev)->service_uuid != NULL) {
-			for (i = 0; i < source_dev->service_index; i++) {
-				(*dest_dev)->service_uuid[i] = strdup(source_dev->uuids[i]);
-				if ((*dest_dev)->service_uuid[i] != NULL) {
-					__bt_convert_lower_to_upper((*dest_dev)->service_uuid[i]);
-				}
-			}
-		}
-	} else {
-		(*dest_dev)->service_uuid = NULL;
-	}
-	(*dest_dev)->service_count = source_dev->service_index;
+	(*dest_dev)->service_count = service_count;
 	(*dest_dev)->is_bonded = (bool)source_dev->paired;
 	(*dest_dev)->is_connected = (bool)source_dev->connected;
 	(*dest_dev)->is_authorized = (bool)source_dev->trust;
@@ -238,56 +523,8 @@ int _bt_get_bt_device_info_s(bt_device_info_s **dest_dev, bluetooth_device_info_
 
 void _bt_free_bt_device_info_s(bt_device_info_s *device_info)
 {
-	int i = 0;
-
-	if (device_info == NULL)
-		return;
-
-	if (device_info->remote_name != NULL)
-		free(device_info->remote_name);
-
-	if (device_info->remote_address != NULL)
-		free(device_info->remote_address);
-
-	if (device_info->service_uuid != NULL) {
-		for (i = 0; i < device_info->service_count; i++) {
-			if (device_info->service_uuid[i] != NULL)
-				free(device_info->service_uuid[i]);
-		}
-		free(device_info->service_uuid);
-	}
-
-	free(device_info);
-	device_info = NULL;
-}
-
-int _bt_convert_address_to_string(char **addr_str, bluetooth_device_address_t *addr_hex)
-{
-	char address[18] = { 0, };
-
-	snprintf(address, 18, "%2.2X:%2.2X:%2.2X:%2.2X:%2.2X:%2.2X", addr_hex->addr[0], addr_hex->addr[1], addr_hex->addr[2], addr_hex->addr[3], addr_hex->addr[4], addr_hex->addr[5]);
-	*addr_str = strdup(address);
-
-	if (*addr_str != NULL) {
-		return BT_ERROR_NONE;
-	} else {
-		return BT_ERROR_OUT_OF_MEMORY;
-	}
-}
-
-void _bt_convert_address_to_hex(bluetooth_device_address_t *addr_hex, const char *addr_str)
-{
-	int i = 0;
-	unsigned int addr[BLUETOOTH_ADDRESS_LENGTH] = { 0, };
-
-	i = sscanf(addr_str, "%X:%X:%X:%X:%X:%X", &addr[0], &addr[1], &addr[2], &addr[3], &addr[4], &addr[5]);
-	if (i != BLUETOOTH_ADDRESS_LENGTH) {
-		LOGI("[%s] Invalid format string - %s", __FUNCTION__, addr_str);
-	}
-
-	for (i = 0; i < BLUETOOTH_ADDRESS_LENGTH; i++) {
-		addr_hex->addr[i] = (unsigned char)addr[i];
-	}
+	/* The members are part of the same block, see _bt_get_bt_device_info_s() */
+	free(BT_INFO_EXT(device_info, bt_device_info_ext_s));
 }
 
 char *_bt_convert_error_to_string(int error)
@@ -346,34 +583,32 @@ bt_adapter_visibility_mode_e _bt_get_bt_visibility_mode_e(bluetooth_discoverable
  *  Internal Functions
  */
 
-static int __bt_get_bt_device_sdp_info_s(bt_device_sdp_info_s **dest, bt_sdp_info_t *source)
+int _bt_get_bt_device_sdp_info_s(bt_device_sdp_info_s **dest, bt_sdp_info_t *source, bt_arena_s *arena)
 {
+	guint64 service_mask = 0;
 	int i = 0;
 
-	*dest = (bt_device_sdp_info_s *)malloc(sizeof(bt_device_sdp_info_s));
+	*dest = (bt_device_sdp_info_s *)_bt_arena_alloc(arena, sizeof(bt_device_sdp_info_s));
 	if (*dest == NULL) {
 		return BT_ERROR_OUT_OF_MEMORY;
 	}
 
-	if (_bt_convert_address_to_string(&((*dest)->remote_address), &(source->device_addr)) != BT_ERROR_NONE) {
-		__bt_free_bt_device_sdp_info_s(*dest);
+	(*dest)->remote_address = (char *)_bt_intern_address(&(source->device_addr));
+	if ((*dest)->remote_address == NULL) {
 		return BT_ERROR_OUT_OF_MEMORY;
 	}
 
 	if (source->service_index > 0) {
-		(*dest)->service_uuid = (char **)malloc(sizeof(char *) * source->service_index);
+		(*dest)->service_uuid = (char **)_bt_arena_alloc(arena, sizeof(char *) * source->service_index);
 		if ((*dest)->service_uuid == NULL) {
-			__bt_free_bt_device_sdp_info_s(*dest);
 			return BT_ERROR_OUT_OF_MEMORY;
 		}
 
 		for (i = 0; i < source->service_index; i++) {
-			(*dest)->service_uuid[i] = strdup(source->uuids[i]);
+			(*dest)->service_uuid[i] = __bt_convert_uuid_in_arena(arena, source->uuids[i], &service_mask);
 			if ((*dest)->service_uuid[i] == NULL) {
-				__bt_free_bt_device_sdp_info_s(*dest);
 				return BT_ERROR_OUT_OF_MEMORY;
 			}
-			__bt_convert_lower_to_upper((*dest)->service_uuid[i]);
 		}
 	} else {
 		(*dest)->service_uuid = NULL;
@@ -383,28 +618,6 @@ static int __bt_get_bt_device_sdp_info_s(bt_device_sdp_info_s **dest, bt_sdp_inf
 	return BT_ERROR_NONE;
 }
 
-static void __bt_free_bt_device_sdp_info_s(bt_device_sdp_info_s *sdp_info)
-{
-	int i = 0;
-
-	if (sdp_info == NULL)
-		return;
-
-	if (sdp_info->remote_address != NULL)
-		free(sdp_info->remote_address);
-
-	if (sdp_info->service_uuid != NULL) {
-		for (i = 0; i < sdp_info->service_count; i++) {
-			if (sdp_info->service_uuid[i] != NULL)
-				free(sdp_info->service_uuid[i]);
-		}
-		free(sdp_info->service_uuid);
-	}
-
-	free(sdp_info);
-	sdp_info = NULL;
-}
-
 void _bt_audio_event_proxy(int event, bt_audio_event_param_t *param, void *user_data)
 {
 	bluetooth_event_param_t new_param;
@@ -435,588 +648,1206 @@ void _bt_hid_event_proxy(int event, hid_event_param_t *param, void *user_data)
 	__bt_event_proxy(event, &new_param, user_data);
 }
 
-static void __bt_event_proxy(int event, bluetooth_event_param_t *param, void *user_data)
+/*
+ *  Build the union of the listener filters, so that an event no listener wants is dropped
+ *  with a single probe. Returns NULL if a listener has no filter.
+ */
+static bt_event_address_filter_s *__bt_event_merge_filters(bt_event_listener_array_s *listeners)
 {
-	bluetooth_rfcomm_connection_t *connection_ind = NULL;
-	bluetooth_rfcomm_disconnection_t *disconnection_ind = NULL;
-	bt_socket_connection_s rfcomm_connection;
-	bt_device_sdp_info_s *sdp_info = NULL;
-	bt_adapter_device_discovery_info_s *discovery_info = NULL;
-	bt_device_info_s *bonded_device = NULL;
-	bluetooth_rfcomm_connection_request_t *reqeust_ind = NULL;
-	bt_obex_server_authorize_into_t *auth_info = NULL;
-	bt_obex_server_transfer_info_t *transfer_info = NULL;
-	bt_opc_transfer_info_t *client_info = NULL;
-	bluetooth_device_address_t *bd_addr = NULL;
-	char *device_addr = NULL;
-	int error_code = BT_ERROR_NONE;
-	int event_index = -1;
-	bluetooth_network_device_info_t *dev_info = NULL;
-	bt_hdp_connected_t *hdp_conn_info = NULL;
-	bt_hdp_disconnected_t *hdp_disconn_info = NULL;
-	bt_hdp_data_ind_t *hdp_data_ind = NULL;
-
-	event_index = __bt_get_cb_index(event);
-	if (event_index == -1 || bt_event_slot_container[event_index].callback == NULL) {
-		return;
-	}
+	bt_event_address_filter_s *any_filter = NULL;
+	const bt_event_address_filter_s *filter = NULL;
+	int count = 0;
+	int i;
+	guint j;
 
-	memset(&rfcomm_connection, 0x00, sizeof(bt_socket_connection_s));
+	if (listeners->count == 0 || listeners->filtered != listeners->count)
+		return NULL;
 
-	switch (event) {
-	case BLUETOOTH_EVENT_ENABLED:
-		LOGI("[%s] bt_adapter_state_changed_cb() will be called with BT_ADAPTER_ENABLED", __FUNCTION__);
-		((bt_adapter_state_changed_cb) bt_event_slot_container[event_index].callback)
-		    (_bt_get_error_code(param->result), BT_ADAPTER_ENABLED, bt_event_slot_container[event_index].user_data);
-		break;
-	case BLUETOOTH_EVENT_DISABLED:
-		LOGI("[%s] bt_adapter_state_changed_cb() will be called with BT_ADAPTER_DISABLED", __FUNCTION__);
-		((bt_adapter_state_changed_cb) bt_event_slot_container[event_index].callback)
-		    (_bt_get_error_code(param->result), BT_ADAPTER_DISABLED, bt_event_slot_container[event_index].user_data);
-		break;
-	case BLUETOOTH_EVENT_LOCAL_NAME_CHANGED:
-		LOGI("[%s] bt_adapter_name_changed_cb() will be called", __FUNCTION__);
-		((bt_adapter_name_changed_cb)bt_event_slot_container[event_index].callback)
-		    ((char *)(param->param_data), bt_event_slot_container[event_index].user_data);
-		break;
-	case BLUETOOTH_EVENT_DISCOVERABLE_MODE_CHANGED:
-		LOGI("[%s] bt_adapter_visibility_mode_changed_cb() will be called", __FUNCTION__);
-		((bt_adapter_visibility_mode_changed_cb)bt_event_slot_container[event_index].callback)
-		    (_bt_get_error_code(param->result), _bt_get_bt_visibility_mode_e(*(bt_adapter_visibility_mode_e *)(param->param_data)), bt_event_slot_container[event_index].user_data);
-		break;
-	case BLUETOOTH_EVENT_DISCOVERY_STARTED:
-		LOGI("[%s] bt_adapter_device_discovery_state_changed_cb() will be called with BT_ADAPTER_DEVICE_DISCOVERY_STARTED", __FUNCTION__);
-		((bt_adapter_device_discovery_state_changed_cb) bt_event_slot_container[event_index].callback)
-		    (_bt_get_error_code(param->result), BT_ADAPTER_DEVICE_DISCOVERY_STARTED, NULL, bt_event_slot_container[event_index].user_data);
-		break;
-	case BLUETOOTH_EVENT_DISCOVERY_FINISHED:
-		LOGI("[%s] bt_adapter_device_discovery_state_changed_cb() will be called with BT_ADAPTER_DEVICE_DISCOVERY_FINISHED", __FUNCTION__);
-		((bt_adapter_device_discovery_state_changed_cb)bt_event_slot_container[event_index].callback)
-		    (_bt_get_error_code(param->result), BT_ADAPTER_DEVICE_DISCOVERY_FINISHED, NULL, bt_event_slot_container[event_index].user_data);
-		break;
-	case BLUETOOTH_EVENT_REMOTE_DEVICE_NAME_UPDATED:
-		LOGI("[%s] bt_adapter_device_discovery_state_changed_cb() will be called with BT_ADAPTER_DEVICE_DISCOVERY_FOUND", __FUNCTION__);
-		if (__bt_get_bt_adapter_device_discovery_info_s(&discovery_info, (bluetooth_device_info_t *)(param->param_data)) == BT_ERROR_NONE) {
-			((bt_adapter_device_discovery_state_changed_cb)bt_event_slot_container[event_index].callback)
-			    (_bt_get_error_code(param->result), BT_ADAPTER_DEVICE_DISCOVERY_FOUND, discovery_info, bt_event_slot_container[event_index].user_data);
-			__bt_free_bt_adapter_device_discovery_info_s(discovery_info);
-		} else {
-			((bt_adapter_device_discovery_state_changed_cb)bt_event_slot_container[event_index].callback)
-			    (_bt_get_error_code(param->result), BT_ADAPTER_DEVICE_DISCOVERY_FOUND, NULL, bt_event_slot_container[event_index].user_data);
-		}
-		break;
-	case BLUETOOTH_EVENT_BONDING_FINISHED:
-		LOGI("[%s] bt_device_bond_created_cb() will be called", __FUNCTION__);
-		_bt_get_bt_device_info_s(&bonded_device, (bluetooth_device_info_t *)(param->param_data));
+	for (i = 0; i < listeners->count; i++)
+		count += listeners->listeners[i].filter->mask + 1;
 
-		((bt_device_bond_created_cb)bt_event_slot_container[event_index].callback)
-		    (_bt_get_error_code(param->result), bonded_device, bt_event_slot_container[event_index].user_data);
-		_bt_free_bt_device_info_s(bonded_device);
-		bonded_device = NULL;
-		break;
-	case BLUETOOTH_EVENT_BONDED_DEVICE_REMOVED:
-		LOGI("[%s] bt_device_bond_destroyed_cb() will be called", __FUNCTION__);
-		_bt_convert_address_to_string(&device_addr, (bluetooth_device_address_t *)(param->param_data));
-		((bt_device_bond_destroyed_cb)bt_event_slot_container[event_index].callback)
-		    (_bt_get_error_code(param->result), device_addr, bt_event_slot_container[event_index].user_data);
-		if (device_addr != NULL)
-			free(device_addr);
-		device_addr = NULL;
-		break;
-	case BLUETOOTH_EVENT_DEVICE_AUTHORIZED:
-		LOGI("[%s] bt_device_authorization_changed_cb() will be called with BT_DEVICE_AUTHORIZED", __FUNCTION__);
-		_bt_convert_address_to_string(&device_addr, (bluetooth_device_address_t *)(param->param_data));
-		((bt_device_authorization_changed_cb)bt_event_slot_container[event_index].callback)
-		    (BT_DEVICE_AUTHORIZED, device_addr, bt_event_slot_container[event_index].user_data);
-		if (device_addr != NULL)
-			free(device_addr);
-		device_addr = NULL;
-		break;
-	case BLUETOOTH_EVENT_DEVICE_UNAUTHORIZED:
-		LOGI("[%s] bt_device_authorization_changed_cb() will be called with BT_DEVICE_UNAUTHORIZED", __FUNCTION__);
-		_bt_convert_address_to_string(&device_addr, (bluetooth_device_address_t *)(param->param_data));
-		((bt_device_authorization_changed_cb)bt_event_slot_container[event_index].callback)
-		    (BT_DEVICE_UNAUTHORIZED, device_addr, bt_event_slot_container[event_index].user_data);
-		if (device_addr != NULL)
-			free(device_addr);
-		device_addr = NULL;
-		break;
-	case BLUETOOTH_EVENT_SERVICE_SEARCHED:
-		LOGI("[%s] bt_device_service_searched_cb() will be called", __FUNCTION__);
-		__bt_get_bt_device_sdp_info_s(&sdp_info, (bt_sdp_info_t *)(param->param_data));
-		error_code = _bt_get_error_code(param->result);
-		// In service search, BT_ERROR_SERVICE_SEARCH_FAILED is returned instead of BT_ERROR_OPERATION_FAILED.
-		if (error_code == BT_ERROR_OPERATION_FAILED)
-			error_code = BT_ERROR_SERVICE_SEARCH_FAILED;
-		((bt_device_service_searched_cb)bt_event_slot_container[event_index].callback)
-		    (error_code, sdp_info, bt_event_slot_container[event_index].user_data);
-		__bt_free_bt_device_sdp_info_s(sdp_info);
-		break;
-	case BLUETOOTH_EVENT_RFCOMM_DATA_RECEIVED:
-		LOGI("[%s] bt_socket_data_received_cb() will be called", __FUNCTION__);
-		((bt_socket_data_received_cb)bt_event_slot_container[event_index].callback)
-		    ((bt_socket_received_data_s *)(param->param_data), bt_event_slot_container[event_index].user_data);
-		break;
-	case BLUETOOTH_EVENT_RFCOMM_CONNECTED:
-		LOGI("[%s] bt_socket_connection_state_changed_cb() will be called with BT_SOCKET_CONNECTED", __FUNCTION__);
-		if (param->result == BLUETOOTH_ERROR_INVALID_PARAM)
-			error_code = BT_ERROR_OPERATION_FAILED;
-		else
-			error_code = _bt_get_error_code(param->result);
-
-		connection_ind = (bluetooth_rfcomm_connection_t *)(param->param_data);
-		rfcomm_connection.socket_fd = connection_ind->socket_fd;
-		rfcomm_connection.local_role = connection_ind->device_role;
-
-		if (connection_ind->uuid) {
-			rfcomm_connection.service_uuid = strdup(connection_ind->uuid);
-			LOGI("uuid: [%s]", rfcomm_connection.service_uuid);
-		}
+	/* Without the union every event is converted and matched per listener */
+	any_filter = __bt_event_create_filter(count / 2);
+	if (any_filter == NULL)
+		return NULL;
 
-		_bt_convert_address_to_string(&(rfcomm_connection.remote_address), &(connection_ind->device_addr));
+	for (i = 0; i < listeners->count; i++) {
+		filter = listeners->listeners[i].filter;
+		for (j = 0; j <= filter->mask; j++) {
+			if (filter->keys[j] != 0)
+				__bt_event_filter_add(any_filter, filter->keys[j]);
+		}
+	}
 
-		((bt_socket_connection_state_changed_cb)bt_event_slot_container[event_index].callback)
-		    (error_code, BT_SOCKET_CONNECTED, &rfcomm_connection, bt_event_slot_container[event_index].user_data);
+	return any_filter;
+}
 
-		if (rfcomm_connection.remote_address != NULL) {
-			free(rfcomm_connection.remote_address);
-			rfcomm_connection.remote_address = NULL;
-		}
+/*
+ *  Subscribe the listener with a new id.
+ */
+static int __bt_event_add_listener(int index, bt_event_sig_event_slot_s *listener, int *subscription_id)
+{
+	int error_code = BT_ERROR_NONE;
 
-		if (rfcomm_connection.service_uuid != NULL) {
-			free(rfcomm_connection.service_uuid);
-			rfcomm_connection.service_uuid = NULL;
-		}
+	g_mutex_lock(&bt_event_registry_lock);
+	error_code = __bt_event_update_listener(index, ++bt_event_last_id, listener);
+	if (error_code == BT_ERROR_NONE)
+		*subscription_id = bt_event_last_id;
+	g_mutex_unlock(&bt_event_registry_lock);
 
-		break;
-	case BLUETOOTH_EVENT_RFCOMM_DISCONNECTED:
-		LOGI("[%s] bt_socket_connection_state_changed_cb() will be called with BT_SOCKET_DISCONNECTED", __FUNCTION__);
+	return error_code;
+}
 
-		disconnection_ind = (bluetooth_rfcomm_disconnection_t *)(param->param_data);
-		rfcomm_connection.socket_fd = disconnection_ind->socket_fd;
-		rfcomm_connection.local_role = disconnection_ind->device_role;
+/*
+ *  Replace, add (listener is not NULL) or remove (listener is NULL) the listener with the given id.
+ *  The array takes the ownership of the filter of listener on success.
+ *  Must be called with bt_event_registry_lock held.
+ */
+static int __bt_event_update_listener(int index, int id, const bt_event_sig_event_slot_s *listener)
+{
+	bt_event_listener_array_s *old_listeners = bt_event_listeners[index];
+	bt_event_listener_array_s *new_listeners = NULL;
+	const bt_event_address_filter_s *old_filter = NULL;
+	int old_count = (old_listeners != NULL) ? old_listeners->count : 0;
+	int i;
+	int j = 0;
+	bool found = false;
 
-		if (disconnection_ind->uuid) {
-			rfcomm_connection.service_uuid = strdup(disconnection_ind->uuid);
-			LOGI("uuid: [%s]", rfcomm_connection.service_uuid);
+	for (i = 0; i < old_count; i++) {
+		if (old_listeners->listeners[i].id == id) {
+			old_filter = old_listeners->listeners[i].filter;
+			found = true;
+			break;
 		}
+	}
 
-		_bt_convert_address_to_string(&(rfcomm_connection.remote_address), &(disconnection_ind->device_addr));
-		((bt_socket_connection_state_changed_cb)bt_event_slot_container[event_index].callback)
-		    (_bt_get_error_code(param->result), BT_SOCKET_DISCONNECTED, &rfcomm_connection, bt_event_slot_container[event_index].user_data);
+	if (found == false && listener == NULL)
+		return BT_ERROR_NONE;
 
-		if (rfcomm_connection.remote_address != NULL) {
-			free(rfcomm_connection.remote_address);
-			rfcomm_connection.remote_address = NULL;
-		}
+	new_listeners = malloc(sizeof(bt_event_listener_array_s) +
+			sizeof(bt_event_sig_event_slot_s) * (old_count + 1));
+	if (new_listeners == NULL)
+		return BT_ERROR_OUT_OF_MEMORY;
 
-		if (rfcomm_connection.service_uuid != NULL) {
-			free(rfcomm_connection.service_uuid);
-			rfcomm_connection.service_uuid = NULL;
+	new_listeners->retired_next = NULL;
+	new_listeners->retired_filter = NULL;
+	new_listeners->filtered = 0;
+	new_listeners->binary = 0;
+
+	for (i = 0; i < old_count; i++) {
+		if (old_listeners->listeners[i].id != id) {
+			new_listeners->listeners[j++] = old_listeners->listeners[i];
+		} else if (listener != NULL) {
+			/* Keep the position of a replaced listener */
+			new_listeners->listeners[j] = *listener;
+			new_listeners->listeners[j].event_type = index;
+			new_listeners->listeners[j++].id = id;
 		}
+	}
 
-		break;
-	case BLUETOOTH_EVENT_RFCOMM_AUTHORIZE:
-		LOGI("[%s] bt_socket_connection_requested_cb() will be called", __FUNCTION__);
-		reqeust_ind = (bluetooth_rfcomm_connection_request_t *)(param->param_data);
-		_bt_convert_address_to_string(&device_addr, &(reqeust_ind->device_addr));
-		((bt_socket_connection_requested_cb)bt_event_slot_container[event_index].callback)
-		    (reqeust_ind->socket_fd, device_addr, bt_event_slot_container[event_index].user_data);
-
-		if (device_addr != NULL)
-			free(device_addr);
-		break;
-	case BLUETOOTH_EVENT_OBEX_SERVER_CONNECTION_AUTHORIZE:
-		LOGI("[%s] bt_opp_server_connection_requested_cb() will be called", __FUNCTION__);
-		bd_addr = (bluetooth_device_address_t *)(param->param_data);
-		_bt_convert_address_to_string(&device_addr, bd_addr);
-		((bt_opp_server_connection_requested_cb)bt_event_slot_container[event_index].callback)
-		    (device_addr, bt_event_slot_container[event_index].user_data);
-
-		if (device_addr != NULL)
-			free(device_addr);
-		break;
-	case BLUETOOTH_EVENT_OBEX_SERVER_TRANSFER_AUTHORIZE:
-		LOGI("[%s] bt_opp_server_push_requested_cb() will be called", __FUNCTION__);
-		auth_info = (bt_obex_server_authorize_into_t *)(param->param_data);
-		((bt_opp_server_push_requested_cb)bt_event_slot_container[event_index].callback)
-		    (auth_info->filename, auth_info->length, bt_event_slot_container[event_index].user_data);
-		break;
+	if (found == false) {
+		new_listeners->listeners[j] = *listener;
+		new_listeners->listeners[j].event_type = index;
+		new_listeners->listeners[j++].id = id;
+	}
 
-	case BLUETOOTH_EVENT_OBEX_SERVER_TRANSFER_STARTED:
-		LOGI("[%s] bt_opp_server_transfer_started_cb() will be called", __FUNCTION__);
-		transfer_info = (bt_obex_server_transfer_info_t *)(param->param_data);
-		((bt_opp_server_transfer_progress_cb)bt_event_slot_container[event_index].callback)
-		    (transfer_info->filename, transfer_info->file_size, 0, bt_event_slot_container[event_index].user_data);
-		break;
+	new_listeners->count = j;
+	for (i = 0; i < j; i++) {
+		if (new_listeners->listeners[i].filter != NULL)
+			new_listeners->filtered++;
+		if (new_listeners->listeners[i].binary == true)
+			new_listeners->binary++;
+	}
+	new_listeners->any_filter = __bt_event_merge_filters(new_listeners);
+	g_atomic_pointer_set(&bt_event_listeners[index], new_listeners);
+
+	if (old_listeners != NULL) {
+		/* Readers of the old array may still probe the filter of the dropped listener */
+		old_listeners->retired_filter = (bt_event_address_filter_s *)old_filter;
+		old_listeners->retired_next = bt_event_retired_listeners;
+		g_atomic_pointer_set(&bt_event_retired_listeners, old_listeners);
+	}
 
-	case BLUETOOTH_EVENT_OBEX_SERVER_TRANSFER_PROGRESS:
-		LOGI("[%s] bt_opp_server_transfer_in_progress_cb() will be called", __FUNCTION__);
-		transfer_info = (bt_obex_server_transfer_info_t *)(param->param_data);
-		((bt_opp_server_transfer_progress_cb)bt_event_slot_container[event_index].callback)
-		    (transfer_info->filename, transfer_info->file_size, transfer_info->percentage, bt_event_slot_container[event_index].user_data);
-		break;
+	__bt_event_reclaim_listeners();
 
-	case BLUETOOTH_EVENT_OBEX_SERVER_TRANSFER_COMPLETED:
-		LOGI("[%s] bt_opp_server_transfer_completed_cb() will be called", __FUNCTION__);
-		transfer_info = (bt_obex_server_transfer_info_t *)(param->param_data);
+	return BT_ERROR_NONE;
+}
 
-		((bt_opp_server_transfer_finished_cb)bt_event_slot_container[event_index].callback)
-		    (_bt_get_error_code(param->result), transfer_info->filename, transfer_info->file_size, bt_event_slot_container[event_index].user_data);
+/*
+ *  Return the event of the listener with the given id, or -1.
+ *  Must be called with bt_event_registry_lock held.
+ */
+static int __bt_event_find_listener(int id)
+{
+	bt_event_listener_array_s *listeners = NULL;
+	int index;
+	int i;
 
-		break;
+	for (index = 0; index < BT_EVENT_MAX; index++) {
+		listeners = bt_event_listeners[index];
+		if (listeners == NULL)
+			continue;
 
-	case BLUETOOTH_EVENT_OPC_CONNECTED:
-		LOGI("[%s] bt_opp_client_push_responded_cb() will be called", __FUNCTION__);
-		bd_addr = (bluetooth_device_address_t *)(param->param_data);
-		_bt_convert_address_to_string(&device_addr, bd_addr);
+		for (i = 0; i < listeners->count; i++) {
+			if (listeners->listeners[i].id == id)
+				return index;
+		}
+	}
 
-		LOGI("address: %s", device_addr);
+	return -1;
+}
 
-		((bt_opp_client_push_responded_cb)bt_event_slot_container[event_index].callback)
-		    (_bt_get_error_code(param->result), device_addr, bt_event_slot_container[event_index].user_data);
-		break;
+/*
+ *  Listener arrays loaded between enter and leave are not freed.
+ */
+static void __bt_event_enter_readers(void)
+{
+	g_atomic_int_inc(&bt_event_readers);
+}
 
-	case BLUETOOTH_EVENT_OPC_DISCONNECTED:
-		LOGI("[%s] bt_opp_client_push_finished_cb() will be called", __FUNCTION__);
-		bd_addr = (bluetooth_device_address_t *)(param->param_data);
-		_bt_convert_address_to_string(&device_addr, bd_addr);
+static void __bt_event_leave_readers(void)
+{
+	/* The last reader frees the retired arrays, unless a subscription is being updated */
+	if (g_atomic_int_dec_and_test(&bt_event_readers) &&
+			g_atomic_pointer_get(&bt_event_retired_listeners) != NULL) {
+		if (g_mutex_trylock(&bt_event_registry_lock)) {
+			__bt_event_reclaim_listeners();
+			g_mutex_unlock(&bt_event_registry_lock);
+		}
+	}
+}
 
-		LOGI("address: %s", device_addr);
+/*
+ *  Free the retired listener arrays if no dispatch is in flight.
+ *  Must be called with bt_event_registry_lock held.
+ */
+static void __bt_event_reclaim_listeners(void)
+{
+	bt_event_listener_array_s *retired = bt_event_retired_listeners;
+	bt_event_listener_array_s *next = NULL;
 
-		((bt_opp_client_push_finished_cb)bt_event_slot_container[event_index].callback)
-		    (_bt_get_error_code(param->result), device_addr, bt_event_slot_container[event_index].user_data);
-		break;
+	/* Every reader of a retired array entered before it was retired */
+	if (retired == NULL || g_atomic_int_get(&bt_event_readers) != 0)
+		return;
 
-	case BLUETOOTH_EVENT_OPC_TRANSFER_STARTED:
-		LOGI("[%s] bt_opp_client_transfer_started_cb() will be called", __FUNCTION__);
-		client_info = (bt_opc_transfer_info_t *)(param->param_data);
-		((bt_opp_client_push_progress_cb)bt_event_slot_container[event_index].callback)
-		    (client_info->filename, client_info->size, 0, bt_event_slot_container[event_index].user_data);
-		break;
+	g_atomic_pointer_set(&bt_event_retired_listeners, NULL);
+	while (retired != NULL) {
+		next = retired->retired_next;
+		if (retired->retired_filter != NULL)
+			free(retired->retired_filter);
+		if (retired->any_filter != NULL)
+			free(retired->any_filter);
+		free(retired);
+		retired = next;
+	}
+}
 
-	case BLUETOOTH_EVENT_OPC_TRANSFER_PROGRESS:
-		LOGI("[%s] bt_opp_client_transfer_in_progress_cb() will be called", __FUNCTION__);
-		client_info = (bt_opc_transfer_info_t *)(param->param_data);
-		((bt_opp_client_push_progress_cb)bt_event_slot_container[event_index].callback)
-		    (client_info->filename, client_info->size, client_info->percentage, bt_event_slot_container[event_index].user_data);
-		break;
+static guint64 __bt_event_address_key(const bluetooth_device_address_t *address)
+{
+	guint64 key = BT_EVENT_ADDRESS_KEY_USED;
+	int i;
 
-	case BLUETOOTH_EVENT_OPC_TRANSFER_COMPLETE:
-		LOGI("[%s] bt_opp_client_push_progress_cb() will be called", __FUNCTION__);
-		client_info = (bt_opc_transfer_info_t *)(param->param_data);
+	for (i = 0; i < BLUETOOTH_ADDRESS_LENGTH; i++)
+		key |= (guint64)address->addr[i] << (8 * i);
 
-		if (param->result != BLUETOOTH_ERROR_NONE) {
-			LOGI("[%s] bt_opp_client_push_finished_cb() will be called", __FUNCTION__);
-			break;
-		}
+	return key;
+}
 
-		((bt_opp_client_push_progress_cb)bt_event_slot_container[event_index].callback)
-		    (client_info->filename, client_info->size, 100, bt_event_slot_container[event_index].user_data);
-		break;
+static guint __bt_event_address_hash(const bt_event_address_filter_s *filter, guint64 key)
+{
+	return (guint)((key * 0x9E3779B97F4A7C15ULL) >> 32) & filter->mask;
+}
 
-	case BLUETOOTH_EVENT_NETWORK_SERVER_CONNECTED:
-		LOGI("[%s] BLUETOOTH_EVENT_NETWORK_SERVER_CONNECTED", __FUNCTION__);
-		dev_info = (bluetooth_network_device_info_t *)(param->param_data);
+/*
+ *  Create an empty filter for count addresses, at most half full.
+ */
+static bt_event_address_filter_s *__bt_event_create_filter(int count)
+{
+	bt_event_address_filter_s *filter = NULL;
+	guint size = 4;
 
-		if (param->result != BLUETOOTH_ERROR_NONE) {
-			LOGI("[%s]BLUETOOTH_EVENT_NETWORK_SERVER_CONNECTED", __FUNCTION__);
-		}
-		_bt_convert_address_to_string(&device_addr, &dev_info->device_address);
-		((bt_nap_connection_state_changed_cb)bt_event_slot_container[event_index].callback)
-		(TRUE, device_addr, dev_info->interface_name, bt_event_slot_container[event_index].user_data);
-		break;
+	while (size < (guint)count * 2)
+		size <<= 1;
 
-	case BLUETOOTH_EVENT_NETWORK_SERVER_DISCONNECTED:
-		LOGI("[%s] BLUETOOTH_EVENT_NETWORK_SERVER_DISCONNECTED", __FUNCTION__);
-		dev_info = (bluetooth_network_device_info_t *)(param->param_data);
+	filter = calloc(1, sizeof(bt_event_address_filter_s) + sizeof(guint64) * size);
+	if (filter == NULL)
+		return NULL;
 
-		if (param->result != BLUETOOTH_ERROR_NONE) {
-			LOGI("[%s]BLUETOOTH_EVENT_NETWORK_SERVER_DISCONNECTED", __FUNCTION__);
-		}
-		_bt_convert_address_to_string(&device_addr, &dev_info->device_address);
-		((bt_nap_connection_state_changed_cb)bt_event_slot_container[event_index].callback)
-		(FALSE, device_addr, dev_info->interface_name, bt_event_slot_container[event_index].user_data);
-		break;
-	case BLUETOOTH_EVENT_NETWORK_DISCONNECTED:
-		LOGI("[%s] Network callback will be", __FUNCTION__);
-		((bt_panu_connection_state_changed_cb)bt_event_slot_container[event_index].callback)
-		(_bt_get_error_code(param->result), FALSE, NULL, BLUETOOTH_NETWORK_NAP_ROLE,
-		bt_event_slot_container[event_index].user_data);
-		break;
+	filter->mask = size - 1;
 
-	case BLUETOOTH_EVENT_NETWORK_CONNECTED:
-		LOGI("[%s] Network callback will be ", __FUNCTION__);
-		((bt_panu_connection_state_changed_cb)bt_event_slot_container[event_index].callback)
-		(_bt_get_error_code(param->result), TRUE, NULL, BLUETOOTH_NETWORK_NAP_ROLE,
-		bt_event_slot_container[event_index].user_data);
-		break;
+	return filter;
+}
 
-	case BLUETOOTH_EVENT_HDP_CONNECTED:
-		LOGI("[%s] HDP Connected ", __FUNCTION__);
-		hdp_conn_info = (bt_hdp_connected_t *)(param->param_data);
-		_bt_convert_address_to_string(&device_addr, &hdp_conn_info->device_address);
-		((bt_hdp_connected_cb)bt_event_slot_container[event_index].callback)
-		(_bt_get_error_code(param->result), device_addr, hdp_conn_info->app_handle,
-		hdp_conn_info->type, hdp_conn_info->channel_id,
-		bt_event_slot_container[event_index].user_data);
-		break;
+static void __bt_event_filter_add(bt_event_address_filter_s *filter, guint64 key)
+{
+	guint position = __bt_event_address_hash(filter, key);
 
-	case BLUETOOTH_EVENT_HDP_DISCONNECTED:
-		LOGI("[%s] HDP disconnected callback will be ", __FUNCTION__);
-		hdp_disconn_info = (bt_hdp_disconnected_t *)(param->param_data);
+	while (filter->keys[position] != 0 && filter->keys[position] != key)
+		position = (position + 1) & filter->mask;
 
-		_bt_convert_address_to_string(&device_addr, &hdp_disconn_info->device_address);
-		((bt_hdp_disconnected_cb)bt_event_slot_container[event_index].callback)
-		(_bt_get_error_code(param->result), device_addr,
-		hdp_disconn_info->channel_id, bt_event_slot_container[event_index].user_data);
-		break;
-	case BLUETOOTH_EVENT_HDP_DATA_RECEIVED:
-		LOGI("[%s] HDP data recieved callback will be ", __FUNCTION__);
-		hdp_data_ind = (bt_hdp_data_ind_t *)(param->param_data);
-		if (param->result != BLUETOOTH_ERROR_NONE) {
-			LOGI("[%s] BLUETOOTH_EVENT_HDP_DATA_RECEIVED will be called", __FUNCTION__);
-		}
+	filter->keys[position] = key;
+}
 
-		((bt_hdp_data_received_cb)bt_event_slot_container[event_index].callback)
-		(hdp_data_ind->channel_id, hdp_data_ind->buffer, hdp_data_ind->size,
-		bt_event_slot_container[event_index].user_data);
-		break;
-	case BLUETOOTH_EVENT_AG_CONNECTED:
-		LOGI("[%s] BLUETOOTH_EVENT_AG_CONNECTED ", __FUNCTION__);
-		device_addr = (char *)(param->param_data);
-		((bt_audio_connection_state_changed_cb)bt_event_slot_container[event_index].callback)
-		(_bt_get_error_code(param->result), TRUE, device_addr, BT_AUDIO_PROFILE_TYPE_HSP_HFP,
-		bt_event_slot_container[event_index].user_data);
-		break;
-	case BLUETOOTH_EVENT_AG_DISCONNECTED:
-		LOGI("[%s] BLUETOOTH_EVENT_AG_DISCONNECTED ", __FUNCTION__);
-		device_addr = (char *)(param->param_data);
-		((bt_audio_connection_state_changed_cb)bt_event_slot_container[event_index].callback)
-		(_bt_get_error_code(param->result), FALSE, device_addr, BT_AUDIO_PROFILE_TYPE_HSP_HFP,
-		bt_event_slot_container[event_index].user_data);
-		break;
-	case BLUETOOTH_EVENT_AG_SPEAKER_GAIN:
-		LOGI("[%s] BLUETOOTH_EVENT_AG_SPEAKER_GAIN", __FUNCTION__);
-		int *spk_gain = (int *)(param->param_data);
-		if (param->result != BLUETOOTH_ERROR_NONE) {
-			LOGI("[%s] BLUETOOTH_EVENT_AG_SPEAKER_GAIN will be called", __FUNCTION__);
-		}
-		((bt_ag_speaker_gain_changed_cb)bt_event_slot_container[event_index].callback)
-		(NULL, *spk_gain, bt_event_slot_container[event_index].user_data);
-		break;
-	case BLUETOOTH_EVENT_AG_MIC_GAIN:
-		LOGI("[%s] BLUETOOTH_EVENT_AG_MIC_GAIN", __FUNCTION__);
-		int *mik_gain = (int *)(param->param_data);
-		if (param->result != BLUETOOTH_ERROR_NONE) {
-			LOGI("[%s] BLUETOOTH_EVENT_AG_MIC_GAIN will be called", __FUNCTION__);
-		}
-		((bt_ag_microphone_gain_changed_cb)bt_event_slot_container[event_index].callback)
-		(NULL, *mik_gain , bt_event_slot_container[event_index].user_data);
-		break;
-	case BLUETOOTH_EVENT_AG_AUDIO_CONNECTED:
-		LOGI("[%s] BLUETOOTH_EVENT_AG_AUDIO_CONNECTED", __FUNCTION__);
-		((bt_audio_connection_state_changed_cb)bt_event_slot_container[event_index].callback)
-		(_bt_get_error_code(param->result), TRUE, NULL, BT_AUDIO_PROFILE_TYPE_HSP_HFP,
-		bt_event_slot_container[event_index].user_data);
-		break;
-	case BLUETOOTH_EVENT_AG_AUDIO_DISCONNECTED:
-		LOGI("[%s] BLUETOOTH_EVENT_AG_AUDIO_DISCONNECTED", __FUNCTION__);
-		device_addr = (char *)(param->param_data);
+static bool __bt_event_filter_contains(const bt_event_address_filter_s *filter, const bluetooth_device_address_t *address)
+{
+	guint64 key = __bt_event_address_key(address);
+	guint position = __bt_event_address_hash(filter, key);
 
-		((bt_audio_connection_state_changed_cb)bt_event_slot_container[event_index].callback)
-		(_bt_get_error_code(param->result), FALSE, device_addr, BT_AUDIO_PROFILE_TYPE_HSP_HFP,
-		bt_event_slot_container[event_index].user_data);
-		break;
-	case BLUETOOTH_EVENT_AV_CONNECTED:
-		LOGI("[%s] BLUETOOTH_EVENT_AV_CONNECTED ", __FUNCTION__);
-		device_addr = (char *)(param->param_data);
-		((bt_audio_connection_state_changed_cb)bt_event_slot_container[event_index].callback)
-		(_bt_get_error_code(param->result), TRUE, device_addr, BT_AUDIO_PROFILE_TYPE_A2DP,
-		bt_event_slot_container[event_index].user_data);
-		break;
-	case BLUETOOTH_EVENT_AV_DISCONNECTED:
-		LOGI("[%s] BLUETOOTH_EVENT_Av_DISCONNECTED ", __FUNCTION__);
-		device_addr = (char *)(param->param_data);
-		((bt_audio_connection_state_changed_cb)bt_event_slot_container[event_index].callback)
-		(_bt_get_error_code(param->result), FALSE, device_addr, BT_AUDIO_PROFILE_TYPE_A2DP,
-		bt_event_slot_container[event_index].user_data);
-		break;
-	case BLUETOOTH_HID_CONNECTED:
-		LOGI("[%s] BLUETOOTH_HID_CONNECTED", __FUNCTION__);
-		bd_addr = (bluetooth_device_address_t *)(param->param_data);
-		_bt_convert_address_to_string(&device_addr, bd_addr);
-		((bt_hid_host_connection_state_changed_cb)bt_event_slot_container[event_index].callback)
-		(_bt_get_error_code(param->result), TRUE, device_addr, bt_event_slot_container[event_index].user_data);
-		break;
-	case BLUETOOTH_HID_DISCONNECTED:
-		LOGI("[%s] BLUETOOTH_HID_DISCONNECTED", __FUNCTION__);
-		bd_addr = (bluetooth_device_address_t *)(param->param_data);
-		_bt_convert_address_to_string(&device_addr, bd_addr);
-		((bt_hid_host_connection_state_changed_cb)bt_event_slot_container[event_index].callback)
-		(_bt_get_error_code(param->result), FALSE, device_addr, bt_event_slot_container[event_index].user_data);
-		break;
-	default:
-		break;
+	while (filter->keys[position] != 0) {
+		if (filter->keys[position] == key)
+			return true;
+		position = (position + 1) & filter->mask;
 	}
+
+	return false;
 }
 
-static int __bt_get_bt_adapter_device_discovery_info_s(bt_adapter_device_discovery_info_s **discovery_info, bluetooth_device_info_t *source_info) {
-	int i;
+/*
+ *  Event converters
+ */
 
-	BT_CHECK_INPUT_PARAMETER(source_info);
+static bool __bt_convert_result(int arg, bluetooth_event_param_t *param, bt_event_data_s *data)
+{
+	data->result = _bt_get_error_code(param->result);
+	data->state = arg;
+	return true;
+}
 
-	*discovery_info = (bt_adapter_device_discovery_info_s *)malloc(sizeof(bt_adapter_device_discovery_info_s));
-	if (*discovery_info == NULL) {
-		return BT_ERROR_OUT_OF_MEMORY;
+static bool __bt_convert_name(int arg, bluetooth_event_param_t *param, bt_event_data_s *data)
+{
+	data->name = (char *)(param->param_data);
+	return true;
+}
+
+static bool __bt_convert_visibility_mode(int arg, bluetooth_event_param_t *param, bt_event_data_s *data)
+{
+	data->result = _bt_get_error_code(param->result);
+	data->state = _bt_get_bt_visibility_mode_e(*(bt_adapter_visibility_mode_e *)(param->param_data));
+	return true;
+}
+
+/*
+ *  The device information is borrowed, and only converted by __bt_convert_device_info()
+ *  when a listener without a device view is invoked.
+ */
+static bool __bt_convert_device_found(int arg, bluetooth_event_param_t *param, bt_event_data_s *data)
+{
+	data->result = _bt_get_error_code(param->result);
+	data->state = arg;
+	data->device = (bluetooth_device_info_t *)(param->param_data);
+	return true;
+}
+
+static bool __bt_convert_bond_created(int arg, bluetooth_event_param_t *param, bt_event_data_s *data)
+{
+	data->result = _bt_get_error_code(param->result);
+	data->device = (bluetooth_device_info_t *)(param->param_data);
+	return true;
+}
+
+static bool __bt_convert_address(int arg, bluetooth_event_param_t *param, bt_event_data_s *data)
+{
+	data->result = _bt_get_error_code(param->result);
+	data->state = arg;
+	data->remote_address = _bt_intern_address((bluetooth_device_address_t *)(param->param_data));
+	return true;
+}
+
+static bool __bt_convert_service_searched(int arg, bluetooth_event_param_t *param, bt_event_data_s *data)
+{
+	bt_device_sdp_info_s *sdp_info = NULL;
+
+	_bt_get_bt_device_sdp_info_s(&sdp_info, (bt_sdp_info_t *)(param->param_data), data->arena);
+	data->info = sdp_info;
+	data->result = _bt_get_error_code(param->result);
+	// In service search, BT_ERROR_SERVICE_SEARCH_FAILED is returned instead of BT_ERROR_OPERATION_FAILED.
+	if (data->result == BT_ERROR_OPERATION_FAILED)
+		data->result = BT_ERROR_SERVICE_SEARCH_FAILED;
+	return true;
+}
+
+static bool __bt_convert_data_received(int arg, bluetooth_event_param_t *param, bt_event_data_s *data)
+{
+	bt_socket_received_data_s *received = (bt_socket_received_data_s *)(param->param_data);
+
+	data->value = received->socket_fd;
+	data->data = received->data;
+	data->size = received->data_size;
+	return true;
+}
+
+static bool __bt_convert_rfcomm_connected(int arg, bluetooth_event_param_t *param, bt_event_data_s *data)
+{
+	bluetooth_rfcomm_connection_t *connection_ind = (bluetooth_rfcomm_connection_t *)(param->param_data);
+
+	if (param->result == BLUETOOTH_ERROR_INVALID_PARAM)
+		data->result = BT_ERROR_OPERATION_FAILED;
+	else
+		data->result = _bt_get_error_code(param->result);
+	data->state = arg;
+
+	data->connection.socket_fd = connection_ind->socket_fd;
+	data->connection.local_role = connection_ind->device_role;
+	if (connection_ind->uuid) {
+		data->connection.service_uuid = _bt_arena_strdup(data->arena, connection_ind->uuid);
+		LOGI("uuid: [%s]", data->connection.service_uuid);
 	}
+	data->connection.remote_address = (char *)_bt_intern_address(&(connection_ind->device_addr));
+	return true;
+}
 
-	if (strlen(source_info->device_name.name) > 0) {
-		(*discovery_info)->remote_name = strdup(source_info->device_name.name);
-	} else {
-		(*discovery_info)->remote_name = NULL;
+static bool __bt_convert_rfcomm_disconnected(int arg, bluetooth_event_param_t *param, bt_event_data_s *data)
+{
+	bluetooth_rfcomm_disconnection_t *disconnection_ind = (bluetooth_rfcomm_disconnection_t *)(param->param_data);
+
+	data->result = _bt_get_error_code(param->result);
+	data->state = arg;
+
+	data->connection.socket_fd = disconnection_ind->socket_fd;
+	data->connection.local_role = disconnection_ind->device_role;
+	if (disconnection_ind->uuid) {
+		data->connection.service_uuid = _bt_arena_strdup(data->arena, disconnection_ind->uuid);
+		LOGI("uuid: [%s]", data->connection.service_uuid);
 	}
+	data->connection.remote_address = (char *)_bt_intern_address(&(disconnection_ind->device_addr));
+	return true;
+}
 
-	_bt_convert_address_to_string(&((*discovery_info)->remote_address), &(source_info->device_address));
+static bool __bt_convert_rfcomm_authorize(int arg, bluetooth_event_param_t *param, bt_event_data_s *data)
+{
+	bluetooth_rfcomm_connection_request_t *reqeust_ind = (bluetooth_rfcomm_connection_request_t *)(param->param_data);
 
-	(*discovery_info)->bt_class.major_device_class = source_info->device_class.major_class;
-	(*discovery_info)->bt_class.minor_device_class = source_info->device_class.minor_class;
-	(*discovery_info)->bt_class.major_service_class_mask = source_info->device_class.service_class;
+	data->value = reqeust_ind->socket_fd;
+	data->remote_address = _bt_intern_address(&(reqeust_ind->device_addr));
+	return true;
+}
 
-	if (source_info->service_index > 0) {
-		(*discovery_info)->service_uuid = (char **)malloc(sizeof(char *) * source_info->service_index);
-		if ((*discovery_info)->service_uuid != NULL) {
-			for (i = 0; i < source_info->service_index; i++) {
-				(*discovery_info)->service_uuid[i] = strdup(source_info->uuids[i]);
-				if ((*discovery_info)->service_uuid[i] != NULL) {
-					__bt_convert_lower_to_upper((*discovery_info)->service_uuid[i]);
-				}
+static bool __bt_convert_push_authorize(int arg, bluetooth_event_param_t *param, bt_event_data_s *data)
+{
+	bt_obex_server_authorize_into_t *auth_info = (bt_obex_server_authorize_into_t *)(param->param_data);
 
-				LOGI("[%s] UUID: %s", __FUNCTION__, (*discovery_info)->service_uuid[i]);
-			}
-		}
-	} else {
-		(*discovery_info)->service_uuid = NULL;
+	data->name = auth_info->filename;
+	data->size = auth_info->length;
+	return true;
+}
+
+static bool __bt_convert_server_transfer(int arg, bluetooth_event_param_t *param, bt_event_data_s *data)
+{
+	bt_obex_server_transfer_info_t *transfer_info = (bt_obex_server_transfer_info_t *)(param->param_data);
+
+	data->result = _bt_get_error_code(param->result);
+	data->name = transfer_info->filename;
+	data->size = transfer_info->file_size;
+	data->value = (arg < 0) ? transfer_info->percentage : arg;
+	return true;
+}
+
+static bool __bt_convert_client_transfer(int arg, bluetooth_event_param_t *param, bt_event_data_s *data)
+{
+	bt_opc_transfer_info_t *client_info = (bt_opc_transfer_info_t *)(param->param_data);
+
+	data->name = client_info->filename;
+	data->size = client_info->size;
+	data->value = (arg < 0) ? client_info->percentage : arg;
+	return true;
+}
+
+static bool __bt_convert_client_transfer_complete(int arg, bluetooth_event_param_t *param, bt_event_data_s *data)
+{
+	if (param->result != BLUETOOTH_ERROR_NONE) {
+		LOGI("[%s] bt_opp_client_push_finished_cb() will be called", __FUNCTION__);
+		return false;
 	}
-	(*discovery_info)->service_count = source_info->service_index;
 
-	(*discovery_info)->rssi = (int)source_info->rssi;
-	(*discovery_info)->is_bonded = (bool)source_info->paired;
+	return __bt_convert_client_transfer(arg, param, data);
+}
 
-	return BT_ERROR_NONE;
+static bool __bt_convert_network_server(int arg, bluetooth_event_param_t *param, bt_event_data_s *data)
+{
+	bluetooth_network_device_info_t *dev_info = (bluetooth_network_device_info_t *)(param->param_data);
+
+	if (param->result != BLUETOOTH_ERROR_NONE) {
+		LOGI("[%s] network server event with result (0x%08x)", __FUNCTION__, param->result);
+	}
+	data->state = arg;
+	data->interface_name = dev_info->interface_name;
+	data->remote_address = _bt_intern_address(&dev_info->device_address);
+	return true;
 }
 
-static void __bt_free_bt_adapter_device_discovery_info_s(bt_adapter_device_discovery_info_s *discovery_info)
+static bool __bt_convert_hdp_connected(int arg, bluetooth_event_param_t *param, bt_event_data_s *data)
 {
-	int i;
+	bt_hdp_connected_t *hdp_conn_info = (bt_hdp_connected_t *)(param->param_data);
+
+	data->result = _bt_get_error_code(param->result);
+	data->name = hdp_conn_info->app_handle;
+	data->type = hdp_conn_info->type;
+	data->value = hdp_conn_info->channel_id;
+	data->remote_address = _bt_intern_address(&hdp_conn_info->device_address);
+	return true;
+}
+
+static bool __bt_convert_hdp_disconnected(int arg, bluetooth_event_param_t *param, bt_event_data_s *data)
+{
+	bt_hdp_disconnected_t *hdp_disconn_info = (bt_hdp_disconnected_t *)(param->param_data);
+
+	data->result = _bt_get_error_code(param->result);
+	data->value = hdp_disconn_info->channel_id;
+	data->remote_address = _bt_intern_address(&hdp_disconn_info->device_address);
+	return true;
+}
+
+static bool __bt_convert_hdp_data_received(int arg, bluetooth_event_param_t *param, bt_event_data_s *data)
+{
+	bt_hdp_data_ind_t *hdp_data_ind = (bt_hdp_data_ind_t *)(param->param_data);
+
+	if (param->result != BLUETOOTH_ERROR_NONE) {
+		LOGI("[%s] BLUETOOTH_EVENT_HDP_DATA_RECEIVED with result (0x%08x)", __FUNCTION__, param->result);
+	}
+	data->value = hdp_data_ind->channel_id;
+	data->data = hdp_data_ind->buffer;
+	data->size = hdp_data_ind->size;
+	return true;
+}
+
+static bool __bt_convert_ag_connection(int arg, bluetooth_event_param_t *param, bt_event_data_s *data)
+{
+	data->result = _bt_get_error_code(param->result);
+	data->state = arg;
+	data->type = BT_AUDIO_PROFILE_TYPE_HSP_HFP;
+	/* The F/W does not report the address when the SCO link is established */
+	if (param->event != BLUETOOTH_EVENT_AG_AUDIO_CONNECTED && param->param_data != NULL)
+		data->remote_address = __bt_convert_address_string(data->arena, (const char *)(param->param_data));
+	return true;
+}
+
+static bool __bt_convert_av_connection(int arg, bluetooth_event_param_t *param, bt_event_data_s *data)
+{
+	data->result = _bt_get_error_code(param->result);
+	data->state = arg;
+	data->type = BT_AUDIO_PROFILE_TYPE_A2DP;
+	if (param->param_data != NULL)
+		data->remote_address = __bt_convert_address_string(data->arena, (const char *)(param->param_data));
+	return true;
+}
+
+static bool __bt_convert_gain(int arg, bluetooth_event_param_t *param, bt_event_data_s *data)
+{
+	if (param->result != BLUETOOTH_ERROR_NONE) {
+		LOGI("[%s] gain event with result (0x%08x)", __FUNCTION__, param->result);
+	}
+	data->value = *(int *)(param->param_data);
+	return true;
+}
+
+/*
+ *  Raw remote address readers, used to match address filters before the conversion
+ */
+
+static bool __bt_address_of_param(bluetooth_event_param_t *param, bluetooth_device_address_t *address)
+{
+	if (param->param_data == NULL)
+		return false;
+	memcpy(address, param->param_data, sizeof(bluetooth_device_address_t));
+	return true;
+}
+
+static bool __bt_address_of_device_info(bluetooth_event_param_t *param, bluetooth_device_address_t *address)
+{
+	if (param->param_data == NULL)
+		return false;
+	memcpy(address, &((bluetooth_device_info_t *)(param->param_data))->device_address, sizeof(bluetooth_device_address_t));
+	return true;
+}
+
+static bool __bt_address_of_sdp_info(bluetooth_event_param_t *param, bluetooth_device_address_t *address)
+{
+	if (param->param_data == NULL)
+		return false;
+	memcpy(address, &((bt_sdp_info_t *)(param->param_data))->device_addr, sizeof(bluetooth_device_address_t));
+	return true;
+}
+
+static bool __bt_address_of_rfcomm_connection(bluetooth_event_param_t *param, bluetooth_device_address_t *address)
+{
+	if (param->param_data == NULL)
+		return false;
+	memcpy(address, &((bluetooth_rfcomm_connection_t *)(param->param_data))->device_addr, sizeof(bluetooth_device_address_t));
+	return true;
+}
 
-	if (discovery_info == NULL)
+static bool __bt_address_of_rfcomm_disconnection(bluetooth_event_param_t *param, bluetooth_device_address_t *address)
+{
+	if (param->param_data == NULL)
+		return false;
+	memcpy(address, &((bluetooth_rfcomm_disconnection_t *)(param->param_data))->device_addr, sizeof(bluetooth_device_address_t));
+	return true;
+}
+
+static bool __bt_address_of_rfcomm_request(bluetooth_event_param_t *param, bluetooth_device_address_t *address)
+{
+	if (param->param_data == NULL)
+		return false;
+	memcpy(address, &((bluetooth_rfcomm_connection_request_t *)(param->param_data))->device_addr, sizeof(bluetooth_device_address_t));
+	return true;
+}
+
+static bool __bt_address_of_network_device(bluetooth_event_param_t *param, bluetooth_device_address_t *address)
+{
+	if (param->param_data == NULL)
+		return false;
+	memcpy(address, &((bluetooth_network_device_info_t *)(param->param_data))->device_address, sizeof(bluetooth_device_address_t));
+	return true;
+}
+
+static bool __bt_address_of_hdp_connected(bluetooth_event_param_t *param, bluetooth_device_address_t *address)
+{
+	if (param->param_data == NULL)
+		return false;
+	memcpy(address, &((bt_hdp_connected_t *)(param->param_data))->device_address, sizeof(bluetooth_device_address_t));
+	return true;
+}
+
+static bool __bt_address_of_hdp_disconnected(bluetooth_event_param_t *param, bluetooth_device_address_t *address)
+{
+	if (param->param_data == NULL)
+		return false;
+	memcpy(address, &((bt_hdp_disconnected_t *)(param->param_data))->device_address, sizeof(bluetooth_device_address_t));
+	return true;
+}
+
+static bool __bt_address_of_string(bluetooth_event_param_t *param, bluetooth_device_address_t *address)
+{
+	if (param->param_data == NULL)
+		return false;
+	return _bt_parse_address((const char *)(param->param_data), address);
+}
+
+static bool __bt_address_of_ag_connection(bluetooth_event_param_t *param, bluetooth_device_address_t *address)
+{
+	if (param->event == BLUETOOTH_EVENT_AG_AUDIO_CONNECTED)
+		return false;
+	return __bt_address_of_string(param, address);
+}
+
+/*
+ *  Event invokers
+ */
+
+static void __bt_invoke_state_changed(const void *callback, bt_event_data_s *data, void *user_data)
+{
+	LOGI("[%s] bt_adapter_state_changed_cb() will be called with %d", __FUNCTION__, data->state);
+	((bt_adapter_state_changed_cb)callback)(data->result, data->state, user_data);
+}
+
+static void __bt_invoke_name_changed(const void *callback, bt_event_data_s *data, void *user_data)
+{
+	LOGI("[%s] bt_adapter_name_changed_cb() will be called", __FUNCTION__);
+	((bt_adapter_name_changed_cb)callback)((char *)data->name, user_data);
+}
+
+static void __bt_invoke_visibility_mode_changed(const void *callback, bt_event_data_s *data, void *user_data)
+{
+	LOGI("[%s] bt_adapter_visibility_mode_changed_cb() will be called", __FUNCTION__);
+	((bt_adapter_visibility_mode_changed_cb)callback)(data->result, data->state, user_data);
+}
+
+static void __bt_convert_device_info(bt_event_data_s *data)
+{
+	bt_adapter_device_discovery_info_s *discovery_info = NULL;
+	bt_device_info_s *bonded_device = NULL;
+
+	if (data->info != NULL || data->device == NULL)
 		return;
 
-	if (discovery_info->remote_name != NULL)
-		free(discovery_info->remote_name);
+	if (data->index == BT_EVENT_DEVICE_DISCOVERY_STATE_CHANGED) {
+		if (_bt_get_bt_adapter_device_discovery_info_s(&discovery_info, data->device, data->arena) == BT_ERROR_NONE)
+			data->info = discovery_info;
+	} else if (data->index == BT_EVENT_BOND_CREATED) {
+		if (_bt_get_bt_device_info_s(&bonded_device, data->device, data->arena) == BT_ERROR_NONE)
+			data->info = bonded_device;
+	}
+}
 
-	if (discovery_info->remote_address != NULL)
-		free(discovery_info->remote_address);
+static void __bt_invoke_device_view(const void *callback, bt_event_data_s *data, void *user_data)
+{
+	struct bt_device_view_s view;
+	bt_device_view_h device = NULL;
+
+	if (data->device != NULL) {
+		view.info = data->device;
+		view.address[0] = '\0';
+		view.uuid[0] = '\0';
+		view.has_service_mask = false;
+		device = &view;
+	}
 
-	if (discovery_info->service_uuid != NULL) {
-		for (i = 0; i < discovery_info->service_count; i++) {
-			if (discovery_info->service_uuid[i] != NULL)
-				free(discovery_info->service_uuid[i]);
-		}
-		free(discovery_info->service_uuid);
+	if (data->index == BT_EVENT_DEVICE_DISCOVERY_STATE_CHANGED) {
+		((bt_adapter_device_discovery_state_changed_view_cb)callback)(data->result, data->state, device, user_data);
+	} else if (data->index == BT_EVENT_BOND_CREATED) {
+		((bt_device_bond_created_view_cb)callback)(data->result, device, user_data);
+	}
+}
+
+static void __bt_invoke_discovery_state_changed(const void *callback, bt_event_data_s *data, void *user_data)
+{
+	LOGI("[%s] bt_adapter_device_discovery_state_changed_cb() will be called with %d", __FUNCTION__, data->state);
+	((bt_adapter_device_discovery_state_changed_cb)callback)(data->result, data->state, data->info, user_data);
+}
+
+static void __bt_invoke_bond_created(const void *callback, bt_event_data_s *data, void *user_data)
+{
+	LOGI("[%s] bt_device_bond_created_cb() will be called", __FUNCTION__);
+	((bt_device_bond_created_cb)callback)(data->result, data->info, user_data);
+}
+
+static void __bt_invoke_bond_destroyed(const void *callback, bt_event_data_s *data, void *user_data)
+{
+	LOGI("[%s] bt_device_bond_destroyed_cb() will be called", __FUNCTION__);
+	((bt_device_bond_destroyed_cb)callback)(data->result, (char *)data->remote_address, user_data);
+}
+
+static void __bt_invoke_authorization_changed(const void *callback, bt_event_data_s *data, void *user_data)
+{
+	LOGI("[%s] bt_device_authorization_changed_cb() will be called with %d", __FUNCTION__, data->state);
+	((bt_device_authorization_changed_cb)callback)(data->state, (char *)data->remote_address, user_data);
+}
+
+static void __bt_invoke_service_searched(const void *callback, bt_event_data_s *data, void *user_data)
+{
+	LOGI("[%s] bt_device_service_searched_cb() will be called", __FUNCTION__);
+	((bt_device_service_searched_cb)callback)(data->result, data->info, user_data);
+}
+
+static void __bt_invoke_data_received(const void *callback, bt_event_data_s *data, void *user_data)
+{
+	bt_socket_received_data_s received;
+
+	LOGI("[%s] bt_socket_data_received_cb() will be called", __FUNCTION__);
+	received.socket_fd = data->value;
+	received.data_size = data->size;
+	received.data = (char *)data->data;
+	((bt_socket_data_received_cb)callback)(&received, user_data);
+}
+
+static void __bt_invoke_socket_connection_state_changed(const void *callback, bt_event_data_s *data, void *user_data)
+{
+	LOGI("[%s] bt_socket_connection_state_changed_cb() will be called with %d", __FUNCTION__, data->state);
+	((bt_socket_connection_state_changed_cb)callback)(data->result, data->state, &data->connection, user_data);
+}
+
+static void __bt_invoke_socket_connection_requested(const void *callback, bt_event_data_s *data, void *user_data)
+{
+	LOGI("[%s] bt_socket_connection_requested_cb() will be called", __FUNCTION__);
+	((bt_socket_connection_requested_cb)callback)(data->value, data->remote_address, user_data);
+}
+
+static void __bt_invoke_opp_server_connection_requested(const void *callback, bt_event_data_s *data, void *user_data)
+{
+	LOGI("[%s] bt_opp_server_connection_requested_cb() will be called", __FUNCTION__);
+	((bt_opp_server_connection_requested_cb)callback)(data->remote_address, user_data);
+}
+
+static void __bt_invoke_opp_server_push_requested(const void *callback, bt_event_data_s *data, void *user_data)
+{
+	LOGI("[%s] bt_opp_server_push_requested_cb() will be called", __FUNCTION__);
+	((bt_opp_server_push_requested_cb)callback)(data->name, data->size, user_data);
+}
+
+static void __bt_invoke_opp_server_transfer_progress(const void *callback, bt_event_data_s *data, void *user_data)
+{
+	LOGI("[%s] bt_opp_server_transfer_progress_cb() will be called", __FUNCTION__);
+	((bt_opp_server_transfer_progress_cb)callback)(data->name, data->size, data->value, user_data);
+}
+
+static void __bt_invoke_opp_server_transfer_finished(const void *callback, bt_event_data_s *data, void *user_data)
+{
+	LOGI("[%s] bt_opp_server_transfer_finished_cb() will be called", __FUNCTION__);
+	((bt_opp_server_transfer_finished_cb)callback)(data->result, data->name, data->size, user_data);
+}
+
+static void __bt_invoke_opp_client_push_responded(const void *callback, bt_event_data_s *data, void *user_data)
+{
+	LOGI("[%s] bt_opp_client_push_responded_cb() will be called", __FUNCTION__);
+	((bt_opp_client_push_responded_cb)callback)(data->result, data->remote_address, user_data);
+}
+
+static void __bt_invoke_opp_client_push_progress(const void *callback, bt_event_data_s *data, void *user_data)
+{
+	LOGI("[%s] bt_opp_client_push_progress_cb() will be called", __FUNCTION__);
+	((bt_opp_client_push_progress_cb)callback)(data->name, data->size, data->value, user_data);
+}
+
+static void __bt_invoke_opp_client_push_finished(const void *callback, bt_event_data_s *data, void *user_data)
+{
+	LOGI("[%s] bt_opp_client_push_finished_cb() will be called", __FUNCTION__);
+	((bt_opp_client_push_finished_cb)callback)(data->result, data->remote_address, user_data);
+}
+
+static void __bt_invoke_nap_connection_state_changed(const void *callback, bt_event_data_s *data, void *user_data)
+{
+	LOGI("[%s] bt_nap_connection_state_changed_cb() will be called with %d", __FUNCTION__, data->state);
+	((bt_nap_connection_state_changed_cb)callback)(data->state, data->remote_address, data->interface_name, user_data);
+}
+
+static void __bt_invoke_panu_connection_state_changed(const void *callback, bt_event_data_s *data, void *user_data)
+{
+	LOGI("[%s] bt_panu_connection_state_changed_cb() will be called with %d", __FUNCTION__, data->state);
+	((bt_panu_connection_state_changed_cb)callback)(data->result, data->state, NULL, BLUETOOTH_NETWORK_NAP_ROLE, user_data);
+}
+
+static void __bt_invoke_hdp_connected(const void *callback, bt_event_data_s *data, void *user_data)
+{
+	LOGI("[%s] bt_hdp_connected_cb() will be called", __FUNCTION__);
+	((bt_hdp_connected_cb)callback)(data->result, data->remote_address, data->name, data->type, data->value, user_data);
+}
+
+static void __bt_invoke_hdp_disconnected(const void *callback, bt_event_data_s *data, void *user_data)
+{
+	LOGI("[%s] bt_hdp_disconnected_cb() will be called", __FUNCTION__);
+	((bt_hdp_disconnected_cb)callback)(data->result, data->remote_address, data->value, user_data);
+}
+
+static void __bt_invoke_hdp_data_received(const void *callback, bt_event_data_s *data, void *user_data)
+{
+	LOGI("[%s] bt_hdp_data_received_cb() will be called", __FUNCTION__);
+	((bt_hdp_data_received_cb)callback)(data->value, data->data, data->size, user_data);
+}
+
+static void __bt_invoke_audio_connection_state_changed(const void *callback, bt_event_data_s *data, void *user_data)
+{
+	LOGI("[%s] bt_audio_connection_state_changed_cb() will be called with %d", __FUNCTION__, data->state);
+	((bt_audio_connection_state_changed_cb)callback)(data->result, data->state, data->remote_address, data->type, user_data);
+}
+
+static void __bt_invoke_ag_speaker_gain_changed(const void *callback, bt_event_data_s *data, void *user_data)
+{
+	LOGI("[%s] bt_ag_speaker_gain_changed_cb() will be called", __FUNCTION__);
+	((bt_ag_speaker_gain_changed_cb)callback)(NULL, data->value, user_data);
+}
+
+static void __bt_invoke_ag_microphone_gain_changed(const void *callback, bt_event_data_s *data, void *user_data)
+{
+	LOGI("[%s] bt_ag_microphone_gain_changed_cb() will be called", __FUNCTION__);
+	((bt_ag_microphone_gain_changed_cb)callback)(NULL, data->value, user_data);
+}
+
+static void __bt_invoke_hid_connection_state_changed(const void *callback, bt_event_data_s *data, void *user_data)
+{
+	LOGI("[%s] bt_hid_host_connection_state_changed_cb() will be called with %d", __FUNCTION__, data->state);
+	((bt_hid_host_connection_state_changed_cb)callback)(data->result, data->state, data->remote_address, user_data);
+}
+
+/*
+ *  Event dispatch table
+ *
+ *  Indexed directly by the Bluetooth F/W event id. Each row names the callback slot,
+ *  a constant argument for the converter, and the converter/address/invoker functions.
+ *  Converted members are allocated in the arena of the event, so there is nothing to release.
+ *  Rows which are not listed are zero-filled and the event is ignored.
+ */
+#define BT_EVENT_DISPATCH(event, index, arg, convert, address, invoke) \
+	[event] = { index, arg, convert, address, invoke }
+
+static const bt_event_dispatch_s bt_event_dispatch_table[] = {
+	BT_EVENT_DISPATCH(BLUETOOTH_EVENT_ENABLED, BT_EVENT_STATE_CHANGED, BT_ADAPTER_ENABLED,
+			__bt_convert_result, NULL, __bt_invoke_state_changed),
+	BT_EVENT_DISPATCH(BLUETOOTH_EVENT_DISABLED, BT_EVENT_STATE_CHANGED, BT_ADAPTER_DISABLED,
+			__bt_convert_result, NULL, __bt_invoke_state_changed),
+	BT_EVENT_DISPATCH(BLUETOOTH_EVENT_LOCAL_NAME_CHANGED, BT_EVENT_NAME_CHANGED, 0,
+			__bt_convert_name, NULL, __bt_invoke_name_changed),
+	BT_EVENT_DISPATCH(BLUETOOTH_EVENT_DISCOVERABLE_MODE_CHANGED, BT_EVENT_VISIBILITY_MODE_CHANGED, 0,
+			__bt_convert_visibility_mode, NULL, __bt_invoke_visibility_mode_changed),
+	BT_EVENT_DISPATCH(BLUETOOTH_EVENT_DISCOVERY_STARTED, BT_EVENT_DEVICE_DISCOVERY_STATE_CHANGED, BT_ADAPTER_DEVICE_DISCOVERY_STARTED,
+			__bt_convert_result, NULL, __bt_invoke_discovery_state_changed),
+	BT_EVENT_DISPATCH(BLUETOOTH_EVENT_DISCOVERY_FINISHED, BT_EVENT_DEVICE_DISCOVERY_STATE_CHANGED, BT_ADAPTER_DEVICE_DISCOVERY_FINISHED,
+			__bt_convert_result, NULL, __bt_invoke_discovery_state_changed),
+	BT_EVENT_DISPATCH(BLUETOOTH_EVENT_REMOTE_DEVICE_NAME_UPDATED, BT_EVENT_DEVICE_DISCOVERY_STATE_CHANGED, BT_ADAPTER_DEVICE_DISCOVERY_FOUND,
+			__bt_convert_device_found, __bt_address_of_device_info, __bt_invoke_discovery_state_changed),
+	BT_EVENT_DISPATCH(BLUETOOTH_EVENT_BONDING_FINISHED, BT_EVENT_BOND_CREATED, 0,
+			__bt_convert_bond_created, __bt_address_of_device_info, __bt_invoke_bond_created),
+	BT_EVENT_DISPATCH(BLUETOOTH_EVENT_BONDED_DEVICE_REMOVED, BT_EVENT_BOND_DESTROYED, 0,
+			__bt_convert_address, __bt_address_of_param, __bt_invoke_bond_destroyed),
+	BT_EVENT_DISPATCH(BLUETOOTH_EVENT_DEVICE_AUTHORIZED, BT_EVENT_AUTHORIZATION_CHANGED, BT_DEVICE_AUTHORIZED,
+			__bt_convert_address, __bt_address_of_param, __bt_invoke_authorization_changed),
+	BT_EVENT_DISPATCH(BLUETOOTH_EVENT_DEVICE_UNAUTHORIZED, BT_EVENT_AUTHORIZATION_CHANGED, BT_DEVICE_UNAUTHORIZED,
+			__bt_convert_address, __bt_address_of_param, __bt_invoke_authorization_changed),
+	BT_EVENT_DISPATCH(BLUETOOTH_EVENT_SERVICE_SEARCHED, BT_EVENT_SERVICE_SEARCHED, 0,
+			__bt_convert_service_searched, __bt_address_of_sdp_info, __bt_invoke_service_searched),
+	BT_EVENT_DISPATCH(BLUETOOTH_EVENT_RFCOMM_DATA_RECEIVED, BT_EVENT_DATA_RECEIVED, 0,
+			__bt_convert_data_received, NULL, __bt_invoke_data_received),
+	BT_EVENT_DISPATCH(BLUETOOTH_EVENT_RFCOMM_CONNECTED, BT_EVENT_CONNECTION_STATE_CHANGED, BT_SOCKET_CONNECTED,
+			__bt_convert_rfcomm_connected, __bt_address_of_rfcomm_connection, __bt_invoke_socket_connection_state_changed),
+	BT_EVENT_DISPATCH(BLUETOOTH_EVENT_RFCOMM_DISCONNECTED, BT_EVENT_CONNECTION_STATE_CHANGED, BT_SOCKET_DISCONNECTED,
+			__bt_convert_rfcomm_disconnected, __bt_address_of_rfcomm_disconnection, __bt_invoke_socket_connection_state_changed),
+	BT_EVENT_DISPATCH(BLUETOOTH_EVENT_RFCOMM_AUTHORIZE, BT_EVENT_RFCOMM_CONNECTION_REQUESTED, 0,
+			__bt_convert_rfcomm_authorize, __bt_address_of_rfcomm_request, __bt_invoke_socket_connection_requested),
+	BT_EVENT_DISPATCH(BLUETOOTH_EVENT_OBEX_SERVER_CONNECTION_AUTHORIZE, BT_EVENT_OPP_CONNECTION_REQUESTED, 0,
+			__bt_convert_address, __bt_address_of_param, __bt_invoke_opp_server_connection_requested),
+	BT_EVENT_DISPATCH(BLUETOOTH_EVENT_OBEX_SERVER_TRANSFER_AUTHORIZE, BT_EVENT_OPP_PUSH_REQUESTED, 0,
+			__bt_convert_push_authorize, NULL, __bt_invoke_opp_server_push_requested),
+	BT_EVENT_DISPATCH(BLUETOOTH_EVENT_OBEX_SERVER_TRANSFER_STARTED, BT_EVENT_OPP_SERVER_TRANSFER_PROGRESS, 0,
+			__bt_convert_server_transfer, NULL, __bt_invoke_opp_server_transfer_progress),
+	BT_EVENT_DISPATCH(BLUETOOTH_EVENT_OBEX_SERVER_TRANSFER_PROGRESS, BT_EVENT_OPP_SERVER_TRANSFER_PROGRESS, -1,
+			__bt_convert_server_transfer, NULL, __bt_invoke_opp_server_transfer_progress),
+	BT_EVENT_DISPATCH(BLUETOOTH_EVENT_OBEX_SERVER_TRANSFER_COMPLETED, BT_EVENT_OPP_SERVER_TRANSFER_FINISHED, 0,
+			__bt_convert_server_transfer, NULL, __bt_invoke_opp_server_transfer_finished),
+	BT_EVENT_DISPATCH(BLUETOOTH_EVENT_OPC_CONNECTED, BT_EVENT_OPP_CLIENT_PUSH_RESPONSED, 0,
+			__bt_convert_address, __bt_address_of_param, __bt_invoke_opp_client_push_responded),
+	BT_EVENT_DISPATCH(BLUETOOTH_EVENT_OPC_DISCONNECTED, BT_EVENT_OPP_CLIENT_PUSH_FINISHED, 0,
+			__bt_convert_address, __bt_address_of_param, __bt_invoke_opp_client_push_finished),
+	BT_EVENT_DISPATCH(BLUETOOTH_EVENT_OPC_TRANSFER_STARTED, BT_EVENT_OPP_CLIENT_PUSH_PROGRESS, 0,
+			__bt_convert_client_transfer, NULL, __bt_invoke_opp_client_push_progress),
+	BT_EVENT_DISPATCH(BLUETOOTH_EVENT_OPC_TRANSFER_PROGRESS, BT_EVENT_OPP_CLIENT_PUSH_PROGRESS, -1,
+			__bt_convert_client_transfer, NULL, __bt_invoke_opp_client_push_progress),
+	BT_EVENT_DISPATCH(BLUETOOTH_EVENT_OPC_TRANSFER_COMPLETE, BT_EVENT_OPP_CLIENT_PUSH_PROGRESS, 100,
+			__bt_convert_client_transfer_complete, NULL, __bt_invoke_opp_client_push_progress),
+	BT_EVENT_DISPATCH(BLUETOOTH_EVENT_NETWORK_SERVER_CONNECTED, BT_EVENT_NAP_CONNECTION_STATE_CHANGED, TRUE,
+			__bt_convert_network_server, __bt_address_of_network_device, __bt_invoke_nap_connection_state_changed),
+	BT_EVENT_DISPATCH(BLUETOOTH_EVENT_NETWORK_SERVER_DISCONNECTED, BT_EVENT_NAP_CONNECTION_STATE_CHANGED, FALSE,
+			__bt_convert_network_server, __bt_address_of_network_device, __bt_invoke_nap_connection_state_changed),
+	BT_EVENT_DISPATCH(BLUETOOTH_EVENT_NETWORK_CONNECTED, BT_EVENT_PAN_CONNECTION_STATE_CHANGED, TRUE,
+			__bt_convert_result, NULL, __bt_invoke_panu_connection_state_changed),
+	BT_EVENT_DISPATCH(BLUETOOTH_EVENT_NETWORK_DISCONNECTED, BT_EVENT_PAN_CONNECTION_STATE_CHANGED, FALSE,
+			__bt_convert_result, NULL, __bt_invoke_panu_connection_state_changed),
+	BT_EVENT_DISPATCH(BLUETOOTH_EVENT_HDP_CONNECTED, BT_EVENT_HDP_CONNECTED, 0,
+			__bt_convert_hdp_connected, __bt_address_of_hdp_connected, __bt_invoke_hdp_connected),
+	BT_EVENT_DISPATCH(BLUETOOTH_EVENT_HDP_DISCONNECTED, BT_EVENT_HDP_DISCONNECTED, 0,
+			__bt_convert_hdp_disconnected, __bt_address_of_hdp_disconnected, __bt_invoke_hdp_disconnected),
+	BT_EVENT_DISPATCH(BLUETOOTH_EVENT_HDP_DATA_RECEIVED, BT_EVENT_HDP_DATA_RECIEVED, 0,
+			__bt_convert_hdp_data_received, NULL, __bt_invoke_hdp_data_received),
+	BT_EVENT_DISPATCH(BLUETOOTH_EVENT_AG_CONNECTED, BT_EVENT_AUDIO_CONNECTION_STATUS, TRUE,
+			__bt_convert_ag_connection, __bt_address_of_ag_connection, __bt_invoke_audio_connection_state_changed),
+	BT_EVENT_DISPATCH(BLUETOOTH_EVENT_AG_DISCONNECTED, BT_EVENT_AUDIO_CONNECTION_STATUS, FALSE,
+			__bt_convert_ag_connection, __bt_address_of_ag_connection, __bt_invoke_audio_connection_state_changed),
+	BT_EVENT_DISPATCH(BLUETOOTH_EVENT_AG_SPEAKER_GAIN, BT_EVENT_AG_SPEAKER_GAIN_CHANGE, 0,
+			__bt_convert_gain, NULL, __bt_invoke_ag_speaker_gain_changed),
+	BT_EVENT_DISPATCH(BLUETOOTH_EVENT_AG_MIC_GAIN, BT_EVENT_AG_MICROPHONE_GAIN_CHANGE, 0,
+			__bt_convert_gain, NULL, __bt_invoke_ag_microphone_gain_changed),
+	BT_EVENT_DISPATCH(BLUETOOTH_EVENT_AG_AUDIO_CONNECTED, BT_EVENT_AUDIO_CONNECTION_STATUS, TRUE,
+			__bt_convert_ag_connection, __bt_address_of_ag_connection, __bt_invoke_audio_connection_state_changed),
+	BT_EVENT_DISPATCH(BLUETOOTH_EVENT_AG_AUDIO_DISCONNECTED, BT_EVENT_AUDIO_CONNECTION_STATUS, FALSE,
+			__bt_convert_ag_connection, __bt_address_of_ag_connection, __bt_invoke_audio_connection_state_changed),
+	BT_EVENT_DISPATCH(BLUETOOTH_EVENT_AV_CONNECTED, BT_EVENT_AUDIO_CONNECTION_STATUS, TRUE,
+			__bt_convert_av_connection, __bt_address_of_string, __bt_invoke_audio_connection_state_changed),
+	BT_EVENT_DISPATCH(BLUETOOTH_EVENT_AV_DISCONNECTED, BT_EVENT_AUDIO_CONNECTION_STATUS, FALSE,
+			__bt_convert_av_connection, __bt_address_of_string, __bt_invoke_audio_connection_state_changed),
+	BT_EVENT_DISPATCH(BLUETOOTH_HID_CONNECTED, BT_EVENT_HID_CONNECTION_STATUS, TRUE,
+			__bt_convert_address, __bt_address_of_param, __bt_invoke_hid_connection_state_changed),
+	BT_EVENT_DISPATCH(BLUETOOTH_HID_DISCONNECTED, BT_EVENT_HID_CONNECTION_STATUS, FALSE,
+			__bt_convert_address, __bt_address_of_param, __bt_invoke_hid_connection_state_changed),
+};
+
+/*
+ *  Whether the remote address of the event can be read from the F/W event.
+ */
+static bool __bt_event_has_address(int index)
+{
+	int i;
+
+	for (i = 0; i < (int)(sizeof(bt_event_dispatch_table) / sizeof(bt_event_dispatch_table[0])); i++) {
+		if (bt_event_dispatch_table[i].invoke != NULL && bt_event_dispatch_table[i].index == index &&
+				bt_event_dispatch_table[i].address != NULL)
+			return true;
 	}
 
-	free(discovery_info);
-	discovery_info = NULL;
+	return false;
 }
 
-static int __bt_get_cb_index(int event)
+static const bt_event_dispatch_s *__bt_get_dispatch_entry(int event)
+{
+	const bt_event_dispatch_s *entry = NULL;
+
+	if (event < 0 || event >= (int)(sizeof(bt_event_dispatch_table) / sizeof(bt_event_dispatch_table[0])))
+		return NULL;
+
+	entry = &bt_event_dispatch_table[event];
+	if (entry->invoke == NULL)
+		return NULL;
+
+	return entry;
+}
+
+static void __bt_update_caches(int event, bluetooth_event_param_t *param)
 {
 	switch (event) {
 	case BLUETOOTH_EVENT_ENABLED:
-	case BLUETOOTH_EVENT_DISABLED:
-		return BT_EVENT_STATE_CHANGED;
 	case BLUETOOTH_EVENT_LOCAL_NAME_CHANGED:
-		return BT_EVENT_NAME_CHANGED;
 	case BLUETOOTH_EVENT_DISCOVERABLE_MODE_CHANGED:
-		return BT_EVENT_VISIBILITY_MODE_CHANGED;
-	case BLUETOOTH_EVENT_DISCOVERY_STARTED:
-	case BLUETOOTH_EVENT_DISCOVERY_FINISHED:
+	case BLUETOOTH_EVENT_DISCOVERABLE_TIMEOUT:
+		_bt_adapter_cache_update(event, param);
+		break;
 	case BLUETOOTH_EVENT_REMOTE_DEVICE_NAME_UPDATED:
-		return BT_EVENT_DEVICE_DISCOVERY_STATE_CHANGED;
+		if (param->result == BLUETOOTH_ERROR_NONE && param->param_data != NULL)
+			_bt_device_cache_update((bluetooth_device_info_t *)(param->param_data));
+		break;
 	case BLUETOOTH_EVENT_BONDING_FINISHED:
-		return BT_EVENT_BOND_CREATED;
 	case BLUETOOTH_EVENT_BONDED_DEVICE_REMOVED:
-		return BT_EVENT_BOND_DESTROYED;
 	case BLUETOOTH_EVENT_DEVICE_AUTHORIZED:
 	case BLUETOOTH_EVENT_DEVICE_UNAUTHORIZED:
-		return BT_EVENT_AUTHORIZATION_CHANGED;
+	case BLUETOOTH_EVENT_DEVICE_CONNECTED:
+	case BLUETOOTH_EVENT_DEVICE_DISCONNECTED:
 	case BLUETOOTH_EVENT_SERVICE_SEARCHED:
-		return BT_EVENT_SERVICE_SEARCHED;
-	case BLUETOOTH_EVENT_RFCOMM_DATA_RECEIVED:
-		return BT_EVENT_DATA_RECEIVED;
+		_bt_bonded_cache_update(event, param);
+		_bt_sdp_cache_update(event, param);
+		_bt_sdp_queue_update(event, param);
+		break;
+	case BLUETOOTH_EVENT_SERVICE_SEARCH_CANCELLED:
+		_bt_sdp_queue_update(event, param);
+		break;
 	case BLUETOOTH_EVENT_RFCOMM_CONNECTED:
 	case BLUETOOTH_EVENT_RFCOMM_DISCONNECTED:
-		return BT_EVENT_CONNECTION_STATE_CHANGED;
-	case BLUETOOTH_EVENT_RFCOMM_AUTHORIZE:
-		return BT_EVENT_RFCOMM_CONNECTION_REQUESTED;
-	case BLUETOOTH_EVENT_OBEX_SERVER_CONNECTION_AUTHORIZE:
-		return BT_EVENT_OPP_CONNECTION_REQUESTED;
-	case BLUETOOTH_EVENT_OBEX_SERVER_TRANSFER_AUTHORIZE:
-		return BT_EVENT_OPP_PUSH_REQUESTED;
-	case BLUETOOTH_EVENT_OBEX_SERVER_TRANSFER_STARTED:
-		return BT_EVENT_OPP_SERVER_TRANSFER_PROGRESS;
-	case BLUETOOTH_EVENT_OBEX_SERVER_TRANSFER_PROGRESS:
-		return BT_EVENT_OPP_SERVER_TRANSFER_PROGRESS;
-	case BLUETOOTH_EVENT_OBEX_SERVER_TRANSFER_COMPLETED:
-		return BT_EVENT_OPP_SERVER_TRANSFER_FINISHED;
-	case BLUETOOTH_EVENT_OPC_CONNECTED:
-		return BT_EVENT_OPP_CLIENT_PUSH_RESPONSED;
-	case BLUETOOTH_EVENT_OPC_TRANSFER_STARTED:
-		return BT_EVENT_OPP_CLIENT_PUSH_PROGRESS;
-	case BLUETOOTH_EVENT_OPC_TRANSFER_PROGRESS:
-	case BLUETOOTH_EVENT_OPC_TRANSFER_COMPLETE:
-		return BT_EVENT_OPP_CLIENT_PUSH_PROGRESS;
-	case BLUETOOTH_EVENT_OPC_DISCONNECTED:
-		return BT_EVENT_OPP_CLIENT_PUSH_FINISHED;
-	case BLUETOOTH_EVENT_NETWORK_SERVER_CONNECTED:
-	case BLUETOOTH_EVENT_NETWORK_SERVER_DISCONNECTED:
-		return BT_EVENT_NAP_CONNECTION_STATE_CHANGED;
-	case BLUETOOTH_EVENT_NETWORK_CONNECTED:
-	case BLUETOOTH_EVENT_NETWORK_DISCONNECTED:
-		return BT_EVENT_PAN_CONNECTION_STATE_CHANGED;
-	case BLUETOOTH_EVENT_HDP_DATA_RECEIVED:
-		return BT_EVENT_HDP_DATA_RECIEVED;
 	case BLUETOOTH_EVENT_HDP_CONNECTED:
-		return BT_EVENT_HDP_CONNECTED;
 	case BLUETOOTH_EVENT_HDP_DISCONNECTED:
-		return BT_EVENT_HDP_DISCONNECTED;
-	case BLUETOOTH_EVENT_AG_CONNECTED:
-		return BT_EVENT_AUDIO_CONNECTION_STATUS;
-	case BLUETOOTH_EVENT_AG_DISCONNECTED:
-		return BT_EVENT_AUDIO_CONNECTION_STATUS;
-	case BLUETOOTH_EVENT_AG_SPEAKER_GAIN:
-		return BT_EVENT_AG_SPEAKER_GAIN_CHANGE;
-	case BLUETOOTH_EVENT_AG_MIC_GAIN:
-		return BT_EVENT_AG_MICROPHONE_GAIN_CHANGE;
-	case BLUETOOTH_EVENT_AG_AUDIO_CONNECTED:
-		return BT_EVENT_AUDIO_CONNECTION_STATUS;
-	case BLUETOOTH_EVENT_AG_AUDIO_DISCONNECTED:
-		return BT_EVENT_AUDIO_CONNECTION_STATUS;
-	case BLUETOOTH_EVENT_AV_CONNECTED:
-		return BT_EVENT_AUDIO_CONNECTION_STATUS;
-	case BLUETOOTH_EVENT_AV_DISCONNECTED:
-		return BT_EVENT_AUDIO_CONNECTION_STATUS;
-	case BLUETOOTH_HID_CONNECTED:
-		return  BT_EVENT_HID_CONNECTION_STATUS;
-	case BLUETOOTH_HID_DISCONNECTED:
-		return  BT_EVENT_HID_CONNECTION_STATUS;
+		_bt_dispatch_update(event, param);
+		break;
+	case BLUETOOTH_EVENT_DISABLED:
+		_bt_dispatch_update(event, param);
+		_bt_adapter_cache_update(event, param);
+		_bt_bonded_cache_update(event, param);
+		_bt_sdp_queue_update(event, param);
+		break;
 	default:
-		return -1;
+		break;
 	}
 }
 
+static void __bt_event_proxy(int event, bluetooth_event_param_t *param, void *user_data)
+{
+	const bt_event_dispatch_s *entry = NULL;
+	bt_event_listener_array_s *listeners = NULL;
+	bt_event_data_s data;
+	unsigned long long received = _bt_diag_now();
+
+	/* The sessions have their own filters and the periodic discovery and the proximity tracking none,
+	 * so they see the devices out of the discovery filter */
+	_bt_discovery_session_update(event, param);
+	_bt_discovery_schedule_update(event, param);
+	if (event == BLUETOOTH_EVENT_REMOTE_DEVICE_NAME_UPDATED && param->result == BLUETOOTH_ERROR_NONE &&
+			param->param_data != NULL)
+		_bt_proximity_update((bluetooth_device_info_t *)(param->param_data));
+
+	/* A device out of the discovery filter is dropped before it is cached or converted */
+	if (event == BLUETOOTH_EVENT_REMOTE_DEVICE_NAME_UPDATED && param->param_data != NULL &&
+			_bt_discovery_filter_match((bluetooth_device_info_t *)(param->param_data)) == false)
+		return;
+
+	/* The caches and the service search queue follow the events whether or not an application listens */
+	__bt_update_caches(event, param);
+
+	entry = __bt_get_dispatch_entry(event);
+	if (entry == NULL)
+		return;
+
+	memset(&data, 0x00, sizeof(bt_event_data_s));
+
+	/* Operations complete before the listeners are invoked */
+	if (_bt_operation_is_pending() == true) {
+		if (entry->address != NULL)
+			data.has_device_address = entry->address(param, &data.device_address);
+		_bt_operation_complete(event, _bt_get_error_code(param->result),
+				(data.has_device_address == true) ? &data.device_address : NULL);
+	}
+
+	/* Skip the conversion if nobody listens, or no listener wants the remote device */
+	__bt_event_enter_readers();
+	listeners = g_atomic_pointer_get(&bt_event_listeners[entry->index]);
+	if (listeners == NULL || listeners->count == 0) {
+		__bt_event_leave_readers();
+		return;
+	}
+
+	if ((listeners->filtered > 0 || listeners->binary > 0) && entry->address != NULL &&
+			data.has_device_address == false)
+		data.has_device_address = entry->address(param, &data.device_address);
+
+	if (listeners->filtered == listeners->count &&
+			(data.has_device_address == false ||
+			(listeners->any_filter != NULL &&
+			__bt_event_filter_contains(listeners->any_filter, &data.device_address) == false))) {
+		__bt_event_leave_readers();
+		return;
+	}
+	__bt_event_leave_readers();
+
+	/*
+	 *  Converted members are allocated in an arena, released after the callbacks. An event queued
+	 *  for the thread pool owns its arena, while an event delivered inline reuses the arena of
+	 *  the thread. Its largest chunk outlives the rewind, so no memory is allocated once the arena
+	 *  has grown to the largest event.
+	 */
+	if (_bt_dispatch_is_active() == true)
+		data.arena = _bt_arena_create();
+	if (data.arena == NULL)
+		data.arena = _bt_arena_get_thread_arena();
+	if (data.arena == NULL) {
+		LOGE("[%s] OUT_OF_MEMORY(0x%08x)", __FUNCTION__, BT_ERROR_OUT_OF_MEMORY);
+		return;
+	}
+	_bt_arena_get_mark(data.arena, &data.arena_mark);
+
+	data.event = event;
+	data.index = entry->index;
+	data.received = received;
+
+	if (entry->convert(entry->arg, param, &data) == false) {
+		_bt_release_event_data(&data);
+		return;
+	}
+	data.converted = _bt_diag_now();
+
+	if (_bt_dispatch_event(&data) == true)
+		return;
+
+	_bt_deliver_event(&data);
+}
+
+void _bt_deliver_event(bt_event_data_s *data)
+{
+	const bt_event_dispatch_s *entry = __bt_get_dispatch_entry(data->event);
+	bt_event_listener_array_s *listeners = NULL;
+	unsigned long long callback_started = 0;
+	bt_addr_t addr;
+	int i;
+
+	if (entry == NULL)
+		return;
+
+	__bt_event_enter_readers();
+	listeners = g_atomic_pointer_get(&bt_event_listeners[entry->index]);
+	if (listeners != NULL && listeners->count > 0) {
+		callback_started = _bt_diag_now();
+		for (i = 0; i < listeners->count; i++) {
+			if (listeners->listeners[i].filter != NULL &&
+					(data->has_device_address == false ||
+					__bt_event_filter_contains(listeners->listeners[i].filter, &data->device_address) == false))
+				continue;
+
+			if (listeners->listeners[i].binary == true) {
+				_bt_convert_hex_to_addr(&addr, &data->device_address);
+				((bt_event_addr_cb)listeners->listeners[i].callback)(data->index, data->result, data->state,
+						(data->has_device_address == true) ? &addr : NULL, listeners->listeners[i].user_data);
+				continue;
+			}
+
+			if (listeners->listeners[i].view == true) {
+				__bt_invoke_device_view(listeners->listeners[i].callback, data,
+						listeners->listeners[i].user_data);
+				continue;
+			}
+
+			__bt_convert_device_info(data);
+			entry->invoke(listeners->listeners[i].callback, data,
+					listeners->listeners[i].user_data);
+		}
+		_bt_diag_record(data, callback_started, _bt_diag_now());
+	}
+	__bt_event_leave_readers();
+
+	_bt_release_event_data(data);
+}
+
+int _bt_detach_event_data(bt_event_data_s *data)
+{
+	const char *name = NULL;
+	const char *interface_name = NULL;
+	const char *buffer = NULL;
+	bluetooth_device_info_t *device = NULL;
+
+	if (data->detached == true)
+		return BT_ERROR_NONE;
+
+	/* Copied into the arena of the event, so they are released with the converted members */
+	if (data->name != NULL && (name = _bt_arena_strdup(data->arena, data->name)) == NULL)
+		return BT_ERROR_OUT_OF_MEMORY;
+
+	if (data->interface_name != NULL &&
+			(interface_name = _bt_arena_strdup(data->arena, data->interface_name)) == NULL)
+		return BT_ERROR_OUT_OF_MEMORY;
+
+	if (data->data != NULL && data->size > 0 &&
+			(buffer = _bt_arena_memdup(data->arena, data->data, data->size)) == NULL)
+		return BT_ERROR_OUT_OF_MEMORY;
+
+	if (data->device != NULL &&
+			(device = _bt_arena_memdup(data->arena, data->device, sizeof(bluetooth_device_info_t))) == NULL)
+		return BT_ERROR_OUT_OF_MEMORY;
+
+	data->name = name;
+	data->interface_name = interface_name;
+	data->data = buffer;
+	data->device = device;
+	data->detached = true;
+
+	return BT_ERROR_NONE;
+}
+
+void _bt_release_event_data(bt_event_data_s *data)
+{
+	if (data->arena == NULL)
+		return;
+
+	if (_bt_arena_is_thread_arena(data->arena) == true)
+		_bt_arena_rewind(data->arena, &data->arena_mark);
+	else
+		_bt_arena_destroy(data->arena);
+
+	data->arena = NULL;
+	data->info = NULL;
+	data->name = NULL;
+	data->interface_name = NULL;
+	data->data = NULL;
+	data->device = NULL;
+	data->detached = false;
+}
+
+int _bt_get_bt_adapter_device_discovery_info_s(bt_adapter_device_discovery_info_s **discovery_info, bluetooth_device_info_t *source_info, bt_arena_s *arena) {
+	bt_discovery_info_ext_s *discovery_ext = NULL;
+	int i;
+
+	BT_CHECK_INPUT_PARAMETER(source_info);
+
+	discovery_ext = (bt_discovery_info_ext_s *)_bt_arena_alloc(arena, sizeof(bt_discovery_info_ext_s));
+	if (discovery_ext == NULL) {
+		*discovery_info = NULL;
+		return BT_ERROR_OUT_OF_MEMORY;
+	}
+	discovery_ext->service_mask = 0;
+	*discovery_info = &discovery_ext->info;
+
+	if (strlen(source_info->device_name.name) > 0) {
+		(*discovery_info)->remote_name = _bt_arena_strdup(arena, source_info->device_name.name);
+	} else {
+		(*discovery_info)->remote_name = NULL;
+	}
+
+	(*discovery_info)->remote_address = (char *)_bt_intern_address(&(source_info->device_address));
+
+	(*discovery_info)->bt_class.major_device_class = source_info->device_class.major_class;
+	(*discovery_info)->bt_class.minor_device_class = source_info->device_class.minor_class;
+	(*discovery_info)->bt_class.major_service_class_mask = source_info->device_class.service_class;
+
+	if (source_info->service_index > 0) {
+		(*discovery_info)->service_uuid = (char **)_bt_arena_alloc(arena, sizeof(char *) * source_info->service_index);
+		if ((*discovery_info)->service_uuid != NULL) {
+			for (i = 0; i < source_info->service_index; i++) {
+				(*discovery_info)->service_uuid[i] = __bt_convert_uuid_in_arena(arena, source_info->uuids[i],
+						&discovery_ext->service_mask);
+
+				LOGI("[%s] UUID: %s", __FUNCTION__, (*discovery_info)->service_uuid[i]);
+			}
+		}
+	} else {
+		(*discovery_info)->service_uuid = NULL;
+	}
+	(*discovery_info)->service_count = source_info->service_index;
+
+	(*discovery_info)->rssi = (int)source_info->rssi;
+	(*discovery_info)->is_bonded = (bool)source_info->paired;
+
+	return BT_ERROR_NONE;
+}
+
 static void __bt_convert_lower_to_upper(char *origin)
 {
 	int length = strlen(origin);
@@ -1028,3 +1859,35 @@ static void __bt_convert_lower_to_upper(char *origin)
 		}
 	}
 }
+
+/*
+ *  Interned address of a F/W address string, or a copy in the arena if it is malformed
+ */
+static const char *__bt_convert_address_string(bt_arena_s *arena, const char *address_str)
+{
+	const char *interned = _bt_intern_address_string(address_str);
+
+	if (interned != NULL)
+		return interned;
+
+	return _bt_arena_strdup(arena, address_str);
+}
+
+/*
+ *  Interned UUID of a F/W UUID string, or an uppercase copy in the arena if it is malformed
+ */
+static char *__bt_convert_uuid_in_arena(bt_arena_s *arena, const char *uuid, guint64 *service_mask)
+{
+	const char *interned = _bt_convert_uuid(uuid, service_mask);
+	char *uuid_str = NULL;
+
+	if (interned != NULL)
+		return (char *)interned;
+
+	uuid_str = _bt_arena_strdup(arena, uuid);
+
+	if (uuid_str != NULL)
+		__bt_convert_lower_to_upper(uuid_str);
+
+	return uuid_str;
+}
@@ -0,0 +1,373 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <glib.h>
+#include <dlog.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <bluetooth-api.h>
+
+#include "bluetooth.h"
+#include "bluetooth_private.h"
+
+#ifdef LOG_TAG
+#undef LOG_TAG
+#endif
+#define LOG_TAG "TIZEN_N_BLUETOOTH"
+
+/*
+ *  Discovered device cache
+ *
+ *  Each device found by a discovery is kept with the time it was last seen, keyed by its
+ *  interned address. An entry is immutable and reference counted: a new discovery of the
+ *  device replaces it, and readers take references under the lock, then invoke the
+ *  callbacks without it. Expired entries are skipped by the readers and removed by the
+ *  next sweep, which runs at most once per second.
+ */
+
+#define BT_DEVICE_CACHE_DEFAULT_TTL 60 /* seconds */
+#define BT_DEVICE_CACHE_SWEEP_INTERVAL G_USEC_PER_SEC
+
+/*
+ *  Single block: bt_device_cache_entry_s | service_uuid[] | remote_name | malformed UUID strings
+ */
+typedef struct {
+	volatile gint ref_count;
+	gint64 last_seen; /* g_get_monotonic_time() */
+	const char *end; /* Of the block, so a UUID string before it is not interned */
+	bt_discovery_info_ext_s discovery_ext;
+} bt_device_cache_entry_s;
+
+static GMutex bt_device_cache_lock;
+static GHashTable *bt_device_cache = NULL;
+static gint64 bt_device_cache_ttl = BT_DEVICE_CACHE_DEFAULT_TTL * G_USEC_PER_SEC;
+static gint64 bt_device_cache_last_sweep = 0;
+
+static void __bt_device_cache_unref(gpointer data)
+{
+	bt_device_cache_entry_s *entry = data;
+
+	if (g_atomic_int_dec_and_test(&entry->ref_count))
+		free(entry);
+}
+
+static bool __bt_device_cache_owns(const bt_device_cache_entry_s *entry, const char *str)
+{
+	return (str > (const char *)entry && str < entry->end) ? true : false;
+}
+
+static bt_device_cache_entry_s *__bt_device_cache_create_entry(const bluetooth_device_info_t *source_info, gint64 now)
+{
+	bt_device_cache_entry_s *entry = NULL;
+	bt_adapter_device_discovery_info_s *info = NULL;
+	const char *uuids[BLUETOOTH_MAX_SERVICES_FOR_DEVICE];
+	const char *address = NULL;
+	guint64 service_mask = 0;
+	int service_count = 0;
+	size_t name_len = 0;
+	size_t uuid_len = 0;
+	size_t size = 0;
+	size_t j;
+	char *pool = NULL;
+	int i;
+
+	address = _bt_intern_address(&source_info->device_address);
+	if (address == NULL)
+		return NULL;
+
+	service_count = (source_info->service_index > 0) ? source_info->service_index : 0;
+	if (service_count > BLUETOOTH_MAX_SERVICES_FOR_DEVICE)
+		service_count = BLUETOOTH_MAX_SERVICES_FOR_DEVICE;
+	name_len = strlen(source_info->device_name.name);
+
+	size = sizeof(bt_device_cache_entry_s) + sizeof(char *) * service_count;
+	if (name_len > 0)
+		size += name_len + 1;
+	for (i = 0; i < service_count; i++) {
+		uuids[i] = _bt_convert_uuid(source_info->uuids[i], &service_mask);
+		if (uuids[i] == NULL)
+			size += strlen(source_info->uuids[i]) + 1;
+	}
+
+	entry = malloc(size);
+	if (entry == NULL)
+		return NULL;
+
+	entry->ref_count = 1;
+	entry->last_seen = now;
+	entry->end = (char *)entry + size;
+	entry->discovery_ext.service_mask = service_mask;
+	info = &entry->discovery_ext.info;
+	pool = (char *)(entry + 1);
+
+	info->service_uuid = (service_count > 0) ? (char **)pool : NULL;
+	pool += sizeof(char *) * service_count;
+
+	if (name_len > 0) {
+		info->remote_name = pool;
+		memcpy(pool, source_info->device_name.name, name_len + 1);
+		pool += name_len + 1;
+	} else {
+		info->remote_name = NULL;
+	}
+
+	for (i = 0; i < service_count; i++) {
+		if (uuids[i] != NULL) {
+			info->service_uuid[i] = (char *)uuids[i];
+			continue;
+		}
+
+		uuid_len = strlen(source_info->uuids[i]);
+		info->service_uuid[i] = pool;
+		for (j = 0; j < uuid_len; j++)
+			pool[j] = g_ascii_toupper(source_info->uuids[i][j]);
+		pool[uuid_len] = '\0';
+		pool += uuid_len + 1;
+	}
+
+	info->remote_address = (char *)address;
+	info->bt_class.major_device_class = source_info->device_class.major_class;
+	info->bt_class.minor_device_class = source_info->device_class.minor_class;
+	info->bt_class.major_service_class_mask = source_info->device_class.service_class;
+	info->service_count = service_count;
+	info->rssi = (int)source_info->rssi;
+	info->is_bonded = (bool)source_info->paired;
+
+	return entry;
+}
+
+static gboolean __bt_device_cache_is_expired(gpointer key, gpointer value, gpointer user_data)
+{
+	bt_device_cache_entry_s *entry = value;
+	gint64 now = *(gint64 *)user_data;
+
+	return (now - entry->last_seen > bt_device_cache_ttl) ? TRUE : FALSE;
+}
+
+/*
+ *  Must be called with bt_device_cache_lock held.
+ */
+static void __bt_device_cache_sweep(gint64 now)
+{
+	if (bt_device_cache == NULL)
+		return;
+
+	g_hash_table_foreach_remove(bt_device_cache, __bt_device_cache_is_expired, &now);
+	bt_device_cache_last_sweep = now;
+}
+
+void _bt_device_cache_update(const bluetooth_device_info_t *source_info)
+{
+	bt_device_cache_entry_s *entry = NULL;
+	gint64 now = g_get_monotonic_time();
+
+	entry = __bt_device_cache_create_entry(source_info, now);
+	if (entry == NULL) {
+		LOGE("[%s] OUT_OF_MEMORY(0x%08x)", __FUNCTION__, BT_ERROR_OUT_OF_MEMORY);
+		return;
+	}
+
+	g_mutex_lock(&bt_device_cache_lock);
+	if (bt_device_cache == NULL)
+		bt_device_cache = g_hash_table_new_full(g_direct_hash, g_direct_equal, NULL, __bt_device_cache_unref);
+
+	if (bt_device_cache_ttl == 0) {
+		g_mutex_unlock(&bt_device_cache_lock);
+		__bt_device_cache_unref(entry);
+		return;
+	}
+
+	g_hash_table_replace(bt_device_cache, entry->discovery_ext.info.remote_address, entry);
+
+	if (now - bt_device_cache_last_sweep >= BT_DEVICE_CACHE_SWEEP_INTERVAL)
+		__bt_device_cache_sweep(now);
+	g_mutex_unlock(&bt_device_cache_lock);
+}
+
+void _bt_device_cache_clear(void)
+{
+	g_mutex_lock(&bt_device_cache_lock);
+	if (bt_device_cache != NULL) {
+		g_hash_table_destroy(bt_device_cache);
+		bt_device_cache = NULL;
+	}
+	g_mutex_unlock(&bt_device_cache_lock);
+}
+
+int bt_adapter_set_discovered_device_ttl(int ttl)
+{
+	BT_CHECK_INIT_STATUS();
+	if (ttl < 0) {
+		LOGE("[%s] INVALID_PARAMETER(0x%08x)", __FUNCTION__, BT_ERROR_INVALID_PARAMETER);
+		return BT_ERROR_INVALID_PARAMETER;
+	}
+
+	g_mutex_lock(&bt_device_cache_lock);
+	bt_device_cache_ttl = (gint64)ttl * G_USEC_PER_SEC;
+	if (ttl == 0 && bt_device_cache != NULL)
+		g_hash_table_remove_all(bt_device_cache);
+	else
+		__bt_device_cache_sweep(g_get_monotonic_time());
+	g_mutex_unlock(&bt_device_cache_lock);
+
+	return BT_ERROR_NONE;
+}
+
+int bt_adapter_get_discovered_device_ttl(int *ttl)
+{
+	BT_CHECK_INIT_STATUS();
+	BT_CHECK_INPUT_PARAMETER(ttl);
+
+	g_mutex_lock(&bt_device_cache_lock);
+	*ttl = (int)(bt_device_cache_ttl / G_USEC_PER_SEC);
+	g_mutex_unlock(&bt_device_cache_lock);
+
+	return BT_ERROR_NONE;
+}
+
+int bt_adapter_foreach_discovered_device(bt_adapter_discovered_device_cb foreach_cb, void *user_data)
+{
+	bt_device_cache_entry_s **entries = NULL;
+	bt_device_cache_entry_s *entry = NULL;
+	GHashTableIter iter;
+	gpointer value = NULL;
+	gint64 now = g_get_monotonic_time();
+	guint count = 0;
+	guint i;
+
+	BT_CHECK_INIT_STATUS();
+	BT_CHECK_INPUT_PARAMETER(foreach_cb);
+
+	/* References are taken under the lock, so the callback may call the cache functions */
+	g_mutex_lock(&bt_device_cache_lock);
+	__bt_device_cache_sweep(now);
+	if (bt_device_cache != NULL && g_hash_table_size(bt_device_cache) > 0) {
+		entries = malloc(sizeof(bt_device_cache_entry_s *) * g_hash_table_size(bt_device_cache));
+		if (entries == NULL) {
+			g_mutex_unlock(&bt_device_cache_lock);
+			LOGE("[%s] OUT_OF_MEMORY(0x%08x)", __FUNCTION__, BT_ERROR_OUT_OF_MEMORY);
+			return BT_ERROR_OUT_OF_MEMORY;
+		}
+
+		g_hash_table_iter_init(&iter, bt_device_cache);
+		while (g_hash_table_iter_next(&iter, NULL, &value)) {
+			entry = value;
+			g_atomic_int_inc(&entry->ref_count);
+			entries[count++] = entry;
+		}
+	}
+	g_mutex_unlock(&bt_device_cache_lock);
+
+	for (i = 0; i < count; i++) {
+		if (!foreach_cb(&entries[i]->discovery_ext.info, (int)((now - entries[i]->last_seen) / 1000), user_data))
+			break;
+	}
+
+	for (i = 0; i < count; i++)
+		__bt_device_cache_unref(entries[i]);
+	free(entries);
+
+	return BT_ERROR_NONE;
+}
+
+int bt_adapter_get_discovered_device_info(const char *remote_address,
+		bt_adapter_device_discovery_info_s **discovery_info, int *age)
+{
+	bluetooth_device_address_t addr_hex = { {0,} };
+	bt_device_cache_entry_s *entry = NULL;
+	bt_discovery_info_ext_s *discovery_ext = NULL;
+	const char *address = NULL;
+	gint64 now = g_get_monotonic_time();
+	size_t size = 0;
+	char *pool = NULL;
+	int i;
+
+	BT_CHECK_INIT_STATUS();
+	BT_CHECK_INPUT_PARAMETER(remote_address);
+	BT_CHECK_INPUT_PARAMETER(discovery_info);
+	BT_CHECK_ADDRESS_TO_HEX(&addr_hex, remote_address);
+
+	address = _bt_intern_address(&addr_hex);
+	if (address == NULL) {
+		LOGE("[%s] OUT_OF_MEMORY(0x%08x)", __FUNCTION__, BT_ERROR_OUT_OF_MEMORY);
+		return BT_ERROR_OUT_OF_MEMORY;
+	}
+
+	g_mutex_lock(&bt_device_cache_lock);
+	if (bt_device_cache != NULL)
+		entry = g_hash_table_lookup(bt_device_cache, address);
+	if (entry == NULL || now - entry->last_seen > bt_device_cache_ttl) {
+		g_mutex_unlock(&bt_device_cache_lock);
+		return BT_ERROR_REMOTE_DEVICE_NOT_FOUND;
+	}
+
+	/* The copy shares the interned strings, and owns the name, the UUID table and the malformed UUIDs */
+	size = sizeof(bt_discovery_info_ext_s) + sizeof(char *) * entry->discovery_ext.info.service_count;
+	if (entry->discovery_ext.info.remote_name != NULL)
+		size += strlen(entry->discovery_ext.info.remote_name) + 1;
+	for (i = 0; i < entry->discovery_ext.info.service_count; i++) {
+		if (__bt_device_cache_owns(entry, entry->discovery_ext.info.service_uuid[i]) == true)
+			size += strlen(entry->discovery_ext.info.service_uuid[i]) + 1;
+	}
+
+	discovery_ext = malloc(size);
+	if (discovery_ext == NULL) {
+		g_mutex_unlock(&bt_device_cache_lock);
+		LOGE("[%s] OUT_OF_MEMORY(0x%08x)", __FUNCTION__, BT_ERROR_OUT_OF_MEMORY);
+		return BT_ERROR_OUT_OF_MEMORY;
+	}
+
+	*discovery_ext = entry->discovery_ext;
+	pool = (char *)(discovery_ext + 1);
+	if (entry->discovery_ext.info.service_count > 0) {
+		discovery_ext->info.service_uuid = (char **)pool;
+		for (i = 0; i < entry->discovery_ext.info.service_count; i++)
+			discovery_ext->info.service_uuid[i] = entry->discovery_ext.info.service_uuid[i];
+		pool += sizeof(char *) * entry->discovery_ext.info.service_count;
+	}
+	if (entry->discovery_ext.info.remote_name != NULL) {
+		discovery_ext->info.remote_name = pool;
+		strcpy(pool, entry->discovery_ext.info.remote_name);
+		pool += strlen(pool) + 1;
+	}
+	for (i = 0; i < entry->discovery_ext.info.service_count; i++) {
+		if (__bt_device_cache_owns(entry, entry->discovery_ext.info.service_uuid[i]) == false)
+			continue;
+		discovery_ext->info.service_uuid[i] = pool;
+		strcpy(pool, entry->discovery_ext.info.service_uuid[i]);
+		pool += strlen(pool) + 1;
+	}
+
+	if (age != NULL)
+		*age = (int)((now - entry->last_seen) / 1000);
+	g_mutex_unlock(&bt_device_cache_lock);
+
+	*discovery_info = &discovery_ext->info;
+
+	return BT_ERROR_NONE;
+}
+
+int bt_adapter_free_discovered_device_info(bt_adapter_device_discovery_info_s *discovery_info)
+{
+	BT_CHECK_INIT_STATUS();
+	BT_CHECK_INPUT_PARAMETER(discovery_info);
+
+	free(BT_INFO_EXT(discovery_info, bt_discovery_info_ext_s));
+
+	return BT_ERROR_NONE;
+}
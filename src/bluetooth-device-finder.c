@@ -0,0 +1,360 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <glib.h>
+#include <dlog.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <bluetooth-api.h>
+
+#include "bluetooth.h"
+#include "bluetooth_private.h"
+
+#ifdef LOG_TAG
+#undef LOG_TAG
+#endif
+#define LOG_TAG "TIZEN_N_BLUETOOTH"
+
+/*
+ *  Device lookup
+ *
+ *  A lookup is first answered from the discovered device cache. Otherwise it opens a discovery
+ *  session, filtered on its service so the other devices are not converted, and completes with
+ *  the first device which matches, its deadline, or a cancellation. Closing the session stops
+ *  the discovery unless another session needs it. As for the operations, whoever removes a
+ *  lookup from the pending list invokes its callback, without the lock. The session callback
+ *  carries the id of the lookup, since it may run while the lookup completes in another thread.
+ */
+
+typedef struct {
+	int id;
+	const char *remote_address; /* Interned, NULL for any */
+	GPatternSpec *name_pattern; /* NULL for any */
+	bt_uuid_s service_uuid; /* Valid if has_service_uuid */
+	bool has_service_uuid;
+	guint64 service_mask; /* #BT_SERVICE_BIT() of service_uuid if it is well-known */
+	bt_adapter_discovery_session_h session;
+	GSource *timeout_source; /* Referenced, NULL before the lookup is pending */
+	bt_adapter_device_found_cb callback;
+	void *user_data;
+} bt_device_finder_s;
+
+typedef struct {
+	const bt_device_finder_s *finder;
+	int max_age;
+	bool found;
+} bt_device_finder_cache_search_s;
+
+static GMutex bt_device_finder_lock;
+static GSList *bt_device_finders = NULL; /* Pending lookups */
+static int bt_device_finder_last_id = 0;
+
+/*
+ *  As for the operations, the timeout source is kept referenced, since the lookup may time out on
+ *  the main loop while it completes in another thread.
+ */
+static void __bt_device_finder_free(bt_device_finder_s *finder)
+{
+	if (finder->timeout_source != NULL) {
+		g_source_destroy(finder->timeout_source);
+		g_source_unref(finder->timeout_source);
+	}
+	if (finder->name_pattern != NULL)
+		g_pattern_spec_free(finder->name_pattern);
+	free(finder);
+}
+
+/*
+ *  Must be called with bt_device_finder_lock held.
+ */
+static GSList *__bt_device_finder_find(int find_id)
+{
+	GSList *node = NULL;
+
+	for (node = bt_device_finders; node != NULL; node = node->next) {
+		if (((bt_device_finder_s *)node->data)->id == find_id)
+			return node;
+	}
+
+	return NULL;
+}
+
+/*
+ *  Must be called with bt_device_finder_lock held.
+ */
+static bt_device_finder_s *__bt_device_finder_remove(int find_id)
+{
+	bt_device_finder_s *finder = NULL;
+	GSList *node = __bt_device_finder_find(find_id);
+
+	if (node == NULL)
+		return NULL;
+
+	finder = node->data;
+	bt_device_finders = g_slist_delete_link(bt_device_finders, node);
+
+	return finder;
+}
+
+static bool __bt_device_finder_match(const bt_device_finder_s *finder,
+		const bt_adapter_device_discovery_info_s *discovery_info)
+{
+	bt_uuid_s uuid;
+	int i;
+
+	/* Interned addresses are compared by pointer */
+	if (finder->remote_address != NULL && discovery_info->remote_address != finder->remote_address)
+		return false;
+
+	if (finder->name_pattern != NULL && (discovery_info->remote_name == NULL ||
+			g_pattern_match_string(finder->name_pattern, discovery_info->remote_name) == FALSE))
+		return false;
+
+	if (finder->service_mask != 0)
+		return (BT_INFO_EXT(discovery_info, bt_discovery_info_ext_s)->service_mask & finder->service_mask) != 0;
+
+	/* The F/W may report the UUID in another form than the criteria */
+	if (finder->has_service_uuid == true) {
+		for (i = 0; i < discovery_info->service_count; i++) {
+			if (_bt_parse_uuid(discovery_info->service_uuid[i], &uuid) == true &&
+					memcmp(&uuid, &finder->service_uuid, sizeof(bt_uuid_s)) == 0)
+				return true;
+		}
+		return false;
+	}
+
+	return true;
+}
+
+static void __bt_device_finder_finish(bt_device_finder_s *finder, int result,
+		bt_adapter_device_discovery_info_s *discovery_info)
+{
+	if (finder->session != NULL)
+		_bt_discovery_session_close(finder->session);
+
+	if (result != BT_ERROR_NONE)
+		LOGI("[%s] lookup %d: %s(0x%08x)", __FUNCTION__, finder->id, _bt_convert_error_to_string(result), result);
+
+	finder->callback(result, discovery_info, 0, finder->user_data);
+	__bt_device_finder_free(finder);
+}
+
+static gboolean __bt_device_finder_timeout(gpointer user_data)
+{
+	bt_device_finder_s *finder = NULL;
+
+	g_mutex_lock(&bt_device_finder_lock);
+	finder = __bt_device_finder_remove(GPOINTER_TO_INT(user_data));
+	g_mutex_unlock(&bt_device_finder_lock);
+
+	if (finder != NULL)
+		__bt_device_finder_finish(finder, BT_ERROR_TIMED_OUT, NULL);
+
+	return FALSE;
+}
+
+static void __bt_device_finder_discovered(int result, bt_adapter_device_discovery_state_e discovery_state,
+		bt_adapter_device_discovery_info_s *discovery_info, void *user_data)
+{
+	bt_device_finder_s *finder = NULL;
+	GSList *node = NULL;
+	int find_id = GPOINTER_TO_INT(user_data);
+
+	g_mutex_lock(&bt_device_finder_lock);
+	node = __bt_device_finder_find(find_id);
+	if (node != NULL && (discovery_state != BT_ADAPTER_DEVICE_DISCOVERY_FOUND ||
+			__bt_device_finder_match(node->data, discovery_info) == true))
+		finder = __bt_device_finder_remove(find_id);
+	g_mutex_unlock(&bt_device_finder_lock);
+
+	/* Found, or the adapter was disabled */
+	if (finder != NULL)
+		__bt_device_finder_finish(finder, result, discovery_info);
+}
+
+static bool __bt_device_finder_search_cache(bt_adapter_device_discovery_info_s *discovery_info, int age,
+		void *user_data)
+{
+	bt_device_finder_cache_search_s *search = user_data;
+
+	if (age > search->max_age || __bt_device_finder_match(search->finder, discovery_info) == false)
+		return true;
+
+	search->found = true;
+	search->finder->callback(BT_ERROR_NONE, discovery_info, age, search->finder->user_data);
+
+	return false;
+}
+
+void _bt_device_finder_cancel_all(void)
+{
+	bt_device_finder_s *finder = NULL;
+
+	while (true) {
+		g_mutex_lock(&bt_device_finder_lock);
+		finder = (bt_device_finders != NULL) ? __bt_device_finder_remove(
+				((bt_device_finder_s *)bt_device_finders->data)->id) : NULL;
+		g_mutex_unlock(&bt_device_finder_lock);
+
+		if (finder == NULL)
+			break;
+
+		__bt_device_finder_finish(finder, BT_ERROR_CANCELLED, NULL);
+	}
+}
+
+int bt_adapter_find_device(const bt_adapter_find_device_criteria_s *criteria, int timeout_ms,
+		bt_adapter_device_found_cb callback, void *user_data, int *find_id)
+{
+	bluetooth_device_address_t addr_hex = { {0,} };
+	bt_adapter_device_discovery_filter_s filter;
+	bt_adapter_discovery_session_h session = NULL;
+	bt_device_finder_cache_search_s search;
+	bt_device_finder_s *finder = NULL;
+	const char *service_uuid = NULL;
+	GSList *node = NULL;
+	int error_code = BT_ERROR_NONE;
+	int service = 0;
+	int id = 0;
+
+	BT_CHECK_INIT_STATUS();
+	BT_CHECK_INPUT_PARAMETER(criteria);
+	BT_CHECK_INPUT_PARAMETER(callback);
+	BT_CHECK_INPUT_PARAMETER(find_id);
+	if ((criteria->remote_address == NULL && criteria->name_pattern == NULL && criteria->service_uuid == NULL) ||
+			criteria->max_age < 0 || timeout_ms <= 0) {
+		LOGE("[%s] INVALID_PARAMETER(0x%08x)", __FUNCTION__, BT_ERROR_INVALID_PARAMETER);
+		return BT_ERROR_INVALID_PARAMETER;
+	}
+
+	finder = calloc(1, sizeof(bt_device_finder_s));
+	if (finder == NULL) {
+		LOGE("[%s] OUT_OF_MEMORY(0x%08x)", __FUNCTION__, BT_ERROR_OUT_OF_MEMORY);
+		return BT_ERROR_OUT_OF_MEMORY;
+	}
+
+	if (criteria->remote_address != NULL) {
+		if (_bt_parse_address(criteria->remote_address, &addr_hex) == false) {
+			__bt_device_finder_free(finder);
+			LOGE("[%s] INVALID_PARAMETER(0x%08x)", __FUNCTION__, BT_ERROR_INVALID_PARAMETER);
+			return BT_ERROR_INVALID_PARAMETER;
+		}
+		finder->remote_address = _bt_intern_address(&addr_hex);
+		if (finder->remote_address == NULL)
+			error_code = BT_ERROR_OUT_OF_MEMORY;
+	}
+	if (criteria->service_uuid != NULL && error_code == BT_ERROR_NONE) {
+		finder->has_service_uuid = _bt_parse_uuid(criteria->service_uuid, &finder->service_uuid);
+		if (finder->has_service_uuid == false)
+			error_code = BT_ERROR_INVALID_PARAMETER;
+		else if ((service = _bt_get_uuid_service(&finder->service_uuid)) >= 0)
+			finder->service_mask = BT_SERVICE_BIT(service);
+	}
+	if (criteria->name_pattern != NULL && error_code == BT_ERROR_NONE)
+		finder->name_pattern = g_pattern_spec_new(criteria->name_pattern);
+	if (error_code != BT_ERROR_NONE) {
+		__bt_device_finder_free(finder);
+		LOGE("[%s] %s(0x%08x)", __FUNCTION__, _bt_convert_error_to_string(error_code), error_code);
+		return error_code;
+	}
+	finder->callback = callback;
+	finder->user_data = user_data;
+
+	g_mutex_lock(&bt_device_finder_lock);
+	if (++bt_device_finder_last_id <= 0)
+		bt_device_finder_last_id = 1;
+	id = finder->id = bt_device_finder_last_id;
+	g_mutex_unlock(&bt_device_finder_lock);
+
+	*find_id = id;
+
+	/* A device seen recently completes the lookup without any discovery */
+	if (criteria->max_age > 0) {
+		search.finder = finder;
+		search.max_age = criteria->max_age;
+		search.found = false;
+		bt_adapter_foreach_discovered_device(__bt_device_finder_search_cache, &search);
+		if (search.found == true) {
+			__bt_device_finder_free(finder);
+			return BT_ERROR_NONE;
+		}
+	}
+
+	/* Pending before the session opens, so a device found at once is not missed */
+	g_mutex_lock(&bt_device_finder_lock);
+	finder->timeout_source = g_timeout_source_new(timeout_ms);
+	g_source_set_callback(finder->timeout_source, __bt_device_finder_timeout, GINT_TO_POINTER(id), NULL);
+	g_source_attach(finder->timeout_source, NULL);
+	bt_device_finders = g_slist_append(bt_device_finders, finder);
+	g_mutex_unlock(&bt_device_finder_lock);
+
+	memset(&filter, 0x00, sizeof(filter));
+	if (criteria->service_uuid != NULL) {
+		service_uuid = criteria->service_uuid;
+		filter.service_uuids = &service_uuid;
+		filter.service_count = 1;
+	}
+
+	error_code = bt_adapter_open_discovery_session(&filter, __bt_device_finder_discovered, GINT_TO_POINTER(id),
+			&session);
+
+	if (error_code != BT_ERROR_NONE) {
+		g_mutex_lock(&bt_device_finder_lock);
+		finder = __bt_device_finder_remove(id);
+		g_mutex_unlock(&bt_device_finder_lock);
+
+		/* Otherwise it already timed out or was cancelled, and its callback was invoked */
+		if (finder == NULL)
+			return BT_ERROR_NONE;
+
+		__bt_device_finder_free(finder);
+		return error_code;
+	}
+
+	/* The lookup may have completed while the session was opening, then its session is closed here */
+	g_mutex_lock(&bt_device_finder_lock);
+	node = __bt_device_finder_find(id);
+	if (node != NULL)
+		((bt_device_finder_s *)node->data)->session = session;
+	g_mutex_unlock(&bt_device_finder_lock);
+
+	if (node == NULL)
+		_bt_discovery_session_close(session);
+
+	return BT_ERROR_NONE;
+}
+
+int bt_adapter_cancel_find_device(int find_id)
+{
+	bt_device_finder_s *finder = NULL;
+
+	BT_CHECK_INIT_STATUS();
+
+	g_mutex_lock(&bt_device_finder_lock);
+	finder = __bt_device_finder_remove(find_id);
+	g_mutex_unlock(&bt_device_finder_lock);
+
+	if (finder == NULL) {
+		LOGE("[%s] NOT_IN_PROGRESS(0x%08x)", __FUNCTION__, BT_ERROR_NOT_IN_PROGRESS);
+		return BT_ERROR_NOT_IN_PROGRESS;
+	}
+
+	__bt_device_finder_finish(finder, BT_ERROR_CANCELLED, NULL);
+
+	return BT_ERROR_NONE;
+}
@@ -27,19 +27,64 @@
 #endif
 #define LOG_TAG "TIZEN_N_BLUETOOTH"
 
+static const bt_operation_type_s bt_operation_create_bond = {
+	{ BLUETOOTH_EVENT_BONDING_FINISHED, 0 }, bluetooth_cancel_bonding,
+};
+
+static const bt_operation_type_s bt_operation_service_search = {
+	{ BLUETOOTH_EVENT_SERVICE_SEARCHED, 0 }, bluetooth_cancel_service_search,
+};
+
+static int __bt_device_create_bond(bluetooth_device_address_t *addr_hex)
+{
+	int error_code = _bt_get_error_code(bluetooth_bond_device(addr_hex));
+
+	if (error_code != BT_ERROR_NONE) {
+		LOGE("[%s] %s(0x%08x)", __FUNCTION__, _bt_convert_error_to_string(error_code), error_code);
+	}
+
+	return error_code;
+}
+
 int bt_device_create_bond(const char *device_address)
 {
 	bluetooth_device_address_t addr_hex = { {0,} };
-	int error_code = BT_ERROR_NONE;
 
 	BT_CHECK_INIT_STATUS();
 	BT_CHECK_INPUT_PARAMETER(device_address);
 
-	_bt_convert_address_to_hex(&addr_hex, device_address);
-	error_code = _bt_get_error_code(bluetooth_bond_device(&addr_hex));
-	if (error_code != BT_ERROR_NONE) {
-		LOGE("[%s] %s(0x%08x)", __FUNCTION__, _bt_convert_error_to_string(error_code), error_code);
-	}
+	BT_CHECK_ADDRESS_TO_HEX(&addr_hex, device_address);
+	return __bt_device_create_bond(&addr_hex);
+}
+
+int bt_device_create_bond_by_addr(const bt_addr_t *remote_addr)
+{
+	bluetooth_device_address_t addr_hex = { {0,} };
+
+	BT_CHECK_INIT_STATUS();
+	BT_CHECK_INPUT_PARAMETER(remote_addr);
+
+	_bt_convert_addr_to_hex(&addr_hex, remote_addr);
+	return __bt_device_create_bond(&addr_hex);
+}
+
+int bt_device_create_bond_async(const char *remote_address, int timeout_ms,
+		bt_operation_completed_cb callback, void *user_data, int *operation_id)
+{
+	bluetooth_device_address_t addr_hex = { {0,} };
+	int error_code = BT_ERROR_NONE;
+
+	BT_CHECK_INIT_STATUS();
+	BT_CHECK_INPUT_PARAMETER(remote_address);
+	BT_CHECK_ADDRESS_TO_HEX(&addr_hex, remote_address);
+
+	error_code = _bt_operation_begin(&bt_operation_create_bond, &addr_hex, timeout_ms, callback, user_data, operation_id);
+	if (error_code != BT_ERROR_NONE)
+		return error_code;
+
+	error_code = __bt_device_create_bond(&addr_hex);
+	if (error_code != BT_ERROR_NONE)
+		_bt_operation_abort(*operation_id);
 
 	return error_code;
 }
@@ -57,70 +102,113 @@ int bt_device_cancel_bonding(void)
 	return error_code;
 }
 
+static int __bt_device_destroy_bond(bluetooth_device_address_t *addr_hex)
+{
+	int error_code = _bt_get_error_code(bluetooth_unbond_device(addr_hex));
+
+	if (error_code != BT_ERROR_NONE) {
+		LOGE("[%s] %s(0x%08x)", __FUNCTION__, _bt_convert_error_to_string(error_code), error_code);
+	}
+
+	return error_code;
+}
+
 int bt_device_destroy_bond(const char *device_address)
 {
 	bluetooth_device_address_t addr_hex = { {0,} };
-	int error_code = BT_ERROR_NONE;
 
 	BT_CHECK_INIT_STATUS();
 	BT_CHECK_INPUT_PARAMETER(device_address);
 
-	_bt_convert_address_to_hex(&addr_hex, device_address);
-	error_code = _bt_get_error_code(bluetooth_unbond_device(&addr_hex));
+	BT_CHECK_ADDRESS_TO_HEX(&addr_hex, device_address);
+	return __bt_device_destroy_bond(&addr_hex);
+}
+
+int bt_device_destroy_bond_by_addr(const bt_addr_t *remote_addr)
+{
+	bluetooth_device_address_t addr_hex = { {0,} };
+
+	BT_CHECK_INIT_STATUS();
+	BT_CHECK_INPUT_PARAMETER(remote_addr);
+
+	_bt_convert_addr_to_hex(&addr_hex, remote_addr);
+	return __bt_device_destroy_bond(&addr_hex);
+}
+
+static int __bt_device_set_alias(bluetooth_device_address_t *addr_hex, const char *alias)
+{
+	int error_code = _bt_get_error_code(bluetooth_set_alias(addr_hex, alias));
+
 	if (error_code != BT_ERROR_NONE) {
 		LOGE("[%s] %s(0x%08x)", __FUNCTION__, _bt_convert_error_to_string(error_code), error_code);
 	}
-
 	return error_code;
 }
 
 int bt_device_set_alias(const char *device_address, const char *alias)
 {
 	bluetooth_device_address_t addr_hex = { {0,} };
-	int error_code = BT_ERROR_NONE;
 
 	BT_CHECK_INIT_STATUS();
 	BT_CHECK_INPUT_PARAMETER(device_address);
 	BT_CHECK_INPUT_PARAMETER(alias);
 
-	_bt_convert_address_to_hex(&addr_hex, device_address);
-	error_code = _bt_get_error_code(bluetooth_set_alias(&addr_hex, alias));
-	if (error_code != BT_ERROR_NONE) {
-		LOGE("[%s] %s(0x%08x)", __FUNCTION__, _bt_convert_error_to_string(error_code), error_code);
-	}
-	return error_code;
+	BT_CHECK_ADDRESS_TO_HEX(&addr_hex, device_address);
+	return __bt_device_set_alias(&addr_hex, alias);
 }
 
-int bt_device_set_authorization(const char *device_address, bt_device_authorization_e authorization)
+int bt_device_set_alias_by_addr(const bt_addr_t *remote_addr, const char *alias)
 {
 	bluetooth_device_address_t addr_hex = { {0,} };
-	gboolean trusted = FALSE;
-	int error_code = BT_ERROR_NONE;
 
 	BT_CHECK_INIT_STATUS();
-	BT_CHECK_INPUT_PARAMETER(device_address);
+	BT_CHECK_INPUT_PARAMETER(remote_addr);
+	BT_CHECK_INPUT_PARAMETER(alias);
+
+	_bt_convert_addr_to_hex(&addr_hex, remote_addr);
+	return __bt_device_set_alias(&addr_hex, alias);
+}
+
+static int __bt_device_set_authorization(bluetooth_device_address_t *addr_hex, bt_device_authorization_e authorization)
+{
+	gboolean trusted = FALSE;
+	int error_code = BT_ERROR_NONE;
 
-	_bt_convert_address_to_hex(&addr_hex, device_address);
 	if (authorization == BT_DEVICE_AUTHORIZED)
 		trusted = TRUE;
 
-	error_code = _bt_get_error_code(bluetooth_authorize_device(&addr_hex, trusted));
+	error_code = _bt_get_error_code(bluetooth_authorize_device(addr_hex, trusted));
 	if (error_code != BT_ERROR_NONE) {
 		LOGE("[%s] %s(0x%08x)", __FUNCTION__, _bt_convert_error_to_string(error_code), error_code);
 	}
 	return error_code;
 }
 
-int bt_device_start_service_search(const char *device_address)
+int bt_device_set_authorization(const char *device_address, bt_device_authorization_e authorization)
 {
 	bluetooth_device_address_t addr_hex = { {0,} };
-	int ret = 0;
 
 	BT_CHECK_INIT_STATUS();
 	BT_CHECK_INPUT_PARAMETER(device_address);
 
-	_bt_convert_address_to_hex(&addr_hex, device_address);
-	ret = _bt_get_error_code(bluetooth_search_service(&addr_hex));
+	BT_CHECK_ADDRESS_TO_HEX(&addr_hex, device_address);
+	return __bt_device_set_authorization(&addr_hex, authorization);
+}
+
+int bt_device_set_authorization_by_addr(const bt_addr_t *remote_addr, bt_device_authorization_e authorization)
+{
+	bluetooth_device_address_t addr_hex = { {0,} };
+
+	BT_CHECK_INIT_STATUS();
+	BT_CHECK_INPUT_PARAMETER(remote_addr);
+
+	_bt_convert_addr_to_hex(&addr_hex, remote_addr);
+	return __bt_device_set_authorization(&addr_hex, authorization);
+}
+
+static int __bt_device_start_service_search(bluetooth_device_address_t *addr_hex)
+{
+	int ret = _bt_get_error_code(bluetooth_search_service(addr_hex));
 
 	// In service search, BT_ERROR_SERVICE_SEARCH_FAILED is returned instead of BT_ERROR_OPERATION_FAILED.
 	if (ret == BT_ERROR_OPERATION_FAILED)
@@ -132,6 +220,49 @@ int bt_device_start_service_search(const char *device_address)
 	return ret;
 }
 
+int bt_device_start_service_search(const char *device_address)
+{
+	bluetooth_device_address_t addr_hex = { {0,} };
+
+	BT_CHECK_INIT_STATUS();
+	BT_CHECK_INPUT_PARAMETER(device_address);
+
+	BT_CHECK_ADDRESS_TO_HEX(&addr_hex, device_address);
+	return __bt_device_start_service_search(&addr_hex);
+}
+
+int bt_device_start_service_search_by_addr(const bt_addr_t *remote_addr)
+{
+	bluetooth_device_address_t addr_hex = { {0,} };
+
+	BT_CHECK_INIT_STATUS();
+	BT_CHECK_INPUT_PARAMETER(remote_addr);
+
+	_bt_convert_addr_to_hex(&addr_hex, remote_addr);
+	return __bt_device_start_service_search(&addr_hex);
+}
+
+int bt_device_start_service_search_async(const char *remote_address, int timeout_ms,
+		bt_operation_completed_cb callback, void *user_data, int *operation_id)
+{
+	bluetooth_device_address_t addr_hex = { {0,} };
+	int error_code = BT_ERROR_NONE;
+
+	BT_CHECK_INIT_STATUS();
+	BT_CHECK_INPUT_PARAMETER(remote_address);
+	BT_CHECK_ADDRESS_TO_HEX(&addr_hex, remote_address);
+
+	error_code = _bt_operation_begin(&bt_operation_service_search, &addr_hex, timeout_ms, callback, user_data, operation_id);
+	if (error_code != BT_ERROR_NONE)
+		return error_code;
+
+	error_code = __bt_device_start_service_search(&addr_hex);
+	if (error_code != BT_ERROR_NONE)
+		_bt_operation_abort(*operation_id);
+
+	return error_code;
+}
+
 int bt_device_cancel_service_search(void)
 {
 	int ret = 0;
@@ -229,3 +360,156 @@ int bt_device_unset_service_searched_cb(void)
 	return BT_ERROR_NONE;
 }
 
+
+int bt_device_view_get_address(bt_device_view_h device, const char **remote_address)
+{
+	BT_CHECK_INPUT_PARAMETER(device);
+	BT_CHECK_INPUT_PARAMETER(remote_address);
+
+	/* Formatted once, on the first request */
+	if (device->address[0] == '\0')
+		_bt_format_address(device->address, &device->info->device_address);
+
+	*remote_address = device->address;
+
+	return BT_ERROR_NONE;
+}
+
+int bt_device_view_get_name(bt_device_view_h device, const char **remote_name)
+{
+	BT_CHECK_INPUT_PARAMETER(device);
+	BT_CHECK_INPUT_PARAMETER(remote_name);
+
+	if (device->info->device_name.name[0] != '\0')
+		*remote_name = device->info->device_name.name;
+	else
+		*remote_name = NULL;
+
+	return BT_ERROR_NONE;
+}
+
+int bt_device_view_get_class(bt_device_view_h device, bt_class_s *bt_class)
+{
+	BT_CHECK_INPUT_PARAMETER(device);
+	BT_CHECK_INPUT_PARAMETER(bt_class);
+
+	bt_class->major_device_class = device->info->device_class.major_class;
+	bt_class->minor_device_class = device->info->device_class.minor_class;
+	bt_class->major_service_class_mask = device->info->device_class.service_class;
+
+	return BT_ERROR_NONE;
+}
+
+int bt_device_view_get_rssi(bt_device_view_h device, int *rssi)
+{
+	BT_CHECK_INPUT_PARAMETER(device);
+	BT_CHECK_INPUT_PARAMETER(rssi);
+
+	*rssi = (int)device->info->rssi;
+
+	return BT_ERROR_NONE;
+}
+
+int bt_device_view_is_bonded(bt_device_view_h device, bool *is_bonded)
+{
+	BT_CHECK_INPUT_PARAMETER(device);
+	BT_CHECK_INPUT_PARAMETER(is_bonded);
+
+	*is_bonded = (bool)device->info->paired;
+
+	return BT_ERROR_NONE;
+}
+
+int bt_device_view_get_service_count(bt_device_view_h device, int *count)
+{
+	BT_CHECK_INPUT_PARAMETER(device);
+	BT_CHECK_INPUT_PARAMETER(count);
+
+	*count = device->info->service_index;
+
+	return BT_ERROR_NONE;
+}
+
+int bt_device_view_get_service_uuid(bt_device_view_h device, int index, const char **uuid)
+{
+	const char *source = NULL;
+	guint64 service_mask = 0;
+	int i;
+
+	BT_CHECK_INPUT_PARAMETER(device);
+	BT_CHECK_INPUT_PARAMETER(uuid);
+
+	if (index < 0 || index >= device->info->service_index) {
+		LOGE("[%s] INVALID_PARAMETER(0x%08x)", __FUNCTION__, BT_ERROR_INVALID_PARAMETER);
+		return BT_ERROR_INVALID_PARAMETER;
+	}
+
+	source = device->info->uuids[index];
+	*uuid = _bt_convert_uuid(source, &service_mask);
+	if (*uuid != NULL)
+		return BT_ERROR_NONE;
+
+	/* A malformed UUID is copied as it is, in uppercase */
+	for (i = 0; i < BLUETOOTH_UUID_STRING_MAX - 1 && source[i] != '\0'; i++)
+		device->uuid[i] = g_ascii_toupper(source[i]);
+	device->uuid[i] = '\0';
+
+	*uuid = device->uuid;
+
+	return BT_ERROR_NONE;
+}
+
+int bt_device_view_has_service_uuid(bt_device_view_h device, const char *uuid, bool *has_uuid)
+{
+	int i;
+
+	BT_CHECK_INPUT_PARAMETER(device);
+	BT_CHECK_INPUT_PARAMETER(uuid);
+	BT_CHECK_INPUT_PARAMETER(has_uuid);
+
+	*has_uuid = false;
+	for (i = 0; i < device->info->service_index; i++) {
+		if (g_ascii_strcasecmp(device->info->uuids[i], uuid) == 0) {
+			*has_uuid = true;
+			break;
+		}
+	}
+
+	return BT_ERROR_NONE;
+}
+
+int bt_device_view_has_service(bt_device_view_h device, bt_service_e service, bool *has_service)
+{
+	BT_CHECK_INPUT_PARAMETER(device);
+	BT_CHECK_INPUT_PARAMETER(has_service);
+	if (service < 0 || service >= BT_SERVICE_MAX) {
+		LOGE("[%s] INVALID_PARAMETER(0x%08x)", __FUNCTION__, BT_ERROR_INVALID_PARAMETER);
+		return BT_ERROR_INVALID_PARAMETER;
+	}
+
+	/* Parsed once, on the first request */
+	if (device->has_service_mask == false) {
+		device->service_mask = _bt_get_service_mask((const char (*)[BLUETOOTH_UUID_STRING_MAX])device->info->uuids,
+				device->info->service_index);
+		device->has_service_mask = true;
+	}
+
+	*has_service = (device->service_mask & BT_SERVICE_BIT(service)) ? true : false;
+
+	return BT_ERROR_NONE;
+}
+
+int bt_device_info_has_service(const bt_device_info_s *device_info, bt_service_e service, bool *has_service)
+{
+	BT_CHECK_INPUT_PARAMETER(device_info);
+	BT_CHECK_INPUT_PARAMETER(has_service);
+	if (service < 0 || service >= BT_SERVICE_MAX) {
+		LOGE("[%s] INVALID_PARAMETER(0x%08x)", __FUNCTION__, BT_ERROR_INVALID_PARAMETER);
+		return BT_ERROR_INVALID_PARAMETER;
+	}
+
+	*has_service = (BT_INFO_EXT(device_info, bt_device_info_ext_s)->service_mask &
+			BT_SERVICE_BIT(service)) ? true : false;
+
+	return BT_ERROR_NONE;
+}
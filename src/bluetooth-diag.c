@@ -0,0 +1,353 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <glib.h>
+#include <dlog.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include <bluetooth-api.h>
+
+#include "bluetooth.h"
+#include "bluetooth_private.h"
+
+#ifdef LOG_TAG
+#undef LOG_TAG
+#endif
+#define LOG_TAG "TIZEN_N_BLUETOOTH"
+
+/* Trace ring, must be a power of two */
+#define BT_DIAG_TRACE_SIZE 1024
+#define BT_DIAG_TRACE_MASK (BT_DIAG_TRACE_SIZE - 1)
+
+/*
+ *  Log-linear histogram: values below 16ns have their own bucket, larger values are split
+ *  into 16 buckets per power of two (about 6% resolution) up to 2^32ns.
+ */
+#define BT_DIAG_SUB_BUCKETS 16
+#define BT_DIAG_MAX_EXPONENT 32
+#define BT_DIAG_BUCKETS ((BT_DIAG_MAX_EXPONENT - 3) * BT_DIAG_SUB_BUCKETS)
+#define BT_DIAG_LATENCY_NUM (BT_DIAG_LATENCY_TOTAL + 1)
+
+/*
+ *  Binary trace record. @a sequence is 0 while the record is written,
+ *  otherwise it is the position of the record in the ring plus 1.
+ */
+typedef struct {
+	volatile gint sequence;
+	gint event;
+	guint64 received;
+	guint32 converted;
+	guint32 callback_started;
+	guint32 callback_ended;
+} bt_diag_record_s;
+
+static bt_diag_record_s bt_diag_trace[BT_DIAG_TRACE_SIZE];
+static volatile gint bt_diag_trace_head = 0;
+static volatile gint bt_diag_trace_start = 0;
+static volatile gint bt_diag_histograms[BT_EVENT_MAX][BT_DIAG_LATENCY_NUM][BT_DIAG_BUCKETS];
+
+static const char *bt_diag_event_names[BT_EVENT_MAX] = {
+	[BT_EVENT_STATE_CHANGED] = "STATE_CHANGED",
+	[BT_EVENT_NAME_CHANGED] = "NAME_CHANGED",
+	[BT_EVENT_VISIBILITY_MODE_CHANGED] = "VISIBILITY_MODE_CHANGED",
+	[BT_EVENT_DEVICE_DISCOVERY_STATE_CHANGED] = "DEVICE_DISCOVERY_STATE_CHANGED",
+	[BT_EVENT_BOND_CREATED] = "BOND_CREATED",
+	[BT_EVENT_BOND_DESTROYED] = "BOND_DESTROYED",
+	[BT_EVENT_AUTHORIZATION_CHANGED] = "AUTHORIZATION_CHANGED",
+	[BT_EVENT_SERVICE_SEARCHED] = "SERVICE_SEARCHED",
+	[BT_EVENT_DATA_RECEIVED] = "DATA_RECEIVED",
+	[BT_EVENT_CONNECTION_STATE_CHANGED] = "CONNECTION_STATE_CHANGED",
+	[BT_EVENT_RFCOMM_CONNECTION_REQUESTED] = "RFCOMM_CONNECTION_REQUESTED",
+	[BT_EVENT_OPP_CONNECTION_REQUESTED] = "OPP_CONNECTION_REQUESTED",
+	[BT_EVENT_OPP_PUSH_REQUESTED] = "OPP_PUSH_REQUESTED",
+	[BT_EVENT_OPP_SERVER_TRANSFER_PROGRESS] = "OPP_SERVER_TRANSFER_PROGRESS",
+	[BT_EVENT_OPP_SERVER_TRANSFER_FINISHED] = "OPP_SERVER_TRANSFER_FINISHED",
+	[BT_EVENT_OPP_CLIENT_PUSH_RESPONSED] = "OPP_CLIENT_PUSH_RESPONSED",
+	[BT_EVENT_OPP_CLIENT_PUSH_PROGRESS] = "OPP_CLIENT_PUSH_PROGRESS",
+	[BT_EVENT_OPP_CLIENT_PUSH_FINISHED] = "OPP_CLIENT_PUSH_FINISHED",
+	[BT_EVENT_PAN_CONNECTION_STATE_CHANGED] = "PAN_CONNECTION_STATE_CHANGED",
+	[BT_EVENT_NAP_CONNECTION_STATE_CHANGED] = "NAP_CONNECTION_STATE_CHANGED",
+	[BT_EVENT_HDP_CONNECTED] = "HDP_CONNECTED",
+	[BT_EVENT_HDP_DISCONNECTED] = "HDP_DISCONNECTED",
+	[BT_EVENT_HDP_DATA_RECIEVED] = "HDP_DATA_RECIEVED",
+	[BT_EVENT_AUDIO_CONNECTION_STATUS] = "AUDIO_CONNECTION_STATUS",
+	[BT_EVENT_AG_MICROPHONE_GAIN_CHANGE] = "AG_MICROPHONE_GAIN_CHANGE",
+	[BT_EVENT_AG_SPEAKER_GAIN_CHANGE] = "AG_SPEAKER_GAIN_CHANGE",
+	[BT_EVENT_AVRCP_CONNECTION_STATUS] = "AVRCP_CONNECTION_STATUS",
+	[BT_EVENT_HID_CONNECTION_STATUS] = "HID_CONNECTION_STATUS",
+};
+
+static const char *bt_diag_latency_names[BT_DIAG_LATENCY_NUM] = {
+	[BT_DIAG_LATENCY_QUEUE] = "queue",
+	[BT_DIAG_LATENCY_CALLBACK] = "callback",
+	[BT_DIAG_LATENCY_TOTAL] = "total",
+};
+
+static int __bt_diag_get_bucket(guint64 value)
+{
+	int exponent;
+
+	if (value < BT_DIAG_SUB_BUCKETS)
+		return (int)value;
+
+	if (value >> BT_DIAG_MAX_EXPONENT)
+		return BT_DIAG_BUCKETS - 1;
+
+	exponent = 63 - __builtin_clzll(value);
+	return (exponent - 3) * BT_DIAG_SUB_BUCKETS +
+			(int)((value >> (exponent - 4)) & (BT_DIAG_SUB_BUCKETS - 1));
+}
+
+/* Highest value counted in the bucket */
+static guint64 __bt_diag_get_bucket_value(int bucket)
+{
+	int shift;
+	guint64 lowest;
+
+	if (bucket < BT_DIAG_SUB_BUCKETS)
+		return bucket;
+
+	shift = bucket / BT_DIAG_SUB_BUCKETS - 1;
+	lowest = (guint64)(BT_DIAG_SUB_BUCKETS + bucket % BT_DIAG_SUB_BUCKETS) << shift;
+
+	return lowest + (1ULL << shift) - 1;
+}
+
+static void __bt_diag_count(int index, bt_diag_latency_e type, guint64 latency)
+{
+	g_atomic_int_inc(&bt_diag_histograms[index][type][__bt_diag_get_bucket(latency)]);
+}
+
+static void __bt_diag_get_latency_stats(int index, bt_diag_latency_e type, bt_diag_latency_stats_s *stats)
+{
+	guint counts[BT_DIAG_BUCKETS];
+	const double percentiles[] = { 0.5, 0.9, 0.99, 0.999 };
+	unsigned long long *values[] = { &stats->p50, &stats->p90, &stats->p99, &stats->p999 };
+	unsigned long long total = 0;
+	unsigned long long seen = 0;
+	int next = 0;
+	int i;
+
+	memset(stats, 0x00, sizeof(bt_diag_latency_stats_s));
+
+	for (i = 0; i < BT_DIAG_BUCKETS; i++) {
+		counts[i] = (guint)g_atomic_int_get(&bt_diag_histograms[index][type][i]);
+		total += counts[i];
+	}
+
+	stats->count = total;
+	if (total == 0)
+		return;
+
+	for (i = 0; i < BT_DIAG_BUCKETS; i++) {
+		if (counts[i] == 0)
+			continue;
+
+		if (seen == 0)
+			stats->min = __bt_diag_get_bucket_value(i);
+		stats->max = __bt_diag_get_bucket_value(i);
+
+		seen += counts[i];
+		while (next < 4 && seen >= (unsigned long long)(percentiles[next] * total + 0.5)) {
+			*values[next] = __bt_diag_get_bucket_value(i);
+			next++;
+		}
+	}
+
+	while (next < 4)
+		*values[next++] = stats->max;
+}
+
+static bool __bt_diag_read_record(guint position, bt_diag_trace_record_s *record)
+{
+	bt_diag_record_s *slot = &bt_diag_trace[position & BT_DIAG_TRACE_MASK];
+	gint sequence = g_atomic_int_get(&slot->sequence);
+
+	if (sequence != (gint)(position + 1))
+		return false;
+
+	record->event = slot->event;
+	record->received = slot->received;
+	record->converted = slot->converted;
+	record->callback_started = slot->callback_started;
+	record->callback_ended = slot->callback_ended;
+
+	/* Overwritten while it was copied */
+	return g_atomic_int_get(&slot->sequence) == sequence;
+}
+
+unsigned long long _bt_diag_now(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	return (unsigned long long)now.tv_sec * 1000000000ULL + now.tv_nsec;
+}
+
+void _bt_diag_record(bt_event_data_s *data, unsigned long long callback_started,
+		unsigned long long callback_ended)
+{
+	guint position = (guint)g_atomic_int_add(&bt_diag_trace_head, 1);
+	bt_diag_record_s *slot = &bt_diag_trace[position & BT_DIAG_TRACE_MASK];
+
+	g_atomic_int_set(&slot->sequence, 0);
+	slot->event = data->index;
+	slot->received = data->received;
+	slot->converted = (guint32)(data->converted - data->received);
+	slot->callback_started = (guint32)(callback_started - data->received);
+	slot->callback_ended = (guint32)(callback_ended - data->received);
+	g_atomic_int_set(&slot->sequence, (gint)(position + 1));
+
+	__bt_diag_count(data->index, BT_DIAG_LATENCY_QUEUE, callback_started - data->received);
+	__bt_diag_count(data->index, BT_DIAG_LATENCY_CALLBACK, callback_ended - callback_started);
+	__bt_diag_count(data->index, BT_DIAG_LATENCY_TOTAL, callback_ended - data->received);
+}
+
+int bt_diag_get_latency_stats(bt_event_e event, bt_diag_latency_e type, bt_diag_latency_stats_s *stats)
+{
+	BT_CHECK_INIT_STATUS();
+	BT_CHECK_INPUT_PARAMETER(stats);
+
+	if (event < BT_EVENT_STATE_CHANGED || event >= BT_EVENT_MAX ||
+			type < BT_DIAG_LATENCY_QUEUE || type > BT_DIAG_LATENCY_TOTAL) {
+		LOGE("[%s] INVALID_PARAMETER(0x%08x)", __FUNCTION__, BT_ERROR_INVALID_PARAMETER);
+		return BT_ERROR_INVALID_PARAMETER;
+	}
+
+	__bt_diag_get_latency_stats(event, type, stats);
+
+	return BT_ERROR_NONE;
+}
+
+int bt_diag_get_trace(bt_diag_trace_record_s *records, int max_count, int *count)
+{
+	guint head;
+	guint start;
+	guint position;
+	int found = 0;
+
+	BT_CHECK_INIT_STATUS();
+	BT_CHECK_INPUT_PARAMETER(records);
+	BT_CHECK_INPUT_PARAMETER(count);
+
+	if (max_count <= 0) {
+		LOGE("[%s] INVALID_PARAMETER(0x%08x)", __FUNCTION__, BT_ERROR_INVALID_PARAMETER);
+		return BT_ERROR_INVALID_PARAMETER;
+	}
+
+	head = (guint)g_atomic_int_get(&bt_diag_trace_head);
+	start = (guint)g_atomic_int_get(&bt_diag_trace_start);
+	if (head - start > BT_DIAG_TRACE_SIZE)
+		start = head - BT_DIAG_TRACE_SIZE;
+	if (head - start > (guint)max_count)
+		start = head - max_count;
+
+	for (position = start; position != head; position++) {
+		if (__bt_diag_read_record(position, &records[found]) == true)
+			found++;
+	}
+
+	*count = found;
+
+	return BT_ERROR_NONE;
+}
+
+int bt_diag_reset(void)
+{
+	int i;
+	int j;
+	int k;
+
+	BT_CHECK_INIT_STATUS();
+
+	g_atomic_int_set(&bt_diag_trace_start, g_atomic_int_get(&bt_diag_trace_head));
+
+	for (i = 0; i < BT_EVENT_MAX; i++) {
+		for (j = 0; j < BT_DIAG_LATENCY_NUM; j++) {
+			for (k = 0; k < BT_DIAG_BUCKETS; k++)
+				g_atomic_int_set(&bt_diag_histograms[i][j][k], 0);
+		}
+	}
+
+	return BT_ERROR_NONE;
+}
+
+int bt_diag_dump(const char *path)
+{
+	bt_diag_latency_stats_s stats;
+	bt_diag_trace_record_s *records = NULL;
+	FILE *file = NULL;
+	int count = 0;
+	int error_code = BT_ERROR_NONE;
+	int i;
+	int j;
+
+	BT_CHECK_INIT_STATUS();
+	BT_CHECK_INPUT_PARAMETER(path);
+
+	records = malloc(sizeof(bt_diag_trace_record_s) * BT_DIAG_TRACE_SIZE);
+	if (records == NULL) {
+		LOGE("[%s] OUT_OF_MEMORY(0x%08x)", __FUNCTION__, BT_ERROR_OUT_OF_MEMORY);
+		return BT_ERROR_OUT_OF_MEMORY;
+	}
+
+	file = fopen(path, "w");
+	if (file == NULL) {
+		LOGE("[%s] INVALID_PARAMETER(0x%08x) : cannot open %s", __FUNCTION__, BT_ERROR_INVALID_PARAMETER, path);
+		free(records);
+		return BT_ERROR_INVALID_PARAMETER;
+	}
+
+	fprintf(file, "# latency (ns)\n");
+	fprintf(file, "%-32s %-8s %10s %10s %10s %10s %10s %10s %10s\n",
+			"event", "type", "count", "min", "p50", "p90", "p99", "p99.9", "max");
+	for (i = 0; i < BT_EVENT_MAX; i++) {
+		for (j = 0; j < BT_DIAG_LATENCY_NUM; j++) {
+			__bt_diag_get_latency_stats(i, j, &stats);
+			if (stats.count == 0)
+				continue;
+
+			fprintf(file, "%-32s %-8s %10llu %10llu %10llu %10llu %10llu %10llu %10llu\n",
+					bt_diag_event_names[i], bt_diag_latency_names[j], stats.count,
+					stats.min, stats.p50, stats.p90, stats.p99, stats.p999, stats.max);
+		}
+	}
+
+	error_code = bt_diag_get_trace(records, BT_DIAG_TRACE_SIZE, &count);
+	if (error_code == BT_ERROR_NONE) {
+		fprintf(file, "\n# trace (ns)\n");
+		fprintf(file, "%-32s %20s %10s %10s %10s\n",
+				"event", "received", "converted", "started", "ended");
+		for (i = 0; i < count; i++) {
+			fprintf(file, "%-32s %20llu %10u %10u %10u\n",
+					bt_diag_event_names[records[i].event], records[i].received,
+					records[i].converted, records[i].callback_started, records[i].callback_ended);
+		}
+	}
+
+	if (fclose(file) != 0) {
+		LOGE("[%s] OPERATION_FAILED(0x%08x) : cannot write %s", __FUNCTION__, BT_ERROR_OPERATION_FAILED, path);
+		error_code = BT_ERROR_OPERATION_FAILED;
+	}
+
+	free(records);
+
+	return error_code;
+}
@@ -0,0 +1,267 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <glib.h>
+#include <dlog.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <bluetooth-api.h>
+
+#include "bluetooth.h"
+#include "bluetooth_private.h"
+
+#ifdef LOG_TAG
+#undef LOG_TAG
+#endif
+#define LOG_TAG "TIZEN_N_BLUETOOTH"
+
+/*
+ *  Device discovery filter
+ *
+ *  The filter is compiled once when the discovery starts: the well-known services of the UUIDs
+ *  become a #BT_SERVICE_BIT() mask and the other UUIDs are parsed, so a device is checked on the
+ *  raw F/W information, cheapest condition first, without any allocation.
+ */
+
+/* The F/W masks the major device classes from computer to health, with the bit of computer first */
+#define BT_DISCOVERY_FW_MAJOR_FIRST BT_MAJOR_DEVICE_CLASS_COMPUTER
+#define BT_DISCOVERY_FW_MAJOR_LAST BT_MAJOR_DEVICE_CLASS_HEALTH
+
+struct bt_discovery_filter_s {
+	unsigned int major_device_class_mask;
+	unsigned long long minor_device_class_mask;
+	guint64 service_mask; /* #BT_SERVICE_BIT() flags of the well-known services */
+	int uuid_count; /* The other services */
+	bt_uuid_s *uuids;
+	int min_rssi;
+	size_t name_prefix_length;
+	char *name_prefix;
+};
+
+static GMutex bt_discovery_filter_lock;
+static GMutex bt_discovery_filter_start_lock; /* Serializes the starts, which restore the filter on failure */
+static bt_discovery_filter_s *bt_discovery_filter = NULL;
+
+static bt_discovery_filter_s *__bt_discovery_filter_swap(bt_discovery_filter_s *filter)
+{
+	bt_discovery_filter_s *previous = NULL;
+
+	g_mutex_lock(&bt_discovery_filter_lock);
+	previous = bt_discovery_filter;
+	g_atomic_pointer_set(&bt_discovery_filter, filter);
+	g_mutex_unlock(&bt_discovery_filter_lock);
+
+	return previous;
+}
+
+static void __bt_discovery_filter_set(bt_discovery_filter_s *filter)
+{
+	free(__bt_discovery_filter_swap(filter));
+}
+
+int _bt_discovery_filter_compile(const bt_adapter_device_discovery_filter_s *source, bt_discovery_filter_s **filter)
+{
+	bt_uuid_s uuids[BLUETOOTH_MAX_SERVICES_FOR_DEVICE];
+	bt_discovery_filter_s *compiled = NULL;
+	guint64 service_mask = 0;
+	size_t name_prefix_length = 0;
+	int uuid_count = 0;
+	int service;
+	int i;
+
+	if (source->service_count < 0 || source->service_count > BLUETOOTH_MAX_SERVICES_FOR_DEVICE ||
+			(source->service_count > 0 && source->service_uuids == NULL) || source->min_rssi > 0)
+		return BT_ERROR_INVALID_PARAMETER;
+
+	for (i = 0; i < source->service_count; i++) {
+		if (source->service_uuids[i] == NULL || _bt_parse_uuid(source->service_uuids[i], &uuids[uuid_count]) == false)
+			return BT_ERROR_INVALID_PARAMETER;
+
+		service = _bt_get_uuid_service(&uuids[uuid_count]);
+		if (service >= 0)
+			service_mask |= BT_SERVICE_BIT(service);
+		else
+			uuid_count++;
+	}
+
+	if (source->name_prefix != NULL)
+		name_prefix_length = strlen(source->name_prefix);
+
+	/* The UUIDs and the name prefix are stored in the same memory block */
+	compiled = malloc(sizeof(bt_discovery_filter_s) + sizeof(bt_uuid_s) * uuid_count + name_prefix_length + 1);
+	if (compiled == NULL)
+		return BT_ERROR_OUT_OF_MEMORY;
+
+	compiled->major_device_class_mask = source->major_device_class_mask;
+	compiled->minor_device_class_mask = source->minor_device_class_mask;
+	compiled->service_mask = service_mask;
+	compiled->uuid_count = uuid_count;
+	compiled->uuids = (bt_uuid_s *)(compiled + 1);
+	memcpy(compiled->uuids, uuids, sizeof(bt_uuid_s) * uuid_count);
+	compiled->min_rssi = source->min_rssi;
+	compiled->name_prefix_length = name_prefix_length;
+	compiled->name_prefix = (char *)(compiled->uuids + uuid_count);
+	if (name_prefix_length > 0)
+		memcpy(compiled->name_prefix, source->name_prefix, name_prefix_length);
+	compiled->name_prefix[name_prefix_length] = '\0';
+
+	*filter = compiled;
+
+	return BT_ERROR_NONE;
+}
+
+unsigned int _bt_discovery_filter_get_fw_mask(const bt_discovery_filter_s *filter)
+{
+	unsigned int fw_classes = 0;
+	int major;
+
+	for (major = BT_DISCOVERY_FW_MAJOR_FIRST; major <= BT_DISCOVERY_FW_MAJOR_LAST; major++)
+		fw_classes |= 1U << major;
+
+	if (filter->major_device_class_mask == 0 || (filter->major_device_class_mask & ~fw_classes) != 0)
+		return BLUETOOTH_DEVICE_MAJOR_MASK_MISC;
+
+	return filter->major_device_class_mask >> BT_DISCOVERY_FW_MAJOR_FIRST;
+}
+
+static bool __bt_discovery_filter_match_services(const bt_discovery_filter_s *filter,
+		const bluetooth_device_info_t *source_info)
+{
+	guint64 service_mask = 0;
+	guint64 found_uuids = 0;
+	guint64 all_uuids = (filter->uuid_count > 0) ? (~0ULL >> (64 - filter->uuid_count)) : 0;
+	bt_uuid_s uuid;
+	int count = MIN(source_info->service_index, BLUETOOTH_MAX_SERVICES_FOR_DEVICE);
+	int service;
+	int i;
+	int j;
+
+	for (i = 0; i < count; i++) {
+		if (_bt_parse_uuid(source_info->uuids[i], &uuid) == false)
+			continue;
+
+		service = _bt_get_uuid_service(&uuid);
+		if (service >= 0) {
+			service_mask |= BT_SERVICE_BIT(service);
+		} else {
+			for (j = 0; j < filter->uuid_count; j++) {
+				if (memcmp(&uuid, &filter->uuids[j], sizeof(bt_uuid_s)) == 0)
+					found_uuids |= 1ULL << j;
+			}
+		}
+
+		if ((service_mask & filter->service_mask) == filter->service_mask && found_uuids == all_uuids)
+			return true;
+	}
+
+	return false;
+}
+
+bool _bt_discovery_filter_match_device(const bt_discovery_filter_s *filter, const bluetooth_device_info_t *source_info)
+{
+	unsigned int major = source_info->device_class.major_class;
+	unsigned int minor = source_info->device_class.minor_class >> 2;
+
+	if (filter->min_rssi < 0 && source_info->rssi < filter->min_rssi)
+		return false;
+
+	if (filter->major_device_class_mask != 0 &&
+			(major >= 32 || (filter->major_device_class_mask & (1U << major)) == 0))
+		return false;
+
+	if (filter->minor_device_class_mask != 0 &&
+			(minor >= 64 || (filter->minor_device_class_mask & (1ULL << minor)) == 0))
+		return false;
+
+	if (filter->name_prefix_length > 0 &&
+			strncmp(source_info->device_name.name, filter->name_prefix, filter->name_prefix_length) != 0)
+		return false;
+
+	if (filter->service_mask != 0 || filter->uuid_count > 0)
+		return __bt_discovery_filter_match_services(filter, source_info);
+
+	return true;
+}
+
+bool _bt_discovery_filter_match(const bluetooth_device_info_t *source_info)
+{
+	bool match = true;
+
+	if (g_atomic_pointer_get(&bt_discovery_filter) == NULL)
+		return true;
+
+	g_mutex_lock(&bt_discovery_filter_lock);
+	if (bt_discovery_filter != NULL)
+		match = _bt_discovery_filter_match_device(bt_discovery_filter, source_info);
+	g_mutex_unlock(&bt_discovery_filter_lock);
+
+	return match;
+}
+
+void _bt_discovery_filter_clear(void)
+{
+	__bt_discovery_filter_set(NULL);
+}
+
+int _bt_discovery_filter_start(bt_discovery_filter_s *filter)
+{
+	bt_discovery_filter_s *previous = NULL;
+	unsigned int fw_mask = BLUETOOTH_DEVICE_MAJOR_MASK_MISC;
+	int error_code = BT_ERROR_NONE;
+
+	if (filter != NULL)
+		fw_mask = _bt_discovery_filter_get_fw_mask(filter);
+
+	/* In effect before the discovery starts, so no device is reported unfiltered */
+	g_mutex_lock(&bt_discovery_filter_start_lock);
+	previous = __bt_discovery_filter_swap(filter);
+
+	error_code = _bt_get_error_code(bluetooth_start_discovery(0, 0, fw_mask));
+
+	/* A discovery already in progress keeps its filter */
+	if (error_code != BT_ERROR_NONE) {
+		__bt_discovery_filter_swap(previous);
+		previous = filter;
+	}
+	g_mutex_unlock(&bt_discovery_filter_start_lock);
+
+	free(previous);
+
+	return error_code;
+}
+
+int bt_adapter_start_device_discovery_with_filter(const bt_adapter_device_discovery_filter_s *filter)
+{
+	bt_discovery_filter_s *compiled = NULL;
+	int error_code = BT_ERROR_NONE;
+
+	BT_CHECK_INIT_STATUS();
+	BT_CHECK_INPUT_PARAMETER(filter);
+
+	error_code = _bt_discovery_filter_compile(filter, &compiled);
+	if (error_code != BT_ERROR_NONE) {
+		LOGE("[%s] %s(0x%08x)", __FUNCTION__, _bt_convert_error_to_string(error_code), error_code);
+		return error_code;
+	}
+
+	error_code = _bt_discovery_filter_start(compiled);
+	if (error_code != BT_ERROR_NONE) {
+		LOGE("[%s] %s(0x%08x)", __FUNCTION__, _bt_convert_error_to_string(error_code), error_code);
+	}
+	return error_code;
+}
@@ -0,0 +1,464 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <glib.h>
+#include <dlog.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <bluetooth-api.h>
+
+#include "bluetooth.h"
+#include "bluetooth_private.h"
+
+#ifdef LOG_TAG
+#undef LOG_TAG
+#endif
+#define LOG_TAG "TIZEN_N_BLUETOOTH"
+
+/*
+ *  Periodic device discovery
+ *
+ *  Each cycle starts a discovery from a timer, and ends when the window passes, the F/W finishes
+ *  the discovery, or a device connects. The timers carry the generation of the schedule, so a
+ *  timer of a stopped schedule does nothing. The F/W is called and the callback invoked without
+ *  the lock, since the F/W may deliver events from the calling thread.
+ */
+
+#define BT_DISCOVERY_SCHEDULE_LOST_SCANS 2
+
+typedef struct {
+	int last_scan; /* Complete discoveries before the one in which the device was last found, plus 1 */
+	int last_cycle;
+} bt_discovery_device_s;
+
+typedef struct {
+	bool running;
+	bool scanning;
+	bool started; /* The F/W reported the start of the discovery of this cycle */
+	int generation;
+	bt_adapter_discovery_schedule_s schedule;
+	int interval;
+	GSource *timer; /* Referenced, NULL when no timer is armed */
+	gint64 cycle_started;
+	int cycle;
+	int completed_scans;
+	int found;
+	int new_devices;
+	GHashTable *inventory; /* bt_discovery_device_s by interned address */
+	GHashTable *connected; /* Interned addresses of the connected devices */
+	bt_adapter_discovery_cycle_cb callback;
+	void *user_data;
+} bt_discovery_schedule_state_s;
+
+static GMutex bt_discovery_schedule_lock;
+static bt_discovery_schedule_state_s bt_discovery_schedule;
+
+static gboolean __bt_discovery_schedule_scan(gpointer user_data);
+
+/*
+ *  Must be called with bt_discovery_schedule_lock held.
+ */
+static void __bt_discovery_schedule_arm(guint delay, GSourceFunc function)
+{
+	bt_discovery_schedule.timer = g_timeout_source_new(delay);
+	g_source_set_callback(bt_discovery_schedule.timer, function, GINT_TO_POINTER(bt_discovery_schedule.generation), NULL);
+	g_source_attach(bt_discovery_schedule.timer, NULL);
+}
+
+/*
+ *  Must be called with bt_discovery_schedule_lock held.
+ *  As for the operations, the timer is kept referenced, since it may fire on the main loop while
+ *  another thread disarms it: destroying it again is harmless, unlike removing it by id.
+ */
+static void __bt_discovery_schedule_disarm(void)
+{
+	if (bt_discovery_schedule.timer != NULL) {
+		g_source_destroy(bt_discovery_schedule.timer);
+		g_source_unref(bt_discovery_schedule.timer);
+	}
+	bt_discovery_schedule.timer = NULL;
+}
+
+/*
+ *  Must be called with bt_discovery_schedule_lock held.
+ *  A complete discovery ages the inventory and adapts the interval, then the next cycle is armed.
+ */
+static void __bt_discovery_schedule_end_cycle(bool complete, int result, bool yielded, bt_adapter_discovery_cycle_s *cycle)
+{
+	bt_discovery_device_s *device = NULL;
+	GHashTableIter iter;
+	gpointer value = NULL;
+	gint64 elapsed = 0;
+	gint64 interval = bt_discovery_schedule.interval;
+	int known_before = 0;
+	int churn = 0;
+
+	bt_discovery_schedule.scanning = false;
+	bt_discovery_schedule.started = false;
+
+	memset(cycle, 0x00, sizeof(bt_adapter_discovery_cycle_s));
+	cycle->cycle = bt_discovery_schedule.cycle;
+	cycle->result = result;
+	cycle->yielded = yielded;
+	cycle->found = bt_discovery_schedule.found;
+	cycle->new_devices = bt_discovery_schedule.new_devices;
+
+	if (complete == true) {
+		bt_discovery_schedule.completed_scans++;
+		g_hash_table_iter_init(&iter, bt_discovery_schedule.inventory);
+		while (g_hash_table_iter_next(&iter, NULL, &value) == TRUE) {
+			device = value;
+			if (device->last_scan <= bt_discovery_schedule.completed_scans - BT_DISCOVERY_SCHEDULE_LOST_SCANS) {
+				g_hash_table_iter_remove(&iter);
+				cycle->lost++;
+			}
+		}
+	}
+	cycle->known = g_hash_table_size(bt_discovery_schedule.inventory);
+
+	/* Slower while nothing changes, back to the shortest interval when a quarter of the devices change */
+	if (complete == true) {
+		known_before = cycle->known - cycle->new_devices + cycle->lost;
+		churn = cycle->new_devices + cycle->lost;
+		if (churn == 0)
+			interval = MIN(interval * 2, bt_discovery_schedule.schedule.max_interval);
+		else if (churn * 4 >= known_before)
+			interval = bt_discovery_schedule.schedule.interval;
+		else
+			interval = MAX(interval / 2, bt_discovery_schedule.schedule.interval);
+		bt_discovery_schedule.interval = (int)interval;
+	}
+	cycle->interval = bt_discovery_schedule.interval;
+
+	elapsed = (g_get_monotonic_time() - bt_discovery_schedule.cycle_started) / 1000;
+	__bt_discovery_schedule_disarm();
+	__bt_discovery_schedule_arm((elapsed < interval) ? (guint)(interval - elapsed) : 0, __bt_discovery_schedule_scan);
+}
+
+static void __bt_discovery_schedule_report(bt_adapter_discovery_cycle_cb callback, bt_adapter_discovery_cycle_s *cycle,
+		void *user_data)
+{
+	if (cycle->result != BT_ERROR_NONE)
+		LOGI("[%s] cycle %d: %s(0x%08x)", __FUNCTION__, cycle->cycle, _bt_convert_error_to_string(cycle->result), cycle->result);
+
+	callback(cycle, user_data);
+}
+
+static gboolean __bt_discovery_schedule_window_end(gpointer user_data)
+{
+	bt_adapter_discovery_cycle_cb callback = NULL;
+	bt_adapter_discovery_cycle_s cycle;
+	void *callback_data = NULL;
+
+	g_mutex_lock(&bt_discovery_schedule_lock);
+	if (bt_discovery_schedule.running == false || bt_discovery_schedule.scanning == false ||
+			bt_discovery_schedule.generation != GPOINTER_TO_INT(user_data)) {
+		g_mutex_unlock(&bt_discovery_schedule_lock);
+		return FALSE;
+	}
+
+	__bt_discovery_schedule_disarm();
+	__bt_discovery_schedule_end_cycle(true, BT_ERROR_NONE, false, &cycle);
+	callback = bt_discovery_schedule.callback;
+	callback_data = bt_discovery_schedule.user_data;
+	g_mutex_unlock(&bt_discovery_schedule_lock);
+
+	bluetooth_cancel_discovery();
+	__bt_discovery_schedule_report(callback, &cycle, callback_data);
+
+	return FALSE;
+}
+
+static gboolean __bt_discovery_schedule_scan(gpointer user_data)
+{
+	bt_adapter_discovery_cycle_cb callback = NULL;
+	bt_adapter_discovery_cycle_s cycle;
+	void *callback_data = NULL;
+	int generation = GPOINTER_TO_INT(user_data);
+	int error_code = BT_ERROR_NONE;
+
+	g_mutex_lock(&bt_discovery_schedule_lock);
+	if (bt_discovery_schedule.running == false || bt_discovery_schedule.generation != generation) {
+		g_mutex_unlock(&bt_discovery_schedule_lock);
+		return FALSE;
+	}
+
+	__bt_discovery_schedule_disarm();
+	bt_discovery_schedule.cycle++;
+	bt_discovery_schedule.cycle_started = g_get_monotonic_time();
+	bt_discovery_schedule.found = 0;
+	bt_discovery_schedule.new_devices = 0;
+	callback = bt_discovery_schedule.callback;
+	callback_data = bt_discovery_schedule.user_data;
+
+	/* The connections keep the radio */
+	if (g_hash_table_size(bt_discovery_schedule.connected) > 0) {
+		__bt_discovery_schedule_end_cycle(false, BT_ERROR_NONE, true, &cycle);
+		g_mutex_unlock(&bt_discovery_schedule_lock);
+
+		__bt_discovery_schedule_report(callback, &cycle, callback_data);
+		return FALSE;
+	}
+
+	bt_discovery_schedule.scanning = true;
+	g_mutex_unlock(&bt_discovery_schedule_lock);
+
+	error_code = _bt_get_error_code(bluetooth_start_discovery(0, 0, BLUETOOTH_DEVICE_MAJOR_MASK_MISC));
+
+	g_mutex_lock(&bt_discovery_schedule_lock);
+	if (bt_discovery_schedule.running == false || bt_discovery_schedule.generation != generation ||
+			bt_discovery_schedule.scanning == false) {
+		/* Stopped, or the cycle was ended by an event meanwhile */
+		g_mutex_unlock(&bt_discovery_schedule_lock);
+		if (error_code == BT_ERROR_NONE)
+			bluetooth_cancel_discovery();
+		return FALSE;
+	}
+
+	if (error_code == BT_ERROR_NONE) {
+		__bt_discovery_schedule_arm(bt_discovery_schedule.schedule.window, __bt_discovery_schedule_window_end);
+		g_mutex_unlock(&bt_discovery_schedule_lock);
+		return FALSE;
+	}
+
+	__bt_discovery_schedule_end_cycle(false, error_code, false, &cycle);
+	g_mutex_unlock(&bt_discovery_schedule_lock);
+
+	__bt_discovery_schedule_report(callback, &cycle, callback_data);
+
+	return FALSE;
+}
+
+/*
+ *  Must be called with bt_discovery_schedule_lock held.
+ */
+static void __bt_discovery_schedule_found(const bluetooth_device_address_t *address)
+{
+	bt_discovery_device_s *device = NULL;
+	const char *interned = _bt_intern_address(address);
+
+	if (interned == NULL)
+		return;
+
+	device = g_hash_table_lookup(bt_discovery_schedule.inventory, interned);
+	if (device == NULL) {
+		device = calloc(1, sizeof(bt_discovery_device_s));
+		if (device == NULL)
+			return;
+		g_hash_table_insert(bt_discovery_schedule.inventory, (gpointer)interned, device);
+		bt_discovery_schedule.new_devices++;
+	}
+
+	if (device->last_cycle != bt_discovery_schedule.cycle)
+		bt_discovery_schedule.found++;
+	device->last_cycle = bt_discovery_schedule.cycle;
+	device->last_scan = bt_discovery_schedule.completed_scans + 1;
+}
+
+void _bt_discovery_schedule_update(int event, bluetooth_event_param_t *param)
+{
+	bt_adapter_discovery_cycle_cb callback = NULL;
+	bt_adapter_discovery_cycle_s cycle;
+	bluetooth_device_info_t *device_info = NULL;
+	const char *interned = NULL;
+	void *callback_data = NULL;
+	bool ended = false;
+
+	g_mutex_lock(&bt_discovery_schedule_lock);
+	if (bt_discovery_schedule.running == false) {
+		g_mutex_unlock(&bt_discovery_schedule_lock);
+		return;
+	}
+
+	switch (event) {
+	case BLUETOOTH_EVENT_REMOTE_DEVICE_NAME_UPDATED:
+		device_info = param->param_data;
+		if (bt_discovery_schedule.scanning == true && param->result == BLUETOOTH_ERROR_NONE && device_info != NULL)
+			__bt_discovery_schedule_found(&device_info->device_address);
+		break;
+	case BLUETOOTH_EVENT_DISCOVERY_STARTED:
+		if (bt_discovery_schedule.scanning == true)
+			bt_discovery_schedule.started = true;
+		break;
+	case BLUETOOTH_EVENT_DISCOVERY_FINISHED:
+		/* The end of the discovery of a previous cycle arrives before the start of this one */
+		if (bt_discovery_schedule.scanning == true && bt_discovery_schedule.started == true) {
+			__bt_discovery_schedule_end_cycle(true, BT_ERROR_NONE, false, &cycle);
+			ended = true;
+		}
+		break;
+	case BLUETOOTH_EVENT_DEVICE_CONNECTED:
+		if (param->param_data == NULL)
+			break;
+
+		interned = _bt_intern_address(param->param_data);
+		if (interned != NULL)
+			g_hash_table_add(bt_discovery_schedule.connected, (gpointer)interned);
+		if (bt_discovery_schedule.scanning == true) {
+			__bt_discovery_schedule_end_cycle(false, BT_ERROR_NONE, true, &cycle);
+			ended = true;
+		}
+		break;
+	case BLUETOOTH_EVENT_DEVICE_DISCONNECTED:
+		if (param->param_data == NULL)
+			break;
+
+		interned = _bt_intern_address(param->param_data);
+		if (interned != NULL)
+			g_hash_table_remove(bt_discovery_schedule.connected, interned);
+		break;
+	case BLUETOOTH_EVENT_DISABLED:
+		g_hash_table_remove_all(bt_discovery_schedule.connected);
+		if (bt_discovery_schedule.scanning == true) {
+			__bt_discovery_schedule_end_cycle(false, BT_ERROR_NOT_ENABLED, false, &cycle);
+			ended = true;
+		}
+		break;
+	default:
+		break;
+	}
+
+	callback = bt_discovery_schedule.callback;
+	callback_data = bt_discovery_schedule.user_data;
+	g_mutex_unlock(&bt_discovery_schedule_lock);
+
+	if (ended == false)
+		return;
+
+	if (cycle.yielded == true)
+		bluetooth_cancel_discovery();
+	__bt_discovery_schedule_report(callback, &cycle, callback_data);
+}
+
+static bool __bt_discovery_schedule_add_connected(bt_device_info_s *device_info, void *user_data)
+{
+	bluetooth_device_address_t address = { {0,} };
+	const char *interned = NULL;
+
+	if (device_info->is_connected == false || _bt_parse_address(device_info->remote_address, &address) == false)
+		return true;
+
+	interned = _bt_intern_address(&address);
+	if (interned == NULL)
+		return true;
+
+	g_mutex_lock(&bt_discovery_schedule_lock);
+	if (bt_discovery_schedule.connected != NULL)
+		g_hash_table_add(bt_discovery_schedule.connected, (gpointer)interned);
+	g_mutex_unlock(&bt_discovery_schedule_lock);
+
+	return true;
+}
+
+/*
+ *  Must be called with bt_discovery_schedule_lock held.
+ *  Return whether a discovery was running.
+ */
+static bool __bt_discovery_schedule_reset(void)
+{
+	bool scanning = bt_discovery_schedule.scanning;
+
+	__bt_discovery_schedule_disarm();
+	bt_discovery_schedule.running = false;
+	bt_discovery_schedule.scanning = false;
+	bt_discovery_schedule.started = false;
+	bt_discovery_schedule.generation++;
+	if (bt_discovery_schedule.inventory != NULL)
+		g_hash_table_remove_all(bt_discovery_schedule.inventory);
+	if (bt_discovery_schedule.connected != NULL)
+		g_hash_table_remove_all(bt_discovery_schedule.connected);
+	bt_discovery_schedule.callback = NULL;
+	bt_discovery_schedule.user_data = NULL;
+
+	return scanning;
+}
+
+void _bt_discovery_schedule_stop(void)
+{
+	bool scanning = false;
+
+	g_mutex_lock(&bt_discovery_schedule_lock);
+	if (bt_discovery_schedule.running == true)
+		scanning = __bt_discovery_schedule_reset();
+	g_mutex_unlock(&bt_discovery_schedule_lock);
+
+	if (scanning == true)
+		bluetooth_cancel_discovery();
+}
+
+int bt_adapter_start_discovery_schedule(const bt_adapter_discovery_schedule_s *schedule,
+		bt_adapter_discovery_cycle_cb callback, void *user_data)
+{
+	BT_CHECK_INIT_STATUS();
+	BT_CHECK_INPUT_PARAMETER(schedule);
+	BT_CHECK_INPUT_PARAMETER(callback);
+	if (schedule->window <= 0 || schedule->interval < schedule->window ||
+			schedule->max_interval < schedule->interval) {
+		LOGE("[%s] INVALID_PARAMETER(0x%08x)", __FUNCTION__, BT_ERROR_INVALID_PARAMETER);
+		return BT_ERROR_INVALID_PARAMETER;
+	}
+
+	g_mutex_lock(&bt_discovery_schedule_lock);
+	if (bt_discovery_schedule.running == true) {
+		g_mutex_unlock(&bt_discovery_schedule_lock);
+		LOGE("[%s] NOW_IN_PROGRESS(0x%08x)", __FUNCTION__, BT_ERROR_NOW_IN_PROGRESS);
+		return BT_ERROR_NOW_IN_PROGRESS;
+	}
+
+	if (bt_discovery_schedule.inventory == NULL)
+		bt_discovery_schedule.inventory = g_hash_table_new_full(g_direct_hash, g_direct_equal, NULL, free);
+	if (bt_discovery_schedule.connected == NULL)
+		bt_discovery_schedule.connected = g_hash_table_new(g_direct_hash, g_direct_equal);
+
+	bt_discovery_schedule.running = true;
+	bt_discovery_schedule.generation++;
+	bt_discovery_schedule.schedule = *schedule;
+	bt_discovery_schedule.interval = schedule->interval;
+	bt_discovery_schedule.cycle = 0;
+	bt_discovery_schedule.completed_scans = 0;
+	bt_discovery_schedule.callback = callback;
+	bt_discovery_schedule.user_data = user_data;
+	__bt_discovery_schedule_arm(0, __bt_discovery_schedule_scan);
+	g_mutex_unlock(&bt_discovery_schedule_lock);
+
+	/* The devices connected before the schedule, then the events keep the set current */
+	_bt_bonded_cache_foreach(__bt_discovery_schedule_add_connected, NULL);
+
+	return BT_ERROR_NONE;
+}
+
+int bt_adapter_stop_discovery_schedule(void)
+{
+	bool scanning = false;
+
+	BT_CHECK_INIT_STATUS();
+
+	g_mutex_lock(&bt_discovery_schedule_lock);
+	if (bt_discovery_schedule.running == false) {
+		g_mutex_unlock(&bt_discovery_schedule_lock);
+		LOGE("[%s] NOT_IN_PROGRESS(0x%08x)", __FUNCTION__, BT_ERROR_NOT_IN_PROGRESS);
+		return BT_ERROR_NOT_IN_PROGRESS;
+	}
+	scanning = __bt_discovery_schedule_reset();
+	g_mutex_unlock(&bt_discovery_schedule_lock);
+
+	if (scanning == true)
+		bluetooth_cancel_discovery();
+
+	return BT_ERROR_NONE;
+}
@@ -0,0 +1,360 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <glib.h>
+#include <dlog.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <bluetooth-api.h>
+
+#include "bluetooth.h"
+#include "bluetooth_private.h"
+
+#ifdef LOG_TAG
+#undef LOG_TAG
+#endif
+#define LOG_TAG "TIZEN_N_BLUETOOTH"
+
+/*
+ *  Shared device discovery sessions
+ *
+ *  One discovery of the F/W runs while any session is open, started again each time the F/W
+ *  finishes it, with the union of the major device classes of the sessions. A session opened
+ *  with classes out of the running discovery restarts it. Each device found is converted once
+ *  and delivered to the sessions whose filter it passes. A session is referenced while its
+ *  callback runs, so closing it from another thread, or from the callback, is safe.
+ */
+
+struct bt_adapter_discovery_session_s {
+	volatile gint ref_count;
+	volatile gint closed;
+	bt_discovery_filter_s *filter; /* NULL for every device */
+	unsigned int fw_mask;
+	bt_adapter_device_discovery_state_changed_cb callback;
+	void *user_data;
+};
+
+static GMutex bt_discovery_session_lock;
+static GSList *bt_discovery_sessions = NULL; /* In the order they were opened */
+static bool bt_discovery_session_scanning = false; /* Started for the sessions and not finished yet */
+static bool bt_discovery_session_owned = false; /* The running discovery was started by the sessions, not by another component */
+static unsigned int bt_discovery_session_fw_mask = BLUETOOTH_DEVICE_MAJOR_MASK_MISC; /* Of the running discovery */
+
+static void __bt_discovery_session_unref(struct bt_adapter_discovery_session_s *session)
+{
+	if (g_atomic_int_dec_and_test(&session->ref_count) == FALSE)
+		return;
+
+	free(session->filter);
+	free(session);
+}
+
+/*
+ *  Whether a discovery with @a fw_mask reports the devices of @a wanted.
+ */
+static bool __bt_discovery_session_covers(unsigned int fw_mask, unsigned int wanted)
+{
+	if (fw_mask == BLUETOOTH_DEVICE_MAJOR_MASK_MISC)
+		return true;
+
+	return wanted != BLUETOOTH_DEVICE_MAJOR_MASK_MISC && (wanted & ~fw_mask) == 0;
+}
+
+/*
+ *  Must be called with bt_discovery_session_lock held.
+ */
+static unsigned int __bt_discovery_session_get_fw_mask(void)
+{
+	struct bt_adapter_discovery_session_s *session = NULL;
+	unsigned int fw_mask = 0;
+	GSList *node = NULL;
+
+	for (node = bt_discovery_sessions; node != NULL; node = node->next) {
+		session = node->data;
+		if (session->fw_mask == BLUETOOTH_DEVICE_MAJOR_MASK_MISC)
+			return BLUETOOTH_DEVICE_MAJOR_MASK_MISC;
+		fw_mask |= session->fw_mask;
+	}
+
+	return fw_mask;
+}
+
+/*
+ *  Start the discovery for the open sessions, unless it is already started.
+ */
+static int __bt_discovery_session_scan(void)
+{
+	unsigned int fw_mask = 0;
+	int error_code = BT_ERROR_NONE;
+
+	g_mutex_lock(&bt_discovery_session_lock);
+	if (bt_discovery_sessions == NULL || bt_discovery_session_scanning == true) {
+		g_mutex_unlock(&bt_discovery_session_lock);
+		return BT_ERROR_NONE;
+	}
+	fw_mask = __bt_discovery_session_get_fw_mask();
+	bt_discovery_session_scanning = true;
+	bt_discovery_session_owned = true;
+	bt_discovery_session_fw_mask = fw_mask;
+	g_mutex_unlock(&bt_discovery_session_lock);
+
+	error_code = _bt_get_error_code(bluetooth_start_discovery(0, 0, fw_mask));
+	if (error_code == BT_ERROR_NONE)
+		return BT_ERROR_NONE;
+
+	/* A discovery not started by the sessions is running, they start theirs when it finishes */
+	if (error_code == BT_ERROR_NOW_IN_PROGRESS) {
+		g_mutex_lock(&bt_discovery_session_lock);
+		bt_discovery_session_owned = false;
+		g_mutex_unlock(&bt_discovery_session_lock);
+		return BT_ERROR_NONE;
+	}
+
+	LOGE("[%s] %s(0x%08x)", __FUNCTION__, _bt_convert_error_to_string(error_code), error_code);
+	g_mutex_lock(&bt_discovery_session_lock);
+	bt_discovery_session_scanning = false;
+	bt_discovery_session_owned = false;
+	g_mutex_unlock(&bt_discovery_session_lock);
+
+	return error_code;
+}
+
+/*
+ *  Invoke the callbacks of the open sessions, for the sessions whose filter @a source_info passes
+ *  if it is not NULL.
+ */
+static void __bt_discovery_session_deliver(int result, bt_adapter_device_discovery_state_e state,
+		bluetooth_device_info_t *source_info)
+{
+	struct bt_adapter_discovery_session_s *session = NULL;
+	bt_adapter_device_discovery_info_s *discovery_info = NULL;
+	bt_arena_s *arena = NULL;
+	bt_arena_mark_s mark;
+	GSList *sessions = NULL;
+	GSList *node = NULL;
+
+	g_mutex_lock(&bt_discovery_session_lock);
+	for (node = bt_discovery_sessions; node != NULL; node = node->next) {
+		session = node->data;
+		g_atomic_int_inc(&session->ref_count);
+		sessions = g_slist_prepend(sessions, session);
+	}
+	g_mutex_unlock(&bt_discovery_session_lock);
+
+	if (sessions == NULL)
+		return;
+
+	arena = _bt_arena_get_thread_arena();
+	if (arena != NULL)
+		_bt_arena_get_mark(arena, &mark);
+
+	sessions = g_slist_reverse(sessions);
+	for (node = sessions; node != NULL; node = node->next) {
+		session = node->data;
+		if (g_atomic_int_get(&session->closed) == TRUE)
+			continue;
+
+		if (source_info != NULL) {
+			if (session->filter != NULL && _bt_discovery_filter_match_device(session->filter, source_info) == false)
+				continue;
+
+			/* Converted once, for the first session which wants the device */
+			if (discovery_info == NULL && (arena == NULL ||
+					_bt_get_bt_adapter_device_discovery_info_s(&discovery_info, source_info, arena) != BT_ERROR_NONE)) {
+				LOGE("[%s] OUT_OF_MEMORY(0x%08x)", __FUNCTION__, BT_ERROR_OUT_OF_MEMORY);
+				break;
+			}
+		}
+
+		session->callback(result, state, discovery_info, session->user_data);
+	}
+
+	if (arena != NULL)
+		_bt_arena_rewind(arena, &mark);
+
+	for (node = sessions; node != NULL; node = node->next)
+		__bt_discovery_session_unref(node->data);
+	g_slist_free(sessions);
+}
+
+void _bt_discovery_session_update(int event, bluetooth_event_param_t *param)
+{
+	switch (event) {
+	case BLUETOOTH_EVENT_REMOTE_DEVICE_NAME_UPDATED:
+		if (param->result == BLUETOOTH_ERROR_NONE && param->param_data != NULL)
+			__bt_discovery_session_deliver(BT_ERROR_NONE, BT_ADAPTER_DEVICE_DISCOVERY_FOUND,
+					(bluetooth_device_info_t *)(param->param_data));
+		break;
+	case BLUETOOTH_EVENT_DISCOVERY_FINISHED:
+		/* Whoever stopped the discovery, it runs again while a session is open */
+		g_mutex_lock(&bt_discovery_session_lock);
+		bt_discovery_session_scanning = false;
+		bt_discovery_session_owned = false;
+		g_mutex_unlock(&bt_discovery_session_lock);
+		__bt_discovery_session_scan();
+		break;
+	case BLUETOOTH_EVENT_ENABLED:
+		__bt_discovery_session_scan();
+		break;
+	case BLUETOOTH_EVENT_DISABLED:
+		g_mutex_lock(&bt_discovery_session_lock);
+		bt_discovery_session_scanning = false;
+		bt_discovery_session_owned = false;
+		g_mutex_unlock(&bt_discovery_session_lock);
+		__bt_discovery_session_deliver(BT_ERROR_NOT_ENABLED, BT_ADAPTER_DEVICE_DISCOVERY_FINISHED, NULL);
+		break;
+	default:
+		break;
+	}
+}
+
+void _bt_discovery_session_close_all(void)
+{
+	struct bt_adapter_discovery_session_s *session = NULL;
+	GSList *sessions = NULL;
+	GSList *node = NULL;
+	bool stop = false;
+
+	g_mutex_lock(&bt_discovery_session_lock);
+	sessions = bt_discovery_sessions;
+	bt_discovery_sessions = NULL;
+	stop = bt_discovery_session_scanning == true && bt_discovery_session_owned == true;
+	bt_discovery_session_scanning = false;
+	bt_discovery_session_owned = false;
+	g_mutex_unlock(&bt_discovery_session_lock);
+
+	if (stop == true)
+		bluetooth_cancel_discovery();
+
+	for (node = sessions; node != NULL; node = node->next) {
+		session = node->data;
+		g_atomic_int_set(&session->closed, TRUE);
+		__bt_discovery_session_unref(session);
+	}
+	g_slist_free(sessions);
+}
+
+int bt_adapter_open_discovery_session(const bt_adapter_device_discovery_filter_s *filter,
+		bt_adapter_device_discovery_state_changed_cb callback, void *user_data,
+		bt_adapter_discovery_session_h *session)
+{
+	struct bt_adapter_discovery_session_s *opened = NULL;
+	bt_discovery_filter_s *compiled = NULL;
+	bool restart = false;
+	int error_code = BT_ERROR_NONE;
+
+	BT_CHECK_INIT_STATUS();
+	BT_CHECK_INPUT_PARAMETER(callback);
+	BT_CHECK_INPUT_PARAMETER(session);
+
+	if (filter != NULL) {
+		error_code = _bt_discovery_filter_compile(filter, &compiled);
+		if (error_code != BT_ERROR_NONE) {
+			LOGE("[%s] %s(0x%08x)", __FUNCTION__, _bt_convert_error_to_string(error_code), error_code);
+			return error_code;
+		}
+	}
+
+	opened = malloc(sizeof(struct bt_adapter_discovery_session_s));
+	if (opened == NULL) {
+		free(compiled);
+		LOGE("[%s] OUT_OF_MEMORY(0x%08x)", __FUNCTION__, BT_ERROR_OUT_OF_MEMORY);
+		return BT_ERROR_OUT_OF_MEMORY;
+	}
+	opened->ref_count = 1;
+	opened->closed = FALSE;
+	opened->filter = compiled;
+	opened->fw_mask = (compiled != NULL) ? _bt_discovery_filter_get_fw_mask(compiled) : BLUETOOTH_DEVICE_MAJOR_MASK_MISC;
+	opened->callback = callback;
+	opened->user_data = user_data;
+
+	g_mutex_lock(&bt_discovery_session_lock);
+	bt_discovery_sessions = g_slist_append(bt_discovery_sessions, opened);
+	/* A discovery of another component is left running, the sessions start theirs with all their classes after it */
+	restart = bt_discovery_session_scanning == true && bt_discovery_session_owned == true &&
+			__bt_discovery_session_covers(bt_discovery_session_fw_mask, opened->fw_mask) == false;
+	g_mutex_unlock(&bt_discovery_session_lock);
+
+	/* The discovery is started again with the new classes when the F/W reports its end */
+	if (restart == true) {
+		error_code = _bt_get_error_code(bluetooth_cancel_discovery());
+		if (error_code != BT_ERROR_NONE)
+			LOGE("[%s] %s(0x%08x)", __FUNCTION__, _bt_convert_error_to_string(error_code), error_code);
+		*session = opened;
+		return BT_ERROR_NONE;
+	}
+
+	error_code = __bt_discovery_session_scan();
+	if (error_code != BT_ERROR_NONE) {
+		g_mutex_lock(&bt_discovery_session_lock);
+		bt_discovery_sessions = g_slist_remove(bt_discovery_sessions, opened);
+		g_mutex_unlock(&bt_discovery_session_lock);
+		__bt_discovery_session_unref(opened);
+		return error_code;
+	}
+
+	*session = opened;
+	return BT_ERROR_NONE;
+}
+
+int _bt_discovery_session_close(bt_adapter_discovery_session_h session)
+{
+	GSList *node = NULL;
+	bool stop = false;
+	int error_code = BT_ERROR_NONE;
+
+	g_mutex_lock(&bt_discovery_session_lock);
+	node = g_slist_find(bt_discovery_sessions, session);
+	if (node == NULL) {
+		g_mutex_unlock(&bt_discovery_session_lock);
+		return BT_ERROR_INVALID_PARAMETER;
+	}
+	bt_discovery_sessions = g_slist_delete_link(bt_discovery_sessions, node);
+	g_atomic_int_set(&session->closed, TRUE);
+	/* Only a discovery the sessions started is cancelled */
+	if (bt_discovery_sessions == NULL && bt_discovery_session_scanning == true) {
+		stop = bt_discovery_session_owned;
+		bt_discovery_session_scanning = false;
+		bt_discovery_session_owned = false;
+	}
+	g_mutex_unlock(&bt_discovery_session_lock);
+
+	__bt_discovery_session_unref(session);
+
+	if (stop == true) {
+		error_code = _bt_get_error_code(bluetooth_cancel_discovery());
+		if (error_code != BT_ERROR_NONE)
+			LOGE("[%s] %s(0x%08x)", __FUNCTION__, _bt_convert_error_to_string(error_code), error_code);
+	}
+
+	return BT_ERROR_NONE;
+}
+
+int bt_adapter_close_discovery_session(bt_adapter_discovery_session_h session)
+{
+	int error_code = BT_ERROR_NONE;
+
+	BT_CHECK_INIT_STATUS();
+	BT_CHECK_INPUT_PARAMETER(session);
+
+	error_code = _bt_discovery_session_close(session);
+	if (error_code != BT_ERROR_NONE) {
+		LOGE("[%s] %s(0x%08x)", __FUNCTION__, _bt_convert_error_to_string(error_code), error_code);
+	}
+	return error_code;
+}
@@ -0,0 +1,616 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <glib.h>
+#include <dlog.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <bluetooth-api.h>
+
+#include "bluetooth.h"
+#include "bluetooth_private.h"
+
+#ifdef LOG_TAG
+#undef LOG_TAG
+#endif
+#define LOG_TAG "TIZEN_N_BLUETOOTH"
+
+#define BT_DISPATCH_KEY_LEN 32
+#define BT_DISPATCH_DEFAULT_CAPACITY 256
+
+/*
+ *  Events of one remote device, delivered in order by one worker at a time.
+ *  A queue is in bt_dispatch_queues while it has a worker scheduled or running, or is parked.
+ *
+ *  Events without a device, such as the end of a discovery, are queued per bt_event_e and wait
+ *  until the events of the same bt_event_e queued before them for a device are delivered: their
+ *  queue is parked, and scheduled again by the worker which delivers the last of those. While it
+ *  exists, the events of that bt_event_e for a device are queued behind them.
+ */
+typedef struct {
+	char key[BT_DISPATCH_KEY_LEN];
+	int index; /* bt_event_e of the events without a device, -1 for the events of a device */
+	bool parked; /* Waiting for bt_dispatch_pending[index] to drop to 0 */
+	GQueue events;
+} bt_dispatch_queue_s;
+
+/*
+ *  Slot of the bounded event queue. Slots are allocated once when the thread pool starts
+ *  and linked both into the queue of their device and into the arrival order of all events.
+ */
+typedef struct bt_dispatch_slot_s {
+	bt_event_data_s data;
+	bt_dispatch_queue_s *queue;
+	GList device_link;
+	GList order_link;
+	struct bt_dispatch_slot_s *next_free;
+} bt_dispatch_slot_s;
+
+static volatile gint bt_dispatch_mode = BT_EVENT_DELIVERY_INLINE;
+static GMutex bt_dispatch_lock;
+static GCond bt_dispatch_space;
+static GThreadPool *bt_dispatch_pool = NULL;
+static GHashTable *bt_dispatch_queues = NULL;
+
+static bt_dispatch_slot_s *bt_dispatch_slots = NULL;
+static bt_dispatch_slot_s *bt_dispatch_free_slots = NULL;
+static GQueue bt_dispatch_order = G_QUEUE_INIT;
+static int bt_dispatch_capacity = BT_DISPATCH_DEFAULT_CAPACITY;
+static bt_event_queue_stats_s bt_dispatch_stats;
+static int bt_dispatch_pending[BT_EVENT_MAX]; /* Events of a device queued or being delivered */
+
+/* Remote device of the connected RFCOMM sockets and HDP channels, whose data events have no address */
+static GHashTable *bt_dispatch_sockets = NULL; /* Socket fd -> interned address */
+static GHashTable *bt_dispatch_channels = NULL; /* HDP channel id -> interned address */
+
+static volatile gint bt_dispatch_policy[BT_EVENT_MAX] = {
+	[BT_EVENT_DEVICE_DISCOVERY_STATE_CHANGED] = BT_EVENT_QUEUE_POLICY_COALESCE_BY_DEVICE,
+	[BT_EVENT_OPP_SERVER_TRANSFER_PROGRESS] = BT_EVENT_QUEUE_POLICY_DROP_OLDEST,
+	[BT_EVENT_OPP_CLIENT_PUSH_PROGRESS] = BT_EVENT_QUEUE_POLICY_DROP_OLDEST,
+};
+
+/*
+ *  Key of the queue of the event, the remote device if it has one.
+ *  Must be called with bt_dispatch_lock held.
+ */
+static bool __bt_dispatch_get_key(bt_event_data_s *data, char *key, int size)
+{
+	const char *address = data->remote_address;
+
+	if (address == NULL)
+		address = data->connection.remote_address;
+
+	/* Data events are queued with the connection events of their device */
+	if (address == NULL && data->event == BLUETOOTH_EVENT_RFCOMM_DATA_RECEIVED) {
+		address = (bt_dispatch_sockets != NULL) ?
+				g_hash_table_lookup(bt_dispatch_sockets, GINT_TO_POINTER(data->value)) : NULL;
+		if (address == NULL) {
+			/* Connected before bt_initialize(), still in order for the socket */
+			snprintf(key, size, "fd:%d", data->value);
+			return true;
+		}
+	} else if (address == NULL && data->event == BLUETOOTH_EVENT_HDP_DATA_RECEIVED) {
+		address = (bt_dispatch_channels != NULL) ?
+				g_hash_table_lookup(bt_dispatch_channels, GINT_TO_POINTER(data->value)) : NULL;
+		if (address == NULL) {
+			snprintf(key, size, "hdp:%d", data->value);
+			return true;
+		}
+	}
+
+	if (address != NULL) {
+		snprintf(key, size, "%s", address);
+	} else if (data->device != NULL) {
+		_bt_format_address(key, &data->device->device_address);
+	} else {
+		snprintf(key, size, "#%d", data->index);
+		return false;
+	}
+
+	return true;
+}
+
+/*
+ *  Address of the remote device reported by the event, other than the device information
+ */
+static const char *__bt_dispatch_get_address(bt_event_data_s *data)
+{
+	if (data->remote_address != NULL)
+		return data->remote_address;
+
+	return data->connection.remote_address;
+}
+
+static bool __bt_dispatch_is_same_device(bt_event_data_s *a, bt_event_data_s *b)
+{
+	const char *address_a = __bt_dispatch_get_address(a);
+	const char *address_b = __bt_dispatch_get_address(b);
+
+	if (a->device != NULL && b->device != NULL)
+		return (memcmp(&a->device->device_address, &b->device->device_address,
+				sizeof(bluetooth_device_address_t)) == 0) ? true : false;
+
+	/* Events without a device, like the discovery STARTED and FINISHED, are state transitions never merged */
+	if (address_a == NULL || address_b == NULL)
+		return false;
+
+	/* Interned addresses of the same device are the same pointer */
+	if (address_a == address_b)
+		return true;
+
+	return (strcmp(address_a, address_b) == 0) ? true : false;
+}
+
+/*
+ *  Must be called with bt_dispatch_lock held.
+ */
+static void __bt_dispatch_free_slot(bt_dispatch_slot_s *slot)
+{
+	slot->queue = NULL;
+	slot->next_free = bt_dispatch_free_slots;
+	bt_dispatch_free_slots = slot;
+	bt_dispatch_stats.queued--;
+	g_cond_signal(&bt_dispatch_space);
+}
+
+/*
+ *  An event of a device was delivered or dropped, schedule the events without a device waiting for it.
+ *  Must be called with bt_dispatch_lock held.
+ */
+static void __bt_dispatch_release_pending(int index)
+{
+	bt_dispatch_queue_s *queue = NULL;
+	char key[BT_DISPATCH_KEY_LEN];
+
+	if (--bt_dispatch_pending[index] > 0)
+		return;
+
+	snprintf(key, sizeof(key), "#%d", index);
+	queue = g_hash_table_lookup(bt_dispatch_queues, key);
+
+	/* While stopping, _bt_dispatch_stop() delivers the parked queues */
+	if (queue != NULL && queue->parked == true && bt_dispatch_pool != NULL) {
+		queue->parked = false;
+		g_thread_pool_push(bt_dispatch_pool, queue, NULL);
+	}
+}
+
+/*
+ *  Drop the oldest queued event delivered to the same bt_event_e.
+ *  Must be called with bt_dispatch_lock held.
+ */
+static bool __bt_dispatch_drop_oldest(int index)
+{
+	bt_dispatch_slot_s *slot = NULL;
+	GList *link = NULL;
+
+	for (link = bt_dispatch_order.head; link != NULL; link = link->next) {
+		slot = link->data;
+		if (slot->data.index != index)
+			continue;
+
+		g_queue_unlink(&bt_dispatch_order, &slot->order_link);
+		g_queue_unlink(&slot->queue->events, &slot->device_link);
+		if (slot->queue->index < 0)
+			__bt_dispatch_release_pending(index);
+		_bt_release_event_data(&slot->data);
+		__bt_dispatch_free_slot(slot);
+		bt_dispatch_stats.dropped++;
+		return true;
+	}
+
+	return false;
+}
+
+/*
+ *  Replace the queued event of the same device and F/W event, keeping its position.
+ *  Must be called with bt_dispatch_lock held.
+ */
+static bool __bt_dispatch_coalesce(bt_dispatch_queue_s *queue, bt_event_data_s *data)
+{
+	bt_dispatch_slot_s *slot = NULL;
+	GList *link = NULL;
+
+	for (link = queue->events.head; link != NULL; link = link->next) {
+		slot = link->data;
+		if (slot->data.event != data->event || __bt_dispatch_is_same_device(&slot->data, data) == false)
+			continue;
+
+		_bt_release_event_data(&slot->data);
+		memcpy(&slot->data, data, sizeof(bt_event_data_s));
+		bt_dispatch_stats.coalesced++;
+		return true;
+	}
+
+	return false;
+}
+
+/*
+ *  Queue of the event, NULL if it has to be created.
+ *  Must be called with bt_dispatch_lock held.
+ */
+static bt_dispatch_queue_s *__bt_dispatch_lookup_queue(const char *key, bool has_device, int index)
+{
+	bt_dispatch_queue_s *queue = NULL;
+	char class_key[BT_DISPATCH_KEY_LEN];
+
+	if (bt_dispatch_queues == NULL)
+		return NULL;
+
+	/* Behind the queued events without a device of the same bt_event_e */
+	if (has_device == true) {
+		snprintf(class_key, sizeof(class_key), "#%d", index);
+		queue = g_hash_table_lookup(bt_dispatch_queues, class_key);
+		if (queue != NULL)
+			return queue;
+	}
+
+	return g_hash_table_lookup(bt_dispatch_queues, key);
+}
+
+static void __bt_dispatch_worker(gpointer data, gpointer user_data)
+{
+	bt_dispatch_queue_s *queue = data;
+	bt_dispatch_slot_s *slot = NULL;
+	bt_event_data_s event;
+
+	while (1) {
+		g_mutex_lock(&bt_dispatch_lock);
+		if (g_queue_is_empty(&queue->events)) {
+			g_hash_table_remove(bt_dispatch_queues, queue->key);
+			g_mutex_unlock(&bt_dispatch_lock);
+			free(queue);
+			return;
+		}
+
+		/* Scheduled again by __bt_dispatch_release_pending() */
+		if (queue->index >= 0 && bt_dispatch_pending[queue->index] > 0) {
+			queue->parked = true;
+			g_mutex_unlock(&bt_dispatch_lock);
+			return;
+		}
+
+		/* Release the slot before the callbacks run */
+		slot = queue->events.head->data;
+		g_queue_unlink(&queue->events, &slot->device_link);
+		g_queue_unlink(&bt_dispatch_order, &slot->order_link);
+		memcpy(&event, &slot->data, sizeof(bt_event_data_s));
+		__bt_dispatch_free_slot(slot);
+		g_mutex_unlock(&bt_dispatch_lock);
+
+		_bt_deliver_event(&event);
+
+		if (queue->index < 0) {
+			g_mutex_lock(&bt_dispatch_lock);
+			__bt_dispatch_release_pending(event.index);
+			g_mutex_unlock(&bt_dispatch_lock);
+		}
+	}
+}
+
+bool _bt_dispatch_is_active(void)
+{
+	return (g_atomic_int_get(&bt_dispatch_mode) == BT_EVENT_DELIVERY_THREAD_POOL) ? true : false;
+}
+
+bool _bt_dispatch_event(bt_event_data_s *data)
+{
+	bt_dispatch_queue_s *queue = NULL;
+	bt_dispatch_slot_s *slot = NULL;
+	char key[BT_DISPATCH_KEY_LEN];
+	bool has_device = false;
+	int policy;
+
+	if (g_atomic_int_get(&bt_dispatch_mode) != BT_EVENT_DELIVERY_THREAD_POOL)
+		return false;
+
+	/* The arena of the calling thread is rewound after the inline delivery */
+	if (_bt_arena_is_thread_arena(data->arena) == true)
+		return false;
+
+	if (_bt_detach_event_data(data) != BT_ERROR_NONE)
+		return false;
+
+	policy = g_atomic_int_get(&bt_dispatch_policy[data->index]);
+
+	g_mutex_lock(&bt_dispatch_lock);
+	has_device = __bt_dispatch_get_key(data, key, sizeof(key));
+	queue = __bt_dispatch_lookup_queue(key, has_device, data->index);
+
+	/* A queue still being drained is used even while stopping, to keep the order */
+	if (queue == NULL && bt_dispatch_pool == NULL) {
+		g_mutex_unlock(&bt_dispatch_lock);
+		return false;
+	}
+
+	if (queue != NULL && policy == BT_EVENT_QUEUE_POLICY_COALESCE_BY_DEVICE &&
+			__bt_dispatch_coalesce(queue, data) == true) {
+		bt_dispatch_stats.enqueued++;
+		g_mutex_unlock(&bt_dispatch_lock);
+		return true;
+	}
+
+	while (bt_dispatch_free_slots == NULL) {
+		if (bt_dispatch_slots == NULL) {
+			/* Stopped while waiting */
+			g_mutex_unlock(&bt_dispatch_lock);
+			return false;
+		}
+
+		if (policy == BT_EVENT_QUEUE_POLICY_BLOCK) {
+			g_cond_wait(&bt_dispatch_space, &bt_dispatch_lock);
+		} else if (__bt_dispatch_drop_oldest(data->index) == false) {
+			/* Nothing of this event to drop, so the new one is dropped */
+			bt_dispatch_stats.dropped++;
+			g_mutex_unlock(&bt_dispatch_lock);
+			_bt_release_event_data(data);
+			return true;
+		}
+	}
+
+	/* The queue may have been drained while waiting */
+	queue = __bt_dispatch_lookup_queue(key, has_device, data->index);
+	if (queue == NULL) {
+		queue = (bt_dispatch_pool != NULL) ? calloc(1, sizeof(bt_dispatch_queue_s)) : NULL;
+		if (queue == NULL) {
+			g_mutex_unlock(&bt_dispatch_lock);
+			return false;
+		}
+
+		snprintf(queue->key, sizeof(queue->key), "%s", key);
+		queue->index = (has_device == true) ? -1 : data->index;
+		g_queue_init(&queue->events);
+		g_hash_table_insert(bt_dispatch_queues, queue->key, queue);
+		if (queue->index >= 0 && bt_dispatch_pending[queue->index] > 0)
+			queue->parked = true;
+		else
+			g_thread_pool_push(bt_dispatch_pool, queue, NULL);
+	}
+	if (queue->index < 0)
+		bt_dispatch_pending[data->index]++;
+
+	slot = bt_dispatch_free_slots;
+	bt_dispatch_free_slots = slot->next_free;
+	memcpy(&slot->data, data, sizeof(bt_event_data_s));
+	slot->queue = queue;
+	slot->device_link.data = slot;
+	slot->order_link.data = slot;
+	g_queue_push_tail_link(&queue->events, &slot->device_link);
+	g_queue_push_tail_link(&bt_dispatch_order, &slot->order_link);
+
+	bt_dispatch_stats.enqueued++;
+	bt_dispatch_stats.queued++;
+	if (bt_dispatch_stats.queued > bt_dispatch_stats.high_water)
+		bt_dispatch_stats.high_water = bt_dispatch_stats.queued;
+	g_mutex_unlock(&bt_dispatch_lock);
+
+	return true;
+}
+
+void _bt_dispatch_stop(void)
+{
+	GThreadPool *pool = NULL;
+	GList *parked = NULL;
+	GList *node = NULL;
+
+	g_atomic_int_set(&bt_dispatch_mode, BT_EVENT_DELIVERY_INLINE);
+
+	g_mutex_lock(&bt_dispatch_lock);
+	pool = bt_dispatch_pool;
+	bt_dispatch_pool = NULL;
+	g_mutex_unlock(&bt_dispatch_lock);
+
+	/* Wait until the queued events are delivered */
+	if (pool != NULL)
+		g_thread_pool_free(pool, FALSE, TRUE);
+
+	/* The events of the devices are delivered, so are the events which waited for them */
+	g_mutex_lock(&bt_dispatch_lock);
+	memset(bt_dispatch_pending, 0x00, sizeof(bt_dispatch_pending));
+	parked = (bt_dispatch_queues != NULL) ? g_hash_table_get_values(bt_dispatch_queues) : NULL;
+	g_mutex_unlock(&bt_dispatch_lock);
+
+	for (node = parked; node != NULL; node = node->next) {
+		((bt_dispatch_queue_s *)node->data)->parked = false;
+		__bt_dispatch_worker(node->data, NULL);
+	}
+	g_list_free(parked);
+
+	g_mutex_lock(&bt_dispatch_lock);
+	if (bt_dispatch_pool == NULL && bt_dispatch_slots != NULL) {
+		free(bt_dispatch_slots);
+		bt_dispatch_slots = NULL;
+		bt_dispatch_free_slots = NULL;
+		g_cond_broadcast(&bt_dispatch_space);
+	}
+	g_mutex_unlock(&bt_dispatch_lock);
+}
+
+void _bt_dispatch_update(int event, bluetooth_event_param_t *param)
+{
+	bluetooth_rfcomm_connection_t *connection = NULL;
+	bt_hdp_connected_t *hdp_connection = NULL;
+
+	g_mutex_lock(&bt_dispatch_lock);
+	if (bt_dispatch_sockets == NULL)
+		bt_dispatch_sockets = g_hash_table_new(g_direct_hash, g_direct_equal);
+	if (bt_dispatch_channels == NULL)
+		bt_dispatch_channels = g_hash_table_new(g_direct_hash, g_direct_equal);
+
+	switch (event) {
+	case BLUETOOTH_EVENT_RFCOMM_CONNECTED:
+		connection = (bluetooth_rfcomm_connection_t *)(param->param_data);
+		if (param->result == BLUETOOTH_ERROR_NONE && connection != NULL)
+			g_hash_table_insert(bt_dispatch_sockets, GINT_TO_POINTER(connection->socket_fd),
+					(gpointer)_bt_intern_address(&connection->device_addr));
+		break;
+	case BLUETOOTH_EVENT_RFCOMM_DISCONNECTED:
+		if (param->param_data != NULL)
+			g_hash_table_remove(bt_dispatch_sockets,
+					GINT_TO_POINTER(((bluetooth_rfcomm_disconnection_t *)(param->param_data))->socket_fd));
+		break;
+	case BLUETOOTH_EVENT_HDP_CONNECTED:
+		hdp_connection = (bt_hdp_connected_t *)(param->param_data);
+		if (param->result == BLUETOOTH_ERROR_NONE && hdp_connection != NULL)
+			g_hash_table_insert(bt_dispatch_channels, GINT_TO_POINTER(hdp_connection->channel_id),
+					(gpointer)_bt_intern_address(&hdp_connection->device_address));
+		break;
+	case BLUETOOTH_EVENT_HDP_DISCONNECTED:
+		if (param->param_data != NULL)
+			g_hash_table_remove(bt_dispatch_channels,
+					GINT_TO_POINTER(((bt_hdp_disconnected_t *)(param->param_data))->channel_id));
+		break;
+	case BLUETOOTH_EVENT_DISABLED:
+		g_hash_table_remove_all(bt_dispatch_sockets);
+		g_hash_table_remove_all(bt_dispatch_channels);
+		break;
+	default:
+		break;
+	}
+	g_mutex_unlock(&bt_dispatch_lock);
+}
+
+int bt_event_set_delivery_mode(bt_event_delivery_mode_e mode, int worker_count)
+{
+	int i;
+
+	BT_CHECK_INIT_STATUS();
+
+	if (mode == BT_EVENT_DELIVERY_INLINE) {
+		_bt_dispatch_stop();
+		return BT_ERROR_NONE;
+	}
+
+	if (mode != BT_EVENT_DELIVERY_THREAD_POOL || worker_count <= 0) {
+		LOGE("[%s] INVALID_PARAMETER(0x%08x)", __FUNCTION__, BT_ERROR_INVALID_PARAMETER);
+		return BT_ERROR_INVALID_PARAMETER;
+	}
+
+	g_mutex_lock(&bt_dispatch_lock);
+	if (bt_dispatch_queues == NULL)
+		bt_dispatch_queues = g_hash_table_new(g_str_hash, g_str_equal);
+
+	if (bt_dispatch_slots == NULL) {
+		bt_dispatch_slots = calloc(bt_dispatch_capacity, sizeof(bt_dispatch_slot_s));
+		if (bt_dispatch_slots == NULL) {
+			g_mutex_unlock(&bt_dispatch_lock);
+			LOGE("[%s] OUT_OF_MEMORY(0x%08x)", __FUNCTION__, BT_ERROR_OUT_OF_MEMORY);
+			return BT_ERROR_OUT_OF_MEMORY;
+		}
+		for (i = 0; i < bt_dispatch_capacity; i++)
+			bt_dispatch_slots[i].next_free = (i + 1 < bt_dispatch_capacity) ? &bt_dispatch_slots[i + 1] : NULL;
+		bt_dispatch_free_slots = &bt_dispatch_slots[0];
+	}
+
+	if (bt_dispatch_pool == NULL) {
+		bt_dispatch_pool = g_thread_pool_new(__bt_dispatch_worker, NULL, worker_count, FALSE, NULL);
+	} else if (bt_dispatch_pool != NULL) {
+		g_thread_pool_set_max_threads(bt_dispatch_pool, worker_count, NULL);
+	}
+
+	if (bt_dispatch_pool == NULL || bt_dispatch_queues == NULL) {
+		g_mutex_unlock(&bt_dispatch_lock);
+		LOGE("[%s] OPERATION_FAILED(0x%08x)", __FUNCTION__, BT_ERROR_OPERATION_FAILED);
+		return BT_ERROR_OPERATION_FAILED;
+	}
+
+	bt_dispatch_stats.capacity = bt_dispatch_capacity;
+	g_atomic_int_set(&bt_dispatch_mode, BT_EVENT_DELIVERY_THREAD_POOL);
+	g_mutex_unlock(&bt_dispatch_lock);
+
+	return BT_ERROR_NONE;
+}
+
+int bt_event_get_delivery_mode(bt_event_delivery_mode_e *mode)
+{
+	BT_CHECK_INIT_STATUS();
+	BT_CHECK_INPUT_PARAMETER(mode);
+
+	*mode = g_atomic_int_get(&bt_dispatch_mode);
+
+	return BT_ERROR_NONE;
+}
+
+int bt_event_set_queue_capacity(int capacity)
+{
+	int error_code = BT_ERROR_NONE;
+
+	BT_CHECK_INIT_STATUS();
+
+	if (capacity <= 0) {
+		LOGE("[%s] INVALID_PARAMETER(0x%08x)", __FUNCTION__, BT_ERROR_INVALID_PARAMETER);
+		return BT_ERROR_INVALID_PARAMETER;
+	}
+
+	g_mutex_lock(&bt_dispatch_lock);
+	if (bt_dispatch_slots != NULL) {
+		error_code = BT_ERROR_RESOURCE_BUSY;
+	} else {
+		bt_dispatch_capacity = capacity;
+	}
+	g_mutex_unlock(&bt_dispatch_lock);
+
+	if (error_code != BT_ERROR_NONE) {
+		LOGE("[%s] %s(0x%08x)", __FUNCTION__, _bt_convert_error_to_string(error_code), error_code);
+	}
+
+	return error_code;
+}
+
+int bt_event_set_queue_policy(bt_event_e event, bt_event_queue_policy_e policy)
+{
+	BT_CHECK_INIT_STATUS();
+
+	if (event < 0 || event >= BT_EVENT_MAX ||
+			policy < BT_EVENT_QUEUE_POLICY_BLOCK || policy > BT_EVENT_QUEUE_POLICY_COALESCE_BY_DEVICE) {
+		LOGE("[%s] INVALID_PARAMETER(0x%08x)", __FUNCTION__, BT_ERROR_INVALID_PARAMETER);
+		return BT_ERROR_INVALID_PARAMETER;
+	}
+
+	g_atomic_int_set(&bt_dispatch_policy[event], policy);
+
+	return BT_ERROR_NONE;
+}
+
+int bt_event_get_queue_policy(bt_event_e event, bt_event_queue_policy_e *policy)
+{
+	BT_CHECK_INIT_STATUS();
+	BT_CHECK_INPUT_PARAMETER(policy);
+
+	if (event < 0 || event >= BT_EVENT_MAX) {
+		LOGE("[%s] INVALID_PARAMETER(0x%08x)", __FUNCTION__, BT_ERROR_INVALID_PARAMETER);
+		return BT_ERROR_INVALID_PARAMETER;
+	}
+
+	*policy = g_atomic_int_get(&bt_dispatch_policy[event]);
+
+	return BT_ERROR_NONE;
+}
+
+int bt_event_get_queue_stats(bt_event_queue_stats_s *stats)
+{
+	BT_CHECK_INIT_STATUS();
+	BT_CHECK_INPUT_PARAMETER(stats);
+
+	g_mutex_lock(&bt_dispatch_lock);
+	memcpy(stats, &bt_dispatch_stats, sizeof(bt_event_queue_stats_s));
+	stats->capacity = bt_dispatch_capacity;
+	g_mutex_unlock(&bt_dispatch_lock);
+
+	return BT_ERROR_NONE;
+}
@@ -36,7 +36,9 @@ int bt_hdp_register_sink_app(unsigned short data_type, char **app_id)
 
 	BT_CHECK_INIT_STATUS();
 	BT_CHECK_INPUT_PARAMETER(app_id);
+	_bt_lock(BT_LOCK_HDP);
 	error = bluetooth_hdp_activate(data_type, HDP_ROLE_SINK, HDP_QOS_ANY, app_id);
+	_bt_unlock(BT_LOCK_HDP);
 	error = _bt_get_error_code(error);
 	if (BT_ERROR_NONE != error) {
 		LOGE("[%s] %s(0x%08x)", __FUNCTION__,
@@ -51,7 +53,9 @@ int bt_hdp_unregister_sink_app(const char *app_id)
 
 	BT_CHECK_INIT_STATUS();
 	BT_CHECK_INPUT_PARAMETER(app_id);
+	_bt_lock(BT_LOCK_HDP);
 	error = bluetooth_hdp_deactivate(app_id);
+	_bt_unlock(BT_LOCK_HDP);
 	error = _bt_get_error_code(error);
 	if (BT_ERROR_NONE != error) {
 		LOGE("[%s] %s(0x%08x)", __FUNCTION__,
@@ -78,15 +82,13 @@ int bt_hdp_send_data(unsigned int channel, const char *data, unsigned int size)
 	return error;
 }
 
-int bt_hdp_connect_to_source(const char *remote_address, const char *app_id)
+static int __bt_hdp_connect_to_source(bluetooth_device_address_t *addr_hex, const char *app_id)
 {
 	int error = BT_ERROR_NONE;
-	bluetooth_device_address_t addr_hex = { {0,} };
-	BT_CHECK_INIT_STATUS();
-	BT_CHECK_INPUT_PARAMETER(app_id);
-	BT_CHECK_INPUT_PARAMETER(remote_address);
-	_bt_convert_address_to_hex(&addr_hex, remote_address);
-	error = bluetooth_hdp_connect(app_id, HDP_QOS_ANY, &addr_hex);
+
+	_bt_lock(BT_LOCK_HDP);
+	error = bluetooth_hdp_connect(app_id, HDP_QOS_ANY, addr_hex);
+	_bt_unlock(BT_LOCK_HDP);
 	error = _bt_get_error_code(error);
 	if (error != BT_ERROR_NONE) {
 		LOGE("[%s] %s(0x%08x)", __FUNCTION__,
@@ -95,15 +97,35 @@ int bt_hdp_connect_to_source(const char *remote_address, const char *app_id)
 	return error;
 }
 
-int bt_hdp_disconnect(const char *remote_address, unsigned int channel)
+int bt_hdp_connect_to_source(const char *remote_address, const char *app_id)
 {
-	int error = BT_ERROR_NONE;
 	bluetooth_device_address_t addr_hex = { {0,} };
+
 	BT_CHECK_INIT_STATUS();
+	BT_CHECK_INPUT_PARAMETER(app_id);
 	BT_CHECK_INPUT_PARAMETER(remote_address);
-	_bt_convert_address_to_hex(&addr_hex, remote_address);
+	BT_CHECK_ADDRESS_TO_HEX(&addr_hex, remote_address);
+	return __bt_hdp_connect_to_source(&addr_hex, app_id);
+}
+
+int bt_hdp_connect_to_source_by_addr(const bt_addr_t *remote_addr, const char *app_id)
+{
+	bluetooth_device_address_t addr_hex = { {0,} };
+
+	BT_CHECK_INIT_STATUS();
+	BT_CHECK_INPUT_PARAMETER(app_id);
+	BT_CHECK_INPUT_PARAMETER(remote_addr);
+	_bt_convert_addr_to_hex(&addr_hex, remote_addr);
+	return __bt_hdp_connect_to_source(&addr_hex, app_id);
+}
 
-	error = bluetooth_hdp_disconnect(channel, &addr_hex);
+static int __bt_hdp_disconnect(bluetooth_device_address_t *addr_hex, unsigned int channel)
+{
+	int error = BT_ERROR_NONE;
+
+	_bt_lock(BT_LOCK_HDP);
+	error = bluetooth_hdp_disconnect(channel, addr_hex);
+	_bt_unlock(BT_LOCK_HDP);
 	error = _bt_get_error_code(error);
 	if (error != BT_ERROR_NONE) {
 		LOGE("[%s] %s(0x%08x)", __FUNCTION__,
@@ -112,14 +134,36 @@ int bt_hdp_disconnect(const char *remote_address, unsigned int channel)
 	return error;
 }
 
+int bt_hdp_disconnect(const char *remote_address, unsigned int channel)
+{
+	bluetooth_device_address_t addr_hex = { {0,} };
+
+	BT_CHECK_INIT_STATUS();
+	BT_CHECK_INPUT_PARAMETER(remote_address);
+	BT_CHECK_ADDRESS_TO_HEX(&addr_hex, remote_address);
+	return __bt_hdp_disconnect(&addr_hex, channel);
+}
+
+int bt_hdp_disconnect_by_addr(const bt_addr_t *remote_addr, unsigned int channel)
+{
+	bluetooth_device_address_t addr_hex = { {0,} };
+
+	BT_CHECK_INIT_STATUS();
+	BT_CHECK_INPUT_PARAMETER(remote_addr);
+	_bt_convert_addr_to_hex(&addr_hex, remote_addr);
+	return __bt_hdp_disconnect(&addr_hex, channel);
+}
+
 int bt_hdp_set_connection_state_changed_cb(bt_hdp_connected_cb connected_cb,
 		bt_hdp_disconnected_cb disconnected_cb, void *user_data)
 {
 	BT_CHECK_INIT_STATUS();
 	BT_CHECK_INPUT_PARAMETER(connected_cb);
 	BT_CHECK_INPUT_PARAMETER(disconnected_cb);
+	_bt_lock(BT_LOCK_HDP);
 	_bt_set_cb(BT_EVENT_HDP_CONNECTED, connected_cb, user_data);
 	_bt_set_cb(BT_EVENT_HDP_DISCONNECTED, disconnected_cb, user_data);
+	_bt_unlock(BT_LOCK_HDP);
 	return BT_ERROR_NONE;
 
 }
@@ -127,10 +171,12 @@ int bt_hdp_set_connection_state_changed_cb(bt_hdp_connected_cb connected_cb,
 int bt_hdp_unset_connection_state_changed_cb(void)
 {
 	BT_CHECK_INIT_STATUS();
+	_bt_lock(BT_LOCK_HDP);
 	if ( _bt_check_cb(BT_EVENT_HDP_CONNECTED) == true)
 		_bt_unset_cb(BT_EVENT_HDP_CONNECTED);
 	if ( _bt_check_cb(BT_EVENT_HDP_DISCONNECTED) == true)
 		_bt_unset_cb(BT_EVENT_HDP_DISCONNECTED);
+	_bt_unlock(BT_LOCK_HDP);
 
 	return BT_ERROR_NONE;
 }
@@ -67,17 +67,11 @@ int bt_hid_host_deinitialize()
 	return error;
 }
 
-int bt_hid_host_connect(const char *remote_address)
+static int __bt_hid_host_connect(bluetooth_device_address_t *addr_hex)
 {
 	int error;
-	bluetooth_device_address_t addr_hex = { {0,} };
-
-	BT_CHECK_INIT_STATUS();
-	BT_CHECK_INPUT_PARAMETER(remote_address);
-
-	_bt_convert_address_to_hex(&addr_hex, remote_address);
 
-	error = bluetooth_hid_connect((hid_device_address_t *)&addr_hex);
+	error = bluetooth_hid_connect((hid_device_address_t *)addr_hex);
 	error = _bt_get_error_code(error);
 	if (error != BT_ERROR_NONE) {
 		LOGE("[%s] %s(0x%08x)", __FUNCTION__,
@@ -86,17 +80,58 @@ int bt_hid_host_connect(const char *remote_address)
 	return error;
 }
 
-int bt_hid_host_disconnect(const char *remote_address)
+int bt_hid_host_connect(const char *remote_address)
 {
-	int error;
 	bluetooth_device_address_t addr_hex = { {0,} };
 
 	BT_CHECK_INIT_STATUS();
 	BT_CHECK_INPUT_PARAMETER(remote_address);
 
-	_bt_convert_address_to_hex(&addr_hex, remote_address);
+	BT_CHECK_ADDRESS_TO_HEX(&addr_hex, remote_address);
+	return __bt_hid_host_connect(&addr_hex);
+}
+
+int bt_hid_host_connect_by_addr(const bt_addr_t *remote_addr)
+{
+	bluetooth_device_address_t addr_hex = { {0,} };
+
+	BT_CHECK_INIT_STATUS();
+	BT_CHECK_INPUT_PARAMETER(remote_addr);
+
+	_bt_convert_addr_to_hex(&addr_hex, remote_addr);
+	return __bt_hid_host_connect(&addr_hex);
+}
+
+static const bt_operation_type_s bt_operation_hid_connect = {
+	{ BLUETOOTH_HID_CONNECTED, 0 }, NULL,
+};
+
+int bt_hid_host_connect_async(const char *remote_address, int timeout_ms,
+		bt_operation_completed_cb callback, void *user_data, int *operation_id)
+{
+	bluetooth_device_address_t addr_hex = { {0,} };
+	int error_code = BT_ERROR_NONE;
+
+	BT_CHECK_INIT_STATUS();
+	BT_CHECK_INPUT_PARAMETER(remote_address);
+	BT_CHECK_ADDRESS_TO_HEX(&addr_hex, remote_address);
 
-	error = bluetooth_hid_disconnect((hid_device_address_t *)&addr_hex);
+	error_code = _bt_operation_begin(&bt_operation_hid_connect, &addr_hex, timeout_ms, callback, user_data, operation_id);
+	if (error_code != BT_ERROR_NONE)
+		return error_code;
+
+	error_code = __bt_hid_host_connect(&addr_hex);
+	if (error_code != BT_ERROR_NONE)
+		_bt_operation_abort(*operation_id);
+
+	return error_code;
+}
+
+static int __bt_hid_host_disconnect(bluetooth_device_address_t *addr_hex)
+{
+	int error;
+
+	error = bluetooth_hid_disconnect((hid_device_address_t *)addr_hex);
 	error = _bt_get_error_code(error);
 	if (error != BT_ERROR_NONE) {
 		LOGE("[%s] %s(0x%08x)", __FUNCTION__,
@@ -104,3 +139,25 @@ int bt_hid_host_disconnect(const char *remote_address)
 	}
 	return error;
 }
+
+int bt_hid_host_disconnect(const char *remote_address)
+{
+	bluetooth_device_address_t addr_hex = { {0,} };
+
+	BT_CHECK_INIT_STATUS();
+	BT_CHECK_INPUT_PARAMETER(remote_address);
+
+	BT_CHECK_ADDRESS_TO_HEX(&addr_hex, remote_address);
+	return __bt_hid_host_disconnect(&addr_hex);
+}
+
+int bt_hid_host_disconnect_by_addr(const bt_addr_t *remote_addr)
+{
+	bluetooth_device_address_t addr_hex = { {0,} };
+
+	BT_CHECK_INIT_STATUS();
+	BT_CHECK_INPUT_PARAMETER(remote_addr);
+
+	_bt_convert_addr_to_hex(&addr_hex, remote_addr);
+	return __bt_hid_host_disconnect(&addr_hex);
+}
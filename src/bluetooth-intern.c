@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <glib.h>
+#include <dlog.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "bluetooth.h"
+#include "bluetooth_private.h"
+
+#ifdef LOG_TAG
+#undef LOG_TAG
+#endif
+#define LOG_TAG "TIZEN_N_BLUETOOTH"
+
+/*
+ *  Interning tables
+ *
+ *  An entry is its key followed by its formatted value, allocated in chunks and never freed,
+ *  so a value stays valid for the life of the process. The slots are open addressing over a
+ *  power of two table, grown when half full. Lookups read the published slots without a lock;
+ *  insertions and growth take the lock of the table. Replaced slots are kept, because a
+ *  reader may still probe them, and they add up to less than the current slots.
+ */
+
+#define BT_INTERN_CHUNK 32
+#define BT_INTERN_MIN_SIZE 64
+
+struct bt_intern_slots_s {
+	struct bt_intern_slots_s *retired_next;
+	guint mask;
+	const char *entries[];
+};
+
+static guint __bt_intern_hash(const void *key, size_t key_len)
+{
+	guint64 words[2] = { 0, 0 };
+
+	memcpy(words, key, key_len);
+
+	return (guint)((((words[0] * 0x9E3779B97F4A7C15ULL) ^ words[1]) * 0xC2B2AE3D27D4EB4FULL) >> 32);
+}
+
+static const char *__bt_intern_find(bt_intern_slots_s *slots, const void *key, size_t key_len, guint hash)
+{
+	const char *entry = NULL;
+	guint slot = hash & slots->mask;
+
+	while ((entry = g_atomic_pointer_get(&slots->entries[slot])) != NULL) {
+		if (memcmp(entry, key, key_len) == 0)
+			return entry + key_len;
+		slot = (slot + 1) & slots->mask;
+	}
+
+	return NULL;
+}
+
+/*
+ *  Must be called with the lock of the table held.
+ */
+static void __bt_intern_insert(bt_intern_slots_s *slots, const char *entry, guint hash)
+{
+	guint slot = hash & slots->mask;
+
+	while (slots->entries[slot] != NULL)
+		slot = (slot + 1) & slots->mask;
+	g_atomic_pointer_set(&slots->entries[slot], (gpointer)entry);
+}
+
+/*
+ *  Must be called with the lock of the table held.
+ */
+static bool __bt_intern_grow(bt_intern_table_s *table)
+{
+	bt_intern_slots_s *old_slots = table->slots;
+	bt_intern_slots_s *new_slots = NULL;
+	guint size = (old_slots != NULL) ? (old_slots->mask + 1) * 2 : BT_INTERN_MIN_SIZE;
+	guint i;
+
+	new_slots = calloc(1, sizeof(bt_intern_slots_s) + sizeof(const char *) * size);
+	if (new_slots == NULL)
+		return false;
+
+	new_slots->mask = size - 1;
+	if (old_slots != NULL) {
+		for (i = 0; i <= old_slots->mask; i++) {
+			if (old_slots->entries[i] != NULL)
+				__bt_intern_insert(new_slots, old_slots->entries[i],
+						__bt_intern_hash(old_slots->entries[i], table->key_len));
+		}
+		old_slots->retired_next = table->retired;
+		table->retired = old_slots;
+	}
+
+	g_atomic_pointer_set(&table->slots, new_slots);
+
+	return true;
+}
+
+const char *_bt_intern(bt_intern_table_s *table, const void *key)
+{
+	bt_intern_slots_s *slots = g_atomic_pointer_get(&table->slots);
+	guint hash = __bt_intern_hash(key, table->key_len);
+	const char *value = NULL;
+	char *entry = NULL;
+
+	if (slots != NULL && (value = __bt_intern_find(slots, key, table->key_len, hash)) != NULL)
+		return value;
+
+	g_mutex_lock(&table->lock);
+
+	/* Interned by another thread, or into slots published since */
+	slots = table->slots;
+	if (slots != NULL && (value = __bt_intern_find(slots, key, table->key_len, hash)) != NULL) {
+		g_mutex_unlock(&table->lock);
+		return value;
+	}
+
+	if ((slots == NULL || (table->count + 1) * 2 > slots->mask + 1) && __bt_intern_grow(table) == false) {
+		g_mutex_unlock(&table->lock);
+		return NULL;
+	}
+
+	if (table->chunk == NULL || table->chunk_used == BT_INTERN_CHUNK) {
+		entry = malloc((table->key_len + table->value_len) * BT_INTERN_CHUNK);
+		if (entry == NULL) {
+			g_mutex_unlock(&table->lock);
+			return NULL;
+		}
+		table->chunk = entry;
+		table->chunk_used = 0;
+	}
+
+	entry = table->chunk + (table->key_len + table->value_len) * table->chunk_used++;
+	memcpy(entry, key, table->key_len);
+	table->format(entry + table->key_len, key);
+	__bt_intern_insert(table->slots, entry, hash);
+	table->count++;
+
+	g_mutex_unlock(&table->lock);
+
+	return entry + table->key_len;
+}
@@ -0,0 +1,267 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <glib.h>
+#include <dlog.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <bluetooth-api.h>
+
+#include "bluetooth.h"
+#include "bluetooth_private.h"
+
+#ifdef LOG_TAG
+#undef LOG_TAG
+#endif
+#define LOG_TAG "TIZEN_N_BLUETOOTH"
+
+/*
+ *  Asynchronous operations
+ *
+ *  An operation is registered before its request is sent to the F/W, so its event cannot be
+ *  missed, and completed by the first of: the F/W events it waits for, its deadline, or a
+ *  cancellation. Operations waiting for the same event and address complete in the order they
+ *  were started. Whoever removes an operation from the pending list invokes its callback,
+ *  without the lock, so the callback may start or cancel operations.
+ */
+
+typedef struct {
+	int id;
+	const bt_operation_type_s *type;
+	const char *remote_address; /* Interned, NULL for the operations of the adapter */
+	unsigned int received; /* Bit of each event of type->events already received */
+	GSource *timeout_source; /* Referenced, NULL without a deadline */
+	bt_operation_completed_cb callback;
+	void *user_data;
+} bt_operation_s;
+
+static GMutex bt_operation_lock;
+static GList *bt_operations = NULL; /* Pending, oldest first */
+static volatile gint bt_operation_count = 0;
+static int bt_operation_last_id = 0;
+
+/*
+ *  Must be called with bt_operation_lock held.
+ */
+static bt_operation_s *__bt_operation_remove(int operation_id)
+{
+	bt_operation_s *operation = NULL;
+	GList *node = NULL;
+
+	for (node = bt_operations; node != NULL; node = node->next) {
+		operation = node->data;
+		if (operation->id == operation_id) {
+			bt_operations = g_list_delete_link(bt_operations, node);
+			g_atomic_int_add(&bt_operation_count, -1);
+			return operation;
+		}
+	}
+
+	return NULL;
+}
+
+/*
+ *  The deadline may expire on the main loop while the operation completes in another thread, so
+ *  the source is kept referenced: destroying it again is harmless, unlike removing it by id.
+ */
+static void __bt_operation_free(bt_operation_s *operation)
+{
+	if (operation->timeout_source != NULL) {
+		g_source_destroy(operation->timeout_source);
+		g_source_unref(operation->timeout_source);
+	}
+	free(operation);
+}
+
+static void __bt_operation_finish(bt_operation_s *operation, int result)
+{
+	if (result != BT_ERROR_NONE)
+		LOGI("[%s] operation %d: %s(0x%08x)", __FUNCTION__, operation->id, _bt_convert_error_to_string(result), result);
+
+	operation->callback(operation->id, result, operation->remote_address, operation->user_data);
+	__bt_operation_free(operation);
+}
+
+static gboolean __bt_operation_timeout(gpointer user_data)
+{
+	bt_operation_s *operation = NULL;
+
+	g_mutex_lock(&bt_operation_lock);
+	operation = __bt_operation_remove(GPOINTER_TO_INT(user_data));
+	g_mutex_unlock(&bt_operation_lock);
+
+	if (operation != NULL)
+		__bt_operation_finish(operation, BT_ERROR_TIMED_OUT);
+
+	return FALSE;
+}
+
+int _bt_operation_begin(const bt_operation_type_s *type, const bluetooth_device_address_t *address,
+		int timeout_ms, bt_operation_completed_cb callback, void *user_data, int *operation_id)
+{
+	bt_operation_s *operation = NULL;
+
+	BT_CHECK_INPUT_PARAMETER(callback);
+	BT_CHECK_INPUT_PARAMETER(operation_id);
+	if (timeout_ms < 0) {
+		LOGE("[%s] INVALID_PARAMETER(0x%08x)", __FUNCTION__, BT_ERROR_INVALID_PARAMETER);
+		return BT_ERROR_INVALID_PARAMETER;
+	}
+
+	operation = calloc(1, sizeof(bt_operation_s));
+	if (operation == NULL) {
+		LOGE("[%s] OUT_OF_MEMORY(0x%08x)", __FUNCTION__, BT_ERROR_OUT_OF_MEMORY);
+		return BT_ERROR_OUT_OF_MEMORY;
+	}
+
+	if (address != NULL) {
+		operation->remote_address = _bt_intern_address(address);
+		if (operation->remote_address == NULL) {
+			free(operation);
+			LOGE("[%s] OUT_OF_MEMORY(0x%08x)", __FUNCTION__, BT_ERROR_OUT_OF_MEMORY);
+			return BT_ERROR_OUT_OF_MEMORY;
+		}
+	}
+	operation->type = type;
+	operation->callback = callback;
+	operation->user_data = user_data;
+
+	g_mutex_lock(&bt_operation_lock);
+	if (++bt_operation_last_id <= 0)
+		bt_operation_last_id = 1;
+	operation->id = bt_operation_last_id;
+	if (timeout_ms > 0) {
+		operation->timeout_source = g_timeout_source_new(timeout_ms);
+		g_source_set_callback(operation->timeout_source, __bt_operation_timeout, GINT_TO_POINTER(operation->id), NULL);
+		g_source_attach(operation->timeout_source, NULL);
+	}
+	bt_operations = g_list_append(bt_operations, operation);
+	g_atomic_int_inc(&bt_operation_count);
+	g_mutex_unlock(&bt_operation_lock);
+
+	*operation_id = operation->id;
+
+	return BT_ERROR_NONE;
+}
+
+void _bt_operation_abort(int operation_id)
+{
+	bt_operation_s *operation = NULL;
+
+	g_mutex_lock(&bt_operation_lock);
+	operation = __bt_operation_remove(operation_id);
+	g_mutex_unlock(&bt_operation_lock);
+
+	if (operation == NULL)
+		return;
+
+	__bt_operation_free(operation);
+}
+
+bool _bt_operation_is_pending(void)
+{
+	return (g_atomic_int_get(&bt_operation_count) > 0) ? true : false;
+}
+
+void _bt_operation_complete(int event, int result, const bluetooth_device_address_t *address)
+{
+	bt_operation_s *operation = NULL;
+	const char *remote_address = NULL;
+	GList *node = NULL;
+	unsigned int all_events;
+	int i;
+
+	if (address != NULL)
+		remote_address = _bt_intern_address(address);
+
+	g_mutex_lock(&bt_operation_lock);
+	for (node = bt_operations; node != NULL; node = node->next) {
+		operation = node->data;
+		if (operation->remote_address != remote_address)
+			continue;
+
+		for (i = 0; i < BT_OPERATION_MAX_EVENTS && operation->type->events[i] != 0; i++) {
+			if (operation->type->events[i] == event && (operation->received & (1U << i)) == 0)
+				break;
+		}
+		if (i == BT_OPERATION_MAX_EVENTS || operation->type->events[i] == 0)
+			continue;
+
+		operation->received |= 1U << i;
+		for (i = 0, all_events = 0; i < BT_OPERATION_MAX_EVENTS && operation->type->events[i] != 0; i++)
+			all_events |= 1U << i;
+
+		/* A failure completes the operation, a success once all its events are received */
+		if (result == BT_ERROR_NONE && operation->received != all_events) {
+			g_mutex_unlock(&bt_operation_lock);
+			return;
+		}
+
+		bt_operations = g_list_delete_link(bt_operations, node);
+		g_atomic_int_add(&bt_operation_count, -1);
+		g_mutex_unlock(&bt_operation_lock);
+
+		__bt_operation_finish(operation, result);
+		return;
+	}
+	g_mutex_unlock(&bt_operation_lock);
+}
+
+void _bt_operation_cancel_all(void)
+{
+	GList *operations = NULL;
+	GList *node = NULL;
+
+	g_mutex_lock(&bt_operation_lock);
+	operations = bt_operations;
+	bt_operations = NULL;
+	g_atomic_int_set(&bt_operation_count, 0);
+	g_mutex_unlock(&bt_operation_lock);
+
+	for (node = operations; node != NULL; node = node->next)
+		__bt_operation_finish(node->data, BT_ERROR_CANCELLED);
+	g_list_free(operations);
+}
+
+int bt_operation_cancel(int operation_id)
+{
+	bt_operation_s *operation = NULL;
+	int error_code = BT_ERROR_NONE;
+
+	BT_CHECK_INIT_STATUS();
+
+	g_mutex_lock(&bt_operation_lock);
+	operation = __bt_operation_remove(operation_id);
+	g_mutex_unlock(&bt_operation_lock);
+
+	if (operation == NULL) {
+		LOGE("[%s] NOT_IN_PROGRESS(0x%08x)", __FUNCTION__, BT_ERROR_NOT_IN_PROGRESS);
+		return BT_ERROR_NOT_IN_PROGRESS;
+	}
+
+	/* The operation completes anyway, even if the F/W cannot stop the request */
+	if (operation->type->cancel != NULL) {
+		error_code = _bt_get_error_code(operation->type->cancel());
+		if (error_code != BT_ERROR_NONE)
+			LOGE("[%s] %s(0x%08x)", __FUNCTION__, _bt_convert_error_to_string(error_code), error_code);
+	}
+
+	__bt_operation_finish(operation, BT_ERROR_CANCELLED);
+
+	return BT_ERROR_NONE;
+}
@@ -29,7 +29,30 @@
 #endif
 #define LOG_TAG "TIZEN_N_BLUETOOTH"
 
-GList *sending_files;
+GList *sending_files; /* Protected by BT_LOCK_OPP */
+
+static void __bt_opp_client_clear_files(void)
+{
+	int i = 0;
+	int file_num = 0;
+	char *c_file = NULL;
+
+	if (sending_files) {
+		file_num = g_list_length(sending_files);
+
+		for (i = 0; i < file_num; i++) {
+			c_file = (char *)g_list_nth_data(sending_files, i);
+
+			if (c_file == NULL)
+				continue;
+
+			free(c_file);
+		}
+
+		g_list_free(sending_files);
+		sending_files = NULL;
+	}
+}
 
 char** __bt_opp_get_file_array(GList *file_list)
 {
@@ -71,7 +94,9 @@ int bt_opp_client_initialize(void)
 
 	BT_CHECK_INIT_STATUS();
 
+	_bt_lock(BT_LOCK_OPP);
 	error_code = _bt_get_error_code(bluetooth_opc_init());
+	_bt_unlock(BT_LOCK_OPP);
 
 	if (error_code != BT_ERROR_NONE) {
 		LOGE("[%s] %s(0x%08x)", __FUNCTION__, _bt_convert_error_to_string(error_code), error_code);
@@ -86,13 +111,15 @@ int bt_opp_client_deinitialize(void)
 
 	BT_CHECK_INIT_STATUS();
 
+	_bt_lock(BT_LOCK_OPP);
 	error_code = _bt_get_error_code(bluetooth_opc_deinit());
 
 	if (error_code != BT_ERROR_NONE) {
 		LOGE("[%s] %s(0x%08x)", __FUNCTION__, _bt_convert_error_to_string(error_code), error_code);
 	}
 
-	bt_opp_client_clear_files();
+	__bt_opp_client_clear_files();
+	_bt_unlock(BT_LOCK_OPP);
 
 	return error_code;
 }
@@ -105,7 +132,9 @@ int bt_opp_client_add_file(const char *file)
 	BT_CHECK_INPUT_PARAMETER(file);
 
 	if (access(file, F_OK) == 0) {
+		_bt_lock(BT_LOCK_OPP);
 		sending_files = g_list_append(sending_files, strdup(file));
+		_bt_unlock(BT_LOCK_OPP);
 	} else {
 		error_code = BT_ERROR_INVALID_PARAMETER;
 		LOGE("[%s] %s(0x%08x)", __FUNCTION__, _bt_convert_error_to_string(error_code), error_code);
@@ -116,49 +145,28 @@ int bt_opp_client_add_file(const char *file)
 
 int bt_opp_client_clear_files(void)
 {
-	int i = 0;
-	int file_num = 0;
-	char *c_file = NULL;
-
 	BT_CHECK_INIT_STATUS();
 
-	if (sending_files) {
-		file_num = g_list_length(sending_files);
-
-		for (i = 0; i < file_num; i++) {
-			c_file = (char *)g_list_nth_data(sending_files, i);
-
-			if (c_file == NULL)
-				continue;
-
-			free(c_file);
-		}
-
-		g_list_free(sending_files);
-		sending_files = NULL;
-	}
+	_bt_lock(BT_LOCK_OPP);
+	__bt_opp_client_clear_files();
+	_bt_unlock(BT_LOCK_OPP);
 
 	return BT_ERROR_NONE;
 }
 
-int bt_opp_client_push_files(const char *remote_address,
+static int __bt_opp_client_push_files(bluetooth_device_address_t *addr_hex,
 			bt_opp_client_push_responded_cb responded_cb,
 			bt_opp_client_push_progress_cb progress_cb,
 			bt_opp_client_push_finished_cb finished_cb,
 			void *user_data)
 {
 	int error_code = BT_ERROR_NONE;
-	bluetooth_device_address_t addr_hex = { {0,} };
 	char **files = NULL;
 
-	BT_CHECK_INIT_STATUS();
-	BT_CHECK_INPUT_PARAMETER(remote_address);
-
-	_bt_convert_address_to_hex(&addr_hex, remote_address);
-
+	_bt_lock(BT_LOCK_OPP);
 	files = __bt_opp_get_file_array(sending_files);
 
-	error_code = _bt_get_error_code(bluetooth_opc_push_files(&addr_hex, files));
+	error_code = _bt_get_error_code(bluetooth_opc_push_files(addr_hex, files));
 
 	if (error_code != BT_ERROR_NONE) {
 		LOGE("[%s] %s(0x%08x)", __FUNCTION__, _bt_convert_error_to_string(error_code), error_code);
@@ -168,7 +176,8 @@ int bt_opp_client_push_files(const char *remote_address,
 		_bt_set_cb(BT_EVENT_OPP_CLIENT_PUSH_FINISHED, finished_cb, user_data);
 	}
 
-	bt_opp_client_clear_files();
+	__bt_opp_client_clear_files();
+	_bt_unlock(BT_LOCK_OPP);
 
 	if (files)
 		free(files);
@@ -176,13 +185,45 @@ int bt_opp_client_push_files(const char *remote_address,
 	return error_code;
 }
 
+int bt_opp_client_push_files(const char *remote_address,
+			bt_opp_client_push_responded_cb responded_cb,
+			bt_opp_client_push_progress_cb progress_cb,
+			bt_opp_client_push_finished_cb finished_cb,
+			void *user_data)
+{
+	bluetooth_device_address_t addr_hex = { {0,} };
+
+	BT_CHECK_INIT_STATUS();
+	BT_CHECK_INPUT_PARAMETER(remote_address);
+
+	BT_CHECK_ADDRESS_TO_HEX(&addr_hex, remote_address);
+	return __bt_opp_client_push_files(&addr_hex, responded_cb, progress_cb, finished_cb, user_data);
+}
+
+int bt_opp_client_push_files_by_addr(const bt_addr_t *remote_addr,
+			bt_opp_client_push_responded_cb responded_cb,
+			bt_opp_client_push_progress_cb progress_cb,
+			bt_opp_client_push_finished_cb finished_cb,
+			void *user_data)
+{
+	bluetooth_device_address_t addr_hex = { {0,} };
+
+	BT_CHECK_INIT_STATUS();
+	BT_CHECK_INPUT_PARAMETER(remote_addr);
+
+	_bt_convert_addr_to_hex(&addr_hex, remote_addr);
+	return __bt_opp_client_push_files(&addr_hex, responded_cb, progress_cb, finished_cb, user_data);
+}
+
 int bt_opp_client_cancel_push(void)
 {
 	int error_code = BT_ERROR_NONE;
 
 	BT_CHECK_INIT_STATUS();
 
+	_bt_lock(BT_LOCK_OPP);
 	error_code = _bt_get_error_code(bluetooth_opc_cancel_push());
+	_bt_unlock(BT_LOCK_OPP);
 
 	if (error_code != BT_ERROR_NONE) {
 		LOGE("[%s] %s(0x%08x)", __FUNCTION__, _bt_convert_error_to_string(error_code), error_code);
@@ -36,6 +36,7 @@ int bt_opp_server_initialize(const char *destination,
 	BT_CHECK_INIT_STATUS();
 	BT_CHECK_INPUT_PARAMETER(destination);
 
+	_bt_lock(BT_LOCK_OPP);
 	_bt_get_error_code(bluetooth_obex_server_init(destination));
 
 	if (error_code != BT_ERROR_NONE) {
@@ -43,6 +44,7 @@ int bt_opp_server_initialize(const char *destination,
 	} else {
 		_bt_set_cb(BT_EVENT_OPP_PUSH_REQUESTED, push_requested_cb, user_data);
 	}
+	_bt_unlock(BT_LOCK_OPP);
 
 	return error_code;
 }
@@ -56,6 +58,7 @@ int bt_opp_server_initialize_by_connection_request(const char *destination,
 	BT_CHECK_INIT_STATUS();
 	BT_CHECK_INPUT_PARAMETER(destination);
 
+	_bt_lock(BT_LOCK_OPP);
 	_bt_get_error_code(bluetooth_obex_server_init_without_agent(destination));
 
 	if (error_code != BT_ERROR_NONE) {
@@ -63,6 +66,7 @@ int bt_opp_server_initialize_by_connection_request(const char *destination,
 	} else {
 		_bt_set_cb(BT_EVENT_OPP_CONNECTION_REQUESTED, connection_requested_cb, user_data);
 	}
+	_bt_unlock(BT_LOCK_OPP);
 
 	return error_code;
 }
@@ -73,6 +77,7 @@ int bt_opp_server_deinitialize(void)
 
 	BT_CHECK_INIT_STATUS();
 
+	_bt_lock(BT_LOCK_OPP);
 	if (_bt_check_cb(BT_EVENT_OPP_CONNECTION_REQUESTED) == false) {
 		error_code = _bt_get_error_code(bluetooth_obex_server_deinit());
 	} else {
@@ -86,6 +91,7 @@ int bt_opp_server_deinitialize(void)
 
 	_bt_unset_cb(BT_EVENT_OPP_CONNECTION_REQUESTED);
 	_bt_unset_cb(BT_EVENT_OPP_PUSH_REQUESTED);
+	_bt_unlock(BT_LOCK_OPP);
 
 	return error_code;
 }
@@ -100,6 +106,7 @@ int bt_opp_server_accept(bt_opp_server_transfer_progress_cb progress_cb,
 
 	BT_CHECK_INIT_STATUS();
 
+	_bt_lock(BT_LOCK_OPP);
 	/* Unset the transfer callbacks */
 	_bt_unset_cb(BT_EVENT_OPP_SERVER_TRANSFER_PROGRESS);
 	_bt_unset_cb(BT_EVENT_OPP_SERVER_TRANSFER_FINISHED);
@@ -117,6 +124,7 @@ int bt_opp_server_accept(bt_opp_server_transfer_progress_cb progress_cb,
 		_bt_set_cb(BT_EVENT_OPP_SERVER_TRANSFER_PROGRESS, progress_cb, user_data);
 		_bt_set_cb(BT_EVENT_OPP_SERVER_TRANSFER_FINISHED, finished_cb, user_data);
 	}
+	_bt_unlock(BT_LOCK_OPP);
 
 	return error_code;
 }
@@ -127,6 +135,7 @@ int bt_opp_server_reject(void)
 
 	BT_CHECK_INIT_STATUS();
 
+	_bt_lock(BT_LOCK_OPP);
 	if (_bt_check_cb(BT_EVENT_OPP_CONNECTION_REQUESTED) == false) {
 		error_code = _bt_get_error_code(bluetooth_obex_server_reject_authorize());
 	} else {
@@ -141,6 +150,7 @@ int bt_opp_server_reject(void)
 	/* Unset the transfer callbacks */
 	_bt_unset_cb(BT_EVENT_OPP_SERVER_TRANSFER_PROGRESS);
 	_bt_unset_cb(BT_EVENT_OPP_SERVER_TRANSFER_FINISHED);
+	_bt_unlock(BT_LOCK_OPP);
 
 	return error_code;
 }
@@ -152,10 +162,12 @@ int bt_opp_server_set_destination(const char *destination)
 	BT_CHECK_INIT_STATUS();
 	BT_CHECK_INPUT_PARAMETER(destination);
 
+	_bt_lock(BT_LOCK_OPP);
 	error_code = _bt_get_error_code(bluetooth_obex_server_set_destination_path(destination));
 	if (error_code != BT_ERROR_NONE) {
 		LOGE("[%s] %s(0x%08x)", __FUNCTION__, _bt_convert_error_to_string(error_code), error_code);
 	}
+	_bt_unlock(BT_LOCK_OPP);
 
 	return error_code;
 }
@@ -166,10 +178,12 @@ int bt_opp_server_cancel_transfer(int transfer_id)
 
 	BT_CHECK_INIT_STATUS();
 
+	_bt_lock(BT_LOCK_OPP);
 	error_code = _bt_get_error_code(bluetooth_obex_server_cancel_transfer(transfer_id));
 	if (error_code != BT_ERROR_NONE) {
 		LOGE("[%s] %s(0x%08x)", __FUNCTION__, _bt_convert_error_to_string(error_code), error_code);
 	}
+	_bt_unlock(BT_LOCK_OPP);
 
 	return error_code;
 }
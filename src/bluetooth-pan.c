@@ -92,16 +92,12 @@ int bt_panu_unset_connection_state_changed_cb(void)
 	return BT_ERROR_NONE;
 }
 
-int bt_panu_connect(const char *remote_address, bt_panu_service_type_e type)
+static int __bt_panu_connect(bluetooth_device_address_t *addr_hex, bt_panu_service_type_e type)
 {
 	int error = BT_ERROR_INVALID_PARAMETER;
-	bluetooth_device_address_t addr_hex = { {0,} };
 
-	BT_CHECK_INIT_STATUS();
-	BT_CHECK_INPUT_PARAMETER(remote_address);
-	_bt_convert_address_to_hex(&addr_hex, remote_address);
 	if (BT_PANU_SERVICE_TYPE_NAP == type) {
-		error = bluetooth_network_connect(&addr_hex,
+		error = bluetooth_network_connect(addr_hex,
 					BLUETOOTH_NETWORK_NAP_ROLE, NULL);
 		error = _bt_get_error_code(error);
 		if (error != BT_ERROR_NONE) {
@@ -112,15 +108,31 @@ int bt_panu_connect(const char *remote_address, bt_panu_service_type_e type)
 	return error;
 }
 
-int bt_panu_disconnect(const char *remote_address)
+int bt_panu_connect(const char *remote_address, bt_panu_service_type_e type)
 {
-	int error = BT_ERROR_INVALID_PARAMETER;
 	bluetooth_device_address_t addr_hex = { {0,} };
 
 	BT_CHECK_INIT_STATUS();
 	BT_CHECK_INPUT_PARAMETER(remote_address);
-	_bt_convert_address_to_hex(&addr_hex, remote_address);
-	error = bluetooth_network_disconnect(&addr_hex);
+	BT_CHECK_ADDRESS_TO_HEX(&addr_hex, remote_address);
+	return __bt_panu_connect(&addr_hex, type);
+}
+
+int bt_panu_connect_by_addr(const bt_addr_t *remote_addr, bt_panu_service_type_e type)
+{
+	bluetooth_device_address_t addr_hex = { {0,} };
+
+	BT_CHECK_INIT_STATUS();
+	BT_CHECK_INPUT_PARAMETER(remote_addr);
+	_bt_convert_addr_to_hex(&addr_hex, remote_addr);
+	return __bt_panu_connect(&addr_hex, type);
+}
+
+static int __bt_panu_disconnect(bluetooth_device_address_t *addr_hex)
+{
+	int error = BT_ERROR_INVALID_PARAMETER;
+
+	error = bluetooth_network_disconnect(addr_hex);
 	error = _bt_get_error_code(error);
 	if (error != BT_ERROR_NONE) {
 		LOGE("[%s] %s(0x%08x)", __FUNCTION__,
@@ -129,3 +141,23 @@ int bt_panu_disconnect(const char *remote_address)
 	return error;
 }
 
+int bt_panu_disconnect(const char *remote_address)
+{
+	bluetooth_device_address_t addr_hex = { {0,} };
+
+	BT_CHECK_INIT_STATUS();
+	BT_CHECK_INPUT_PARAMETER(remote_address);
+	BT_CHECK_ADDRESS_TO_HEX(&addr_hex, remote_address);
+	return __bt_panu_disconnect(&addr_hex);
+}
+
+int bt_panu_disconnect_by_addr(const bt_addr_t *remote_addr)
+{
+	bluetooth_device_address_t addr_hex = { {0,} };
+
+	BT_CHECK_INIT_STATUS();
+	BT_CHECK_INPUT_PARAMETER(remote_addr);
+	_bt_convert_addr_to_hex(&addr_hex, remote_addr);
+	return __bt_panu_disconnect(&addr_hex);
+}
+
@@ -0,0 +1,615 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <glib.h>
+#include <dlog.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <bluetooth-api.h>
+
+#include "bluetooth.h"
+#include "bluetooth_private.h"
+
+#ifdef LOG_TAG
+#undef LOG_TAG
+#endif
+#define LOG_TAG "TIZEN_N_BLUETOOTH"
+
+/*
+ *  Proximity tracking
+ *
+ *  Each device found keeps its last RSSI samples in a ring and a smoothed RSSI, and sits in an
+ *  array ranked by the smoothed RSSI, strongest first. A new sample moves the device by
+ *  insertion, so the cost is the number of devices it overtakes, usually none or a few, and
+ *  the nearest devices are the head of the array. Each device has a bit per threshold it is
+ *  near of; the threshold callbacks are invoked without the lock, after the update. Devices
+ *  not found for the maximum age are removed by a sweep, which runs at most once per second.
+ */
+
+#define BT_PROXIMITY_MAX_THRESHOLDS 32
+#define BT_PROXIMITY_SWEEP_INTERVAL G_USEC_PER_SEC
+
+#define BT_PROXIMITY_DEFAULT_ALPHA 0.3
+#define BT_PROXIMITY_DEFAULT_PROCESS_NOISE 1.0 /* dB^2 per second */
+#define BT_PROXIMITY_DEFAULT_MEASUREMENT_NOISE 16.0 /* dB^2 */
+#define BT_PROXIMITY_DEFAULT_MAX_AGE 30000 /* milliseconds */
+
+typedef struct {
+	gint64 time; /* g_get_monotonic_time() */
+	int rssi;
+} bt_proximity_sample_s;
+
+typedef struct {
+	const char *remote_address; /* Interned, the key */
+	bt_proximity_sample_s samples[BT_PROXIMITY_HISTORY_SIZE];
+	int head; /* Index of the next sample */
+	int sample_count;
+	double estimate; /* Smoothed RSSI */
+	double variance; /* Of the estimate, for the Kalman filter */
+	int rank; /* Index in bt_proximity.ranked */
+	guint32 near; /* Bit of each threshold the device is near of */
+} bt_proximity_device_entry_s;
+
+typedef struct {
+	int id; /* 0 if the slot is free */
+	int rssi;
+	int hysteresis;
+	bt_proximity_threshold_crossed_cb callback;
+	void *user_data;
+} bt_proximity_threshold_s;
+
+typedef struct {
+	int threshold_id;
+	bool is_near;
+	bt_proximity_threshold_crossed_cb callback;
+	void *user_data;
+} bt_proximity_crossing_s;
+
+typedef struct {
+	const char *remote_address;
+	int rssi;
+	bt_proximity_crossing_s crossing;
+} bt_proximity_lost_s;
+
+static struct {
+	volatile gint running;
+	bt_proximity_config_s config;
+	GHashTable *devices; /* Interned address -> bt_proximity_device_entry_s */
+	bt_proximity_device_entry_s **ranked; /* Strongest first */
+	int count;
+	int capacity;
+	bt_proximity_threshold_s thresholds[BT_PROXIMITY_MAX_THRESHOLDS];
+	int last_threshold_id;
+	gint64 last_sweep;
+} bt_proximity;
+
+static GMutex bt_proximity_lock;
+
+static int __bt_proximity_round(double value)
+{
+	return (int)((value < 0) ? value - 0.5 : value + 0.5);
+}
+
+static void __bt_proximity_set_default_config(bt_proximity_config_s *config)
+{
+	config->smoothing = BT_PROXIMITY_SMOOTHING_KALMAN;
+	config->alpha = BT_PROXIMITY_DEFAULT_ALPHA;
+	config->process_noise = BT_PROXIMITY_DEFAULT_PROCESS_NOISE;
+	config->measurement_noise = BT_PROXIMITY_DEFAULT_MEASUREMENT_NOISE;
+	config->max_age = BT_PROXIMITY_DEFAULT_MAX_AGE;
+}
+
+/*
+ *  Must be called with bt_proximity_lock held.
+ */
+static void __bt_proximity_smooth(bt_proximity_device_entry_s *entry, int rssi, gint64 now)
+{
+	const bt_proximity_sample_s *last = NULL;
+	double elapsed = 0;
+	double gain = 0;
+
+	if (entry->sample_count == 0) {
+		entry->estimate = rssi;
+		entry->variance = bt_proximity.config.measurement_noise;
+		return;
+	}
+
+	if (bt_proximity.config.smoothing == BT_PROXIMITY_SMOOTHING_EWMA) {
+		entry->estimate += bt_proximity.config.alpha * (rssi - entry->estimate);
+		return;
+	}
+
+	/* The device may have moved since the last sample, more so as time passes */
+	last = &entry->samples[(entry->head + BT_PROXIMITY_HISTORY_SIZE - 1) % BT_PROXIMITY_HISTORY_SIZE];
+	elapsed = (double)(now - last->time) / G_USEC_PER_SEC;
+	entry->variance += bt_proximity.config.process_noise * elapsed;
+
+	gain = entry->variance / (entry->variance + bt_proximity.config.measurement_noise);
+	entry->estimate += gain * (rssi - entry->estimate);
+	entry->variance *= 1 - gain;
+}
+
+/*
+ *  Move a device to its rank after its estimate changed. Must be called with bt_proximity_lock held.
+ */
+static void __bt_proximity_rerank(bt_proximity_device_entry_s *entry)
+{
+	bt_proximity_device_entry_s **ranked = bt_proximity.ranked;
+	int i = entry->rank;
+
+	while (i > 0 && ranked[i - 1]->estimate < entry->estimate) {
+		ranked[i] = ranked[i - 1];
+		ranked[i]->rank = i;
+		i--;
+	}
+	while (i < bt_proximity.count - 1 && ranked[i + 1]->estimate > entry->estimate) {
+		ranked[i] = ranked[i + 1];
+		ranked[i]->rank = i;
+		i++;
+	}
+	ranked[i] = entry;
+	entry->rank = i;
+}
+
+/*
+ *  Must be called with bt_proximity_lock held.
+ */
+static bt_proximity_device_entry_s *__bt_proximity_add_device(const char *remote_address)
+{
+	bt_proximity_device_entry_s **ranked = NULL;
+	bt_proximity_device_entry_s *entry = NULL;
+	int capacity = 0;
+
+	if (bt_proximity.count == bt_proximity.capacity) {
+		capacity = (bt_proximity.capacity > 0) ? bt_proximity.capacity * 2 : 64;
+		ranked = realloc(bt_proximity.ranked, sizeof(bt_proximity_device_entry_s *) * capacity);
+		if (ranked == NULL)
+			return NULL;
+		bt_proximity.ranked = ranked;
+		bt_proximity.capacity = capacity;
+	}
+
+	entry = calloc(1, sizeof(bt_proximity_device_entry_s));
+	if (entry == NULL)
+		return NULL;
+
+	/* Ranked last, moved up by its first sample */
+	entry->remote_address = remote_address;
+	entry->rank = bt_proximity.count;
+	bt_proximity.ranked[bt_proximity.count++] = entry;
+	g_hash_table_insert(bt_proximity.devices, (gpointer)remote_address, entry);
+
+	return entry;
+}
+
+/*
+ *  Must be called with bt_proximity_lock held. The entry is not freed.
+ */
+static void __bt_proximity_remove_device(bt_proximity_device_entry_s *entry)
+{
+	int i;
+
+	for (i = entry->rank; i < bt_proximity.count - 1; i++) {
+		bt_proximity.ranked[i] = bt_proximity.ranked[i + 1];
+		bt_proximity.ranked[i]->rank = i;
+	}
+	bt_proximity.count--;
+	g_hash_table_remove(bt_proximity.devices, entry->remote_address);
+}
+
+/*
+ *  Must be called with bt_proximity_lock held.
+ */
+static int __bt_proximity_check_thresholds(bt_proximity_device_entry_s *entry, bt_proximity_crossing_s *crossings)
+{
+	bt_proximity_threshold_s *threshold = NULL;
+	guint32 bit = 0;
+	int count = 0;
+	int i;
+
+	for (i = 0; i < BT_PROXIMITY_MAX_THRESHOLDS; i++) {
+		threshold = &bt_proximity.thresholds[i];
+		if (threshold->id == 0)
+			continue;
+
+		bit = 1U << i;
+		if ((entry->near & bit) == 0 && entry->estimate >= threshold->rssi) {
+			entry->near |= bit;
+		} else if ((entry->near & bit) != 0 && entry->estimate < threshold->rssi - threshold->hysteresis) {
+			entry->near &= ~bit;
+		} else {
+			continue;
+		}
+
+		crossings[count].threshold_id = threshold->id;
+		crossings[count].is_near = (entry->near & bit) != 0;
+		crossings[count].callback = threshold->callback;
+		crossings[count].user_data = threshold->user_data;
+		count++;
+	}
+
+	return count;
+}
+
+/*
+ *  Remove the devices not found for the maximum age. Must be called with bt_proximity_lock held.
+ *  Returns the crossings away from the thresholds the removed devices were near of, for
+ *  __bt_proximity_report_lost().
+ */
+static GSList *__bt_proximity_sweep(gint64 now)
+{
+	bt_proximity_device_entry_s *entry = NULL;
+	const bt_proximity_sample_s *last = NULL;
+	bt_proximity_threshold_s *threshold = NULL;
+	bt_proximity_lost_s *crossing = NULL;
+	gint64 max_age = (gint64)bt_proximity.config.max_age * 1000;
+	GSList *lost = NULL;
+	int i;
+	int j;
+
+	if (now - bt_proximity.last_sweep < BT_PROXIMITY_SWEEP_INTERVAL)
+		return NULL;
+	bt_proximity.last_sweep = now;
+
+	for (i = bt_proximity.count - 1; i >= 0; i--) {
+		entry = bt_proximity.ranked[i];
+		last = &entry->samples[(entry->head + BT_PROXIMITY_HISTORY_SIZE - 1) % BT_PROXIMITY_HISTORY_SIZE];
+		if (now - last->time <= max_age)
+			continue;
+
+		__bt_proximity_remove_device(entry);
+
+		for (j = 0; j < BT_PROXIMITY_MAX_THRESHOLDS && entry->near != 0; j++) {
+			threshold = &bt_proximity.thresholds[j];
+			if (threshold->id == 0 || (entry->near & (1U << j)) == 0)
+				continue;
+
+			crossing = malloc(sizeof(bt_proximity_lost_s));
+			if (crossing == NULL) {
+				LOGE("[%s] OUT_OF_MEMORY(0x%08x)", __FUNCTION__, BT_ERROR_OUT_OF_MEMORY);
+				break;
+			}
+			crossing->remote_address = entry->remote_address;
+			crossing->rssi = __bt_proximity_round(entry->estimate);
+			crossing->crossing.threshold_id = threshold->id;
+			crossing->crossing.is_near = false;
+			crossing->crossing.callback = threshold->callback;
+			crossing->crossing.user_data = threshold->user_data;
+			lost = g_slist_prepend(lost, crossing);
+		}
+		free(entry);
+	}
+
+	return lost;
+}
+
+/*
+ *  Invoke the callbacks of the crossings of __bt_proximity_sweep(), then free them.
+ */
+static void __bt_proximity_report_lost(GSList *lost)
+{
+	bt_proximity_lost_s *crossing = NULL;
+	GSList *node = NULL;
+
+	for (node = lost; node != NULL; node = node->next) {
+		crossing = node->data;
+		crossing->crossing.callback(crossing->crossing.threshold_id, crossing->remote_address, crossing->rssi,
+				false, crossing->crossing.user_data);
+		free(crossing);
+	}
+	g_slist_free(lost);
+}
+
+static void __bt_proximity_fill_device(bt_proximity_device_s *device, const bt_proximity_device_entry_s *entry,
+		gint64 now)
+{
+	const bt_proximity_sample_s *last =
+			&entry->samples[(entry->head + BT_PROXIMITY_HISTORY_SIZE - 1) % BT_PROXIMITY_HISTORY_SIZE];
+
+	device->remote_address = entry->remote_address;
+	device->rssi = __bt_proximity_round(entry->estimate);
+	device->last_rssi = last->rssi;
+	device->sample_count = entry->sample_count;
+	device->age = (int)((now - last->time) / 1000);
+}
+
+static void __bt_proximity_free_devices(void)
+{
+	int i;
+
+	for (i = 0; i < bt_proximity.count; i++)
+		free(bt_proximity.ranked[i]);
+	free(bt_proximity.ranked);
+	bt_proximity.ranked = NULL;
+	bt_proximity.count = 0;
+	bt_proximity.capacity = 0;
+
+	if (bt_proximity.devices != NULL) {
+		g_hash_table_destroy(bt_proximity.devices);
+		bt_proximity.devices = NULL;
+	}
+}
+
+void _bt_proximity_update(const bluetooth_device_info_t *source_info)
+{
+	bt_proximity_crossing_s crossings[BT_PROXIMITY_MAX_THRESHOLDS];
+	bt_proximity_device_entry_s *entry = NULL;
+	const char *remote_address = NULL;
+	gint64 now = 0;
+	GSList *lost = NULL;
+	int count = 0;
+	int rssi = 0;
+	int i;
+
+	if (g_atomic_int_get(&bt_proximity.running) == FALSE)
+		return;
+
+	remote_address = _bt_intern_address(&source_info->device_address);
+	if (remote_address == NULL)
+		return;
+
+	rssi = source_info->rssi;
+	now = g_get_monotonic_time();
+
+	g_mutex_lock(&bt_proximity_lock);
+	if (bt_proximity.devices == NULL) {
+		g_mutex_unlock(&bt_proximity_lock);
+		return;
+	}
+
+	entry = g_hash_table_lookup(bt_proximity.devices, remote_address);
+	if (entry == NULL)
+		entry = __bt_proximity_add_device(remote_address);
+	if (entry == NULL) {
+		g_mutex_unlock(&bt_proximity_lock);
+		LOGE("[%s] OUT_OF_MEMORY(0x%08x)", __FUNCTION__, BT_ERROR_OUT_OF_MEMORY);
+		return;
+	}
+
+	__bt_proximity_smooth(entry, rssi, now);
+	entry->samples[entry->head].time = now;
+	entry->samples[entry->head].rssi = rssi;
+	entry->head = (entry->head + 1) % BT_PROXIMITY_HISTORY_SIZE;
+	if (entry->sample_count < BT_PROXIMITY_HISTORY_SIZE)
+		entry->sample_count++;
+
+	__bt_proximity_rerank(entry);
+	count = __bt_proximity_check_thresholds(entry, crossings);
+	rssi = __bt_proximity_round(entry->estimate);
+	lost = __bt_proximity_sweep(now);
+	g_mutex_unlock(&bt_proximity_lock);
+
+	for (i = 0; i < count; i++)
+		crossings[i].callback(crossings[i].threshold_id, remote_address, rssi,
+				crossings[i].is_near, crossings[i].user_data);
+
+	if (lost != NULL)
+		__bt_proximity_report_lost(lost);
+}
+
+void _bt_proximity_clear(void)
+{
+	g_mutex_lock(&bt_proximity_lock);
+	g_atomic_int_set(&bt_proximity.running, FALSE);
+	__bt_proximity_free_devices();
+	memset(bt_proximity.thresholds, 0x00, sizeof(bt_proximity.thresholds));
+	g_mutex_unlock(&bt_proximity_lock);
+}
+
+int bt_proximity_start(const bt_proximity_config_s *config)
+{
+	bt_proximity_config_s checked;
+
+	BT_CHECK_INIT_STATUS();
+
+	if (config != NULL) {
+		if ((config->smoothing != BT_PROXIMITY_SMOOTHING_EWMA && config->smoothing != BT_PROXIMITY_SMOOTHING_KALMAN) ||
+				config->alpha <= 0 || config->alpha > 1 || config->process_noise < 0 ||
+				config->measurement_noise <= 0 || config->max_age <= 0) {
+			LOGE("[%s] INVALID_PARAMETER(0x%08x)", __FUNCTION__, BT_ERROR_INVALID_PARAMETER);
+			return BT_ERROR_INVALID_PARAMETER;
+		}
+		checked = *config;
+	} else {
+		__bt_proximity_set_default_config(&checked);
+	}
+
+	g_mutex_lock(&bt_proximity_lock);
+	if (bt_proximity.devices != NULL) {
+		g_mutex_unlock(&bt_proximity_lock);
+		LOGE("[%s] NOW_IN_PROGRESS(0x%08x)", __FUNCTION__, BT_ERROR_NOW_IN_PROGRESS);
+		return BT_ERROR_NOW_IN_PROGRESS;
+	}
+
+	bt_proximity.devices = g_hash_table_new(g_direct_hash, g_direct_equal);
+	bt_proximity.config = checked;
+	bt_proximity.last_sweep = g_get_monotonic_time();
+	g_atomic_int_set(&bt_proximity.running, TRUE);
+	g_mutex_unlock(&bt_proximity_lock);
+
+	return BT_ERROR_NONE;
+}
+
+int bt_proximity_stop(void)
+{
+	BT_CHECK_INIT_STATUS();
+
+	g_mutex_lock(&bt_proximity_lock);
+	if (bt_proximity.devices == NULL) {
+		g_mutex_unlock(&bt_proximity_lock);
+		LOGE("[%s] NOT_IN_PROGRESS(0x%08x)", __FUNCTION__, BT_ERROR_NOT_IN_PROGRESS);
+		return BT_ERROR_NOT_IN_PROGRESS;
+	}
+
+	g_atomic_int_set(&bt_proximity.running, FALSE);
+	__bt_proximity_free_devices();
+	g_mutex_unlock(&bt_proximity_lock);
+
+	return BT_ERROR_NONE;
+}
+
+int bt_proximity_get_top_n(int n, bt_proximity_device_s *devices, int *count)
+{
+	gint64 now = g_get_monotonic_time();
+	GSList *lost = NULL;
+	int i;
+
+	BT_CHECK_INIT_STATUS();
+	BT_CHECK_INPUT_PARAMETER(devices);
+	BT_CHECK_INPUT_PARAMETER(count);
+	if (n <= 0) {
+		LOGE("[%s] INVALID_PARAMETER(0x%08x)", __FUNCTION__, BT_ERROR_INVALID_PARAMETER);
+		return BT_ERROR_INVALID_PARAMETER;
+	}
+
+	g_mutex_lock(&bt_proximity_lock);
+	if (bt_proximity.devices == NULL) {
+		g_mutex_unlock(&bt_proximity_lock);
+		LOGE("[%s] NOT_IN_PROGRESS(0x%08x)", __FUNCTION__, BT_ERROR_NOT_IN_PROGRESS);
+		return BT_ERROR_NOT_IN_PROGRESS;
+	}
+
+	lost = __bt_proximity_sweep(now);
+	*count = MIN(n, bt_proximity.count);
+	for (i = 0; i < *count; i++)
+		__bt_proximity_fill_device(&devices[i], bt_proximity.ranked[i], now);
+	g_mutex_unlock(&bt_proximity_lock);
+
+	if (lost != NULL)
+		__bt_proximity_report_lost(lost);
+
+	return BT_ERROR_NONE;
+}
+
+int bt_proximity_get_device(const char *remote_address, bt_proximity_device_s *device,
+		int *history, int history_size, int *history_count)
+{
+	bluetooth_device_address_t addr_hex = { {0,} };
+	bt_proximity_device_entry_s *entry = NULL;
+	const char *address = NULL;
+	gint64 now = g_get_monotonic_time();
+	int first = 0;
+	int i;
+
+	BT_CHECK_INIT_STATUS();
+	BT_CHECK_INPUT_PARAMETER(remote_address);
+	BT_CHECK_INPUT_PARAMETER(device);
+	BT_CHECK_ADDRESS_TO_HEX(&addr_hex, remote_address);
+	if (history_size < 0 || (history_size > 0 && (history == NULL || history_count == NULL))) {
+		LOGE("[%s] INVALID_PARAMETER(0x%08x)", __FUNCTION__, BT_ERROR_INVALID_PARAMETER);
+		return BT_ERROR_INVALID_PARAMETER;
+	}
+
+	address = _bt_intern_address(&addr_hex);
+	if (address == NULL) {
+		LOGE("[%s] OUT_OF_MEMORY(0x%08x)", __FUNCTION__, BT_ERROR_OUT_OF_MEMORY);
+		return BT_ERROR_OUT_OF_MEMORY;
+	}
+
+	g_mutex_lock(&bt_proximity_lock);
+	if (bt_proximity.devices == NULL) {
+		g_mutex_unlock(&bt_proximity_lock);
+		LOGE("[%s] NOT_IN_PROGRESS(0x%08x)", __FUNCTION__, BT_ERROR_NOT_IN_PROGRESS);
+		return BT_ERROR_NOT_IN_PROGRESS;
+	}
+
+	entry = g_hash_table_lookup(bt_proximity.devices, address);
+	if (entry == NULL) {
+		g_mutex_unlock(&bt_proximity_lock);
+		return BT_ERROR_REMOTE_DEVICE_NOT_FOUND;
+	}
+
+	__bt_proximity_fill_device(device, entry, now);
+
+	/* The most recent samples, oldest first */
+	if (history_size > 0) {
+		*history_count = MIN(history_size, entry->sample_count);
+		first = entry->head + BT_PROXIMITY_HISTORY_SIZE - *history_count;
+		for (i = 0; i < *history_count; i++)
+			history[i] = entry->samples[(first + i) % BT_PROXIMITY_HISTORY_SIZE].rssi;
+	}
+	g_mutex_unlock(&bt_proximity_lock);
+
+	return BT_ERROR_NONE;
+}
+
+int bt_proximity_add_threshold(int rssi, int hysteresis, bt_proximity_threshold_crossed_cb callback,
+		void *user_data, int *threshold_id)
+{
+	bt_proximity_threshold_s *threshold = NULL;
+	int i;
+
+	BT_CHECK_INIT_STATUS();
+	BT_CHECK_INPUT_PARAMETER(callback);
+	BT_CHECK_INPUT_PARAMETER(threshold_id);
+	if (rssi > 0 || hysteresis < 0) {
+		LOGE("[%s] INVALID_PARAMETER(0x%08x)", __FUNCTION__, BT_ERROR_INVALID_PARAMETER);
+		return BT_ERROR_INVALID_PARAMETER;
+	}
+
+	g_mutex_lock(&bt_proximity_lock);
+	for (i = 0; i < BT_PROXIMITY_MAX_THRESHOLDS && threshold == NULL; i++) {
+		if (bt_proximity.thresholds[i].id == 0)
+			threshold = &bt_proximity.thresholds[i];
+	}
+	if (threshold == NULL) {
+		g_mutex_unlock(&bt_proximity_lock);
+		LOGE("[%s] RESOURCE_BUSY(0x%08x)", __FUNCTION__, BT_ERROR_RESOURCE_BUSY);
+		return BT_ERROR_RESOURCE_BUSY;
+	}
+
+	if (++bt_proximity.last_threshold_id <= 0)
+		bt_proximity.last_threshold_id = 1;
+	threshold->id = bt_proximity.last_threshold_id;
+	threshold->rssi = rssi;
+	threshold->hysteresis = hysteresis;
+	threshold->callback = callback;
+	threshold->user_data = user_data;
+	*threshold_id = threshold->id;
+	g_mutex_unlock(&bt_proximity_lock);
+
+	return BT_ERROR_NONE;
+}
+
+int bt_proximity_remove_threshold(int threshold_id)
+{
+	guint32 bit = 0;
+	int i;
+
+	BT_CHECK_INIT_STATUS();
+
+	g_mutex_lock(&bt_proximity_lock);
+	for (i = 0; i < BT_PROXIMITY_MAX_THRESHOLDS; i++) {
+		if (threshold_id > 0 && bt_proximity.thresholds[i].id == threshold_id)
+			break;
+	}
+	if (i == BT_PROXIMITY_MAX_THRESHOLDS) {
+		g_mutex_unlock(&bt_proximity_lock);
+		LOGE("[%s] INVALID_PARAMETER(0x%08x)", __FUNCTION__, BT_ERROR_INVALID_PARAMETER);
+		return BT_ERROR_INVALID_PARAMETER;
+	}
+
+	/* The slot may be reused, so no device stays near of it */
+	bt_proximity.thresholds[i].id = 0;
+	bit = 1U << i;
+	for (i = 0; i < bt_proximity.count; i++)
+		bt_proximity.ranked[i]->near &= ~bit;
+	g_mutex_unlock(&bt_proximity_lock);
+
+	return BT_ERROR_NONE;
+}
@@ -0,0 +1,404 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <glib.h>
+#include <dlog.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <bluetooth-api.h>
+
+#include "bluetooth.h"
+#include "bluetooth_private.h"
+
+#ifdef LOG_TAG
+#undef LOG_TAG
+#endif
+#define LOG_TAG "TIZEN_N_BLUETOOTH"
+
+/*
+ *  Service cache
+ *
+ *  The services found by the searches are kept in a file of fixed size records, with the UUIDs
+ *  in binary, shared by the processes of the user through a mapping. A writer holds the lock of
+ *  the file. A reader takes no lock: it copies the record, and retries if the sequence of the
+ *  record was odd, as while it is written, or has changed meanwhile.
+ */
+
+#define BT_SDP_CACHE_MAGIC 0x43445342 /* "BSDC" */
+#define BT_SDP_CACHE_VERSION 2
+#define BT_SDP_CACHE_DEVICES 64
+#define BT_SDP_CACHE_READ_RETRIES 8
+#define BT_SDP_CACHE_MAX_AGE_DEFAULT (7 * 24 * 60 * 60)
+#define BT_SDP_CACHE_DIRECTORY "capi-network-bluetooth"
+#define BT_SDP_CACHE_FILE "sdp-cache"
+
+typedef struct {
+	guint32 magic;
+	guint32 version;
+	guint32 record_size;
+	guint32 record_count;
+} bt_sdp_cache_header_s;
+
+typedef struct {
+	gint sequence; /* Odd while the record is written */
+	guint8 address[BLUETOOTH_ADDRESS_LENGTH];
+	guint8 service_count;
+	guint8 reserved;
+	gint64 searched; /* Real time in seconds, 0 if the record is free */
+	bt_uuid_s uuids[BLUETOOTH_MAX_SERVICES_FOR_DEVICE];
+	guint8 uuid_lengths[BLUETOOTH_MAX_SERVICES_FOR_DEVICE]; /* Digits of the form the F/W reported each UUID in */
+} bt_sdp_cache_record_s;
+
+typedef struct {
+	bt_sdp_cache_header_s header;
+	bt_sdp_cache_record_s records[BT_SDP_CACHE_DEVICES];
+} bt_sdp_cache_file_s;
+
+static GMutex bt_sdp_cache_lock;
+static bt_sdp_cache_file_s *bt_sdp_cache = NULL;
+static int bt_sdp_cache_fd = -1;
+static int bt_sdp_cache_max_age = BT_SDP_CACHE_MAX_AGE_DEFAULT;
+
+static gint64 __bt_sdp_cache_now(void)
+{
+	return g_get_real_time() / G_USEC_PER_SEC;
+}
+
+/*
+ *  Must be called with bt_sdp_cache_lock held.
+ */
+static bool __bt_sdp_cache_read(bt_sdp_cache_record_s *record, bt_sdp_cache_record_s *copy)
+{
+	gint sequence;
+	int i;
+
+	for (i = 0; i < BT_SDP_CACHE_READ_RETRIES; i++) {
+		sequence = g_atomic_int_get(&record->sequence);
+		if (sequence & 1)
+			continue;
+
+		memcpy(copy, record, sizeof(bt_sdp_cache_record_s));
+		if (g_atomic_int_get(&record->sequence) == sequence)
+			return true;
+	}
+
+	return false;
+}
+
+/*
+ *  Must be called with bt_sdp_cache_lock and the lock of the file held.
+ */
+static void __bt_sdp_cache_write(bt_sdp_cache_record_s *record, const bluetooth_device_address_t *address,
+		const bt_uuid_s *uuids, const guint8 *uuid_lengths, int count, gint64 searched)
+{
+	/* Odd even if a writer died in the middle of the record */
+	guint sequence = (guint)g_atomic_int_get(&record->sequence) | 1;
+
+	g_atomic_int_set(&record->sequence, (gint)(sequence & G_MAXINT));
+	memcpy(record->address, address->addr, BLUETOOTH_ADDRESS_LENGTH);
+	record->service_count = count;
+	record->searched = searched;
+	if (count > 0) {
+		memcpy(record->uuids, uuids, sizeof(bt_uuid_s) * count);
+		memcpy(record->uuid_lengths, uuid_lengths, count);
+	}
+	g_atomic_int_set(&record->sequence, (gint)((sequence + 1) & G_MAXINT));
+}
+
+/*
+ *  Must be called with bt_sdp_cache_lock held, and bt_sdp_cache mapped.
+ */
+static void __bt_sdp_cache_store(const bluetooth_device_address_t *address, const bt_uuid_s *uuids,
+		const guint8 *uuid_lengths, int count)
+{
+	bt_sdp_cache_record_s *record = NULL;
+	bt_sdp_cache_record_s *oldest = NULL;
+	bt_sdp_cache_record_s *free_record = NULL;
+	int i;
+
+	if (flock(bt_sdp_cache_fd, LOCK_EX) != 0) {
+		LOGE("[%s] flock: %s", __FUNCTION__, strerror(errno));
+		return;
+	}
+
+	for (i = 0; i < BT_SDP_CACHE_DEVICES; i++) {
+		record = &bt_sdp_cache->records[i];
+		if (record->searched == 0) {
+			if (free_record == NULL)
+				free_record = record;
+			continue;
+		}
+		if (memcmp(record->address, address->addr, BLUETOOTH_ADDRESS_LENGTH) == 0)
+			break;
+		if (oldest == NULL || record->searched < oldest->searched)
+			oldest = record;
+	}
+
+	if (i == BT_SDP_CACHE_DEVICES) {
+		/* A device not cached has nothing to forget, and a new one replaces the oldest if full */
+		if (count < 0) {
+			flock(bt_sdp_cache_fd, LOCK_UN);
+			return;
+		}
+		record = (free_record != NULL) ? free_record : oldest;
+	}
+
+	if (count < 0)
+		__bt_sdp_cache_write(record, address, NULL, NULL, 0, 0);
+	else
+		__bt_sdp_cache_write(record, address, uuids, uuid_lengths, count, __bt_sdp_cache_now());
+
+	flock(bt_sdp_cache_fd, LOCK_UN);
+}
+
+void _bt_sdp_cache_open(void)
+{
+	const bt_sdp_cache_header_s header = {
+		BT_SDP_CACHE_MAGIC, BT_SDP_CACHE_VERSION, sizeof(bt_sdp_cache_record_s), BT_SDP_CACHE_DEVICES
+	};
+	bt_sdp_cache_header_s current;
+	struct stat file_stat;
+	char *directory = NULL;
+	char *path = NULL;
+	void *map = MAP_FAILED;
+	int fd = -1;
+
+	g_mutex_lock(&bt_sdp_cache_lock);
+	if (bt_sdp_cache != NULL) {
+		g_mutex_unlock(&bt_sdp_cache_lock);
+		return;
+	}
+
+	directory = g_build_filename(g_get_user_cache_dir(), BT_SDP_CACHE_DIRECTORY, NULL);
+	path = g_build_filename(directory, BT_SDP_CACHE_FILE, NULL);
+	if (g_mkdir_with_parents(directory, 0700) != 0)
+		goto fail;
+
+	fd = open(path, O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+	if (fd < 0 || flock(fd, LOCK_EX) != 0)
+		goto fail;
+
+	/* A new file, or one of another layout, is reset */
+	if (fstat(fd, &file_stat) != 0) {
+		flock(fd, LOCK_UN);
+		goto fail;
+	}
+	if (file_stat.st_size != sizeof(bt_sdp_cache_file_s) ||
+			pread(fd, &current, sizeof(current), 0) != sizeof(current) ||
+			memcmp(&current, &header, sizeof(header)) != 0) {
+		if (ftruncate(fd, 0) != 0 || ftruncate(fd, sizeof(bt_sdp_cache_file_s)) != 0 ||
+				pwrite(fd, &header, sizeof(header), 0) != sizeof(header)) {
+			flock(fd, LOCK_UN);
+			goto fail;
+		}
+	}
+	flock(fd, LOCK_UN);
+
+	map = mmap(NULL, sizeof(bt_sdp_cache_file_s), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	if (map == MAP_FAILED)
+		goto fail;
+
+	bt_sdp_cache = map;
+	bt_sdp_cache_fd = fd;
+	g_mutex_unlock(&bt_sdp_cache_lock);
+
+	g_free(path);
+	g_free(directory);
+	return;
+
+fail:
+	LOGE("[%s] %s: %s, the services are not cached", __FUNCTION__, path, strerror(errno));
+	g_mutex_unlock(&bt_sdp_cache_lock);
+	if (fd >= 0)
+		close(fd);
+	g_free(path);
+	g_free(directory);
+}
+
+void _bt_sdp_cache_close(void)
+{
+	g_mutex_lock(&bt_sdp_cache_lock);
+	if (bt_sdp_cache != NULL) {
+		munmap(bt_sdp_cache, sizeof(bt_sdp_cache_file_s));
+		close(bt_sdp_cache_fd);
+		bt_sdp_cache = NULL;
+		bt_sdp_cache_fd = -1;
+	}
+	g_mutex_unlock(&bt_sdp_cache_lock);
+}
+
+void _bt_sdp_cache_update(int event, bluetooth_event_param_t *param)
+{
+	bt_uuid_s uuids[BLUETOOTH_MAX_SERVICES_FOR_DEVICE];
+	guint8 uuid_lengths[BLUETOOTH_MAX_SERVICES_FOR_DEVICE];
+	bt_sdp_info_t *source = NULL;
+	int count = 0;
+	int i;
+
+	switch (event) {
+	case BLUETOOTH_EVENT_SERVICE_SEARCHED:
+		source = param->param_data;
+		if (param->result != BLUETOOTH_ERROR_NONE || source == NULL)
+			return;
+
+		/* Parsed before the lock is taken */
+		for (i = 0; i < source->service_index && i < BLUETOOTH_MAX_SERVICES_FOR_DEVICE; i++) {
+			if (_bt_parse_uuid(source->uuids[i], &uuids[count]) == true)
+				uuid_lengths[count++] = strnlen(source->uuids[i], BT_UUID_STR_LEN);
+		}
+
+		g_mutex_lock(&bt_sdp_cache_lock);
+		if (bt_sdp_cache != NULL)
+			__bt_sdp_cache_store(&source->device_addr, uuids, uuid_lengths, count);
+		g_mutex_unlock(&bt_sdp_cache_lock);
+		break;
+	case BLUETOOTH_EVENT_BONDED_DEVICE_REMOVED:
+		if (param->param_data == NULL)
+			return;
+
+		g_mutex_lock(&bt_sdp_cache_lock);
+		if (bt_sdp_cache != NULL)
+			__bt_sdp_cache_store(param->param_data, NULL, NULL, -1);
+		g_mutex_unlock(&bt_sdp_cache_lock);
+		break;
+	default:
+		break;
+	}
+}
+
+int _bt_sdp_cache_get(const bluetooth_device_address_t *address, bt_device_sdp_info_s **sdp_info, int *age)
+{
+	bt_sdp_cache_record_s *record = NULL;
+	bt_sdp_cache_record_s copy;
+	bt_device_sdp_info_s *info = NULL;
+	gint64 elapsed = 0;
+	int max_age = 0;
+	int i;
+
+	g_mutex_lock(&bt_sdp_cache_lock);
+	max_age = bt_sdp_cache_max_age;
+	if (bt_sdp_cache == NULL || max_age == 0) {
+		g_mutex_unlock(&bt_sdp_cache_lock);
+		return BT_ERROR_REMOTE_DEVICE_NOT_FOUND;
+	}
+
+	/* The address of a record is checked again in its consistent copy */
+	for (i = 0; i < BT_SDP_CACHE_DEVICES; i++) {
+		record = &bt_sdp_cache->records[i];
+		if (memcmp(record->address, address->addr, BLUETOOTH_ADDRESS_LENGTH) == 0 &&
+				__bt_sdp_cache_read(record, &copy) == true &&
+				memcmp(copy.address, address->addr, BLUETOOTH_ADDRESS_LENGTH) == 0)
+			break;
+	}
+	g_mutex_unlock(&bt_sdp_cache_lock);
+
+	if (i == BT_SDP_CACHE_DEVICES || copy.searched == 0 ||
+			copy.service_count > BLUETOOTH_MAX_SERVICES_FOR_DEVICE)
+		return BT_ERROR_REMOTE_DEVICE_NOT_FOUND;
+
+	/* A search in the future of a clock set back is stale as well */
+	elapsed = __bt_sdp_cache_now() - copy.searched;
+	if (elapsed < 0 || elapsed > max_age)
+		return BT_ERROR_REMOTE_DEVICE_NOT_FOUND;
+
+	/* The copy shares the interned strings, and owns the UUID table */
+	info = malloc(sizeof(bt_device_sdp_info_s) + sizeof(char *) * copy.service_count);
+	if (info == NULL)
+		return BT_ERROR_OUT_OF_MEMORY;
+
+	info->remote_address = (char *)_bt_intern_address(address);
+	info->service_uuid = (copy.service_count > 0) ? (char **)(info + 1) : NULL;
+	info->service_count = copy.service_count;
+	if (info->remote_address == NULL) {
+		free(info);
+		return BT_ERROR_OUT_OF_MEMORY;
+	}
+	for (i = 0; i < copy.service_count; i++) {
+		info->service_uuid[i] = (char *)_bt_intern_uuid(&copy.uuids[i], copy.uuid_lengths[i]);
+		if (info->service_uuid[i] == NULL) {
+			free(info);
+			return BT_ERROR_OUT_OF_MEMORY;
+		}
+	}
+
+	if (age != NULL)
+		*age = (int)elapsed;
+	*sdp_info = info;
+
+	return BT_ERROR_NONE;
+}
+
+int bt_device_get_cached_services(const char *remote_address, bt_device_sdp_info_s **sdp_info, int *age)
+{
+	bluetooth_device_address_t addr_hex = { {0,} };
+	int error_code = BT_ERROR_NONE;
+
+	BT_CHECK_INIT_STATUS();
+	BT_CHECK_INPUT_PARAMETER(remote_address);
+	BT_CHECK_INPUT_PARAMETER(sdp_info);
+	BT_CHECK_ADDRESS_TO_HEX(&addr_hex, remote_address);
+
+	error_code = _bt_sdp_cache_get(&addr_hex, sdp_info, age);
+	if (error_code == BT_ERROR_OUT_OF_MEMORY)
+		LOGE("[%s] OUT_OF_MEMORY(0x%08x)", __FUNCTION__, BT_ERROR_OUT_OF_MEMORY);
+
+	return error_code;
+}
+
+int bt_device_free_cached_services(bt_device_sdp_info_s *sdp_info)
+{
+	BT_CHECK_INIT_STATUS();
+	BT_CHECK_INPUT_PARAMETER(sdp_info);
+
+	free(sdp_info);
+
+	return BT_ERROR_NONE;
+}
+
+int bt_device_set_cached_services_max_age(int max_age)
+{
+	BT_CHECK_INIT_STATUS();
+	if (max_age < 0) {
+		LOGE("[%s] INVALID_PARAMETER(0x%08x)", __FUNCTION__, BT_ERROR_INVALID_PARAMETER);
+		return BT_ERROR_INVALID_PARAMETER;
+	}
+
+	g_mutex_lock(&bt_sdp_cache_lock);
+	bt_sdp_cache_max_age = max_age;
+	g_mutex_unlock(&bt_sdp_cache_lock);
+
+	return BT_ERROR_NONE;
+}
+
+int bt_device_get_cached_services_max_age(int *max_age)
+{
+	BT_CHECK_INIT_STATUS();
+	BT_CHECK_INPUT_PARAMETER(max_age);
+
+	g_mutex_lock(&bt_sdp_cache_lock);
+	*max_age = bt_sdp_cache_max_age;
+	g_mutex_unlock(&bt_sdp_cache_lock);
+
+	return BT_ERROR_NONE;
+}
@@ -0,0 +1,336 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <glib.h>
+#include <dlog.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <bluetooth-api.h>
+
+#include "bluetooth.h"
+#include "bluetooth_private.h"
+
+#ifdef LOG_TAG
+#undef LOG_TAG
+#endif
+#define LOG_TAG "TIZEN_N_BLUETOOTH"
+
+/*
+ *  Service search queue
+ *
+ *  The F/W runs one service search at a time, so the queued searches are started one after
+ *  the other, each as soon as the result of the previous one arrives. A request for a device
+ *  already queued or being searched joins that search. If the F/W is busy with a search not
+ *  started by the queue, the queue waits for its result.
+ */
+
+typedef struct {
+	bt_device_service_searched_cb callback;
+	void *user_data;
+} bt_sdp_waiter_s;
+
+typedef struct {
+	bluetooth_device_address_t address;
+	const char *remote_address; /* Interned */
+	gint64 queued; /* g_get_monotonic_time() */
+	GSList *waiters; /* Most recent first */
+} bt_sdp_request_s;
+
+static GMutex bt_sdp_queue_lock;
+static GQueue bt_sdp_queue = G_QUEUE_INIT; /* Waiting requests, oldest first */
+static GHashTable *bt_sdp_requests = NULL; /* Waiting and running requests by interned address */
+static bt_sdp_request_s *bt_sdp_running = NULL;
+static bt_device_service_search_queue_stats_s bt_sdp_queue_stats;
+static gint64 bt_sdp_total_wait = 0;
+
+static void __bt_sdp_request_finish(bt_sdp_request_s *request, int result, bt_sdp_info_t *source)
+{
+	bt_device_sdp_info_s empty_info = { (char *)request->remote_address, NULL, 0 };
+	bt_device_sdp_info_s *sdp_info = &empty_info;
+	bt_sdp_waiter_s *waiter = NULL;
+	bt_arena_s *arena = NULL;
+	bt_arena_mark_s mark;
+	GSList *node = NULL;
+
+	if (result != BT_ERROR_NONE)
+		LOGE("[%s] %s %s(0x%08x)", __FUNCTION__, request->remote_address, _bt_convert_error_to_string(result), result);
+
+	arena = _bt_arena_get_thread_arena();
+	if (arena != NULL)
+		_bt_arena_get_mark(arena, &mark);
+	if (source != NULL && arena != NULL &&
+			_bt_get_bt_device_sdp_info_s(&sdp_info, source, arena) != BT_ERROR_NONE) {
+		LOGE("[%s] OUT_OF_MEMORY(0x%08x)", __FUNCTION__, BT_ERROR_OUT_OF_MEMORY);
+		sdp_info = &empty_info;
+		result = BT_ERROR_OUT_OF_MEMORY;
+	}
+
+	/* In the order of the requests */
+	request->waiters = g_slist_reverse(request->waiters);
+	for (node = request->waiters; node != NULL; node = node->next) {
+		waiter = node->data;
+		waiter->callback(result, sdp_info, waiter->user_data);
+		free(waiter);
+	}
+
+	if (arena != NULL)
+		_bt_arena_rewind(arena, &mark);
+	g_slist_free(request->waiters);
+	free(request);
+}
+
+/*
+ *  Must be called with bt_sdp_queue_lock held.
+ */
+static void __bt_sdp_queue_account(gint64 wait, int searches)
+{
+	bt_sdp_total_wait += wait;
+	bt_sdp_queue_stats.searches += searches;
+	bt_sdp_queue_stats.wait_avg = (bt_sdp_queue_stats.searches > 0) ?
+			(int)(bt_sdp_total_wait / (gint64)bt_sdp_queue_stats.searches) : 0;
+	if (wait > bt_sdp_queue_stats.wait_max)
+		bt_sdp_queue_stats.wait_max = (int)wait;
+}
+
+/*
+ *  Start the searches, until one is running or the queue is empty.
+ */
+static void __bt_sdp_queue_start(void)
+{
+	bt_sdp_request_s *request = NULL;
+	gint64 wait = 0;
+	int error_code = BT_ERROR_NONE;
+
+	while (true) {
+		g_mutex_lock(&bt_sdp_queue_lock);
+		if (bt_sdp_running != NULL || g_queue_is_empty(&bt_sdp_queue)) {
+			g_mutex_unlock(&bt_sdp_queue_lock);
+			return;
+		}
+
+		/* Running before the request is sent, so its result cannot be missed */
+		request = g_queue_pop_head(&bt_sdp_queue);
+		bt_sdp_running = request;
+		bt_sdp_queue_stats.depth = g_queue_get_length(&bt_sdp_queue);
+		wait = (g_get_monotonic_time() - request->queued) / 1000;
+		__bt_sdp_queue_account(wait, 1);
+		g_mutex_unlock(&bt_sdp_queue_lock);
+
+		error_code = _bt_get_error_code(bluetooth_search_service(&request->address));
+
+		g_mutex_lock(&bt_sdp_queue_lock);
+		if (bt_sdp_running != request) {
+			/* Already completed by its result, or cancelled */
+			g_mutex_unlock(&bt_sdp_queue_lock);
+			continue;
+		}
+
+		if (error_code == BT_ERROR_NOW_IN_PROGRESS) {
+			/* Busy with another search, retried when its result arrives */
+			__bt_sdp_queue_account(-wait, -1);
+			bt_sdp_running = NULL;
+			g_queue_push_head(&bt_sdp_queue, request);
+			bt_sdp_queue_stats.depth = g_queue_get_length(&bt_sdp_queue);
+			g_mutex_unlock(&bt_sdp_queue_lock);
+			return;
+		}
+
+		if (error_code == BT_ERROR_NONE) {
+			g_mutex_unlock(&bt_sdp_queue_lock);
+			return;
+		}
+
+		bt_sdp_running = NULL;
+		g_hash_table_remove(bt_sdp_requests, request->remote_address);
+		g_mutex_unlock(&bt_sdp_queue_lock);
+
+		__bt_sdp_request_finish(request, error_code, NULL);
+	}
+}
+
+void _bt_sdp_queue_update(int event, bluetooth_event_param_t *param)
+{
+	bt_sdp_request_s *request = NULL;
+	bt_sdp_info_t *source = NULL;
+	GQueue failed = G_QUEUE_INIT;
+	int result = BT_ERROR_NONE;
+
+	g_mutex_lock(&bt_sdp_queue_lock);
+	if (bt_sdp_running == NULL && g_queue_is_empty(&bt_sdp_queue)) {
+		g_mutex_unlock(&bt_sdp_queue_lock);
+		return;
+	}
+
+	switch (event) {
+	case BLUETOOTH_EVENT_SERVICE_SEARCHED:
+		source = param->param_data;
+		result = _bt_get_error_code(param->result);
+		/* A result without the address is taken as the result of the running search */
+		if (bt_sdp_running != NULL && (source == NULL ||
+				memcmp(&source->device_addr, &bt_sdp_running->address, sizeof(bluetooth_device_address_t)) == 0))
+			request = bt_sdp_running;
+		break;
+	case BLUETOOTH_EVENT_SERVICE_SEARCH_CANCELLED:
+		request = bt_sdp_running;
+		result = BT_ERROR_CANCELLED;
+		break;
+	case BLUETOOTH_EVENT_DISABLED:
+		request = bt_sdp_running;
+		result = BT_ERROR_NOT_ENABLED;
+		failed = bt_sdp_queue;
+		g_queue_init(&bt_sdp_queue);
+		g_hash_table_remove_all(bt_sdp_requests);
+		bt_sdp_queue_stats.depth = 0;
+		break;
+	default:
+		break;
+	}
+
+	if (request != NULL) {
+		bt_sdp_running = NULL;
+		g_hash_table_remove(bt_sdp_requests, request->remote_address);
+	}
+	g_mutex_unlock(&bt_sdp_queue_lock);
+
+	if (request != NULL)
+		__bt_sdp_request_finish(request, result, (result == BT_ERROR_NONE) ? source : NULL);
+
+	while ((request = g_queue_pop_head(&failed)) != NULL)
+		__bt_sdp_request_finish(request, result, NULL);
+
+	__bt_sdp_queue_start();
+}
+
+void _bt_sdp_queue_cancel_all(void)
+{
+	bt_sdp_request_s *request = NULL;
+	GQueue cancelled = G_QUEUE_INIT;
+
+	g_mutex_lock(&bt_sdp_queue_lock);
+	cancelled = bt_sdp_queue;
+	g_queue_init(&bt_sdp_queue);
+	if (bt_sdp_running != NULL)
+		g_queue_push_head(&cancelled, bt_sdp_running);
+	bt_sdp_running = NULL;
+	if (bt_sdp_requests != NULL)
+		g_hash_table_remove_all(bt_sdp_requests);
+	memset(&bt_sdp_queue_stats, 0x00, sizeof(bt_sdp_queue_stats));
+	bt_sdp_total_wait = 0;
+	g_mutex_unlock(&bt_sdp_queue_lock);
+
+	while ((request = g_queue_pop_head(&cancelled)) != NULL)
+		__bt_sdp_request_finish(request, BT_ERROR_CANCELLED, NULL);
+}
+
+int bt_device_queue_service_search(const char *remote_address, bt_device_service_searched_cb callback, void *user_data)
+{
+	return bt_device_queue_service_search_with_mode(remote_address, BT_DEVICE_SERVICE_SEARCH_ALWAYS,
+			callback, user_data);
+}
+
+int bt_device_queue_service_search_with_mode(const char *remote_address, bt_device_service_search_mode_e mode,
+		bt_device_service_searched_cb callback, void *user_data)
+{
+	bluetooth_device_address_t addr_hex = { {0,} };
+	bt_device_sdp_info_s *sdp_info = NULL;
+	bt_sdp_request_s *request = NULL;
+	bt_sdp_waiter_s *waiter = NULL;
+	const char *interned = NULL;
+
+	BT_CHECK_INIT_STATUS();
+	BT_CHECK_INPUT_PARAMETER(remote_address);
+	BT_CHECK_INPUT_PARAMETER(callback);
+	BT_CHECK_ADDRESS_TO_HEX(&addr_hex, remote_address);
+	if (mode != BT_DEVICE_SERVICE_SEARCH_ALWAYS && mode != BT_DEVICE_SERVICE_SEARCH_IF_STALE) {
+		LOGE("[%s] INVALID_PARAMETER(0x%08x)", __FUNCTION__, BT_ERROR_INVALID_PARAMETER);
+		return BT_ERROR_INVALID_PARAMETER;
+	}
+
+	/* Otherwise, the device is searched */
+	if (mode == BT_DEVICE_SERVICE_SEARCH_IF_STALE &&
+			_bt_sdp_cache_get(&addr_hex, &sdp_info, NULL) == BT_ERROR_NONE) {
+		g_mutex_lock(&bt_sdp_queue_lock);
+		bt_sdp_queue_stats.requests++;
+		bt_sdp_queue_stats.cached++;
+		g_mutex_unlock(&bt_sdp_queue_lock);
+
+		callback(BT_ERROR_NONE, sdp_info, user_data);
+		free(sdp_info);
+		return BT_ERROR_NONE;
+	}
+
+	interned = _bt_intern_address(&addr_hex);
+	waiter = malloc(sizeof(bt_sdp_waiter_s));
+	if (interned == NULL || waiter == NULL) {
+		free(waiter);
+		LOGE("[%s] OUT_OF_MEMORY(0x%08x)", __FUNCTION__, BT_ERROR_OUT_OF_MEMORY);
+		return BT_ERROR_OUT_OF_MEMORY;
+	}
+	waiter->callback = callback;
+	waiter->user_data = user_data;
+
+	g_mutex_lock(&bt_sdp_queue_lock);
+	if (bt_sdp_requests == NULL)
+		bt_sdp_requests = g_hash_table_new(g_direct_hash, g_direct_equal);
+	bt_sdp_queue_stats.requests++;
+
+	request = g_hash_table_lookup(bt_sdp_requests, interned);
+	if (request != NULL) {
+		request->waiters = g_slist_prepend(request->waiters, waiter);
+		bt_sdp_queue_stats.deduplicated++;
+		g_mutex_unlock(&bt_sdp_queue_lock);
+		return BT_ERROR_NONE;
+	}
+
+	request = calloc(1, sizeof(bt_sdp_request_s));
+	if (request == NULL) {
+		bt_sdp_queue_stats.requests--;
+		g_mutex_unlock(&bt_sdp_queue_lock);
+		free(waiter);
+		LOGE("[%s] OUT_OF_MEMORY(0x%08x)", __FUNCTION__, BT_ERROR_OUT_OF_MEMORY);
+		return BT_ERROR_OUT_OF_MEMORY;
+	}
+	request->address = addr_hex;
+	request->remote_address = interned;
+	request->queued = g_get_monotonic_time();
+	request->waiters = g_slist_prepend(NULL, waiter);
+
+	g_hash_table_insert(bt_sdp_requests, (gpointer)interned, request);
+	g_queue_push_tail(&bt_sdp_queue, request);
+	bt_sdp_queue_stats.depth = g_queue_get_length(&bt_sdp_queue);
+	if (bt_sdp_queue_stats.depth > bt_sdp_queue_stats.max_depth)
+		bt_sdp_queue_stats.max_depth = bt_sdp_queue_stats.depth;
+	g_mutex_unlock(&bt_sdp_queue_lock);
+
+	__bt_sdp_queue_start();
+
+	return BT_ERROR_NONE;
+}
+
+int bt_device_get_service_search_queue_stats(bt_device_service_search_queue_stats_s *stats)
+{
+	BT_CHECK_INIT_STATUS();
+	BT_CHECK_INPUT_PARAMETER(stats);
+
+	g_mutex_lock(&bt_sdp_queue_lock);
+	*stats = bt_sdp_queue_stats;
+	stats->running = (bt_sdp_running != NULL) ? true : false;
+	g_mutex_unlock(&bt_sdp_queue_lock);
+
+	return BT_ERROR_NONE;
+}
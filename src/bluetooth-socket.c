@@ -35,7 +35,9 @@ int bt_socket_create_rfcomm(const char *uuid, int *socket_fd)
 	BT_CHECK_INPUT_PARAMETER(uuid);
 	BT_CHECK_INPUT_PARAMETER(socket_fd);
 
+	_bt_lock(BT_LOCK_SOCKET);
 	ret = bluetooth_rfcomm_create_socket(uuid);
+	_bt_unlock(BT_LOCK_SOCKET);
 	if (ret < 0) {
 		ret = _bt_get_error_code(ret);
 		LOGE("[%s] %s(0x%08x)", __FUNCTION__, _bt_convert_error_to_string(ret), ret);
@@ -51,7 +53,9 @@ int bt_socket_destroy_rfcomm(int socket_fd)
 	int error_code = BT_ERROR_NONE;
 
 	BT_CHECK_INIT_STATUS();
+	_bt_lock(BT_LOCK_SOCKET);
 	error_code = _bt_get_error_code(bluetooth_rfcomm_remove_socket(socket_fd));
+	_bt_unlock(BT_LOCK_SOCKET);
 	if (error_code != BT_ERROR_NONE) {
 		LOGE("[%s] %s(0x%08x)", __FUNCTION__, _bt_convert_error_to_string(error_code), error_code);
 	}
@@ -75,7 +79,9 @@ int bt_socket_listen_and_accept_rfcomm(int socket_fd, int max_pending_connection
 	int error_code = BT_ERROR_NONE;
 
 	BT_CHECK_INIT_STATUS();
+	_bt_lock(BT_LOCK_SOCKET);
 	error_code = _bt_get_error_code(bluetooth_rfcomm_listen_and_accept(socket_fd, max_pending_connections));
+	_bt_unlock(BT_LOCK_SOCKET);
 	if (error_code != BT_ERROR_NONE) {
 		LOGE("[%s] %s(0x%08x)", __FUNCTION__, _bt_convert_error_to_string(error_code), error_code);
 	}
@@ -89,7 +95,9 @@ int bt_socket_listen(int socket_fd, int max_pending_connections)
 
 	BT_CHECK_INIT_STATUS();
 
+	_bt_lock(BT_LOCK_SOCKET);
 	error_code = _bt_get_error_code(bluetooth_rfcomm_listen(socket_fd, max_pending_connections));
+	_bt_unlock(BT_LOCK_SOCKET);
 	if (error_code != BT_ERROR_NONE) {
 		LOGE("[%s] %s(0x%08x)", __FUNCTION__, _bt_convert_error_to_string(error_code), error_code);
 	}
@@ -103,7 +111,9 @@ int bt_socket_accept(int socket_fd, int *connected_socket_fd)
 
 	BT_CHECK_INIT_STATUS();
 
+	_bt_lock(BT_LOCK_SOCKET);
 	error_code = _bt_get_error_code(bluetooth_rfcomm_accept_connection(socket_fd, connected_socket_fd));
+	_bt_unlock(BT_LOCK_SOCKET);
 	if (error_code != BT_ERROR_NONE) {
 		LOGE("[%s] %s(0x%08x)", __FUNCTION__, _bt_convert_error_to_string(error_code), error_code);
 	}
@@ -117,7 +127,23 @@ int bt_socket_reject(int socket_fd)
 
 	BT_CHECK_INIT_STATUS();
 
+	_bt_lock(BT_LOCK_SOCKET);
 	error_code = _bt_get_error_code(bluetooth_rfcomm_reject_connection(socket_fd));
+	_bt_unlock(BT_LOCK_SOCKET);
+	if (error_code != BT_ERROR_NONE) {
+		LOGE("[%s] %s(0x%08x)", __FUNCTION__, _bt_convert_error_to_string(error_code), error_code);
+	}
+
+	return error_code;
+}
+
+static int __bt_socket_connect_rfcomm(bluetooth_device_address_t *addr_hex, const char *remote_port_uuid)
+{
+	int error_code = BT_ERROR_NONE;
+
+	_bt_lock(BT_LOCK_SOCKET);
+	error_code = _bt_get_error_code(bluetooth_rfcomm_connect(addr_hex, remote_port_uuid));
+	_bt_unlock(BT_LOCK_SOCKET);
 	if (error_code != BT_ERROR_NONE) {
 		LOGE("[%s] %s(0x%08x)", __FUNCTION__, _bt_convert_error_to_string(error_code), error_code);
 	}
@@ -126,6 +152,35 @@ int bt_socket_reject(int socket_fd)
 }
 
 int bt_socket_connect_rfcomm(const char *remote_address, const char *remote_port_uuid)
+{
+	bluetooth_device_address_t addr_hex = { {0,} };
+
+	BT_CHECK_INIT_STATUS();
+	BT_CHECK_INPUT_PARAMETER(remote_address);
+	BT_CHECK_INPUT_PARAMETER(remote_port_uuid);
+
+	BT_CHECK_ADDRESS_TO_HEX(&addr_hex, remote_address);
+	return __bt_socket_connect_rfcomm(&addr_hex, remote_port_uuid);
+}
+
+int bt_socket_connect_rfcomm_by_addr(const bt_addr_t *remote_addr, const char *remote_port_uuid)
+{
+	bluetooth_device_address_t addr_hex = { {0,} };
+
+	BT_CHECK_INIT_STATUS();
+	BT_CHECK_INPUT_PARAMETER(remote_addr);
+	BT_CHECK_INPUT_PARAMETER(remote_port_uuid);
+
+	_bt_convert_addr_to_hex(&addr_hex, remote_addr);
+	return __bt_socket_connect_rfcomm(&addr_hex, remote_port_uuid);
+}
+
+static const bt_operation_type_s bt_operation_connect_rfcomm = {
+	{ BLUETOOTH_EVENT_RFCOMM_CONNECTED, 0 }, NULL,
+};
+
+int bt_socket_connect_rfcomm_async(const char *remote_address, const char *remote_port_uuid, int timeout_ms,
+		bt_operation_completed_cb callback, void *user_data, int *operation_id)
 {
 	bluetooth_device_address_t addr_hex = { {0,} };
 	int error_code = BT_ERROR_NONE;
@@ -133,13 +188,15 @@ int bt_socket_connect_rfcomm(const char *remote_address, const char *remote_port
 	BT_CHECK_INIT_STATUS();
 	BT_CHECK_INPUT_PARAMETER(remote_address);
 	BT_CHECK_INPUT_PARAMETER(remote_port_uuid);
+	BT_CHECK_ADDRESS_TO_HEX(&addr_hex, remote_address);
 
-	_bt_convert_address_to_hex(&addr_hex, remote_address);
+	error_code = _bt_operation_begin(&bt_operation_connect_rfcomm, &addr_hex, timeout_ms, callback, user_data, operation_id);
+	if (error_code != BT_ERROR_NONE)
+		return error_code;
 
-	error_code = _bt_get_error_code(bluetooth_rfcomm_connect(&addr_hex, remote_port_uuid));
-	if (error_code != BT_ERROR_NONE) {
-		LOGE("[%s] %s(0x%08x)", __FUNCTION__, _bt_convert_error_to_string(error_code), error_code);
-	}
+	error_code = __bt_socket_connect_rfcomm(&addr_hex, remote_port_uuid);
+	if (error_code != BT_ERROR_NONE)
+		_bt_operation_abort(*operation_id);
 
 	return error_code;
 }
@@ -150,7 +207,9 @@ int bt_socket_disconnect_rfcomm(int socket_fd)
 
 	BT_CHECK_INIT_STATUS();
 
+	_bt_lock(BT_LOCK_SOCKET);
 	ret = _bt_get_error_code(bluetooth_rfcomm_disconnect(socket_fd));
+	_bt_unlock(BT_LOCK_SOCKET);
 	if (ret != BT_ERROR_NONE) {
 		LOGE("[%s] %s(0x%08x)", __FUNCTION__, _bt_convert_error_to_string(ret), ret);
 	}
@@ -0,0 +1,229 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <glib.h>
+#include <dlog.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <bluetooth-api.h>
+
+#include "bluetooth.h"
+#include "bluetooth_private.h"
+
+#ifdef LOG_TAG
+#undef LOG_TAG
+#endif
+#define LOG_TAG "TIZEN_N_BLUETOOTH"
+
+/*
+ *  UUID codec
+ *
+ *  UUIDs of the F/W are parsed to 128 bit values, and each distinct value is formatted
+ *  once into an interned uppercase string, in the 16, 32 or 128 bit form the F/W reported
+ *  it in, as the legacy conversion did. The well-known services are the 16 bit UUIDs on the
+ *  Bluetooth base UUID, 0000XXXX-0000-1000-8000-00805F9B34FB.
+ */
+
+static const unsigned char bt_uuid_base[16] = {
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x00,
+	0x80, 0x00, 0x00, 0x80, 0x5F, 0x9B, 0x34, 0xFB,
+};
+
+/* Position of each byte in "XXXXXXXX-XXXX-XXXX-XXXX-XXXXXXXXXXXX" */
+static const unsigned char bt_uuid_offsets[16] = {
+	0, 2, 4, 6, 9, 11, 14, 16, 19, 21, 24, 26, 28, 30, 32, 34,
+};
+
+/* bt_service_e + 1 of the 16 bit UUIDs from 0x1100 to 0x113F, 0 if not a well-known service */
+static const unsigned char bt_service_by_uuid16[0x40] = {
+	[0x01] = BT_SERVICE_SPP + 1,
+	[0x03] = BT_SERVICE_DUN + 1,
+	[0x05] = BT_SERVICE_OPP + 1,
+	[0x06] = BT_SERVICE_FTP + 1,
+	[0x08] = BT_SERVICE_HSP + 1,
+	[0x0A] = BT_SERVICE_A2DP_SOURCE + 1,
+	[0x0B] = BT_SERVICE_A2DP_SINK + 1,
+	[0x0C] = BT_SERVICE_AVRCP_TARGET + 1,
+	[0x0E] = BT_SERVICE_AVRCP + 1,
+	[0x0F] = BT_SERVICE_AVRCP_CONTROLLER + 1,
+	[0x12] = BT_SERVICE_HSP_AG + 1,
+	[0x15] = BT_SERVICE_PANU + 1,
+	[0x16] = BT_SERVICE_NAP + 1,
+	[0x17] = BT_SERVICE_GN + 1,
+	[0x1E] = BT_SERVICE_HFP + 1,
+	[0x1F] = BT_SERVICE_HFP_AG + 1,
+	[0x24] = BT_SERVICE_HID + 1,
+	[0x2D] = BT_SERVICE_SAP + 1,
+	[0x2E] = BT_SERVICE_PBAP_PCE + 1,
+	[0x2F] = BT_SERVICE_PBAP_PSE + 1,
+	[0x32] = BT_SERVICE_MAP_MSE + 1,
+	[0x33] = BT_SERVICE_MAP_MCE + 1,
+};
+
+/*
+ *  Parse the hexadecimal digits of count bytes at the given offsets of str.
+ *  Errors are accumulated, so a valid UUID takes no branch.
+ */
+static bool __bt_parse_uuid_bytes(const unsigned char *str, const unsigned char *offsets, int count, unsigned char *bytes)
+{
+	unsigned char high;
+	unsigned char low;
+	unsigned int invalid = 0;
+	int i;
+
+	for (i = 0; i < count; i++) {
+		high = _bt_hex_value[str[offsets[i]]];
+		low = _bt_hex_value[str[offsets[i] + 1]];
+		invalid |= (high | low) & 0xF0;
+		bytes[i] = (unsigned char)((high << 4) | (low & 0x0F));
+	}
+
+	return (invalid == 0) ? true : false;
+}
+
+bool _bt_parse_uuid(const char *uuid_str, bt_uuid_s *uuid)
+{
+	const unsigned char *str = (const unsigned char *)uuid_str;
+	size_t len;
+
+	if (uuid_str == NULL)
+		return false;
+
+	len = strnlen(uuid_str, BT_UUID_STR_LEN);
+	switch (len) {
+	case 4:
+		memcpy(uuid->uuid, bt_uuid_base, sizeof(bt_uuid_base));
+		return __bt_parse_uuid_bytes(str, bt_uuid_offsets, 2, uuid->uuid + 2);
+	case 8:
+		memcpy(uuid->uuid, bt_uuid_base, sizeof(bt_uuid_base));
+		return __bt_parse_uuid_bytes(str, bt_uuid_offsets, 4, uuid->uuid);
+	case BT_UUID_STR_LEN - 1:
+		if (str[8] != '-' || str[13] != '-' || str[18] != '-' || str[23] != '-')
+			return false;
+		return __bt_parse_uuid_bytes(str, bt_uuid_offsets, 16, uuid->uuid);
+	default:
+		return false;
+	}
+}
+
+void _bt_format_uuid(char *uuid_str, const bt_uuid_s *uuid)
+{
+	int i;
+
+	memset(uuid_str, '-', BT_UUID_STR_LEN - 1);
+	for (i = 0; i < 16; i++)
+		memcpy(uuid_str + bt_uuid_offsets[i], _bt_hex_pairs[uuid->uuid[i]], 2);
+	uuid_str[BT_UUID_STR_LEN - 1] = '\0';
+}
+
+static void __bt_uuid_intern_format(char *value, const void *key)
+{
+	_bt_format_uuid(value, (const bt_uuid_s *)key);
+}
+
+/* Keys of the short forms are their 4 or 2 bytes, the rest being the base UUID */
+static void __bt_uuid32_intern_format(char *value, const void *key)
+{
+	int i;
+
+	for (i = 0; i < 4; i++)
+		memcpy(value + i * 2, _bt_hex_pairs[((const unsigned char *)key)[i]], 2);
+	value[8] = '\0';
+}
+
+static void __bt_uuid16_intern_format(char *value, const void *key)
+{
+	memcpy(value, _bt_hex_pairs[((const unsigned char *)key)[0]], 2);
+	memcpy(value + 2, _bt_hex_pairs[((const unsigned char *)key)[1]], 2);
+	value[4] = '\0';
+}
+
+static bt_intern_table_s bt_uuid_intern_table = BT_INTERN_TABLE_INIT(sizeof(bt_uuid_s),
+		BT_UUID_STR_LEN, __bt_uuid_intern_format);
+static bt_intern_table_s bt_uuid32_intern_table = BT_INTERN_TABLE_INIT(4, 9, __bt_uuid32_intern_format);
+static bt_intern_table_s bt_uuid16_intern_table = BT_INTERN_TABLE_INIT(2, 5, __bt_uuid16_intern_format);
+
+const char *_bt_intern_uuid(const bt_uuid_s *uuid, int length)
+{
+	switch (length) {
+	case 4:
+		return _bt_intern(&bt_uuid16_intern_table, uuid->uuid + 2);
+	case 8:
+		return _bt_intern(&bt_uuid32_intern_table, uuid->uuid);
+	default:
+		return _bt_intern(&bt_uuid_intern_table, uuid);
+	}
+}
+
+int _bt_get_uuid_service(const bt_uuid_s *uuid)
+{
+	unsigned short uuid16;
+
+	if (uuid->uuid[0] != 0 || uuid->uuid[1] != 0 ||
+			memcmp(uuid->uuid + 4, bt_uuid_base + 4, sizeof(bt_uuid_base) - 4) != 0)
+		return -1;
+
+	uuid16 = (unsigned short)((uuid->uuid[2] << 8) | uuid->uuid[3]);
+	if (uuid16 >= 0x1100 && uuid16 < 0x1140)
+		return (int)bt_service_by_uuid16[uuid16 - 0x1100] - 1;
+
+	switch (uuid16) {
+	case 0x1200:
+		return BT_SERVICE_PNP;
+	case 0x1401:
+		return BT_SERVICE_HDP_SOURCE;
+	case 0x1402:
+		return BT_SERVICE_HDP_SINK;
+	default:
+		return -1;
+	}
+}
+
+const char *_bt_convert_uuid(const char *uuid_str, guint64 *service_mask)
+{
+	bt_uuid_s uuid;
+	int service;
+
+	if (_bt_parse_uuid(uuid_str, &uuid) == false)
+		return NULL;
+
+	service = _bt_get_uuid_service(&uuid);
+	if (service >= 0)
+		*service_mask |= BT_SERVICE_BIT(service);
+
+	return _bt_intern_uuid(&uuid, strnlen(uuid_str, BT_UUID_STR_LEN));
+}
+
+guint64 _bt_get_service_mask(const char (*uuids)[BLUETOOTH_UUID_STRING_MAX], int count)
+{
+	guint64 service_mask = 0;
+	bt_uuid_s uuid;
+	int service;
+	int i;
+
+	for (i = 0; i < count; i++) {
+		if (_bt_parse_uuid(uuids[i], &uuid) == false)
+			continue;
+
+		service = _bt_get_uuid_service(&uuid);
+		if (service >= 0)
+			service_mask |= BT_SERVICE_BIT(service);
+	}
+
+	return service_mask;
+}
@@ -0,0 +1,125 @@
+/*
+ * capi-network-bluetooth
+ *
+ * Copyright (c) 2000 - 2011 Samsung Electronics Co., Ltd. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *		http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/**
+ * @file       bt_address_bench.c
+ * @brief      Compares the address codec to the former sscanf() and snprintf() conversions.
+ *
+ * Usage: bt_address_bench [iterations]
+ *
+ * No Bluetooth adapter is required.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <glib.h>
+
+#include "bluetooth.h"
+#include "bluetooth_private.h"
+
+#define DEFAULT_ITERATIONS 1000000
+#define BENCH_ADDRESS_COUNT 256
+
+static bluetooth_device_address_t bench_addresses[BENCH_ADDRESS_COUNT];
+static char bench_strings[BENCH_ADDRESS_COUNT][BT_ADDRESS_STR_LEN];
+static volatile unsigned int bench_sink = 0;
+
+static void __bench_legacy_to_hex(bluetooth_device_address_t *addr_hex, const char *addr_str)
+{
+	unsigned int addr[BLUETOOTH_ADDRESS_LENGTH] = { 0, };
+	int i;
+
+	sscanf(addr_str, "%X:%X:%X:%X:%X:%X", &addr[0], &addr[1], &addr[2], &addr[3], &addr[4], &addr[5]);
+	for (i = 0; i < BLUETOOTH_ADDRESS_LENGTH; i++)
+		addr_hex->addr[i] = (unsigned char)addr[i];
+}
+
+static void __bench_legacy_to_string(char *addr_str, const bluetooth_device_address_t *addr_hex)
+{
+	snprintf(addr_str, BT_ADDRESS_STR_LEN, "%2.2X:%2.2X:%2.2X:%2.2X:%2.2X:%2.2X", addr_hex->addr[0], addr_hex->addr[1],
+			addr_hex->addr[2], addr_hex->addr[3], addr_hex->addr[4], addr_hex->addr[5]);
+}
+
+static double __bench_report(const char *name, gint64 start, int iterations, double base)
+{
+	double ns = (double)(g_get_monotonic_time() - start) * 1000.0 / (double)iterations;
+
+	printf("%-22s %10.1f %9.2fx\n", name, ns, (base > 0.0 && ns > 0.0) ? base / ns : 1.0);
+	return ns;
+}
+
+int main(int argc, char *argv[])
+{
+	int iterations = (argc > 1) ? atoi(argv[1]) : DEFAULT_ITERATIONS;
+	bluetooth_device_address_t address;
+	char address_str[BT_ADDRESS_STR_LEN];
+	double base = 0.0;
+	gint64 start;
+	int i;
+	int j;
+
+	if (iterations < BENCH_ADDRESS_COUNT)
+		iterations = DEFAULT_ITERATIONS;
+	iterations -= iterations % BENCH_ADDRESS_COUNT;
+
+	for (i = 0; i < BENCH_ADDRESS_COUNT; i++) {
+		for (j = 0; j < BLUETOOTH_ADDRESS_LENGTH; j++)
+			bench_addresses[i].addr[j] = (unsigned char)g_random_int();
+		__bench_legacy_to_string(bench_strings[i], &bench_addresses[i]);
+	}
+
+	printf("%-22s %10s %10s\n", "conversion", "ns/addr", "speedup");
+
+	start = g_get_monotonic_time();
+	for (i = 0; i < iterations; i++) {
+		__bench_legacy_to_hex(&address, bench_strings[i % BENCH_ADDRESS_COUNT]);
+		bench_sink += address.addr[5];
+	}
+	base = __bench_report("to_hex sscanf", start, iterations, 0.0);
+
+	start = g_get_monotonic_time();
+	for (i = 0; i < iterations; i++) {
+		_bt_convert_address_to_hex(&address, bench_strings[i % BENCH_ADDRESS_COUNT]);
+		bench_sink += address.addr[5];
+	}
+	__bench_report("to_hex table", start, iterations, base);
+
+	start = g_get_monotonic_time();
+	for (i = 0; i < iterations; i++) {
+		__bench_legacy_to_string(address_str, &bench_addresses[i % BENCH_ADDRESS_COUNT]);
+		bench_sink += address_str[16];
+	}
+	base = __bench_report("to_string snprintf", start, iterations, 0.0);
+
+	start = g_get_monotonic_time();
+	for (i = 0; i < iterations; i++) {
+		_bt_format_address(address_str, &bench_addresses[i % BENCH_ADDRESS_COUNT]);
+		bench_sink += address_str[16];
+	}
+	__bench_report("to_string table", start, iterations, base);
+
+	/* Each address is interned by the first lookup, later lookups return the same string */
+	start = g_get_monotonic_time();
+	for (i = 0; i < iterations; i++)
+		bench_sink += _bt_intern_address(&bench_addresses[i % BENCH_ADDRESS_COUNT])[16];
+	__bench_report("to_string interned", start, iterations, base);
+
+	return 0;
+}
@@ -0,0 +1,232 @@
+/*
+ * capi-network-bluetooth
+ *
+ * Copyright (c) 2000 - 2011 Samsung Electronics Co., Ltd. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *		http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/**
+ * @file       bt_alloc_bench.c
+ * @brief      Counts the heap allocations made to convert and deliver each event.
+ *
+ * Usage: bt_alloc_bench [iterations]
+ *
+ * The F/W callback registered by bt_initialize() is captured by replacing
+ * bluetooth_register_callback(), and synthesized F/W events are fed to it while
+ * malloc(), calloc() and realloc() are counted. No Bluetooth adapter is required.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <glib.h>
+#include <bluetooth-api.h>
+
+#include "bluetooth.h"
+
+#define PRT(format, args...) printf("%s:%d() "format, __FUNCTION__, __LINE__, ##args)
+#define TC_PRT(format, args...) PRT(format"\n", ##args)
+
+#define DEFAULT_ITERATIONS 10000
+
+extern void *__libc_malloc(size_t size);
+extern void *__libc_calloc(size_t nmemb, size_t size);
+extern void *__libc_realloc(void *ptr, size_t size);
+extern void __libc_free(void *ptr);
+
+typedef struct {
+	const char *name;
+	int event;
+	void *param_data;
+} bench_event_t;
+
+static bluetooth_cb_func_ptr bench_proxy = NULL;
+static volatile int bench_counting = 0;
+static unsigned long bench_allocations = 0;
+
+void *malloc(size_t size)
+{
+	if (bench_counting)
+		bench_allocations++;
+	return __libc_malloc(size);
+}
+
+void *calloc(size_t nmemb, size_t size)
+{
+	if (bench_counting)
+		bench_allocations++;
+	return __libc_calloc(nmemb, size);
+}
+
+void *realloc(void *ptr, size_t size)
+{
+	if (bench_counting)
+		bench_allocations++;
+	return __libc_realloc(ptr, size);
+}
+
+void free(void *ptr)
+{
+	__libc_free(ptr);
+}
+
+int bluetooth_register_callback(bluetooth_cb_func_ptr callback_ptr, void *user_data)
+{
+	bench_proxy = callback_ptr;
+	return BLUETOOTH_ERROR_NONE;
+}
+
+int bluetooth_unregister_callback(void)
+{
+	bench_proxy = NULL;
+	return BLUETOOTH_ERROR_NONE;
+}
+
+static void __bench_discovery_cb(int result, bt_adapter_device_discovery_state_e discovery_state,
+		bt_adapter_device_discovery_info_s *discovery_info, void *user_data)
+{
+}
+
+static void __bench_service_searched_cb(int result, bt_device_sdp_info_s *sdp_info, void *user_data)
+{
+}
+
+static void __bench_socket_cb(int result, bt_socket_connection_state_e connection_state,
+		bt_socket_connection_s *connection, void *user_data)
+{
+}
+
+static void __bench_nap_cb(bool connected, const char *remote_address, const char *interface_name, void *user_data)
+{
+}
+
+static void __bench_hdp_cb(int result, const char *remote_address, const char *app_id,
+		bt_hdp_channel_type_e type, unsigned int channel, void *user_data)
+{
+}
+
+static void __bench_audio_cb(int result, bool connected, const char *remote_address,
+		bt_audio_profile_type_e type, void *user_data)
+{
+}
+
+static void __bench_set_address(bluetooth_device_address_t *address)
+{
+	static const unsigned char addr[6] = { 0x00, 0x1B, 0x66, 0x01, 0x23, 0x45 };
+
+	memcpy(address->addr, addr, sizeof(addr));
+}
+
+static unsigned long __bench_run(const bench_event_t *event, int iterations)
+{
+	bluetooth_event_param_t param;
+	unsigned long allocations;
+	int i;
+
+	memset(&param, 0x00, sizeof(param));
+	param.event = event->event;
+	param.result = BLUETOOTH_ERROR_NONE;
+	param.param_data = event->param_data;
+
+	/* The first event grows the arena of the thread */
+	bench_proxy(event->event, &param, NULL);
+
+	bench_allocations = 0;
+	bench_counting = 1;
+	for (i = 0; i < iterations; i++)
+		bench_proxy(event->event, &param, NULL);
+	bench_counting = 0;
+	allocations = bench_allocations;
+
+	return allocations;
+}
+
+int main(int argc, char *argv[])
+{
+	int iterations = (argc > 1) ? atoi(argv[1]) : DEFAULT_ITERATIONS;
+	bluetooth_device_info_t device;
+	bt_sdp_info_t sdp;
+	bluetooth_rfcomm_connection_t rfcomm;
+	bluetooth_network_device_info_t network;
+	bt_hdp_connected_t hdp;
+	char audio_address[] = "00:1B:66:01:23:45";
+	char rfcomm_uuid[] = "00001101-0000-1000-8000-00805f9b34fb";
+	int subscription_id = 0;
+	unsigned long allocations;
+	int i;
+
+	if (iterations <= 0)
+		iterations = DEFAULT_ITERATIONS;
+
+	memset(&device, 0x00, sizeof(device));
+	__bench_set_address(&device.device_address);
+	snprintf(device.device_name.name, sizeof(device.device_name.name), "%s", "bench headset");
+	device.service_index = 3;
+	snprintf(device.uuids[0], BLUETOOTH_UUID_STRING_MAX, "%s", "0000110b-0000-1000-8000-00805f9b34fb");
+	snprintf(device.uuids[1], BLUETOOTH_UUID_STRING_MAX, "%s", "0000110e-0000-1000-8000-00805f9b34fb");
+	snprintf(device.uuids[2], BLUETOOTH_UUID_STRING_MAX, "%s", "0000111e-0000-1000-8000-00805f9b34fb");
+
+	memset(&sdp, 0x00, sizeof(sdp));
+	__bench_set_address(&sdp.device_addr);
+	sdp.service_index = device.service_index;
+	memcpy(sdp.uuids, device.uuids, sizeof(sdp.uuids));
+
+	memset(&rfcomm, 0x00, sizeof(rfcomm));
+	__bench_set_address(&rfcomm.device_addr);
+	rfcomm.socket_fd = 10;
+	rfcomm.uuid = rfcomm_uuid;
+
+	memset(&network, 0x00, sizeof(network));
+	__bench_set_address(&network.device_address);
+	snprintf(network.interface_name, sizeof(network.interface_name), "%s", "bnep0");
+
+	memset(&hdp, 0x00, sizeof(hdp));
+	__bench_set_address(&hdp.device_address);
+	hdp.app_handle = "/org/bluez/health_app_1";
+	hdp.channel_id = 1;
+
+	bench_event_t events[] = {
+		{"device found", BLUETOOTH_EVENT_REMOTE_DEVICE_NAME_UPDATED, &device},
+		{"service searched", BLUETOOTH_EVENT_SERVICE_SEARCHED, &sdp},
+		{"rfcomm connected", BLUETOOTH_EVENT_RFCOMM_CONNECTED, &rfcomm},
+		{"nap connected", BLUETOOTH_EVENT_NETWORK_SERVER_CONNECTED, &network},
+		{"hdp connected", BLUETOOTH_EVENT_HDP_CONNECTED, &hdp},
+		{"ag connected", BLUETOOTH_EVENT_AG_CONNECTED, audio_address},
+		{NULL, 0, NULL},
+	};
+
+	if (bt_initialize() != BT_ERROR_NONE || bench_proxy == NULL) {
+		TC_PRT("bt_initialize() failed");
+		return -1;
+	}
+
+	bt_event_subscribe(BT_EVENT_DEVICE_DISCOVERY_STATE_CHANGED, __bench_discovery_cb, NULL, &subscription_id);
+	bt_event_subscribe(BT_EVENT_SERVICE_SEARCHED, __bench_service_searched_cb, NULL, &subscription_id);
+	bt_event_subscribe(BT_EVENT_CONNECTION_STATE_CHANGED, __bench_socket_cb, NULL, &subscription_id);
+	bt_event_subscribe(BT_EVENT_NAP_CONNECTION_STATE_CHANGED, __bench_nap_cb, NULL, &subscription_id);
+	bt_event_subscribe(BT_EVENT_HDP_CONNECTED, __bench_hdp_cb, NULL, &subscription_id);
+	bt_event_subscribe(BT_EVENT_AUDIO_CONNECTION_STATUS, __bench_audio_cb, NULL, &subscription_id);
+
+	printf("%-18s %12s %14s\n", "event", "iterations", "allocs/event");
+	for (i = 0; events[i].name != NULL; i++) {
+		allocations = __bench_run(&events[i], iterations);
+		printf("%-18s %12d %14.2f\n", events[i].name, iterations,
+				(double)allocations / (double)iterations);
+	}
+
+	bt_deinitialize();
+
+	return 0;
+}
@@ -0,0 +1,291 @@
+/*
+ * capi-network-bluetooth
+ *
+ * Copyright (c) 2000 - 2011 Samsung Electronics Co., Ltd. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *		http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/**
+ * @file       bt_bonded_bench.c
+ * @brief      Measures the allocations, RSS and time of the bonded device information.
+ *
+ * Usage: bt_bonded_bench [device_count]
+ *
+ * The bonded device list of the F/W is replaced by synthesized devices with a few services.
+ * bt_adapter_get_bonded_device_info() is compared to a copy of the former layout, which
+ * allocated the structure, the name, the address, the UUID table and each UUID separately.
+ * Each layout is measured in a child process, so both start from the same heap.
+ * No Bluetooth adapter is required.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <ctype.h>
+#include <sys/wait.h>
+#include <glib.h>
+#include <bluetooth-api.h>
+
+#include "bluetooth.h"
+
+#define PRT(format, args...) printf("%s:%d() "format, __FUNCTION__, __LINE__, ##args)
+#define TC_PRT(format, args...) PRT(format"\n", ##args)
+
+#define DEFAULT_DEVICE_COUNT 1000
+#define BENCH_SERVICE_COUNT 4
+
+extern void *__libc_malloc(size_t size);
+extern void *__libc_calloc(size_t nmemb, size_t size);
+extern void *__libc_realloc(void *ptr, size_t size);
+extern void __libc_free(void *ptr);
+
+typedef struct {
+	unsigned long allocations;
+	long rss_kb;
+	double usec;
+} bench_result_t;
+
+static bluetooth_device_info_t *bench_devices = NULL;
+static int bench_device_count = 0;
+static volatile int bench_counting = 0;
+static unsigned long bench_allocations = 0;
+
+void *malloc(size_t size)
+{
+	if (bench_counting)
+		bench_allocations++;
+	return __libc_malloc(size);
+}
+
+void *calloc(size_t nmemb, size_t size)
+{
+	if (bench_counting)
+		bench_allocations++;
+	return __libc_calloc(nmemb, size);
+}
+
+void *realloc(void *ptr, size_t size)
+{
+	if (bench_counting)
+		bench_allocations++;
+	return __libc_realloc(ptr, size);
+}
+
+void free(void *ptr)
+{
+	__libc_free(ptr);
+}
+
+int bluetooth_register_callback(bluetooth_cb_func_ptr callback_ptr, void *user_data)
+{
+	return BLUETOOTH_ERROR_NONE;
+}
+
+int bluetooth_unregister_callback(void)
+{
+	return BLUETOOTH_ERROR_NONE;
+}
+
+int bluetooth_get_bonded_device(const bluetooth_device_address_t *device_address, bluetooth_device_info_t *dev_info)
+{
+	int index = (device_address->addr[4] << 8) | device_address->addr[5];
+
+	if (index >= bench_device_count)
+		return BLUETOOTH_ERROR_NOT_FOUND;
+
+	memcpy(dev_info, &bench_devices[index], sizeof(bluetooth_device_info_t));
+	return BLUETOOTH_ERROR_NONE;
+}
+
+static long __bench_get_rss_kb(void)
+{
+	FILE *fp = fopen("/proc/self/statm", "r");
+	long size = 0;
+	long resident = 0;
+
+	if (fp == NULL)
+		return 0;
+
+	if (fscanf(fp, "%ld %ld", &size, &resident) != 2)
+		resident = 0;
+	fclose(fp);
+
+	return resident * (sysconf(_SC_PAGESIZE) / 1024);
+}
+
+static void __bench_get_address(int index, char *address, size_t len)
+{
+	snprintf(address, len, "00:1B:66:00:%2.2X:%2.2X", (index >> 8) & 0xFF, index & 0xFF);
+}
+
+static void __bench_create_devices(int count)
+{
+	static const char *uuids[BENCH_SERVICE_COUNT] = {
+		"0000110b-0000-1000-8000-00805f9b34fb",
+		"0000110e-0000-1000-8000-00805f9b34fb",
+		"0000111e-0000-1000-8000-00805f9b34fb",
+		"00001108-0000-1000-8000-00805f9b34fb",
+	};
+	int i;
+	int j;
+
+	bench_devices = g_new0(bluetooth_device_info_t, count);
+	bench_device_count = count;
+
+	for (i = 0; i < count; i++) {
+		bench_devices[i].device_address.addr[0] = 0x00;
+		bench_devices[i].device_address.addr[1] = 0x1B;
+		bench_devices[i].device_address.addr[2] = 0x66;
+		bench_devices[i].device_address.addr[4] = (i >> 8) & 0xFF;
+		bench_devices[i].device_address.addr[5] = i & 0xFF;
+		snprintf(bench_devices[i].device_name.name, sizeof(bench_devices[i].device_name.name),
+				"bench device %d", i);
+		bench_devices[i].service_index = BENCH_SERVICE_COUNT;
+		for (j = 0; j < BENCH_SERVICE_COUNT; j++)
+			snprintf(bench_devices[i].uuids[j], BLUETOOTH_UUID_STRING_MAX, "%s", uuids[j]);
+		bench_devices[i].paired = TRUE;
+	}
+}
+
+/* Former layout of bt_device_info_s, with one allocation per member */
+static bt_device_info_s *__bench_legacy_device_info(bluetooth_device_info_t *source_dev)
+{
+	bt_device_info_s *dest_dev = malloc(sizeof(bt_device_info_s));
+	char address[18];
+	int i;
+	int j;
+
+	if (dest_dev == NULL)
+		return NULL;
+
+	memset(dest_dev, 0x00, sizeof(bt_device_info_s));
+	if (strlen(source_dev->device_name.name) > 0)
+		dest_dev->remote_name = strdup(source_dev->device_name.name);
+
+	snprintf(address, sizeof(address), "%2.2X:%2.2X:%2.2X:%2.2X:%2.2X:%2.2X",
+			source_dev->device_address.addr[0], source_dev->device_address.addr[1],
+			source_dev->device_address.addr[2], source_dev->device_address.addr[3],
+			source_dev->device_address.addr[4], source_dev->device_address.addr[5]);
+	dest_dev->remote_address = strdup(address);
+
+	dest_dev->service_uuid = malloc(sizeof(char *) * source_dev->service_index);
+	for (i = 0; i < source_dev->service_index; i++) {
+		dest_dev->service_uuid[i] = strdup(source_dev->uuids[i]);
+		for (j = 0; dest_dev->service_uuid[i][j] != '\0'; j++)
+			dest_dev->service_uuid[i][j] = toupper(dest_dev->service_uuid[i][j]);
+	}
+	dest_dev->service_count = source_dev->service_index;
+
+	return dest_dev;
+}
+
+static void __bench_legacy_free_device_info(bt_device_info_s *device_info)
+{
+	int i;
+
+	free(device_info->remote_name);
+	free(device_info->remote_address);
+	for (i = 0; i < device_info->service_count; i++)
+		free(device_info->service_uuid[i]);
+	free(device_info->service_uuid);
+	free(device_info);
+}
+
+static void __bench_measure(bool legacy, bt_device_info_s **infos, int count, bench_result_t *result)
+{
+	char address[18];
+	long rss = __bench_get_rss_kb();
+	gint64 start = g_get_monotonic_time();
+	int i;
+
+	bench_allocations = 0;
+	bench_counting = 1;
+	for (i = 0; i < count; i++) {
+		if (legacy) {
+			infos[i] = __bench_legacy_device_info(&bench_devices[i]);
+		} else {
+			__bench_get_address(i, address, sizeof(address));
+			if (bt_adapter_get_bonded_device_info(address, &infos[i]) != BT_ERROR_NONE)
+				infos[i] = NULL;
+		}
+	}
+	bench_counting = 0;
+
+	result->allocations = bench_allocations;
+	result->rss_kb = __bench_get_rss_kb() - rss;
+
+	for (i = 0; i < count; i++) {
+		if (infos[i] == NULL)
+			continue;
+		if (legacy)
+			__bench_legacy_free_device_info(infos[i]);
+		else
+			bt_adapter_free_device_info(infos[i]);
+	}
+	result->usec = (double)(g_get_monotonic_time() - start);
+}
+
+static void __bench_run(bool legacy, bt_device_info_s **infos, int count)
+{
+	bench_result_t result;
+	pid_t pid;
+
+	fflush(stdout);
+	pid = fork();
+	if (pid < 0) {
+		TC_PRT("fork() failed");
+		return;
+	}
+
+	if (pid == 0) {
+		__bench_measure(legacy, infos, count, &result);
+		printf("%-8s %8d %12lu %10ld %12.0f\n", legacy ? "legacy" : "compact", count,
+				result.allocations, result.rss_kb, result.usec);
+		fflush(stdout);
+		_exit(0);
+	}
+
+	waitpid(pid, NULL, 0);
+}
+
+int main(int argc, char *argv[])
+{
+	int count = (argc > 1) ? atoi(argv[1]) : DEFAULT_DEVICE_COUNT;
+	bt_device_info_s **infos = NULL;
+
+	if (count <= 0 || count > 0x10000)
+		count = DEFAULT_DEVICE_COUNT;
+
+	if (bt_initialize() != BT_ERROR_NONE) {
+		TC_PRT("bt_initialize() failed");
+		return -1;
+	}
+
+	__bench_create_devices(count);
+	infos = g_new0(bt_device_info_s *, count);
+
+	printf("%-8s %8s %12s %10s %12s\n", "layout", "devices", "allocations", "rss(KB)", "time(us)");
+
+	/* bt_adapter_get_bonded_device_info() also allocates a temporary copy of the F/W information */
+	__bench_run(true, infos, count);
+	__bench_run(false, infos, count);
+
+	g_free(infos);
+	g_free(bench_devices);
+	bt_deinitialize();
+
+	return 0;
+}
@@ -0,0 +1,183 @@
+/*
+ * capi-network-bluetooth
+ *
+ * Copyright (c) 2000 - 2011 Samsung Electronics Co., Ltd. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *		http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/**
+ * @file       bt_mt_bench.c
+ * @brief      Measures the throughput of the API as caller threads are added.
+ *
+ * Usage: bt_mt_bench [max_threads] [duration_ms]
+ *
+ * Each workload is run with 1, 2, 4, ... max_threads threads. The "event" workload
+ * subscribes and unsubscribes events, the "opp" workload adds and clears OPP files and
+ * the "mixed" workload alternates both between threads, so threads of different
+ * subsystems run on different locks. No Bluetooth adapter is required.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <glib.h>
+
+#include "bluetooth.h"
+
+#define PRT(format, args...) printf("%s:%d() "format, __FUNCTION__, __LINE__, ##args)
+#define TC_PRT(format, args...) PRT(format"\n", ##args)
+
+#define DEFAULT_MAX_THREADS 8
+#define DEFAULT_DURATION_MS 1000
+
+typedef int (*bench_op_f)(int thread_index);
+
+typedef struct {
+	const char *name;
+	bench_op_f op;
+} bench_workload_t;
+
+typedef struct {
+	bench_op_f op;
+	int thread_index;
+	gint64 deadline;
+	guint64 count;
+	int errors;
+} bench_thread_t;
+
+static void __bench_state_changed_cb(int result, bt_adapter_state_e adapter_state, void *user_data)
+{
+}
+
+static int __bench_event_op(int thread_index)
+{
+	int subscription_id = 0;
+	int ret;
+
+	ret = bt_event_subscribe(BT_EVENT_STATE_CHANGED, __bench_state_changed_cb, NULL, &subscription_id);
+	if (ret != BT_ERROR_NONE)
+		return ret;
+
+	return bt_event_unsubscribe(subscription_id);
+}
+
+static int __bench_opp_op(int thread_index)
+{
+	int ret;
+
+	ret = bt_opp_client_add_file("/dev/null");
+	if (ret != BT_ERROR_NONE)
+		return ret;
+
+	return bt_opp_client_clear_files();
+}
+
+static int __bench_mixed_op(int thread_index)
+{
+	return (thread_index % 2) ? __bench_opp_op(thread_index) : __bench_event_op(thread_index);
+}
+
+static bench_workload_t workloads[] = {
+	{"event", __bench_event_op},
+	{"opp", __bench_opp_op},
+	{"mixed", __bench_mixed_op},
+	{NULL, NULL},
+};
+
+static gpointer __bench_thread_func(gpointer data)
+{
+	bench_thread_t *thread = data;
+	int i;
+
+	while (g_get_monotonic_time() < thread->deadline) {
+		/* Check the clock once per batch to keep it out of the measurement */
+		for (i = 0; i < 64; i++) {
+			if (thread->op(thread->thread_index) != BT_ERROR_NONE)
+				thread->errors++;
+			thread->count++;
+		}
+	}
+
+	return NULL;
+}
+
+static double __bench_run(bench_op_f op, int thread_num, int duration_ms)
+{
+	GThread **threads = g_new0(GThread *, thread_num);
+	bench_thread_t *contexts = g_new0(bench_thread_t, thread_num);
+	gint64 start = g_get_monotonic_time();
+	gint64 elapsed = 0;
+	guint64 total = 0;
+	int errors = 0;
+	int i;
+
+	for (i = 0; i < thread_num; i++) {
+		contexts[i].op = op;
+		contexts[i].thread_index = i;
+		contexts[i].deadline = start + (gint64)duration_ms * 1000;
+		threads[i] = g_thread_new("bt_mt_bench", __bench_thread_func, &contexts[i]);
+	}
+
+	for (i = 0; i < thread_num; i++) {
+		g_thread_join(threads[i]);
+		total += contexts[i].count;
+		errors += contexts[i].errors;
+	}
+	elapsed = g_get_monotonic_time() - start;
+
+	if (errors > 0)
+		TC_PRT("%d operations failed", errors);
+
+	g_free(threads);
+	g_free(contexts);
+
+	return (elapsed > 0) ? (double)total * 1000000.0 / (double)elapsed : 0.0;
+}
+
+int main(int argc, char *argv[])
+{
+	int max_threads = (argc > 1) ? atoi(argv[1]) : DEFAULT_MAX_THREADS;
+	int duration_ms = (argc > 2) ? atoi(argv[2]) : DEFAULT_DURATION_MS;
+	double base = 0.0;
+	double ops = 0.0;
+	int thread_num;
+	int i;
+
+	if (max_threads <= 0)
+		max_threads = DEFAULT_MAX_THREADS;
+	if (duration_ms <= 0)
+		duration_ms = DEFAULT_DURATION_MS;
+
+	if (bt_initialize() != BT_ERROR_NONE) {
+		TC_PRT("bt_initialize() failed");
+		return -1;
+	}
+
+	printf("%-8s %8s %16s %8s\n", "workload", "threads", "ops/sec", "scaling");
+	for (i = 0; workloads[i].name != NULL; i++) {
+		for (thread_num = 1; thread_num <= max_threads; thread_num *= 2) {
+			ops = __bench_run(workloads[i].op, thread_num, duration_ms);
+			if (thread_num == 1)
+				base = ops;
+
+			printf("%-8s %8d %16.0f %7.2fx\n", workloads[i].name, thread_num, ops,
+					(base > 0.0) ? ops / base : 0.0);
+		}
+	}
+
+	bt_deinitialize();
+
+	return 0;
+}
@@ -42,6 +42,8 @@ const char *opp_uuid = "00001105-0000-1000-8000-00805f9b34fb";
 
 static int server_fd;
 static int client_fd;
+static int subscription_id;
+static bt_adapter_discovery_session_h discovery_session;
 
 GMainLoop *main_loop = NULL;
 
@@ -64,6 +66,24 @@ tc_table_t tc_table[] = {
 	{"bt_adapter_is_service_used"		, 10},
 	{"bt_adapter_set_device_discovery_state_changed_cb"	, 11},
 	{"bt_adapter_unset_device_discovery_state_changed_cb"	, 12},
+	{"bt_event_subscribe"			, 13},
+	{"bt_event_unsubscribe"			, 14},
+	{"bt_event_set_delivery_mode"		, 15},
+	{"bt_event_get_queue_stats"		, 16},
+	{"bt_diag_dump"				, 17},
+	{"bt_event_subscribe_with_filter"	, 18},
+	{"bt_event_subscribe_device_view"	, 19},
+	{"bt_event_subscribe_addr"		, 20},
+	{"bt_adapter_foreach_discovered_device"	, 21},
+	{"bt_adapter_get_bonded_device_cache_stats"	, 22},
+	{"bt_adapter_enable_async"		, 23},
+	{"bt_device_get_service_search_queue_stats"	, 24},
+	{"bt_device_get_cached_services"	, 25},
+	{"bt_adapter_start_device_discovery_with_filter"	, 26},
+	{"bt_adapter_start_discovery_schedule"	, 27},
+	{"bt_adapter_open/close_discovery_session"	, 28},
+	{"bt_adapter_find_device"		, 29},
+	{"bt_proximity_get_top_n"		, 30},
 
 	/* Socket functions */
 	{"bt_socket_create_rfcomm"		, 50},
@@ -142,6 +162,83 @@ static void __bt_adapter_device_discovery_state_changed_cb(int result,
 	}
 }
 
+static void __bt_adapter_discovery_cycle_cb(const bt_adapter_discovery_cycle_s *cycle, void *user_data)
+{
+	TC_PRT("cycle: %d, result: %d, yielded: %d", cycle->cycle, cycle->result, cycle->yielded);
+	TC_PRT("found: %d, new: %d, lost: %d, known: %d", cycle->found, cycle->new_devices, cycle->lost, cycle->known);
+	TC_PRT("next cycle in %d ms", cycle->interval);
+}
+
+static void __bt_adapter_device_found_cb(int result, bt_adapter_device_discovery_info_s *discovery_info,
+				int age, void *user_data)
+{
+	TC_PRT("result: %d", result);
+
+	if (discovery_info == NULL)
+		return;
+
+	TC_PRT("remote_address: %s, age: %d ms", discovery_info->remote_address, age);
+	TC_PRT("remote_name: %s", discovery_info->remote_name);
+}
+
+static void __bt_proximity_threshold_crossed_cb(int threshold_id, const char *remote_address, int rssi,
+				bool is_near, void *user_data)
+{
+	TC_PRT("threshold %d: %s %s (%d dBm)", threshold_id, remote_address, is_near ? "near" : "away", rssi);
+}
+
+static void __bt_adapter_device_discovery_state_changed_view_cb(int result,
+				bt_adapter_device_discovery_state_e discovery_state,
+				bt_device_view_h device,
+				void *user_data)
+{
+	const char *remote_address = NULL;
+	int rssi = 0;
+
+	TC_PRT("discovery_state: %d", discovery_state);
+
+	if (device == NULL) {
+		TC_PRT("No device!");
+		return;
+	}
+
+	bt_device_view_get_address(device, &remote_address);
+	bt_device_view_get_rssi(device, &rssi);
+	TC_PRT("remote_address: %s", remote_address);
+	TC_PRT("rssi: %d", rssi);
+}
+
+static void __bt_event_addr_cb(bt_event_e event, int result, int state,
+				const bt_addr_t *remote_addr, void *user_data)
+{
+	TC_PRT("event: %d, result: %d, state: %d", event, result, state);
+
+	if (remote_addr == NULL) {
+		TC_PRT("No address!");
+		return;
+	}
+
+	TC_PRT("remote_addr: %2.2X:%2.2X:%2.2X:%2.2X:%2.2X:%2.2X",
+			remote_addr->addr[0], remote_addr->addr[1], remote_addr->addr[2],
+			remote_addr->addr[3], remote_addr->addr[4], remote_addr->addr[5]);
+}
+
+static void __bt_operation_completed_cb(int operation_id, int result,
+				const char *remote_address, void *user_data)
+{
+	TC_PRT("operation_id: %d, result: %d, remote_address: %s", operation_id, result,
+			(remote_address != NULL) ? remote_address : "(none)");
+}
+
+static bool __bt_adapter_discovered_device_cb(bt_adapter_device_discovery_info_s *discovery_info,
+				int age, void *user_data)
+{
+	TC_PRT("remote_address: %s, rssi: %d, age: %d ms",
+			discovery_info->remote_address, discovery_info->rssi, age);
+
+	return true;
+}
+
 static void __bt_socket_data_received_cb(bt_socket_received_data_s *data, void *user_data)
 {
 	TC_PRT("+");
@@ -310,6 +407,192 @@ int test_input_callback(void *data)
 		if (ret < BT_ERROR_NONE)
 			TC_PRT("failed with [0x%04x]", ret);
 		break;
+	case 13:
+		ret = bt_event_subscribe(BT_EVENT_DEVICE_DISCOVERY_STATE_CHANGED,
+				__bt_adapter_device_discovery_state_changed_cb, NULL, &subscription_id);
+		if (ret < BT_ERROR_NONE)
+			TC_PRT("failed with [0x%04x]", ret);
+		else
+			TC_PRT("subscription_id: %d", subscription_id);
+		break;
+	case 14:
+		ret = bt_event_unsubscribe(subscription_id);
+		if (ret < BT_ERROR_NONE)
+			TC_PRT("failed with [0x%04x]", ret);
+		break;
+	case 15:
+		ret = bt_event_set_delivery_mode(BT_EVENT_DELIVERY_THREAD_POOL, 2);
+		if (ret < BT_ERROR_NONE)
+			TC_PRT("failed with [0x%04x]", ret);
+		break;
+	case 16: {
+		bt_event_queue_stats_s stats = { 0, };
+
+		ret = bt_event_get_queue_stats(&stats);
+		if (ret < BT_ERROR_NONE) {
+			TC_PRT("failed with [0x%04x]", ret);
+		} else {
+			TC_PRT("enqueued: %llu, dropped: %llu, coalesced: %llu",
+					stats.enqueued, stats.dropped, stats.coalesced);
+			TC_PRT("queued: %d, high water: %d, capacity: %d",
+					stats.queued, stats.high_water, stats.capacity);
+		}
+		break;
+	}
+	case 17:
+		ret = bt_diag_dump("/tmp/bt_diag.txt");
+		if (ret < BT_ERROR_NONE)
+			TC_PRT("failed with [0x%04x]", ret);
+		break;
+	case 18: {
+		const char *addresses[] = { "00:02:48:F4:3E:D2" };
+
+		ret = bt_event_subscribe_with_filter(BT_EVENT_CONNECTION_STATE_CHANGED, addresses, 1,
+				__bt_socket_connection_state_changed_cb, NULL, &subscription_id);
+		if (ret < BT_ERROR_NONE)
+			TC_PRT("failed with [0x%04x]", ret);
+		else
+			TC_PRT("subscription_id: %d", subscription_id);
+		break;
+	}
+	case 19:
+		ret = bt_event_subscribe_device_view(BT_EVENT_DEVICE_DISCOVERY_STATE_CHANGED,
+				__bt_adapter_device_discovery_state_changed_view_cb, NULL, &subscription_id);
+		if (ret < BT_ERROR_NONE)
+			TC_PRT("failed with [0x%04x]", ret);
+		else
+			TC_PRT("subscription_id: %d", subscription_id);
+		break;
+	case 20:
+		ret = bt_event_subscribe_addr(BT_EVENT_AUDIO_CONNECTION_STATUS,
+				__bt_event_addr_cb, NULL, &subscription_id);
+		if (ret < BT_ERROR_NONE)
+			TC_PRT("failed with [0x%04x]", ret);
+		else
+			TC_PRT("subscription_id: %d", subscription_id);
+		break;
+	case 21:
+		ret = bt_adapter_foreach_discovered_device(__bt_adapter_discovered_device_cb, NULL);
+		if (ret < BT_ERROR_NONE)
+			TC_PRT("failed with [0x%04x]", ret);
+		break;
+	case 22: {
+		bt_adapter_bonded_device_cache_stats_s stats;
+
+		ret = bt_adapter_get_bonded_device_cache_stats(&stats);
+		if (ret < BT_ERROR_NONE)
+			TC_PRT("failed with [0x%04x]", ret);
+		else
+			TC_PRT("hits: %llu, misses: %llu, refreshes: %llu, count: %d",
+					stats.hits, stats.misses, stats.refreshes, stats.count);
+		break;
+	}
+	case 23: {
+		int operation_id = 0;
+
+		ret = bt_adapter_enable_async(10000, __bt_operation_completed_cb, NULL, &operation_id);
+		if (ret < BT_ERROR_NONE)
+			TC_PRT("failed with [0x%04x]", ret);
+		else
+			TC_PRT("operation_id: %d", operation_id);
+		break;
+	}
+	case 24: {
+		bt_device_service_search_queue_stats_s stats;
+
+		ret = bt_device_get_service_search_queue_stats(&stats);
+		if (ret < BT_ERROR_NONE)
+			TC_PRT("failed with [0x%04x]", ret);
+		else
+			TC_PRT("depth: %d, max_depth: %d, running: %d, requests: %llu, deduplicated: %llu, "
+					"searches: %llu, wait_avg: %d ms, wait_max: %d ms",
+					stats.depth, stats.max_depth, stats.running, stats.requests,
+					stats.deduplicated, stats.searches, stats.wait_avg, stats.wait_max);
+		break;
+	}
+	case 25: {
+		bt_device_sdp_info_s *sdp_info = NULL;
+		int age = 0;
+		int i;
+
+		ret = bt_device_get_cached_services("00:02:48:F4:3E:D2", &sdp_info, &age);
+		if (ret < BT_ERROR_NONE) {
+			TC_PRT("failed with [0x%04x]", ret);
+			break;
+		}
+
+		TC_PRT("remote_address: %s, age: %d s", sdp_info->remote_address, age);
+		for (i = 0; i < sdp_info->service_count; i++)
+			TC_PRT("service_uuid[%d]: %s", i, sdp_info->service_uuid[i]);
+		bt_device_free_cached_services(sdp_info);
+		break;
+	}
+	case 26: {
+		bt_adapter_device_discovery_filter_s filter;
+
+		memset(&filter, 0x00, sizeof(filter));
+		filter.major_device_class_mask = 1U << BT_MAJOR_DEVICE_CLASS_AUDIO_VIDEO;
+		filter.min_rssi = -70;
+
+		ret = bt_adapter_start_device_discovery_with_filter(&filter);
+		if (ret < BT_ERROR_NONE)
+			TC_PRT("failed with [0x%04x]", ret);
+		break;
+	}
+	case 27: {
+		bt_adapter_discovery_schedule_s schedule = { 10000, 30000, 300000 };
+
+		ret = bt_adapter_start_discovery_schedule(&schedule, __bt_adapter_discovery_cycle_cb, NULL);
+		if (ret < BT_ERROR_NONE)
+			TC_PRT("failed with [0x%04x]", ret);
+		break;
+	}
+	case 28: {
+		if (discovery_session != NULL) {
+			ret = bt_adapter_close_discovery_session(discovery_session);
+			discovery_session = NULL;
+		} else {
+			ret = bt_adapter_open_discovery_session(NULL,
+					__bt_adapter_device_discovery_state_changed_cb, NULL, &discovery_session);
+		}
+		if (ret < BT_ERROR_NONE)
+			TC_PRT("failed with [0x%04x]", ret);
+		break;
+	}
+	case 29: {
+		bt_adapter_find_device_criteria_s criteria = { "00:02:48:F4:3E:D2", NULL, NULL, 5000 };
+		int find_id = 0;
+
+		ret = bt_adapter_find_device(&criteria, 12000, __bt_adapter_device_found_cb, NULL, &find_id);
+		if (ret < BT_ERROR_NONE)
+			TC_PRT("failed with [0x%04x]", ret);
+		break;
+	}
+	case 30: {
+		bt_proximity_device_s devices[5];
+		int threshold_id = 0;
+		int count = 0;
+		int i;
+
+		/* The first call starts the tracking, the next ones print the ranking */
+		ret = bt_proximity_start(NULL);
+		if (ret == BT_ERROR_NONE) {
+			ret = bt_proximity_add_threshold(-60, 5, __bt_proximity_threshold_crossed_cb, NULL, &threshold_id);
+			if (ret < BT_ERROR_NONE)
+				TC_PRT("failed with [0x%04x]", ret);
+			break;
+		}
+
+		ret = bt_proximity_get_top_n(5, devices, &count);
+		if (ret < BT_ERROR_NONE) {
+			TC_PRT("failed with [0x%04x]", ret);
+			break;
+		}
+		for (i = 0; i < count; i++)
+			TC_PRT("%d: %s %d dBm (%d samples)", i + 1, devices[i].remote_address,
+					devices[i].rssi, devices[i].sample_count);
+		break;
+	}
 
 	/* Socket functions */
 	case 50: {
@@ -0,0 +1,149 @@
+/*
+ * capi-network-bluetooth
+ *
+ * Copyright (c) 2000 - 2011 Samsung Electronics Co., Ltd. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *		http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/**
+ * @file       bt_uuid_bench.c
+ * @brief      Compares the interned UUIDs and service bitmask to the former uppercase copies and strcmp().
+ *
+ * Usage: bt_uuid_bench [iterations]
+ *
+ * The UUIDs of a device with a few services are converted, as a discovery event does,
+ * and the A2DP sink service is looked up, as an application does. No Bluetooth adapter is required.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <glib.h>
+
+#include "bluetooth.h"
+#include "bluetooth_private.h"
+
+#define DEFAULT_ITERATIONS 1000000
+#define BENCH_SERVICE_COUNT 6
+
+static const char bench_uuids[BENCH_SERVICE_COUNT][BLUETOOTH_UUID_STRING_MAX] = {
+	"00001108-0000-1000-8000-00805f9b34fb",
+	"0000110c-0000-1000-8000-00805f9b34fb",
+	"0000110e-0000-1000-8000-00805f9b34fb",
+	"0000111e-0000-1000-8000-00805f9b34fb",
+	"00001200-0000-1000-8000-00805f9b34fb",
+	"0000110b-0000-1000-8000-00805f9b34fb",
+};
+
+static volatile unsigned int bench_sink = 0;
+
+static double __bench_report(const char *name, gint64 start, int iterations, double base)
+{
+	double ns = (double)(g_get_monotonic_time() - start) * 1000.0 / (double)iterations;
+
+	printf("%-22s %10.1f %9.2fx\n", name, ns, (base > 0.0 && ns > 0.0) ? base / ns : 1.0);
+	return ns;
+}
+
+/* Former conversion, an uppercase copy of each UUID */
+static void __bench_legacy_convert(char **service_uuid)
+{
+	int i;
+	int j;
+
+	for (i = 0; i < BENCH_SERVICE_COUNT; i++) {
+		service_uuid[i] = strdup(bench_uuids[i]);
+		for (j = 0; service_uuid[i][j] != '\0'; j++)
+			service_uuid[i][j] = toupper(service_uuid[i][j]);
+	}
+}
+
+static void __bench_legacy_free(char **service_uuid)
+{
+	int i;
+
+	for (i = 0; i < BENCH_SERVICE_COUNT; i++)
+		free(service_uuid[i]);
+}
+
+/* Lookup of the application, with the former strings */
+static bool __bench_legacy_has_service(char **service_uuid)
+{
+	int i;
+
+	for (i = 0; i < BENCH_SERVICE_COUNT; i++) {
+		if (strcmp(service_uuid[i], "0000110B-0000-1000-8000-00805F9B34FB") == 0)
+			return true;
+	}
+
+	return false;
+}
+
+static guint64 __bench_interned_convert(const char **service_uuid)
+{
+	guint64 service_mask = 0;
+	int i;
+
+	for (i = 0; i < BENCH_SERVICE_COUNT; i++)
+		service_uuid[i] = _bt_convert_uuid(bench_uuids[i], &service_mask);
+
+	return service_mask;
+}
+
+int main(int argc, char *argv[])
+{
+	int iterations = (argc > 1) ? atoi(argv[1]) : DEFAULT_ITERATIONS;
+	char *legacy_uuids[BENCH_SERVICE_COUNT];
+	const char *interned_uuids[BENCH_SERVICE_COUNT];
+	volatile guint64 service_mask = 0;
+	double base = 0.0;
+	gint64 start;
+	int i;
+
+	if (iterations <= 0)
+		iterations = DEFAULT_ITERATIONS;
+
+	printf("%-22s %10s %10s\n", "per device", "ns", "speedup");
+
+	start = g_get_monotonic_time();
+	for (i = 0; i < iterations; i++) {
+		__bench_legacy_convert(legacy_uuids);
+		bench_sink += legacy_uuids[0][0];
+		__bench_legacy_free(legacy_uuids);
+	}
+	base = __bench_report("convert uppercase", start, iterations, 0.0);
+
+	start = g_get_monotonic_time();
+	for (i = 0; i < iterations; i++) {
+		service_mask = __bench_interned_convert(interned_uuids);
+		bench_sink += interned_uuids[0][0];
+	}
+	__bench_report("convert interned", start, iterations, base);
+
+	__bench_legacy_convert(legacy_uuids);
+	start = g_get_monotonic_time();
+	for (i = 0; i < iterations; i++)
+		bench_sink += __bench_legacy_has_service(legacy_uuids);
+	base = __bench_report("has_service strcmp", start, iterations, 0.0);
+	__bench_legacy_free(legacy_uuids);
+
+	start = g_get_monotonic_time();
+	for (i = 0; i < iterations; i++)
+		bench_sink += (service_mask & BT_SERVICE_BIT(BT_SERVICE_A2DP_SINK)) ? 1 : 0;
+	__bench_report("has_service bitmask", start, iterations, base);
+
+	return 0;
+}